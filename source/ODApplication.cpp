@@ -69,7 +69,7 @@ void ODApplication::startGame(boost::program_options::variables_map& options)
     logMgr.setLevel(resMgr.getLogLevel());
 
     logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
-    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkFile(resMgr.getLogFile())));
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkFile(resMgr.getLogFile(), resMgr.isLogAsync())));
 
     if(resMgr.isServerMode())
         startServer();
@@ -415,19 +415,39 @@ bool BaseAI::computePointsForRoom(Tile* tile, Seat* mPlayerSeat, int32_t wantedS
 
 bool BaseAI::digWayToTile(Tile* tileStart, Tile* tileEnd)
 {
-    // We find a way to tileEnd. We search in reverse order to stop when we reach the first
-    // accessible tile
-
-    // Set a diggable path up to the first gold spot for the given team color, by the first available worker
-    Seat* seat = mPlayer.getSeat();
-    Creature* worker = mGameMap.getWorkerForPathFinding(seat);
+    // Set a diggable path for the given team color, by the first available worker
+    Creature* worker = mGameMap.getWorkerForPathFinding(mPlayer.getSeat());
     if (worker == nullptr)
         return false;
 
-    std::list<Tile*> pathToDig = mGameMap.path(tileEnd, tileStart, worker, seat, true);
-    if (pathToDig.empty())
+    std::vector<Tile*> path;
+    if(!mGameMap.findDigPath(*worker, tileStart, std::vector<Tile*>(1, tileEnd), path))
         return false;
 
+    markPathForDigging(worker, tileStart, path);
+    return true;
+}
+
+Tile* BaseAI::digWayToClosestGold(Tile* tileStart)
+{
+    Creature* worker = mGameMap.getWorkerForPathFinding(mPlayer.getSeat());
+    if (worker == nullptr)
+        return nullptr;
+
+    std::vector<Tile*> path;
+    if(!mGameMap.findDigPathToGold(*worker, tileStart, path))
+        return nullptr;
+
+    markPathForDigging(worker, tileStart, path);
+    return path.back();
+}
+
+void BaseAI::markPathForDigging(const Creature* worker, Tile* tileStart, const std::vector<Tile*>& path)
+{
+    // We search in reverse order to stop when we reach the first accessible tile
+    Seat* seat = mPlayer.getSeat();
+    std::list<Tile*> pathToDig(path.rbegin(), path.rend());
+
     // We search for the first reachable tile in the list
     bool isPathFound = false;
     for(std::list<Tile*>::iterator it = pathToDig.begin(); it != pathToDig.end();)
@@ -470,6 +490,4 @@ bool BaseAI::digWayToTile(Tile* tileStart, Tile* tileEnd)
         if (tile && tile->isDiggable(seat))
             tile->setMarkedForDigging(true, &mPlayer);
     }
-
-    return true;
 }
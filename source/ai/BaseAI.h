@@ -22,6 +22,7 @@
 #include <vector>
 #include <cstdint>
 
+class Creature;
 class GameMap;
 class Player;
 class Room;
@@ -57,6 +58,15 @@ protected:
         int32_t& bestX, int32_t& bestY);
 
     bool digWayToTile(Tile* tileStart, Tile* tileEnd);
+
+    //! \brief Marks for digging the way from tileStart to the gold tile that needs the less digging
+    //! (see GameMap::findDigPathToGold). Returns the gold tile the way leads to or nullptr if none can be reached
+    Tile* digWayToClosestGold(Tile* tileStart);
+
+    //! \brief Marks for digging the tiles of the given dig path (see GameMap::findDigPath) that the worker
+    //! cannot reach from tileStart
+    void markPathForDigging(const Creature* worker, Tile* tileStart, const std::vector<Tile*>& path);
+
     bool computePointsForRoom(Tile* tile, Seat* playerSeat, int32_t wantedSize,
         bool bottomLeft2TopRight, bool useWalls, int32_t& points);
 
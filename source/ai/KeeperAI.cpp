@@ -124,16 +124,8 @@ bool KeeperAI::checkTreasury()
     }
     mCooldownCheckTreasury = Random::Int(10,30);
 
-    int totalGold = 0;
-    int totalStorage = 0;
-    for(Room* room : mGameMap.getRooms())
-    {
-        if(room->getSeat() != mPlayer.getSeat())
-            continue;
-
-        totalGold += room->getTotalGoldStored();
-        totalStorage += room->getTotalGoldStorage();
-    }
+    int totalGold = mPlayer.getSeat()->getGold();
+    int totalStorage = mPlayer.getSeat()->getGoldMax();
 
     // We want at least to be allowed to store 3000 gold
     if(totalStorage >= 3000)
@@ -369,118 +361,16 @@ bool KeeperAI::lookForGold()
     mCooldownLookingForGold = Random::Int(70,120);
 
     // Do we need gold ?
-    int emptyStorage = 0;
-    for(Room* room : mGameMap.getRooms())
-    {
-        if(room->getSeat() != mPlayer.getSeat())
-            continue;
-
-        emptyStorage += (room->getTotalGoldStorage() - room->getTotalGoldStored());
-    }
+    int emptyStorage = mPlayer.getSeat()->getGoldMax() - mPlayer.getSeat()->getGold();
 
     // No need to search for gold
     if(emptyStorage < 100)
         return false;
 
+    // We look for the gold tile we can reach by digging the less
     Tile* central = getDungeonTemple()->getCentralTile();
-    int widerSide = mGameMap.getMapSizeX() > mGameMap.getMapSizeY() ?
-        mGameMap.getMapSizeX() : mGameMap.getMapSizeY();
-
-    // We search for the closest gold tile
-    Tile* firstGoldTile = nullptr;
-    for(int32_t distance = 1; distance < widerSide; ++distance)
-    {
-        for(int k = 0; k <= distance; ++k)
-        {
-            Tile* t;
-            // North-East
-            t = mGameMap.getTile(central->getX() + k, central->getY() + distance);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                // If we already have a tile at same distance, we randomly change to
-                // try to not be too predictable
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // North-West
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - k, central->getY() + distance);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // South-East
-            t = mGameMap.getTile(central->getX() + k, central->getY() - distance);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // South-West
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - k, central->getY() - distance);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // East-North
-            t = mGameMap.getTile(central->getX() + distance, central->getY() + k);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // East-South
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() + distance, central->getY() - k);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-            // West-North
-            t = mGameMap.getTile(central->getX() - distance, central->getY() + k);
-            if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-            {
-                if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                    firstGoldTile = t;
-            }
-            // West-South
-            if(k > 0)
-            {
-                t = mGameMap.getTile(central->getX() - distance, central->getY() - k);
-                if(t != nullptr && t->getType() == TileType::gold && t->getFullness() > 0.0)
-                {
-                    if((firstGoldTile == nullptr) || (Random::Uint(1,2) == 1))
-                        firstGoldTile = t;
-                }
-            }
-
-            if(firstGoldTile != nullptr)
-                break;
-        }
-
-        // If we found a tile, no need to continue
-        if(firstGoldTile != nullptr)
-            break;
-    }
-
-    // No more gold
-    if (firstGoldTile == nullptr)
-    {
-        mNoMoreReachableGold = true;
-        return false;
-    }
-
-    if(!digWayToTile(central, firstGoldTile))
+    Tile* firstGoldTile = digWayToClosestGold(central);
+    if(firstGoldTile == nullptr)
     {
         mNoMoreReachableGold = true;
         return false;
@@ -0,0 +1,245 @@
+/*! \file   ServerBenchmark.cpp
+ *  \brief  Headless server benchmark. It loads a level, gives a KeeperAI to every seat and runs
+ *          the server turns without network nor rendering. The time spent in the main phases of the
+ *          turns (see GameMapPhaseTimings) is written as JSON so that simulation performance
+ *          regressions can be caught before deploying a new build.
+ *          Example: OpenDungeonsBenchmark --level levels/skirmish/Bridges.level --turns 1000 --seed 42 --output result.json
+ *
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ai/KeeperAIType.h"
+#include "entities/Tile.h"
+#include "game/Player.h"
+#include "game/Seat.h"
+#include "gamemap/GameMap.h"
+#include "network/ODServer.h"
+#include "utils/ConfigManager.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+#include "utils/LogSinkConsole.h"
+#include "utils/Random.h"
+#include "utils/ResourceManager.h"
+#include "utils/ThreadPool.h"
+#include "ODApplication.h"
+
+#include <OgreTimer.h>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+//! \brief Gives a KeeperAI to every seat and starts the game like ODServer does once the seats are configured
+static bool configureSeats(GameMap& gameMap)
+{
+    const std::vector<std::string>& factions = ConfigManager::getSingleton().getFactions();
+    for(Seat* seat : gameMap.getSeats())
+    {
+        // Rogue seat do not have to be configured
+        if(seat->isRogueSeat())
+            continue;
+
+        if(seat->getFaction().compare(Seat::PLAYER_FACTION_CHOICE) == 0)
+            seat->setFaction(factions.front());
+
+        const std::vector<int>& availableTeamIds = seat->getAvailableTeamIds();
+        if(availableTeamIds.empty())
+        {
+            OD_LOG_ERR("No team available for seatId=" + Helper::toString(seat->getId()));
+            return false;
+        }
+        seat->setTeamId(availableTeamIds.front());
+
+        Player* aiPlayer = new Player(&gameMap, 0);
+        aiPlayer->setNick("Keeper AI " + KeeperAITypes::toString(KeeperAIType::normal) + " " + Helper::toString(seat->getId()));
+        gameMap.addPlayer(aiPlayer);
+        seat->setPlayer(aiPlayer);
+        gameMap.assignAI(*aiPlayer, KeeperAIType::normal);
+        seat->setMapSize(gameMap.getMapSizeX(), gameMap.getMapSizeY());
+    }
+
+    for(Seat* seat : gameMap.getSeats())
+        seat->initSeat();
+
+    gameMap.notifySeatsConfigured();
+
+    const std::vector<Seat*>& seats = gameMap.getSeats();
+    for (int jj = 0; jj < gameMap.getMapSizeY(); ++jj)
+    {
+        for (int ii = 0; ii < gameMap.getMapSizeX(); ++ii)
+            gameMap.getTile(ii,jj)->setSeats(seats);
+    }
+
+    for(Seat* seat : seats)
+    {
+        for(Seat* alliedSeat : seats)
+        {
+            if(alliedSeat == seat)
+                continue;
+            if(!seat->isAlliedSeat(alliedSeat))
+                continue;
+            seat->addAlliedSeat(alliedSeat);
+        }
+    }
+
+    gameMap.setTurnNumber(0);
+    gameMap.setGamePaused(false);
+    gameMap.createAllEntities();
+
+    for(Seat* seat : seats)
+    {
+        if(seat->getPlayer() == nullptr)
+            continue;
+
+        if(seat->getGold() > 0)
+            gameMap.addGoldToSeat(seat->getGold(), seat->getId());
+    }
+
+    return true;
+}
+
+//! \brief Writes the given phase as a JSON member. Times are given in milliseconds
+static void writePhase(std::ostream& os, const std::string& name, uint64_t totalUs, uint32_t nbTurns, bool isLast = false)
+{
+    double totalMs = static_cast<double>(totalUs) / 1000.0;
+    os << "    \"" << name << "\": { \"total_ms\": " << totalMs
+       << ", \"per_turn_ms\": " << (nbTurns > 0 ? totalMs / nbTurns : 0.0) << " }"
+       << (isLast ? "\n" : ",\n");
+}
+
+int main(int argc, char** argv)
+{
+    boost::program_options::options_description desc("Allowed options");
+    desc.add_options()
+        ("help", "produce help message")
+        ("level", boost::program_options::value<std::string>(), "level file to load")
+        ("turns", boost::program_options::value<uint32_t>()->default_value(1000), "number of turns to run")
+        ("seed", boost::program_options::value<uint32_t>()->default_value(1), "seed used by the random generators")
+        ("threads", boost::program_options::value<uint32_t>(), "number of worker threads (default: one per core)")
+        ("output", boost::program_options::value<std::string>(), "file where the JSON results are written (default: standard output)")
+    ;
+    ResourceManager::buildCommandOptions(desc);
+
+    boost::program_options::variables_map options;
+    boost::program_options::store(boost::program_options::command_line_parser(argc, argv).options(desc).run(), options);
+    boost::program_options::notify(options);
+
+    if(options.count("help") || !options.count("level"))
+    {
+        std::cout << desc << "\n";
+        return options.count("help") ? 0 : 1;
+    }
+
+    const std::string levelFile = options["level"].as<std::string>();
+    uint32_t nbTurns = options["turns"].as<uint32_t>();
+    uint32_t seed = options["seed"].as<uint32_t>();
+
+    ResourceManager resMgr(options);
+    LogManager logMgr;
+    // By default, we only log warnings to not slow down the turns (the game map logs every turn)
+    if(options.count("loglevel"))
+        logMgr.setLevel(resMgr.getLogLevel());
+    else
+        logMgr.setLevel(LogMessageLevel::WARNING);
+    logMgr.addSink(std::unique_ptr<LogSink>(new LogSinkConsole()));
+
+    // std::random_shuffle is used by some creature actions so we seed it too
+    Random::initialize(seed);
+    std::srand(seed);
+    ConfigManager configManager(resMgr.getConfigPath(), "", resMgr.getSoundPath());
+
+    // The server is not started. It is only needed because game entities queue their notifications through it.
+    // As it is not connected, these notifications are discarded
+    ODServer server;
+    GameMap gameMap(true);
+    uint32_t nbWorkers = options.count("threads") ? options["threads"].as<uint32_t>() : ThreadPool::getDefaultNbWorkers();
+    gameMap.setNbWorkerThreads(nbWorkers);
+
+    Ogre::Timer stopwatch;
+    if(!gameMap.loadLevel(levelFile))
+    {
+        OD_LOG_ERR("Couldn't load level file: " + levelFile);
+        return 1;
+    }
+
+    if(!configureSeats(gameMap))
+        return 1;
+
+    uint64_t loadUs = stopwatch.getMicroseconds();
+
+    // We use the same turn length as the server. Like the server, we make the server time a little bit late
+    double timeSinceLastTurn = 0.95 / ODApplication::turnsPerSecond;
+    gameMap.resetPhaseTimings();
+    uint64_t maxTurnUs = 0;
+    stopwatch.reset();
+    for(uint32_t i = 0; i < nbTurns; ++i)
+    {
+        uint64_t turnStartUs = stopwatch.getMicroseconds();
+        gameMap.setTurnNumber(gameMap.getTurnNumber() + 1);
+        gameMap.updateAnimations(timeSinceLastTurn);
+        gameMap.updateVisibleEntities();
+        gameMap.doTurn(timeSinceLastTurn);
+        gameMap.doPlayerAITurn(timeSinceLastTurn);
+        gameMap.fireRefreshEntities();
+        gameMap.processDeletionQueues();
+        maxTurnUs = std::max(maxTurnUs, stopwatch.getMicroseconds() - turnStartUs);
+    }
+    uint64_t totalUs = stopwatch.getMicroseconds();
+
+    const GameMapPhaseTimings& timings = gameMap.getPhaseTimings();
+    std::stringstream ss;
+    ss << "{\n";
+    ss << "  \"level\": \"" << levelFile << "\",\n";
+    ss << "  \"turns\": " << nbTurns << ",\n";
+    ss << "  \"seed\": " << seed << ",\n";
+    ss << "  \"threads\": " << nbWorkers << ",\n";
+    ss << "  \"creatures\": " << gameMap.getCreatures().size() << ",\n";
+    ss << "  \"load_ms\": " << static_cast<double>(loadUs) / 1000.0 << ",\n";
+    ss << "  \"max_turn_ms\": " << static_cast<double>(maxTurnUs) / 1000.0 << ",\n";
+    ss << "  \"path_calls\": " << timings.mNbPathCalls << ",\n";
+    // Path calls and flood fill happen during the other phases so they are included in their times
+    ss << "  \"phases\": {\n";
+    writePhase(ss, "total", totalUs, nbTurns);
+    writePhase(ss, "vision", timings.mVisionUs, nbTurns);
+    writePhase(ss, "perception", timings.mPerceptionUs, nbTurns);
+    writePhase(ss, "active_objects_upkeep", timings.mActiveObjectsUs, nbTurns);
+    writePhase(ss, "ai", timings.mAIUs, nbTurns);
+    writePhase(ss, "flood_fill", timings.mFloodFillUs, nbTurns);
+    writePhase(ss, "path", timings.mPathUs, nbTurns, true);
+    ss << "  }\n";
+    ss << "}\n";
+
+    gameMap.clearAll();
+
+    if(!options.count("output"))
+    {
+        std::cout << ss.str();
+        return 0;
+    }
+
+    std::ofstream file(options["output"].as<std::string>());
+    if(!file.is_open())
+    {
+        OD_LOG_ERR("Couldn't open output file: " + options["output"].as<std::string>());
+        return 1;
+    }
+    file << ss.str();
+    return 0;
+}
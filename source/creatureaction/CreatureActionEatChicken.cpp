@@ -29,6 +29,11 @@
 #include "utils/MakeUnique.h"
 #include "utils/Random.h"
 
+const ConfigParam HatcheryHungerPerChickenParam(ConfigParamCtg::room, "HatcheryHungerPerChicken");
+const ConfigParam HatcheryCooldownChickenMinParam(ConfigParamCtg::room, "HatcheryCooldownChickenMin");
+const ConfigParam HatcheryCooldownChickenMaxParam(ConfigParamCtg::room, "HatcheryCooldownChickenMax");
+const ConfigParam HatcheryHpRecoveredPerChickenParam(ConfigParamCtg::room, "HatcheryHpRecoveredPerChicken");
+
 CreatureActionEatChicken::CreatureActionEatChicken(Creature& creature, ChickenEntity& chicken) :
     CreatureAction(creature),
     mChicken(&chicken)
@@ -108,10 +113,10 @@ bool CreatureActionEatChicken::handleEatChicken(Creature& creature, ChickenEntit
 
     // We can eat the chicken
     chicken->eatChicken(&creature);
-    creature.foodEaten(ConfigManager::getSingleton().getRoomConfigDouble("HatcheryHungerPerChicken"));
-    creature.setJobCooldown(Random::Int(ConfigManager::getSingleton().getRoomConfigUInt32("HatcheryCooldownChickenMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("HatcheryCooldownChickenMax")));
-    creature.setHP(creature.getHP() + ConfigManager::getSingleton().getRoomConfigDouble("HatcheryHpRecoveredPerChicken"));
+    creature.foodEaten(ConfigManager::getSingleton().getConfigDouble(HatcheryHungerPerChickenParam));
+    creature.setJobCooldown(Random::Int(ConfigManager::getSingleton().getConfigUInt32(HatcheryCooldownChickenMinParam),
+        ConfigManager::getSingleton().getConfigUInt32(HatcheryCooldownChickenMaxParam)));
+    creature.setHP(creature.getHP() + ConfigManager::getSingleton().getConfigDouble(HatcheryHpRecoveredPerChickenParam));
     creature.computeCreatureOverlayHealthValue();
     Ogre::Vector3 walkDirection = Ogre::Vector3(chickenTile->getX(), chickenTile->getY(), 0) - creature.getPosition();
     walkDirection.normalise();
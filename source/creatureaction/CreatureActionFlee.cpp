@@ -54,14 +54,14 @@ bool CreatureActionFlee::handleFlee(Creature& creature, int32_t nbTurns)
     }
 
     // We try to go closer to the dungeon temple. If we are too near or if we cannot go there, we will flee randomly
-    std::vector<Room*> tempRooms = creature.getGameMap()->getRoomsByTypeAndSeat(RoomType::dungeonTemple, creature.getSeat());
-    tempRooms = creature.getGameMap()->getReachableRooms(tempRooms, myTile, &creature);
+    std::vector<Room*> tempRooms = creature.getGameMap()->getReachableRooms(
+        creature.getGameMap()->getRoomsOfSeat(creature.getSeat(), RoomType::dungeonTemple), myTile, &creature);
     if(!tempRooms.empty())
     {
         // We can go to one dungeon temple
         Room* room = tempRooms[Random::Int(0, tempRooms.size() - 1)];
         Tile* tile = room->getCoveredTile(0);
-        std::list<Tile*> result = creature.getGameMap()->path(&creature, tile);
+        std::list<Tile*> result = creature.getGameMap()->flowFieldPath(&creature, tile);
         // If we are not too near from the dungeon temple, we go there
         if(result.size() > 5)
         {
@@ -69,8 +69,8 @@ bool CreatureActionLeaveDungeon::handleLeaveDungeon(Creature& creature)
     }
 
     // We try to go to the portal
-    std::vector<Room*> tempRooms = creature.getGameMap()->getRoomsByTypeAndSeat(RoomType::portal, creature.getSeat());
-    tempRooms = creature.getGameMap()->getReachableRooms(tempRooms, myTile, &creature);
+    std::vector<Room*> tempRooms = creature.getGameMap()->getReachableRooms(
+        creature.getGameMap()->getRoomsOfSeat(creature.getSeat(), RoomType::portal), myTile, &creature);
     if(tempRooms.empty())
     {
         creature.popAction();
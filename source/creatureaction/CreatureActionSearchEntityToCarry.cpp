@@ -20,9 +20,11 @@
 #include "creatureaction/CreatureActionGrabEntity.h"
 #include "entities/Building.h"
 #include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
 #include "entities/Tile.h"
 #include "game/Player.h"
 #include "game/Seat.h"
+#include "game/SeatJobBoard.h"
 #include "gamemap/GameMap.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
@@ -58,7 +60,11 @@ bool CreatureActionSearchEntityToCarry::handleSearchEntityToCarry(Creature& crea
     }
 
     std::vector<Building*> buildings = creature.getGameMap()->getReachableBuildingsPerSeat(creature.getSeat(), myTile, &creature);
-    std::vector<GameEntity*> carryableEntities = creature.getGameMap()->getCarryableEntities(&creature, creature.getTilesWithinSightRadius());
+    // Only the tiles within sight radius holding entities that may be carried are checked
+    std::vector<Tile*> tilesWithEntities;
+    creature.getSeat()->getJobBoard().getJobsInRadius(SeatJobType::carry, *myTile,
+        creature.getDefinition()->getSightRadius(), tilesWithEntities);
+    std::vector<GameEntity*> carryableEntities = creature.getGameMap()->getCarryableEntities(&creature, tilesWithEntities);
     std::vector<Tile*> carryableEntityInMyTileClients;
     std::vector<GameEntity*> availableEntities;
     EntityCarryType highestPriority = EntityCarryType::notCarryable;
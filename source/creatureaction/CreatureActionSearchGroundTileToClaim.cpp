@@ -19,11 +19,12 @@
 
 #include "creatureaction/CreatureActionClaimGroundTile.h"
 #include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
 #include "entities/Tile.h"
 #include "game/Player.h"
 #include "game/Seat.h"
+#include "game/SeatJobBoard.h"
 #include "gamemap/GameMap.h"
-#include "gamemap/Pathfinding.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
@@ -125,29 +126,21 @@ bool CreatureActionSearchGroundTileToClaim::handleSearchGroundTileToClaim(Creatu
         }
     }
 
-    // If we still haven't found a tile to claim, we try to take the closest one
-    float distBest = -1;
-    Tile* tileToClaim = nullptr;
-    for (Tile* tile : creature.getTilesWithinSightRadius())
+    // If we still haven't found a tile to claim, we try to take the closest one from the job board
+    Tile* tileToClaim = creature.getSeat()->getJobBoard().findClosestJob(SeatJobType::claimGround, *myTile,
+        creature.getDefinition()->getSightRadius(), [&](Tile& tile)
     {
         // if this tile is not fully claimed yet or the tile is of another player's color
-        if(tile == nullptr)
-            continue;
-        if(tile->isFullTile())
-            continue;
-        if(!tile->isGroundClaimable(creature.getSeat()))
-            continue;
-        if(!creature.getGameMap()->pathExists(&creature, myTile, tile))
-            continue;
-        if(!tile->canWorkerClaim(creature))
-            continue;
-
-        float dist = Pathfinding::squaredDistanceTile(*myTile, *tile);
-        if((distBest != -1) && (distBest <= dist))
-            continue;
+        if(tile.isFullTile())
+            return false;
+        if(!tile.isGroundClaimable(creature.getSeat()))
+            return false;
+        if(!tile.canWorkerClaim(creature))
+            return false;
 
         // Check to see if one of the tile's neighbors is claimed for our color
-        for (Tile* neigh : tile->getAllNeighbors())
+        bool hasClaimedNeighbor = false;
+        for (Tile* neigh : tile.getAllNeighbors())
         {
             if(neigh->isFullTile())
                 continue;
@@ -156,11 +149,15 @@ bool CreatureActionSearchGroundTileToClaim::handleSearchGroundTileToClaim(Creatu
             if(neigh->getClaimedPercentage() < 1.0)
                 continue;
 
-            distBest = dist;
-            tileToClaim = tile;
+            hasClaimedNeighbor = true;
             break;
         }
-    }
+
+        if(!hasClaimedNeighbor)
+            return false;
+
+        return creature.getGameMap()->pathExists(&creature, myTile, &tile);
+    });
 
     // Check if we found a tile
     if(tileToClaim != nullptr)
@@ -20,10 +20,12 @@
 #include "creatureaction/CreatureActionDigTile.h"
 #include "creatureaction/CreatureActionGrabEntity.h"
 #include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
 #include "entities/Tile.h"
 #include "entities/TreasuryObject.h"
 #include "game/Player.h"
 #include "game/Seat.h"
+#include "game/SeatJobBoard.h"
 #include "gamemap/GameMap.h"
 #include "gamemap/Pathfinding.h"
 #include "rooms/Room.h"
@@ -108,37 +110,37 @@ bool CreatureActionSearchTileToDig::handleSearchTileToDig(Creature& creature, in
         return true;
     }
 
-    // Find the closest tile to dig
-    float distBest = -1;
-    Tile* tileToDig = nullptr;
+    // Find the closest tile to dig. The tiles marked by our player are taken from the job board by
+    // increasing distance and the ones already having enough workers are skipped before checking paths
     Tile* tilePos = nullptr;
-    for (Tile* tile : creature.getTilesWithinSightRadius())
+    Tile* tileToDig = creature.getSeat()->getJobBoard().findClosestJob(SeatJobType::dig, *myTile,
+        creature.getDefinition()->getSightRadius(), [&](Tile& tile)
     {
-        // Check to see whether the tile is marked for digging
-        if(!tile->getMarkedForDigging(tempPlayer))
-            continue;
+        // Check to see whether the tile is still marked for digging
+        if(!tile.getMarkedForDigging(tempPlayer))
+            return false;
 
         // and there is still room to work on it
+        if(!tile.hasFreeDigFace())
+            return false;
+
         std::vector<Tile*> tiles;
-        tile->canWorkerDig(creature, tiles);
-        if(tiles.empty())
-            continue;
+        tile.canWorkerDig(creature, tiles);
 
-        // We search for the closest neighbor tile
+        // We search for the closest neighbor tile (canWorkerDig only returns reachable ones)
+        float distBest = -1;
         for (Tile* neighborTile : tiles)
         {
-            if (!creature.getGameMap()->pathExists(&creature, myTile, neighborTile))
-                continue;
-
             float dist = Pathfinding::squaredDistanceTile(*myTile, *neighborTile);
             if((distBest != -1) && (distBest <= dist))
                 continue;
 
             distBest = dist;
-            tileToDig = tile;
             tilePos = neighborTile;
         }
-    }
+
+        return (tilePos != nullptr);
+    });
 
     if((tileToDig != nullptr) && (tilePos != nullptr))
     {
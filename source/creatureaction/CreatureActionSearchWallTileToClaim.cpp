@@ -19,11 +19,12 @@
 
 #include "creatureaction/CreatureActionClaimWallTile.h"
 #include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
 #include "entities/Tile.h"
 #include "game/Player.h"
 #include "game/Seat.h"
+#include "game/SeatJobBoard.h"
 #include "gamemap/GameMap.h"
-#include "gamemap/Pathfinding.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 #include "utils/MakeUnique.h"
@@ -84,33 +85,27 @@ bool CreatureActionSearchWallTileToClaim::handleSearchWallTileToClaim(Creature&
         return true;
     }
 
-    // Find paths to all of the neighbor tiles for all of the visible wall tiles.
-    float distBest = -1;
-    Tile* tileToClaim = nullptr;
-    for(Tile* tile : creature.getTilesWithinSightRadius())
+    // Take the closest claimable wall from the job board that can be reached by the creature
+    Tile* tileToClaim = creature.getSeat()->getJobBoard().findClosestJob(SeatJobType::claimWall, *myTile,
+        creature.getDefinition()->getSightRadius(), [&](Tile& tile)
     {
-        // Check to see whether the tile is a claimable wall
-        if(tile->getMarkedForDigging(tempPlayer))
-            continue;
-        if(!tile->isWallClaimable(creature.getSeat()))
-            continue;
-        if (!tile->canWorkerClaim(creature))
-            continue;
+        // Check to see whether the tile is still a claimable wall
+        if(tile.getMarkedForDigging(tempPlayer))
+            return false;
+        if(!tile.isWallClaimable(creature.getSeat()))
+            return false;
+        if (!tile.canWorkerClaim(creature))
+            return false;
 
         // and can be reached by the creature
-        for(Tile* neigh : tile->getAllNeighbors())
+        for(Tile* neigh : tile.getAllNeighbors())
         {
-            if(!creature.getGameMap()->pathExists(&creature, myTile, neigh))
-                continue;
-
-            float dist = Pathfinding::squaredDistanceTile(*myTile, *neigh);
-            if((distBest != -1) && (distBest <= dist))
-                continue;
-
-            distBest = dist;
-            tileToClaim = tile;
+            if(creature.getGameMap()->pathExists(&creature, myTile, neigh))
+                return true;
         }
-    }
+
+        return false;
+    });
 
     if(tileToClaim != nullptr)
     {
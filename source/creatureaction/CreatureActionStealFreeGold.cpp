@@ -18,13 +18,17 @@
 #include "creatureaction/CreatureActionStealFreeGold.h"
 
 #include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
+#include "entities/GameEntityType.h"
 #include "entities/Tile.h"
 #include "entities/TreasuryObject.h"
-#include "game/Seat.h"
+#include "gamemap/EntityGrid.h"
 #include "gamemap/GameMap.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
+#include <vector>
+
 // ATM, we use an hardcoded value for creatures stealing gold. Later, we might
 // want to add something in the creature parameters or at least increase value
 // for high tier/level creatures
@@ -54,33 +58,34 @@ bool CreatureActionStealFreeGold::handleStealFreeGold(Creature& creature)
         return true;
     }
 
-    // We look for the closest TreasuryObject
-    TreasuryObject* treasuryClosest = nullptr;
-    for(Tile* tile : creature.getVisibleTiles())
-    {
-        if(!creature.getGameMap()->pathExists(&creature, myTile, tile))
-            continue;
+    // We look for the closest reachable TreasuryObject in the entity grid. Only the treasuries around the
+    // creature are checked and they are given by increasing distance
+    GameMap* gameMap = creature.getGameMap();
+    std::vector<GameEntity*> treasuryObjects;
+    gameMap->getEntityGrid().getNearestEntities(GameEntityType::treasuryObject, myTile->getX(), myTile->getY(),
+        creature.getDefinition()->getSightRadius(), 1, [&creature, gameMap, myTile](GameEntity& entity)
+        {
+            if(!entity.getIsOnMap())
+                return false;
 
-        std::vector<GameEntity*> treasuryObjects;
-        tile->fillWithEntities(treasuryObjects, SelectionEntityWanted::treasuryObjects, creature.getSeat()->getPlayer());
-        if(treasuryObjects.empty())
-            continue;
+            Tile* tile = entity.getPositionTile();
+            if(tile == nullptr)
+                return false;
+
+            if(!creature.isTileVisible(tile))
+                return false;
 
-        for(GameEntity* entity : treasuryObjects)
-        {
-            TreasuryObject* treasuryObject = static_cast<TreasuryObject*>(entity);
             // We do not consider treasuries locked by a kobolds
-            if(treasuryObject->getCarryLock(creature))
-                continue;
-
-            treasuryClosest = treasuryObject;
-            break;
-        }
-        // getVisibleTiles returns tiles sorted by distance. Thanks to that,
-        // we know the first we find will be the closest
-        if(treasuryClosest != nullptr)
-            break;
-    }
+            TreasuryObject& treasuryObject = static_cast<TreasuryObject&>(entity);
+            if(treasuryObject.getCarryLock(creature))
+                return false;
+
+            return gameMap->pathExists(&creature, myTile, tile);
+        }, treasuryObjects);
+
+    TreasuryObject* treasuryClosest = nullptr;
+    if(!treasuryObjects.empty())
+        treasuryClosest = static_cast<TreasuryObject*>(treasuryObjects.front());
 
     // If we found a treasury, we go to it
     if(treasuryClosest == nullptr)
@@ -50,10 +50,9 @@ const std::string& CreatureMoodCreature::getModifierName() const
 
 int32_t CreatureMoodCreature::computeMood(const Creature& creature) const
 {
-    std::vector<GameEntity*> alliedCreatures = creature.getGameMap()->getVisibleCreatures(creature.getVisibleTiles(),
-        creature.getSeat(), false);
+    // The allied forces have been computed during the creature perception, before its mood
     int nbCreatures = 0;
-    for(GameEntity* entity : alliedCreatures)
+    for(GameEntity* entity : creature.getVisibleAlliedObjects())
     {
         if(entity->getObjectType() != GameEntityType::creature)
             continue;
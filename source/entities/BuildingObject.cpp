@@ -114,25 +114,3 @@ void BuildingObject::addParticleEffect(const std::string& effectScript, uint32_t
     EntityParticleEffect* effect = new EntityParticleEffect(nextParticleSystemsName(), effectScript, nbTurns);
     mEntityParticleEffects.push_back(effect);
 }
-
-void BuildingObject::fireRefresh()
-{
-    for(Seat* seat : mSeatsWithVisionNotified)
-    {
-        if(seat->getPlayer() == nullptr)
-            continue;
-        if(!seat->getPlayer()->getIsHuman())
-            continue;
-
-        const std::string& name = getName();
-        ServerNotification *serverNotification = new ServerNotification(
-            ServerNotificationType::entitiesRefresh, seat->getPlayer());
-        uint32_t nb = 1;
-        GameEntityType entityType = getObjectType();
-        serverNotification->mPacket << nb;
-        serverNotification->mPacket << entityType;
-        serverNotification->mPacket << name;
-        exportToPacketForUpdate(serverNotification->mPacket, seat);
-        ODServer::getSingleton().queueServerNotification(serverNotification);
-    }
-}
@@ -47,8 +47,6 @@ public:
 
     void addParticleEffect(const std::string& effectScript, uint32_t nbTurns);
 
-    void fireRefresh();
-
     static BuildingObject* getBuildingObjectFromPacket(GameMap* gameMap, ODPacket& is);
 };
 
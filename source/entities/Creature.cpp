@@ -89,6 +89,7 @@
 #include <OgreVector2.h>
 
 #include <cmath>
+#include <cstdlib>
 #include <algorithm>
 
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
@@ -96,6 +97,8 @@
 #endif
 
 static const Ogre::Real CANNON_MISSILE_HEIGHT = 0.3;
+//! \brief Number of delta updates sent to a seat before the full creature state is sent again
+static const uint32_t NB_DELTAS_BEFORE_FULL_STATE = 20;
 
 const int32_t Creature::NB_TURNS_BEFORE_CHECKING_TASK = 15;
 const uint32_t Creature::NB_OVERLAY_HEALTH_VALUES = 8;
@@ -156,6 +159,7 @@ Creature::Creature(GameMap* gameMap, const CreatureDefinition* definition, Seat*
     mWeaponDropDeath         ("none"),
     mStatsWindow             (nullptr),
     mNbTurnsWithoutBattle    (0),
+    mIsPerceptionComputed    (false),
     mCarriedEntity           (nullptr),
     mMoodCooldownTurns       (0),
     mMoodValue               (CreatureMoodLevel::Neutral),
@@ -164,14 +168,15 @@ Creature::Creature(GameMap* gameMap, const CreatureDefinition* definition, Seat*
     mOverlayHealthValue      (0),
     mOverlayMoodValue        (CreatureMoodValues::Nothing),
     mOverlayStatus           (nullptr),
-    mNeedFireRefresh         (false),
     mDropCooldown            (0),
     mSpeedModifier           (1.0),
     mKoTurnCounter           (0),
     mSeatPrison              (nullptr),
     mNbTurnsTorture          (0),
     mNbTurnsPrison           (0),
-    mActiveSlapsCount        (0)
+    mActiveSlapsCount        (0),
+    mVisionSeat              (nullptr),
+    mVisionTile              (nullptr)
 
 {
     //TODO: This should be set in initialiser list in parent classes
@@ -234,6 +239,7 @@ Creature::Creature(GameMap* gameMap) :
     mWeaponDropDeath         ("none"),
     mStatsWindow             (nullptr),
     mNbTurnsWithoutBattle    (0),
+    mIsPerceptionComputed    (false),
     mCarriedEntity           (nullptr),
     mMoodCooldownTurns       (0),
     mMoodValue               (CreatureMoodLevel::Neutral),
@@ -242,14 +248,15 @@ Creature::Creature(GameMap* gameMap) :
     mOverlayHealthValue      (0),
     mOverlayMoodValue        (0),
     mOverlayStatus           (nullptr),
-    mNeedFireRefresh         (false),
     mDropCooldown            (0),
     mSpeedModifier           (1.0),
     mKoTurnCounter           (0),
     mSeatPrison              (nullptr),
     mNbTurnsTorture          (0),
     mNbTurnsPrison           (0),
-    mActiveSlapsCount        (0)
+    mActiveSlapsCount        (0),
+    mVisionSeat              (nullptr),
+    mVisionTile              (nullptr)
 {
 }
 
@@ -329,6 +336,7 @@ void Creature::removeFromGameMap()
     removeEntityFromPositionTile();
     getGameMap()->removeCreature(this);
     getGameMap()->removeAnimatedObject(this);
+    clearVision();
     getGameMap()->removeClientUpkeepEntity(this);
 
     if(!getIsOnServerMap())
@@ -675,27 +683,92 @@ void Creature::update(Ogre::Real timeSinceLastFrame)
     }
 }
 
-void Creature::computeVisibleTiles()
+void Creature::updateVision(const std::vector<Tile*>& tilesOcclusionChanged)
 {
-    // dead Creatures do not give vision
-    if (getHP() <= 0.0)
+    if(!prepareVisionUpdate(tilesOcclusionChanged))
         return;
 
-    // KO Creatures do not give vision
-    if (isKo())
-        return;
+    // Look at the surrounding area
+    updateTilesInSight();
+    commitVisionUpdate();
+}
 
-    // creatures in jail do not give vision
-    if (mSeatPrison != nullptr)
-        return;
+bool Creature::prepareVisionUpdate(const std::vector<Tile*>& tilesOcclusionChanged)
+{
+    // dead Creatures, KO Creatures and creatures in jail do not give vision
+    Tile* posTile = nullptr;
+    if((getHP() > 0.0) && !isKo() && (mSeatPrison == nullptr) && getIsOnMap())
+        posTile = getPositionTile();
 
-    if (!getIsOnMap())
-        return;
+    if(posTile == nullptr)
+    {
+        clearVision();
+        return false;
+    }
 
-    // Look at the surrounding area
-    updateTilesInSight();
-    for(Tile* tile : mVisibleTiles)
-        tile->notifyVision(getSeat());
+    if((posTile == mVisionTile) && (getSeat() == mVisionSeat))
+    {
+        // The creature did not move. We only need to compute vision again if a tile it could
+        // see changed
+        int sightRadius = mDefinition->getSightRadius();
+        bool isVisionChanged = false;
+        for(Tile* tile : tilesOcclusionChanged)
+        {
+            if((std::abs(tile->getX() - posTile->getX()) > sightRadius) ||
+               (std::abs(tile->getY() - posTile->getY()) > sightRadius))
+            {
+                continue;
+            }
+
+            isVisionChanged = true;
+            break;
+        }
+
+        if(!isVisionChanged)
+            return false;
+    }
+
+    return true;
+}
+
+void Creature::commitVisionUpdate()
+{
+    Seat* seat = getSeat();
+    if((mVisionSeat == nullptr) || (mVisionSeat != seat))
+    {
+        clearVision();
+        for(Tile* tile : mVisibleTiles.getTiles())
+            tile->addVision(seat);
+    }
+    else
+    {
+        // Vision is refcounted so we only update the tiles that are not seen anymore or newly
+        // seen. When the creature moved by one tile, that is only the border of its sight
+        for(Tile* tile : mVisibleTilesGiven.getTiles())
+        {
+            if(!mVisibleTiles.isTileVisible(tile))
+                tile->removeVision(seat);
+        }
+        for(Tile* tile : mVisibleTiles.getTiles())
+        {
+            if(!mVisibleTilesGiven.isTileVisible(tile))
+                tile->addVision(seat);
+        }
+    }
+
+    mVisibleTilesGiven.copyTiles(mVisibleTiles);
+    mVisionSeat = seat;
+    mVisionTile = getPositionTile();
+}
+
+void Creature::clearVision()
+{
+    for(Tile* tile : mVisibleTilesGiven.getTiles())
+        tile->removeVision(mVisionSeat);
+
+    mVisibleTilesGiven.clear();
+    mVisionSeat = nullptr;
+    mVisionTile = nullptr;
 }
 
 void Creature::setLevel(unsigned int level)
@@ -751,6 +824,10 @@ void Creature::dropCarriedEquipment()
 
 void Creature::doUpkeep()
 {
+    // The perception buffers are only valid for the current upkeep
+    bool isPerceptionComputed = mIsPerceptionComputed;
+    mIsPerceptionComputed = false;
+
     // If the creature is in jail, we check if it is still standing on it (if not picked up). If
     // not, it is free
     if((mSeatPrison != nullptr) &&
@@ -826,6 +903,7 @@ void Creature::doUpkeep()
             return;
 
         mHp = 0;
+        getGameMap()->notifyCreatureDead(this);
         computeCreatureOverlayHealthValue();
         computeCreatureOverlayMoodValue();
     }
@@ -896,9 +974,20 @@ void Creature::doUpkeep()
         increaseHunger(mDefinition->getHungerGrowthPerTurn());
     }
 
-    mVisibleEnemyObjects         = getVisibleEnemyObjects();
-    mVisibleAlliedObjects        = getVisibleAlliedObjects();
-    mReachableAlliedObjects      = getReachableAttackableObjects(mVisibleAlliedObjects);
+    if(isPerceptionComputed)
+    {
+        // The perception has been computed at the beginning of the upkeep. Since then, the creatures
+        // processed before this one may have killed or removed some of the entities
+        removeLostEntities(mVisibleEnemyObjects);
+        removeLostEntities(mVisibleAlliedObjects);
+        removeLostEntities(mReachableAlliedObjects);
+    }
+    else
+    {
+        mVisibleEnemyObjects         = getVisibleEnemyObjects();
+        mVisibleAlliedObjects        = getVisibleAlliedObjects();
+        mReachableAlliedObjects      = getReachableAttackableObjects(mVisibleAlliedObjects);
+    }
 
     // Check if we should compute mood
     if(mMoodCooldownTurns > 0)
@@ -1092,7 +1181,7 @@ bool Creature::handleIdleAction()
             uint32_t index = Random::Uint(0,reachableCallToWars.size()-1);
             Spell* callToWar = reachableCallToWars[index];
             Tile* callToWarTile = callToWar->getPositionTile();
-            std::list<Tile*> tempPath = getGameMap()->path(this, callToWarTile);
+            std::list<Tile*> tempPath = getGameMap()->flowFieldPath(this, callToWarTile);
             // If we are 5 tiles from the call to war, we don't go there
             if(tempPath.size() >= 5)
             {
@@ -1274,7 +1363,7 @@ bool Creature::searchBestTargetInList(const std::vector<GameEntity*>& listObject
         std::vector<Tile*> coveredTiles = entity->getCoveredTiles();
         for(Tile* tile : coveredTiles)
         {
-            if(std::find(mVisibleTiles.begin(), mVisibleTiles.end(), tile) == mVisibleTiles.end())
+            if(!mVisibleTiles.isTileVisible(tile))
                 continue;
 
             int dist = Pathfinding::squaredDistanceTile(*tile, *myTile);
@@ -1339,9 +1428,13 @@ bool Creature::searchBestTargetInList(const std::vector<GameEntity*>& listObject
         int skillRangeMaxInt = static_cast<int>(skillRangeMax);
         int skillRangeMaxIntSquared = skillRangeMaxInt * skillRangeMaxInt;
         int bestScoreAttack = -1;
-        std::vector<Tile*> tiles;
+        std::vector<Tile*> tilesFiltered;
+        const std::vector<Tile*>* tiles = &tilesFiltered;
         if(tilesFilter.empty())
-            tiles = getGameMap()->visibleTiles(tileAttackCheck->getX(), tileAttackCheck->getY(), skillRangeMaxInt);
+        {
+            getGameMap()->visibleTiles(tileAttackCheck->getX(), tileAttackCheck->getY(), skillRangeMaxInt, mVisibleTilesFromTarget);
+            tiles = &mVisibleTilesFromTarget.getTiles();
+        }
         else
         {
             float radiusSquared = skillRangeMaxInt * skillRangeMaxInt;
@@ -1351,10 +1444,10 @@ bool Creature::searchBestTargetInList(const std::vector<GameEntity*>& listObject
                 if(dist > radiusSquared)
                     continue;
 
-                tiles.push_back(tile);
+                tilesFiltered.push_back(tile);
             }
         }
-        for(Tile* tile : tiles)
+        for(Tile* tile : *tiles)
         {
             if(tile->isFullTile())
                 continue;
@@ -1395,9 +1488,13 @@ bool Creature::searchBestTargetInList(const std::vector<GameEntity*>& listObject
         int bestScoreFlee = -1;
         int32_t fightIdleDist = getDefinition()->getFightIdleDist();
         Tile* fleeTile = nullptr;
-        std::vector<Tile*> tiles;
+        std::vector<Tile*> tilesFiltered;
+        const std::vector<Tile*>* tiles = &tilesFiltered;
         if(tilesFilter.empty())
-            tiles = getGameMap()->visibleTiles(tileEntityFlee->getX(), tileEntityFlee->getY(), fightIdleDist);
+        {
+            getGameMap()->visibleTiles(tileEntityFlee->getX(), tileEntityFlee->getY(), fightIdleDist, mVisibleTilesFromTarget);
+            tiles = &mVisibleTilesFromTarget.getTiles();
+        }
         else
         {
             float radiusSquared = fightIdleDist * fightIdleDist;
@@ -1407,11 +1504,11 @@ bool Creature::searchBestTargetInList(const std::vector<GameEntity*>& listObject
                 if(dist > radiusSquared)
                     continue;
 
-                tiles.push_back(tile);
+                tilesFiltered.push_back(tile);
             }
         }
         int32_t fightIdleDistSquared = fightIdleDist * fightIdleDist;
-        for(Tile* tile : tiles)
+        for(Tile* tile : *tiles)
         {
             if(tile->isFullTile())
                 continue;
@@ -1558,81 +1655,126 @@ void Creature::checkLevelUp()
     setLevel(mLevel + 1);
 }
 
-void Creature::exportToPacketForUpdate(ODPacket& os, const Seat* seat) const
+CreatureNetworkState Creature::getNetworkState(const Seat* seat) const
 {
-    MovableGameEntity::exportToPacketForUpdate(os, seat);
-
-    int seatId = getSeat()->getId();
-    os << mLevel;
-    os << seatId;
-    os << mOverlayHealthValue;
+    CreatureNetworkState state;
+    state.mLevel = mLevel;
+    state.mSeatId = getSeat()->getId();
+    state.mOverlayHealthValue = mOverlayHealthValue;
 
     // Only allied players should see creature mood (except some states)
-    uint32_t moodValue = 0;
     if(seat->isAlliedSeat(getSeat()))
-        moodValue = mOverlayMoodValue;
+        state.mOverlayMoodValue = mOverlayMoodValue;
     else if(mSeatPrison != nullptr)
     {
         if(mSeatPrison->isAlliedSeat(seat))
-            moodValue = mOverlayMoodValue & CreatureMoodValues::MoodPrisonFiltersPrisonAllies;
+            state.mOverlayMoodValue = mOverlayMoodValue & CreatureMoodValues::MoodPrisonFiltersPrisonAllies;
         else
-            moodValue = mOverlayMoodValue & CreatureMoodValues::MoodPrisonFiltersAllPlayers;
+            state.mOverlayMoodValue = mOverlayMoodValue & CreatureMoodValues::MoodPrisonFiltersAllPlayers;
     }
 
-    os << moodValue;
-    os << mGroundSpeed;
-    os << mWaterSpeed;
-    os << mLavaSpeed;
-    os << mSpeedModifier;
+    state.mGroundSpeed = mGroundSpeed;
+    state.mWaterSpeed = mWaterSpeed;
+    state.mLavaSpeed = mLavaSpeed;
+    state.mSpeedModifier = mSpeedModifier;
 
-    int seatPrisonId = -1;
     if(mSeatPrison != nullptr)
-        seatPrisonId = mSeatPrison->getId();
+        state.mSeatPrisonId = mSeatPrison->getId();
+
+    return state;
+}
+
+void Creature::exportToPacketForUpdate(ODPacket& os, const Seat* seat) const
+{
+    MovableGameEntity::exportToPacketForUpdate(os, seat);
+
+    CreatureNetworkState state = getNetworkState(seat);
+    for(SeatNetworkState& seatState : mSeatsNetworkStates)
+    {
+        if(seatState.mSeat != seat)
+            continue;
+
+        // The updates are not acknowledged by the client. If one is lost, the client would stay
+        // out of sync until the fields change again. To avoid that, we regularly send everything
+        ++seatState.mNbDeltas;
+        if(seatState.mNbDeltas >= NB_DELTAS_BEFORE_FULL_STATE)
+        {
+            CreatureNetworkState::exportDeltaToPacket(os, nullptr, state);
+            seatState.mNbDeltas = 0;
+        }
+        else
+            CreatureNetworkState::exportDeltaToPacket(os, &seatState.mState, state);
 
-    os << seatPrisonId;
+        seatState.mState = state;
+        return;
+    }
+
+    // First update since the creature was added to this seat. We send everything
+    CreatureNetworkState::exportDeltaToPacket(os, nullptr, state);
+    mSeatsNetworkStates.push_back({ seat, state, 0 });
+}
+
+void Creature::resetSeatNetworkState(const Seat* seat)
+{
+    auto it = std::find_if(mSeatsNetworkStates.begin(), mSeatsNetworkStates.end(),
+        [seat](const SeatNetworkState& seatState) { return seatState.mSeat == seat; });
+    if(it != mSeatsNetworkStates.end())
+        mSeatsNetworkStates.erase(it);
 }
 
 void Creature::updateFromPacket(ODPacket& is)
 {
     MovableGameEntity::updateFromPacket(is);
 
-    int seatId;
-    OD_ASSERT_TRUE(is >> mLevel);
-    OD_ASSERT_TRUE(is >> seatId);
-    OD_ASSERT_TRUE(is >> mOverlayHealthValue);
-    OD_ASSERT_TRUE(is >> mOverlayMoodValue);
-    OD_ASSERT_TRUE(is >> mGroundSpeed);
-    OD_ASSERT_TRUE(is >> mWaterSpeed);
-    OD_ASSERT_TRUE(is >> mLavaSpeed);
-    OD_ASSERT_TRUE(is >> mSpeedModifier);
+    // Only the fields that changed are in the packet. The others keep their current value
+    CreatureNetworkState state;
+    state.mLevel = mLevel;
+    state.mSeatId = getSeat()->getId();
+    state.mOverlayHealthValue = mOverlayHealthValue;
+    state.mOverlayMoodValue = mOverlayMoodValue;
+    state.mGroundSpeed = mGroundSpeed;
+    state.mWaterSpeed = mWaterSpeed;
+    state.mLavaSpeed = mLavaSpeed;
+    state.mSpeedModifier = mSpeedModifier;
+    if(mSeatPrison != nullptr)
+        state.mSeatPrisonId = mSeatPrison->getId();
+
+    OD_ASSERT_TRUE(CreatureNetworkState::importDeltaFromPacket(is, state));
+    mLevel = state.mLevel;
+    mOverlayHealthValue = state.mOverlayHealthValue;
+    mOverlayMoodValue = state.mOverlayMoodValue;
+    mGroundSpeed = state.mGroundSpeed;
+    mWaterSpeed = state.mWaterSpeed;
+    mLavaSpeed = state.mLavaSpeed;
+    mSpeedModifier = state.mSpeedModifier;
 
     // We do not scale the creature if it is picked up (because it is already not at its normal size). It will be
     // resized anyway when dropped
     if(getIsOnMap())
         RenderManager::getSingleton().rrScaleCreature(*this);
 
-    if(getSeat()->getId() != seatId)
+    if(getSeat()->getId() != state.mSeatId)
     {
-        Seat* seat = getGameMap()->getSeatById(seatId);
+        Seat* seat = getGameMap()->getSeatById(state.mSeatId);
         if(seat == nullptr)
         {
-            OD_LOG_ERR("Creature " + getName() + ", wrong seatId=" + Helper::toString(seatId));
+            OD_LOG_ERR("Creature " + getName() + ", wrong seatId=" + Helper::toString(state.mSeatId));
         }
         else
         {
+            getGameMap()->notifyCreatureSeatChanging(this, seat);
             setSeat(seat);
         }
     }
 
-    OD_ASSERT_TRUE(is >> seatId);
-    if(seatId == -1)
+    if(state.mSeatPrisonId == -1)
         mSeatPrison = nullptr;
     else
     {
-        mSeatPrison = getGameMap()->getSeatById(seatId);
+        mSeatPrison = getGameMap()->getSeatById(state.mSeatPrisonId);
         if(mSeatPrison == nullptr)
         {
-            OD_LOG_ERR("Creature " + getName() + ", wrong seatId=" + Helper::toString(seatId));
+            OD_LOG_ERR("Creature " + getName() + ", wrong seatId=" + Helper::toString(state.mSeatPrisonId));
         }
     }
 }
@@ -1647,7 +1789,34 @@ void Creature::updateTilesInSight()
     mTilesWithinSightRadius = getGameMap()->circularRegion(posTile->getX(), posTile->getY(), mDefinition->getSightRadius());
 
     // Only the tiles the creature can "see".
-    mVisibleTiles = getGameMap()->visibleTiles(posTile->getX(), posTile->getY(), mDefinition->getSightRadius());
+    getGameMap()->visibleTiles(posTile->getX(), posTile->getY(), mDefinition->getSightRadius(), mVisibleTiles);
+}
+
+void Creature::computePerception()
+{
+    // We only compute the perception for creatures that will use it in doUpkeep
+    if(!getIsOnMap() || !isAlive() || (mKoTurnCounter != 0) || (mSeatPrison != nullptr))
+        return;
+
+    mVisibleEnemyObjects         = getVisibleEnemyObjects();
+    mVisibleAlliedObjects        = getVisibleAlliedObjects();
+    mReachableAlliedObjects      = getReachableAttackableObjects(mVisibleAlliedObjects);
+    mIsPerceptionComputed = true;
+}
+
+void Creature::removeLostEntities(std::vector<GameEntity*>& entities)
+{
+    auto it = std::remove_if(entities.begin(), entities.end(), [](GameEntity* entity)
+    {
+        if(!entity->getIsOnMap())
+            return true;
+
+        if(entity->getObjectType() != GameEntityType::creature)
+            return false;
+
+        return !static_cast<Creature*>(entity)->isAlive();
+    });
+    entities.erase(it, entities.end());
 }
 
 std::vector<GameEntity*> Creature::getVisibleEnemyObjects()
@@ -1718,7 +1887,7 @@ void Creature::computeVisualDebugEntities()
 
     updateTilesInSight();
 
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::refreshCreatureVisDebug, nullptr);
 
     const std::string& name = getName();
@@ -1726,10 +1895,10 @@ void Creature::computeVisualDebugEntities()
     serverNotification->mPacket << true;
     if(getIsOnMap())
     {
-        uint32_t nbTiles = mVisibleTiles.size();
+        uint32_t nbTiles = mVisibleTiles.getTiles().size();
         serverNotification->mPacket << nbTiles;
 
-        for (Tile* tile : mVisibleTiles)
+        for (Tile* tile : mVisibleTiles.getTiles())
             getGameMap()->tileToPacket(serverNotification->mPacket, tile);
     }
     else
@@ -1782,7 +1951,7 @@ void Creature::stopComputeVisualDebugEntities()
 
     mHasVisualDebuggingEntities = false;
 
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::refreshCreatureVisDebug, nullptr);
     const std::string& name = getName();
     serverNotification->mPacket << name;
@@ -1846,8 +2015,7 @@ void Creature::createStatsWindow()
 
     ClientNotification *clientNotification = new ClientNotification(
         ClientNotificationType::askCreatureInfos);
-    std::string name = getName();
-    clientNotification->mPacket << name << true;
+    clientNotification->mPacket << getId() << true;
     ODClient::getSingleton().queueClientNotification(clientNotification);
 
     CEGUI::WindowManager* wmgr = CEGUI::WindowManager::getSingletonPtr();
@@ -1883,8 +2051,7 @@ void Creature::destroyStatsWindow()
     {
         ClientNotification *clientNotification = new ClientNotification(
             ClientNotificationType::askCreatureInfos);
-        std::string name = getName();
-        clientNotification->mPacket << name << false;
+        clientNotification->mPacket << getId() << false;
         ODClient::getSingleton().queueClientNotification(clientNotification);
 
         mStatsWindow->destroy();
@@ -1985,7 +2152,13 @@ double Creature::takeDamage(GameEntity* attacker, double absoluteDamage, double
     computeCreatureOverlayMoodValue();
 
     if(!isAlive())
+    {
+        // If the creature was already dead, no damage can be done
+        if(damageDone > 0.0)
+            getGameMap()->notifyCreatureDead(this);
+
         fireEntityDead();
+    }
 
     if(!getIsOnServerMap())
         return damageDone;
@@ -2459,10 +2632,9 @@ void Creature::releaseCarriedEntity()
         if(!seat->getPlayer()->getIsHuman())
             continue;
 
-        ServerNotification* serverNotification = new ServerNotification(
+        ServerNotification* serverNotification = ServerNotification::create(
             ServerNotificationType::releaseCarriedEntity, seat->getPlayer());
-        serverNotification->mPacket << getName() << carriedEntity->getObjectType();
-        serverNotification->mPacket << carriedEntity->getName();
+        serverNotification->mPacket << getId() << carriedEntity->getId();
         serverNotification->mPacket << mPosition;
         ODServer::getSingleton().queueServerNotification(serverNotification);
     }
@@ -2516,11 +2688,17 @@ void Creature::slap()
         ConfigManager::getSingleton().getSlapEffectDuration(), "");
     addCreatureEffect(effect);
     mHp -= mMaxHP * ConfigManager::getSingleton().getSlapDamagePercent() / 100.0;
+    if(mHp <= 0.0)
+        getGameMap()->notifyCreatureDead(this);
+
     computeCreatureOverlayHealthValue();
 }
 
 void Creature::fireAddEntity(Seat* seat, bool async)
 {
+    // The seat gets the full creature so the next update will send the full state again
+    resetSeatNetworkState(seat);
+
     if(async)
     {
         ServerNotification serverNotification(
@@ -2536,7 +2714,7 @@ void Creature::fireAddEntity(Seat* seat, bool async)
         return;
     }
 
-    ServerNotification* serverNotification = new ServerNotification(
+    ServerNotification* serverNotification = ServerNotification::create(
         ServerNotificationType::addEntity, seat->getPlayer());
     exportHeadersToPacket(serverNotification->mPacket);
     exportToPacket(serverNotification->mPacket, seat);
@@ -2546,63 +2724,36 @@ void Creature::fireAddEntity(Seat* seat, bool async)
     {
         mCarriedEntity->addSeatWithVision(seat, false);
 
-        serverNotification = new ServerNotification(
+        serverNotification = ServerNotification::create(
             ServerNotificationType::carryEntity, seat->getPlayer());
-        serverNotification->mPacket << getName() << mCarriedEntity->getObjectType();
-        serverNotification->mPacket << mCarriedEntity->getName();
+        serverNotification->mPacket << getId() << mCarriedEntity->getId();
         ODServer::getSingleton().queueServerNotification(serverNotification);
     }
 }
 
 void Creature::fireRemoveEntity(Seat* seat)
 {
+    // The seat will get the full creature if it sees it again
+    resetSeatNetworkState(seat);
+
     // If we are carrying an entity, we release it first, then we can remove it and us
     if(mCarriedEntity != nullptr)
     {
-        ServerNotification* serverNotification = new ServerNotification(
+        ServerNotification* serverNotification = ServerNotification::create(
             ServerNotificationType::releaseCarriedEntity, seat->getPlayer());
-        serverNotification->mPacket << getName() << mCarriedEntity->getObjectType();
-        serverNotification->mPacket << mCarriedEntity->getName();
+        serverNotification->mPacket << getId() << mCarriedEntity->getId();
         serverNotification->mPacket << mPosition;
         ODServer::getSingleton().queueServerNotification(serverNotification);
 
         mCarriedEntity->removeSeatWithVision(seat);
     }
 
-    const std::string& name = getName();
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::removeEntity, seat->getPlayer());
-    GameEntityType type = getObjectType();
-    serverNotification->mPacket << type;
-    serverNotification->mPacket << name;
+    serverNotification->mPacket << getId();
     ODServer::getSingleton().queueServerNotification(serverNotification);
 }
 
-void Creature::fireCreatureRefreshIfNeeded()
-{
-    if(!mNeedFireRefresh)
-        return;
-
-    mNeedFireRefresh = false;
-    for(Seat* seat : mSeatsWithVisionNotified)
-    {
-        if(seat->getPlayer() == nullptr)
-            continue;
-        if(!seat->getPlayer()->getIsHuman())
-            continue;
-
-        const std::string& name = getName();
-        ServerNotification *serverNotification = new ServerNotification(
-            ServerNotificationType::entitiesRefresh, seat->getPlayer());
-        uint32_t nbCreature = 1;
-        serverNotification->mPacket << nbCreature;
-        serverNotification->mPacket << GameEntityType::creature;
-        serverNotification->mPacket << name;
-        exportToPacketForUpdate(serverNotification->mPacket, seat);
-        ODServer::getSingleton().queueServerNotification(serverNotification);
-    }
-}
-
 void Creature::fireChatMsgTookFee(int goldTaken)
 {
     if(getSeat()->getPlayer() == nullptr)
@@ -2612,7 +2763,7 @@ void Creature::fireChatMsgTookFee(int goldTaken)
     if(getSeat()->getPlayer()->getHasLost())
         return;
 
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::chatServer, getSeat()->getPlayer());
     std::string msg;
     // We don't display the same message if we have taken all our fee or only a part of it
@@ -2634,7 +2785,7 @@ void Creature::fireChatMsgLeftDungeon()
     if(getSeat()->getPlayer()->getHasLost())
         return;
 
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::chatServer, getSeat()->getPlayer());
     std::string msg = getName() + " left your dungeon";
     serverNotification->mPacket << msg << EventShortNoticeType::aboutCreatures;
@@ -2650,7 +2801,7 @@ void Creature::fireChatMsgLeavingDungeon()
     if(getSeat()->getPlayer()->getHasLost())
         return;
 
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::chatServer, getSeat()->getPlayer());
     std::string msg = getName() + " is leaving your dungeon";
     serverNotification->mPacket << msg << EventShortNoticeType::aboutCreatures;
@@ -2666,7 +2817,7 @@ void Creature::fireChatMsgBecameRogue()
     if(getSeat()->getPlayer()->getHasLost())
         return;
 
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::chatServer, getSeat()->getPlayer());
     std::string msg = getName() + " is not under your control anymore !";
     serverNotification->mPacket << msg << EventShortNoticeType::aboutCreatures;
@@ -2682,7 +2833,7 @@ void Creature::fireChatMsgUnhappy()
     if(getSeat()->getPlayer()->getHasLost())
         return;
 
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::chatServer, getSeat()->getPlayer());
     std::string msg = getName() + " is unhappy !";
     serverNotification->mPacket << msg << EventShortNoticeType::aboutCreatures;
@@ -2698,7 +2849,7 @@ void Creature::fireChatMsgFurious()
     if(getSeat()->getPlayer()->getHasLost())
         return;
 
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::chatServer, getSeat()->getPlayer());
     std::string msg = getName() + " is furious !";
     serverNotification->mPacket << msg << EventShortNoticeType::aboutCreatures;
@@ -2808,7 +2959,7 @@ void Creature::fireCreatureSound(CreatureSound sound)
         if(!seat->getPlayer()->getIsHuman())
             continue;
 
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::playSpatialSound, seat->getPlayer());
         serverNotification->mPacket << soundComplete << posTile->getX() << posTile->getY();
         ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -3219,6 +3370,7 @@ void Creature::changeSeat(Seat* newSeat)
 {
     OD_LOG_INF("creature=" + getName() + " changes side from seatId=" + Helper::toString(getSeat()->getId()) + " to seatId=" + Helper::toString(newSeat->getId()));
     OD_ASSERT_TRUE_MSG(getSeat() != newSeat, "creature=" + getName() + ", seatId=" + Helper::toString(newSeat->getId()));
+    getGameMap()->notifyCreatureSeatChanging(this, newSeat);
     setSeat(newSeat);
     mMoodValue = CreatureMoodLevel::Neutral;
     mMoodPoints = 0;
@@ -21,7 +21,9 @@
 #ifndef CREATURE_H
 #define CREATURE_H
 
+#include "entities/CreatureNetworkState.h"
 #include "entities/MovableGameEntity.h"
+#include "gamemap/TileContainer.h"
 
 #include <OgreVector2.h>
 #include <OgreVector3.h>
@@ -249,8 +251,27 @@ public:
      */
     void doUpkeep() override;
 
-    //! \brief Computes the visible tiles and tags them to know which are visible
-    void computeVisibleTiles();
+    //! \brief Updates the tiles this creature gives vision on. They are only computed again if the creature moved
+    //! or if one of the given tiles, that may have started or stopped blocking vision, is within its sight radius
+    void updateVision(const std::vector<Tile*>& tilesOcclusionChanged);
+
+    //! \brief updateVision split in 3 steps so that the tiles in sight of several creatures can be computed in parallel.
+    //! prepareVisionUpdate returns true if the vision has to be computed again. In this case, updateTilesInSight and
+    //! then commitVisionUpdate should be called. Only updateTilesInSight can be called from a worker thread
+    bool prepareVisionUpdate(const std::vector<Tile*>& tilesOcclusionChanged);
+    void commitVisionUpdate();
+
+    //! \brief Updates the lists of tiles within sight radius.
+    //! And the tiles the creature can "see" (removing the ones behind walls).
+    void updateTilesInSight();
+
+    //! \brief Computes the visible enemies, visible allies and reachable allies the next call to doUpkeep will use.
+    //! It only reads the game map and writes the buffers of this creature so it can be called from a worker thread
+    //! for several creatures at the same time (as long as the floodfill forests are flattened, see GameMap)
+    void computePerception();
+
+    //! \brief Removes the vision given on the tiles by updateVision
+    void clearVision();
 
     virtual bool isAttackable(Tile* tile, Seat* seat) const override;
 
@@ -261,9 +282,9 @@ public:
     //! \brief Check whether a creature has earned one level. If yes, handle leveling it up
     void checkLevelUp();
 
-    //! \brief Updates the lists of tiles within sight radius.
-    //! And the tiles the creature can "see" (removing the ones behind walls).
-    void updateTilesInSight();
+    //! \brief Removes from the given perception buffer the entities that have been removed from the
+    //! map or killed since it was computed
+    static void removeLostEntities(std::vector<GameEntity*>& entities);
 
     //! \brief Loops over the visibleTiles and adds all enemy creatures in each tile to a list which it returns.
     std::vector<GameEntity*> getVisibleEnemyObjects();
@@ -396,7 +417,11 @@ public:
     void itsPayDay();
 
     inline const std::vector<Tile*>& getVisibleTiles() const
-    { return mVisibleTiles; }
+    { return mVisibleTiles.getTiles(); }
+
+    //! \brief Returns true if the given tile is in getVisibleTiles (in O(1))
+    inline bool isTileVisible(const Tile* tile) const
+    { return mVisibleTiles.isTileVisible(tile); }
 
     inline const std::vector<Tile*>& getTilesWithinSightRadius() const
     { return mTilesWithinSightRadius; }
@@ -471,8 +496,6 @@ public:
     void pushAction(std::unique_ptr<CreatureAction>&& action);
     void popAction();
 
-    void fireCreatureRefreshIfNeeded();
-
     void fireChatMsgTookFee(int goldTaken);
     void fireChatMsgLeftDungeon();
     void fireChatMsgLeavingDungeon();
@@ -682,11 +705,18 @@ private:
 
     //! \brief Only visible tiles, not hidden for other tiles,
     //! used for actions linked to enemies.
-    std::vector<Tile*>              mVisibleTiles;
+    VisibleTiles                    mVisibleTiles;
+
+    //! \brief Buffer used to compute the tiles visible from a target or a fleeing point
+    VisibleTiles                    mVisibleTilesFromTarget;
 
     std::vector<GameEntity*>        mVisibleEnemyObjects;
     std::vector<GameEntity*>        mVisibleAlliedObjects;
     std::vector<GameEntity*>        mReachableAlliedObjects;
+
+    //! \brief True if computePerception filled the 3 vectors above for the next call to doUpkeep
+    bool                            mIsPerceptionComputed;
+
     std::vector<std::unique_ptr<CreatureAction>>    mActions;
     std::vector<Tile*>              mVisualDebugEntityTiles;
 
@@ -720,10 +750,6 @@ private:
     //! to allocate/delete this pointer
     CreatureOverlayStatus*          mOverlayStatus;
 
-    //! Used on server side to indicate if a change that needs to be notified to the clients happened (like changing
-    //! level or HP)
-    bool                            mNeedFireRefresh;
-
     //! \brief Used on client side. When a creature is dropped, this cooldown will be set to a value > 0
     //! and decreased at each turn. Until it is > 0, the creature cannot be slapped. That's to avoid
     //! slapping creatures to death when dropping many.
@@ -758,9 +784,36 @@ private:
     //! \brief Counts the number of active slaps affecting the creature
     uint32_t                        mActiveSlapsCount;
 
+    //! \brief Tiles this creature gives vision on to mVisionSeat. They were computed when the creature
+    //! was on mVisionTile and are kept to only update the tiles that changed when it moves
+    VisibleTiles                    mVisibleTilesGiven;
+    Seat*                           mVisionSeat;
+    Tile*                           mVisionTile;
+
     //! \brief Skills the creature can use
     std::vector<CreatureSkillData> mSkillData;
 
+    //! \brief Server side. Last state sent to a seat by exportToPacketForUpdate and number of deltas
+    //! sent since the last full state
+    struct SeatNetworkState
+    {
+        const Seat* mSeat;
+        CreatureNetworkState mState;
+        uint32_t mNbDeltas;
+    };
+
+    //! \brief Server side. Last state sent to each seat by exportToPacketForUpdate. It is used to only send
+    //! the fields that changed. Because the client does not acknowledge the updates, the full state is sent
+    //! again every NB_DELTAS_BEFORE_FULL_STATE updates. Reset when the creature is added to or removed from
+    //! the seat (see fireAddEntity and fireRemoveEntity)
+    mutable std::vector<SeatNetworkState> mSeatsNetworkStates;
+
+    //! \brief Forgets the last state sent to the given seat so that the next update sends the full state
+    void resetSeatNetworkState(const Seat* seat);
+
+    //! \brief Returns the fields of this creature that are sent to the given seat
+    CreatureNetworkState getNetworkState(const Seat* seat) const;
+
     //! \brief A sub-function called by doTurn()
     //! This one checks if there is something prioritary to do (like fighting). If it is the case,
     //! it should empty the action list before adding what to do.
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "entities/CreatureNetworkState.h"
+
+#include "network/ODPacket.h"
+
+namespace
+{
+//! \brief Bits of the mask sent before the changed fields
+enum CreatureNetworkField : uint16_t
+{
+    level               = 1 << 0,
+    seatId              = 1 << 1,
+    overlayHealthValue  = 1 << 2,
+    overlayMoodValue    = 1 << 3,
+    groundSpeed         = 1 << 4,
+    waterSpeed          = 1 << 5,
+    lavaSpeed           = 1 << 6,
+    speedModifier       = 1 << 7,
+    seatPrisonId        = 1 << 8,
+    allFields           = (1 << 9) - 1
+};
+
+inline float quantize(double value)
+{
+    return static_cast<float>(value);
+}
+
+inline void setIfChanged(uint16_t& mask, uint16_t field, bool isChanged)
+{
+    if(isChanged)
+        mask |= field;
+}
+}
+
+void CreatureNetworkState::exportDeltaToPacket(ODPacket& os, const CreatureNetworkState* baseline, const CreatureNetworkState& state)
+{
+    uint16_t mask = 0;
+    if(baseline == nullptr)
+    {
+        mask = CreatureNetworkField::allFields;
+    }
+    else
+    {
+        setIfChanged(mask, CreatureNetworkField::level, baseline->mLevel != state.mLevel);
+        setIfChanged(mask, CreatureNetworkField::seatId, baseline->mSeatId != state.mSeatId);
+        setIfChanged(mask, CreatureNetworkField::overlayHealthValue, baseline->mOverlayHealthValue != state.mOverlayHealthValue);
+        setIfChanged(mask, CreatureNetworkField::overlayMoodValue, baseline->mOverlayMoodValue != state.mOverlayMoodValue);
+        setIfChanged(mask, CreatureNetworkField::groundSpeed, quantize(baseline->mGroundSpeed) != quantize(state.mGroundSpeed));
+        setIfChanged(mask, CreatureNetworkField::waterSpeed, quantize(baseline->mWaterSpeed) != quantize(state.mWaterSpeed));
+        setIfChanged(mask, CreatureNetworkField::lavaSpeed, quantize(baseline->mLavaSpeed) != quantize(state.mLavaSpeed));
+        setIfChanged(mask, CreatureNetworkField::speedModifier, quantize(baseline->mSpeedModifier) != quantize(state.mSpeedModifier));
+        setIfChanged(mask, CreatureNetworkField::seatPrisonId, baseline->mSeatPrisonId != state.mSeatPrisonId);
+    }
+
+    os << mask;
+    // Levels and overlay health values are small enough to be sent on 8 bits
+    if((mask & CreatureNetworkField::level) != 0)
+        os << static_cast<uint8_t>(state.mLevel);
+    if((mask & CreatureNetworkField::seatId) != 0)
+        os << state.mSeatId;
+    if((mask & CreatureNetworkField::overlayHealthValue) != 0)
+        os << static_cast<uint8_t>(state.mOverlayHealthValue);
+    if((mask & CreatureNetworkField::overlayMoodValue) != 0)
+        os << state.mOverlayMoodValue;
+    if((mask & CreatureNetworkField::groundSpeed) != 0)
+        os << quantize(state.mGroundSpeed);
+    if((mask & CreatureNetworkField::waterSpeed) != 0)
+        os << quantize(state.mWaterSpeed);
+    if((mask & CreatureNetworkField::lavaSpeed) != 0)
+        os << quantize(state.mLavaSpeed);
+    if((mask & CreatureNetworkField::speedModifier) != 0)
+        os << quantize(state.mSpeedModifier);
+    if((mask & CreatureNetworkField::seatPrisonId) != 0)
+        os << state.mSeatPrisonId;
+}
+
+bool CreatureNetworkState::importDeltaFromPacket(ODPacket& is, CreatureNetworkState& state)
+{
+    uint16_t mask;
+    if(!(is >> mask))
+        return false;
+
+    uint8_t value8;
+    float valueFloat;
+    if((mask & CreatureNetworkField::level) != 0)
+    {
+        if(!(is >> value8))
+            return false;
+        state.mLevel = value8;
+    }
+    if(((mask & CreatureNetworkField::seatId) != 0) && !(is >> state.mSeatId))
+        return false;
+    if((mask & CreatureNetworkField::overlayHealthValue) != 0)
+    {
+        if(!(is >> value8))
+            return false;
+        state.mOverlayHealthValue = value8;
+    }
+    if(((mask & CreatureNetworkField::overlayMoodValue) != 0) && !(is >> state.mOverlayMoodValue))
+        return false;
+    if((mask & CreatureNetworkField::groundSpeed) != 0)
+    {
+        if(!(is >> valueFloat))
+            return false;
+        state.mGroundSpeed = valueFloat;
+    }
+    if((mask & CreatureNetworkField::waterSpeed) != 0)
+    {
+        if(!(is >> valueFloat))
+            return false;
+        state.mWaterSpeed = valueFloat;
+    }
+    if((mask & CreatureNetworkField::lavaSpeed) != 0)
+    {
+        if(!(is >> valueFloat))
+            return false;
+        state.mLavaSpeed = valueFloat;
+    }
+    if((mask & CreatureNetworkField::speedModifier) != 0)
+    {
+        if(!(is >> valueFloat))
+            return false;
+        state.mSpeedModifier = valueFloat;
+    }
+    if(((mask & CreatureNetworkField::seatPrisonId) != 0) && !(is >> state.mSeatPrisonId))
+        return false;
+
+    return true;
+}
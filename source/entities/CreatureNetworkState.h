@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CREATURENETWORKSTATE_H
+#define CREATURENETWORKSTATE_H
+
+#include <cstdint>
+
+class ODPacket;
+
+//! \brief Creature fields sent to the clients when the creature changes (see Creature::exportToPacketForUpdate).
+//! The server keeps the last state sent to each seat. Only the fields that changed since are sent, preceded by
+//! a bitmask telling which ones are in the packet.
+//! Level and overlay health are sent on 8 bits and speeds as floats.
+struct CreatureNetworkState
+{
+    CreatureNetworkState() :
+        mLevel(0),
+        mSeatId(-1),
+        mOverlayHealthValue(0),
+        mOverlayMoodValue(0),
+        mGroundSpeed(0.0),
+        mWaterSpeed(0.0),
+        mLavaSpeed(0.0),
+        mSpeedModifier(0.0),
+        mSeatPrisonId(-1)
+    {}
+
+    uint32_t mLevel;
+    int32_t mSeatId;
+    uint32_t mOverlayHealthValue;
+    uint32_t mOverlayMoodValue;
+    double mGroundSpeed;
+    double mWaterSpeed;
+    double mLavaSpeed;
+    double mSpeedModifier;
+    int32_t mSeatPrisonId;
+
+    //! \brief Writes in os the fields of state that are different from baseline. If baseline is null,
+    //! every field is written. Doubles are compared after quantization so that a change too small to
+    //! be noticed by the client is not sent
+    static void exportDeltaToPacket(ODPacket& os, const CreatureNetworkState* baseline, const CreatureNetworkState& state);
+
+    //! \brief Reads a packet written by exportDeltaToPacket. Only the fields that were written are changed in state.
+    //! Returns false if the packet is invalid
+    static bool importDeltaFromPacket(ODPacket& is, CreatureNetworkState& state);
+};
+
+#endif // CREATURENETWORKSTATE_H
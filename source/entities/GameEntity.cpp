@@ -88,6 +88,7 @@ GameEntity::GameEntity(
           ) :
     mPosition          (Ogre::Vector3::ZERO),
     mName              (name),
+    mId                (0),
     mMeshName          (meshName),
     mMeshExists        (false),
     mSeat              (seat),
@@ -164,8 +165,7 @@ void GameEntity::removeEntityFromPositionTile()
 void GameEntity::firePickupEntity(Player* playerPicking)
 {
     int seatId = playerPicking->getSeat()->getId();
-    GameEntityType entityType = getObjectType();
-    const std::string& entityName = getName();
+    uint32_t entityId = getId();
     for(std::vector<Seat*>::iterator it = mSeatsWithVisionNotified.begin(); it != mSeatsWithVisionNotified.end();)
     {
         Seat* seat = *it;
@@ -195,14 +195,14 @@ void GameEntity::firePickupEntity(Player* playerPicking)
         {
             ServerNotification serverNotification(
                 ServerNotificationType::entityPickedUp, seat->getPlayer());
-            serverNotification.mPacket << seatId << entityType << entityName;
+            serverNotification.mPacket << seatId << entityId;
             ODServer::getSingleton().sendAsyncMsg(serverNotification);
         }
         else
         {
-            ServerNotification* serverNotification = new ServerNotification(
+            ServerNotification* serverNotification = ServerNotification::create(
                 ServerNotificationType::entityPickedUp, seat->getPlayer());
-            serverNotification->mPacket << seatId << entityType << entityName;
+            serverNotification->mPacket << seatId << entityId;
             ODServer::getSingleton().queueServerNotification(serverNotification);
         }
     }
@@ -256,7 +256,7 @@ void GameEntity::fireDropEntity(Player* playerPicking, Tile* tile)
         }
         else
         {
-            ServerNotification* serverNotification = new ServerNotification(
+            ServerNotification* serverNotification = ServerNotification::create(
                 ServerNotificationType::entityDropped, seat->getPlayer());
             serverNotification->mPacket << seatId;
             getGameMap()->tileToPacket(serverNotification->mPacket, tile);
@@ -376,6 +376,7 @@ void GameEntity::exportToPacket(ODPacket& os, const Seat* seat) const
         seatId = mSeat->getId();
 
     os << seatId;
+    os << mId;
     os << mName;
     os << mMeshName;
     os << mPosition;
@@ -393,6 +394,7 @@ void GameEntity::importFromPacket(ODPacket& is)
     if(seatId != -1)
         mSeat = mGameMap->getSeatById(seatId);
 
+    OD_ASSERT_TRUE(is >> mId);
     OD_ASSERT_TRUE(is >> mName);
     OD_ASSERT_TRUE(is >> mMeshName);
     OD_ASSERT_TRUE(is >> mPosition);
@@ -168,6 +168,11 @@ class GameEntity
     inline const std::string& getName() const
     { return mName; }
 
+    //! \brief Get the id used to reference the entity in the network messages. 0 means
+    //! that no id has been given yet
+    inline uint32_t getId() const
+    { return mId; }
+
     //! \brief Get the mesh name of the object
     inline const std::string& getMeshName() const
     { return mMeshName; }
@@ -193,6 +198,10 @@ class GameEntity
     inline void setName(const std::string& name)
     { mName = name; }
 
+    //! \brief Set the network id of the entity. It should only be called by the gamemap
+    inline void setId(uint32_t id)
+    { mId = id; }
+
     //! \brief Set the name of the mesh file
     inline void setMeshName(const std::string& meshName)
     { mMeshName = meshName; }
@@ -333,6 +342,9 @@ class GameEntity
     //! \brief Fires remove event to every seat with vision
     virtual void fireRemoveEntityToSeatsWithVision();
 
+    inline const std::vector<Seat*>& getSeatsWithVisionNotified() const
+    { return mSeatsWithVisionNotified; }
+
     //! \brief Returns true if the entity can be carried by a worker. False otherwise.
     virtual EntityCarryType getEntityCarryType(Creature* carrier)
     { return EntityCarryType::notCarryable; }
@@ -426,6 +438,10 @@ class GameEntity
     //! brief The name of the entity
     std::string mName;
 
+    //! \brief Id of the entity known by both server and clients. It is given by the server
+    //! gamemap when the entity is added and is used instead of the name in the network messages
+    uint32_t mId;
+
     //! \brief The name of the mesh
     std::string mMeshName;
 
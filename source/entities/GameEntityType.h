@@ -40,7 +40,8 @@ enum class GameEntityType
     persistentObject,
     trapEntity,
     skillEntity,
-    giftBoxEntity
+    giftBoxEntity,
+    nbEntityTypes
 };
 
 ODPacket& operator<<(ODPacket& os, const GameEntityType& type);
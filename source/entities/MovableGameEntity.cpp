@@ -33,6 +33,7 @@
 
 MovableGameEntity::MovableGameEntity(GameMap* gameMap) :
     GameEntity(gameMap),
+    mNeedFireRefresh(false),
     mAnimationState(nullptr),
     mDestinationAnimationState(EntityAnimation::idle_anim),
     mDestinationAnimationLoop(false),
@@ -98,11 +99,11 @@ void MovableGameEntity::setWalkPath(const std::string& walkAnim, const std::stri
         if(!seat->getPlayer()->getIsHuman())
             continue;
 
-        const std::string& name = getName();
         uint32_t nbDest = mWalkQueue.size();
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::animatedObjectSetWalkPath, seat->getPlayer());
-        serverNotification->mPacket << name << walkAnim << endAnim << loopEndAnim << playIdleWhenAnimationEnds << nbDest;
+        serverNotification->mPacket.reserve(64 + walkAnim.size() + endAnim.size() + nbDest * sizeof(Ogre::Vector3));
+        serverNotification->mPacket << getId() << walkAnim << endAnim << loopEndAnim << playIdleWhenAnimationEnds << nbDest;
         for(const Ogre::Vector3& v : mWalkQueue)
             serverNotification->mPacket << v;
 
@@ -122,12 +123,11 @@ void MovableGameEntity::clearDestinations(const std::string& animation, bool loo
         if(!seat->getPlayer()->getIsHuman())
             continue;
 
-        const std::string& name = getName();
         const std::string emptyString;
         uint32_t nbDest = 0;
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::animatedObjectSetWalkPath, seat->getPlayer());
-        serverNotification->mPacket << name << emptyString << animation
+        serverNotification->mPacket << getId() << emptyString << animation
             << loopAnim << playIdleWhenAnimationEnds << nbDest;
         ODServer::getSingleton().queueServerNotification(serverNotification);
     }
@@ -307,10 +307,9 @@ void MovableGameEntity::fireObjectAnimationState(const std::string& state, bool
         if(!seat->getPlayer()->getIsHuman())
             continue;
 
-        ServerNotification* serverNotification = new ServerNotification(
+        ServerNotification* serverNotification = ServerNotification::create(
             ServerNotificationType::setObjectAnimationState, seat->getPlayer());
-        const std::string& name = getName();
-        serverNotification->mPacket << name << state << loop << playIdleWhenAnimationEnds;
+        serverNotification->mPacket << getId() << state << loop << playIdleWhenAnimationEnds;
         if(direction != Ogre::Vector3::ZERO)
             serverNotification->mPacket << true << direction;
         else if(mWalkDirection != Ogre::Vector3::ZERO)
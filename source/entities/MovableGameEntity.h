@@ -105,6 +105,14 @@ public:
 
     virtual void restoreEntityState() override;
 
+    //! \brief Server side. True if a change that needs to be notified to the clients happened (like changing
+    //! level or HP). The changed entities are sent once per turn by GameMap::fireRefreshEntities
+    inline bool getNeedFireRefresh() const
+    { return mNeedFireRefresh; }
+
+    inline void setNeedFireRefresh(bool needFireRefresh)
+    { mNeedFireRefresh = needFireRefresh; }
+
     static std::string getMovableGameEntityStreamFormat();
 
 protected:
@@ -116,6 +124,7 @@ protected:
     std::deque<Ogre::Vector3> mWalkQueue;
     std::string mPrevAnimationState;
     bool mPrevAnimationStateLoop;
+    bool mNeedFireRefresh;
 
 private:
     void fireObjectAnimationState(const std::string& state, bool loop, const Ogre::Vector3& direction, bool playIdleWhenAnimationEnds);
@@ -127,10 +127,9 @@ void RenderedMovableEntity::setMeshOpacity(float opacity)
             if(!seat->getPlayer()->getIsHuman())
                 continue;
 
-            ServerNotification* serverNotification = new ServerNotification(
+            ServerNotification* serverNotification = ServerNotification::create(
                 ServerNotificationType::setEntityOpacity, seat->getPlayer());
-            const std::string& name = getName();
-            serverNotification->mPacket << name << opacity;
+            serverNotification->mPacket << getId() << opacity;
             ODServer::getSingleton().queueServerNotification(serverNotification);
         }
         return;
@@ -162,7 +161,7 @@ void RenderedMovableEntity::fireAddEntity(Seat* seat, bool async)
     }
     else
     {
-        ServerNotification* serverNotification = new ServerNotification(
+        ServerNotification* serverNotification = ServerNotification::create(
             ServerNotificationType::addEntity, seat->getPlayer());
         exportHeadersToPacket(serverNotification->mPacket);
         exportToPacket(serverNotification->mPacket, seat);
@@ -172,12 +171,9 @@ void RenderedMovableEntity::fireAddEntity(Seat* seat, bool async)
 
 void RenderedMovableEntity::fireRemoveEntity(Seat* seat)
 {
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::removeEntity, seat->getPlayer());
-    const std::string& name = getName();
-    GameEntityType type = getObjectType();
-    serverNotification->mPacket << type;
-    serverNotification->mPacket << name;
+    serverNotification->mPacket << getId();
     ODServer::getSingleton().queueServerNotification(serverNotification);
 }
 
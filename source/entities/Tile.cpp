@@ -67,7 +67,10 @@ Tile::Tile(GameMap* gameMap, int x, int y, TileType type, double fullness) :
     mHasBridge          (false),
     mLocalPlayerHasVision   (false),
     mTileCulling        (CullingType::HIDE),
-    mNbWorkersClaiming(0)
+    mNbWorkersClaiming(0),
+    mClaimedVisionSeat(nullptr),
+    mIsVisionDirty(false),
+    mIsOcclusionDirty(false)
 {
     computeTileVisual();
 }
@@ -417,6 +420,7 @@ bool Tile::isMarkedForDiggingByAnySeat()
 void Tile::addPlayerMarkingTile(const Player *p)
 {
     mPlayersMarkingTile.push_back(p);
+    getGameMap()->notifyTileJobsChanged(this);
 }
 
 void Tile::removePlayerMarkingTile(const Player *p)
@@ -426,6 +430,7 @@ void Tile::removePlayerMarkingTile(const Player *p)
         return;
 
     mPlayersMarkingTile.erase(it);
+    getGameMap()->notifyTileJobsChanged(this);
 }
 
 void Tile::addNeighbor(Tile *n)
@@ -546,121 +551,107 @@ bool Tile::isFloodFillPossible(Seat* seat, FloodFillType type) const
     return false;
 }
 
-bool Tile::isSameFloodFill(Seat* seat, FloodFillType type, Tile* tile) const
+bool Tile::isFloodFillIndexValid(Seat* seat, FloodFillType type) const
 {
-    return getFloodFillValue(seat, type) == tile->getFloodFillValue(seat, type);
+    GameMap* gameMap = getGameMap();
+    if((seat->getTeamIndex() < gameMap->getNbFloodFillTeams()) &&
+       (static_cast<uint32_t>(type) < static_cast<uint32_t>(FloodFillType::nbValues)))
+    {
+        return true;
+    }
+
+    static bool logMsg = false;
+    if(!logMsg)
+    {
+        logMsg = true;
+        OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
+            + ", tile=" + Tile::displayAsString(this)
+            + ", seatIndex=" + Helper::toString(seat->getTeamIndex()) + ", nbTeams=" + Helper::toString(gameMap->getNbFloodFillTeams())
+            + ", intType=" + Helper::toString(static_cast<uint32_t>(type))
+            + ", fullness=" + Helper::toString(getFullness()));
+    }
+    return false;
 }
 
-void Tile::resetFloodFill()
+bool Tile::isVisionIndexValid(Seat* seat) const
 {
-    for(std::vector<uint32_t>& values : mFloodFillColor)
+    GameMap* gameMap = getGameMap();
+    if(seat->getSeatIndex() < gameMap->getNbVisionSeats())
+        return true;
+
+    static bool logMsg = false;
+    if(!logMsg)
     {
-        for(uint32_t& floodFillValue : values)
-        {
-            floodFillValue = NO_FLOODFILL;
-        }
+        logMsg = true;
+        OD_LOG_ERR("Wrong vision seat index seatId=" + Helper::toString(seat->getId())
+            + ", tile=" + Tile::displayAsString(this)
+            + ", seatIndex=" + Helper::toString(seat->getSeatIndex()) + ", nbSeats=" + Helper::toString(gameMap->getNbVisionSeats()));
     }
+    return false;
 }
 
-bool Tile::updateFloodFillFromTile(Seat* seat, FloodFillType type, Tile* tile)
+bool Tile::isSameFloodFill(Seat* seat, FloodFillType type, Tile* tile) const
 {
-    if(seat->getTeamIndex() >= mFloodFillColor.size())
-    {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", seatIndex=" + Helper::toString(seat->getTeamIndex()) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(mFloodFillColor.size()))
-                + ", fullness=" + Helper::toString(getFullness()));
-        }
+    if(!isFloodFillIndexValid(seat, type))
         return false;
-    }
 
-    std::vector<uint32_t>& values = mFloodFillColor[seat->getTeamIndex()];
+    // If both tiles were given the same color, no need to resolve it
+    GameMap* gameMap = getGameMap();
     uint32_t intType = static_cast<uint32_t>(type);
-    if(intType >= values.size())
+    if(gameMap->getFloodFillColor(seat->getTeamIndex(), intType, mX, mY) ==
+       gameMap->getFloodFillColor(seat->getTeamIndex(), intType, tile->mX, tile->mY))
     {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", intType=" + Helper::toString(intType) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(values.size())));
-        }
-        return false;
+        return true;
     }
 
-    if((values[intType] != NO_FLOODFILL) ||
-       (tile->getFloodFillValue(seat, type) == NO_FLOODFILL))
-    {
+    return getFloodFillValue(seat, type) == tile->getFloodFillValue(seat, type);
+}
+
+bool Tile::updateFloodFillFromTile(Seat* seat, FloodFillType type, Tile* tile)
+{
+    if(!isFloodFillIndexValid(seat, type))
+        return false;
+
+    GameMap* gameMap = getGameMap();
+    uint32_t intType = static_cast<uint32_t>(type);
+    if(gameMap->getFloodFillColor(seat->getTeamIndex(), intType, mX, mY) != NO_FLOODFILL)
+        return false;
+
+    uint32_t color = tile->getFloodFillValue(seat, type);
+    if(color == NO_FLOODFILL)
         return false;
-    }
 
-    values[intType] = tile->getFloodFillValue(seat, type);
+    gameMap->setFloodFillColor(seat->getTeamIndex(), intType, mX, mY, color);
     return true;
 }
 
 void Tile::replaceFloodFill(Seat* seat, FloodFillType type, uint32_t newValue)
 {
-    if(seat->getTeamIndex() >= mFloodFillColor.size())
-    {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", seatIndex=" + Helper::toString(seat->getTeamIndex()) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(mFloodFillColor.size())));
-        }
-        return;
-    }
-
-    std::vector<uint32_t>& values = mFloodFillColor[seat->getTeamIndex()];
-    uint32_t intType = static_cast<uint32_t>(type);
-    if(intType >= values.size())
-    {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", intType=" + Helper::toString(intType) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(values.size())));
-        }
+    if(!isFloodFillIndexValid(seat, type))
         return;
-    }
 
-    values[intType] = newValue;
+    getGameMap()->setFloodFillColor(seat->getTeamIndex(), static_cast<uint32_t>(type), mX, mY, newValue);
 }
 
 void Tile::copyFloodFillToOtherSeats(Seat* seatToCopy)
 {
-    if(seatToCopy->getTeamIndex() >= mFloodFillColor.size())
-    {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seatToCopy->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", seatIndex=" + Helper::toString(seatToCopy->getTeamIndex()) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(mFloodFillColor.size())));
-        }
-        return;
-    }
-
-    std::vector<uint32_t>& valuesToCopy = mFloodFillColor[seatToCopy->getTeamIndex()];
-    for(uint32_t indexFloodFill = 0; indexFloodFill < mFloodFillColor.size(); ++indexFloodFill)
+    GameMap* gameMap = getGameMap();
+    uint32_t nbTeams = gameMap->getNbFloodFillTeams();
+    for(uint32_t intType = 0; intType < static_cast<uint32_t>(FloodFillType::nbValues); ++intType)
     {
-        if(seatToCopy->getTeamIndex() == indexFloodFill)
-            continue;
+        // We copy the resolved colors because the other teams do not share the merges of seatToCopy
+        FloodFillType type = static_cast<FloodFillType>(intType);
+        if(!isFloodFillIndexValid(seatToCopy, type))
+            return;
 
-        std::vector<uint32_t>& values = mFloodFillColor[indexFloodFill];
-        for(uint32_t intType = 0; intType < static_cast<uint32_t>(FloodFillType::nbValues); ++intType)
-            values[intType] = valuesToCopy[intType];
+        uint32_t color = getFloodFillValue(seatToCopy, type);
+        for(uint32_t teamIndex = 0; teamIndex < nbTeams; ++teamIndex)
+        {
+            if(seatToCopy->getTeamIndex() == teamIndex)
+                continue;
 
+            gameMap->setFloodFillColor(teamIndex, intType, mX, mY, color);
+        }
     }
 }
 
@@ -670,13 +661,13 @@ void Tile::logFloodFill() const
         + " - type=" + Tile::tileVisualToString(getTileVisual())
         + " - fullness=" + Helper::toString(getFullness())
         + " - seatId=" + std::string(getSeat() == nullptr ? "-1" : Helper::toString(getSeat()->getId()));
-    for(const std::vector<uint32_t>& values : mFloodFillColor)
+    GameMap* gameMap = getGameMap();
+    for(uint32_t teamIndex = 0; teamIndex < gameMap->getNbFloodFillTeams(); ++teamIndex)
     {
-        int cpt = 0;
-        for(const uint32_t& floodFill : values)
+        for(uint32_t intType = 0; intType < static_cast<uint32_t>(FloodFillType::nbValues); ++intType)
         {
-            str += ", [" + Helper::toString(cpt) + "]=" + Helper::toString(floodFill);
-            ++cpt;
+            str += ", [" + Helper::toString(intType) + "]="
+                + Helper::toString(gameMap->getFloodFillColor(teamIndex, intType, mX, mY));
         }
     }
     OD_LOG_INF(str);
@@ -719,22 +710,72 @@ bool Tile::isClaimed() const
     return true;
 }
 
-void Tile::clearVision()
+void Tile::addVision(Seat* seat)
+{
+    addSeatVision(seat);
+
+    // We also give vision to allied seats
+    for(Seat* alliedSeat : seat->getAlliedSeats())
+        addSeatVision(alliedSeat);
+}
+
+void Tile::removeVision(Seat* seat)
 {
-    mSeatsWithVision.clear();
+    removeSeatVision(seat);
+
+    for(Seat* alliedSeat : seat->getAlliedSeats())
+        removeSeatVision(alliedSeat);
 }
 
-void Tile::notifyVision(Seat* seat)
+void Tile::addSeatVision(Seat* seat)
 {
-    if(std::find(mSeatsWithVision.begin(), mSeatsWithVision.end(), seat) != mSeatsWithVision.end())
+    if(!isVisionIndexValid(seat))
         return;
 
-    seat->notifyVisionOnTile(this);
-    mSeatsWithVision.push_back(seat);
+    // The seat gains vision on this tile with its first vision source
+    if(getGameMap()->addSeatVisionSource(seat->getSeatIndex(), mX, mY))
+        seat->notifyVisionOnTile(this, true);
+}
+
+void Tile::removeSeatVision(Seat* seat)
+{
+    if(!isVisionIndexValid(seat))
+        return;
 
-    // We also notify vision for allied seats
-    for(Seat* alliedSeat : seat->getAlliedSeats())
-        notifyVision(alliedSeat);
+    GameMap* gameMap = getGameMap();
+    if(!gameMap->hasSeatVision(seat->getSeatIndex(), mX, mY))
+    {
+        OD_LOG_ERR("tile=" + Tile::displayAsString(this) + ", seat without vision id=" + Helper::toString(seat->getId()));
+        return;
+    }
+
+    // The seat loses vision on this tile with its last vision source
+    if(gameMap->removeSeatVisionSource(seat->getSeatIndex(), mX, mY))
+        seat->notifyVisionOnTile(this, false);
+}
+
+void Tile::fillSeatsWithVision(std::vector<Seat*>& seats) const
+{
+    seats.clear();
+    GameMap* gameMap = getGameMap();
+    if(gameMap->getNbVisionSeats() == 0)
+        return;
+
+    for(Seat* seat : gameMap->getSeats())
+    {
+        if(seat->getSeatIndex() >= gameMap->getNbVisionSeats())
+            continue;
+
+        if(gameMap->hasSeatVision(seat->getSeatIndex(), mX, mY))
+            seats.push_back(seat);
+    }
+}
+
+std::vector<Seat*> Tile::getSeatsWithVision() const
+{
+    std::vector<Seat*> seats;
+    fillSeatsWithVision(seats);
+    return seats;
 }
 
 void Tile::setSeats(const std::vector<Seat*>& seats)
@@ -842,41 +883,16 @@ void Tile::computeTileVisual()
 
 uint32_t Tile::getFloodFillValue(Seat* seat, FloodFillType type) const
 {
-    if(seat->getTeamIndex() >= mFloodFillColor.size())
-    {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", seatIndex=" + Helper::toString(seat->getTeamIndex()) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(mFloodFillColor.size()))
-                + ", fullness=" + Helper::toString(getFullness()));
-        }
+    if(!isFloodFillIndexValid(seat, type))
         return NO_FLOODFILL;
-    }
 
-    const std::vector<uint32_t>& values = mFloodFillColor[seat->getTeamIndex()];
-    uint32_t intType = static_cast<uint32_t>(type);
-    if(intType >= values.size())
-    {
-        static bool logMsg = false;
-        if(!logMsg)
-        {
-            logMsg = true;
-            OD_LOG_ERR("Wrong floodfill seat index seatId=" + Helper::toString(seat->getId())
-                + ", tile=" + Tile::displayAsString(this)
-                + ", intType=" + Helper::toString(intType) + ", floodfillsize=" + Helper::toString(static_cast<uint32_t>(values.size())));
-        }
+    GameMap* gameMap = getGameMap();
+    uint32_t value = gameMap->getFloodFillColor(seat->getTeamIndex(), static_cast<uint32_t>(type), mX, mY);
+    if(value == NO_FLOODFILL)
         return NO_FLOODFILL;
-    }
-
-    return values.at(intType);
-}
 
-void Tile::setTeamsNumber(uint32_t nbTeams)
-{
-    mFloodFillColor = std::vector<std::vector<uint32_t>>(nbTeams, std::vector<uint32_t>(static_cast<uint32_t>(FloodFillType::nbValues), NO_FLOODFILL));
+    // The color may have been merged with another one since it was given to this tile
+    return gameMap->getFloodFillRoot(seat->getTeamIndex(), type, value);
 }
 
 bool Tile::shouldColorTileMesh() const
@@ -903,6 +919,12 @@ void Tile::setFullness(double f)
 
     mFullness = f;
 
+    if((oldFullness > 0.0) != (mFullness > 0.0))
+    {
+        getGameMap()->notifyTileOcclusionChanged(this);
+        getGameMap()->notifyTileJobsChanged(this);
+    }
+
     // If the tile was marked for digging and has been dug out, unmark it and set its fullness to 0.
     if (mFullness == 0.0 && isMarkedForDiggingByAnySeat())
     {
@@ -999,7 +1021,12 @@ void Tile::setCoveringBuilding(Building *building)
         // Set the tile as claimed and of the team color of the building
         setSeat(mCoveringBuilding->getSeat());
         mClaimedPercentage = 1.0;
+        getGameMap()->notifyTileClaimChanged(this);
     }
+
+    // Buildings like doors can block vision
+    getGameMap()->notifyTileOcclusionChanged(this);
+    getGameMap()->notifyTileJobsChanged(this);
 }
 
 bool Tile::isGroundClaimable(Seat* seat) const
@@ -1195,6 +1222,8 @@ bool Tile::addEntity(GameEntity *entity)
     }
 
     mEntitiesInTile.push_back(entity);
+    getGameMap()->getEntityGrid().addEntity(*entity, entity->getObjectType(), getX(), getY());
+    getGameMap()->notifyTileEntitiesChanged(this);
     if(!getGameMap()->isServerGameMap())
     {
         // On client side, we cull any movable entity that walks over a
@@ -1217,6 +1246,8 @@ void Tile::removeEntity(GameEntity *entity)
     }
 
     mEntitiesInTile.erase(it);
+    getGameMap()->getEntityGrid().removeEntity(*entity, entity->getObjectType(), getX(), getY());
+    getGameMap()->notifyTileEntitiesChanged(this);
     fireTileStateChanged();
 }
 
@@ -1242,7 +1273,12 @@ void Tile::claimForSeat(Seat* seat, double nDanceRate)
     }
     else
     {
+        // The tile stops counting as claimed for its seat as soon as it is not fully claimed
+        bool wasClaimed = isClaimed();
         mClaimedPercentage -= nDanceRate;
+        if(wasClaimed && !isClaimed())
+            getGameMap()->notifyTileClaimChanged(this);
+
         if (mClaimedPercentage <= 0.0)
         {
             // We notify the old seat that the tile is lost
@@ -1254,6 +1290,7 @@ void Tile::claimForSeat(Seat* seat, double nDanceRate)
             setSeat(seat);
             computeTileVisual();
             setDirtyForAllSeats();
+            getGameMap()->notifyTileClaimChanged(this);
         }
     }
 
@@ -1273,6 +1310,7 @@ void Tile::claimTile(Seat* seat)
     // We need this because if we are a client, the tile may be from a non allied seat
     setSeat(seat);
     mClaimedPercentage = 1.0;
+    getGameMap()->notifyTileClaimChanged(this);
 
     if(isFullTile())
         fireTileSound(TileSound::ClaimWall);
@@ -1308,6 +1346,7 @@ void Tile::unclaimTile()
 
     setSeat(nullptr);
     mClaimedPercentage = 0.0;
+    getGameMap()->notifyTileClaimChanged(this);
 
     computeTileVisual();
     setDirtyForAllSeats();
@@ -1706,25 +1745,26 @@ bool Tile::checkCoveringTrapType(TrapType type) const
     return (coveringTrap->getType() == type);
 }
 
-void Tile::computeVisibleTiles()
+void Tile::updateVision()
 {
-    if(!getGameMap()->getIsFOWActivated())
-    {
-        // If the FOW is deactivated, we allow vision for every seat
-        for(Seat* seat : getGameMap()->getSeats())
-            notifyVision(seat);
-
-        return;
-    }
-
-    if(!isClaimed())
+    Seat* seat = isClaimed() ? getSeat() : nullptr;
+    if(seat == mClaimedVisionSeat)
         return;
 
     // A claimed tile can see it self and its neighboors
-    notifyVision(getSeat());
-    for(Tile* tile : mNeighbors)
+    if(mClaimedVisionSeat != nullptr)
+    {
+        removeVision(mClaimedVisionSeat);
+        for(Tile* tile : mNeighbors)
+            tile->removeVision(mClaimedVisionSeat);
+    }
+
+    mClaimedVisionSeat = seat;
+    if(mClaimedVisionSeat != nullptr)
     {
-        tile->notifyVision(getSeat());
+        addVision(mClaimedVisionSeat);
+        for(Tile* tile : mNeighbors)
+            tile->addVision(mClaimedVisionSeat);
     }
 }
 
@@ -1737,11 +1777,15 @@ void Tile::setDirtyForAllSeats()
         seatChanged.second = true;
 }
 
-void Tile::notifyEntitiesSeatsWithVision()
+void Tile::notifyEntitiesSeatsWithVision(std::vector<Seat*>& seatsBuffer)
 {
+    if(mEntitiesInTile.empty())
+        return;
+
+    fillSeatsWithVision(seatsBuffer);
     for(GameEntity* entity : mEntitiesInTile)
     {
-        entity->notifySeatsWithVision(mSeatsWithVision);
+        entity->notifySeatsWithVision(seatsBuffer);
     }
 }
 
@@ -1958,6 +2002,23 @@ bool Tile::removeWorkerDigging(const Creature& worker, Tile& tile)
     return false;
 }
 
+bool Tile::hasFreeDigFace() const
+{
+    uint32_t nbWorkersMax = ConfigManager::getSingleton().getNbWorkersDigSameFaceTile();
+    for(uint32_t i = 0; (i < mNeighbors.size()) && (i < mNbWorkersDigging.size()); ++i)
+    {
+        if(mNeighbors[i]->isFullTile())
+            continue;
+
+        if(mNbWorkersDigging[i] >= nbWorkersMax)
+            continue;
+
+        return true;
+    }
+
+    return false;
+}
+
 void Tile::setTileCullingFlags(uint32_t mask, bool value)
 {
     // We save the current state. If the result is different, we refresh culling
@@ -366,21 +366,43 @@ public:
     //! Fills the given vector with corresponding entities on this tile.
     void fillWithEntities(std::vector<GameEntity*>& entities, SelectionEntityWanted entityWanted, Player* player);
 
-    //! \brief Computes the visible tiles and tags them to know which are visible
-    void computeVisibleTiles();
-    void clearVision();
-    void notifyVision(Seat* seat);
+    //! \brief If the tile is claimed, gives vision on itself and its neighbors to its seat. Only the changes since
+    //! the last call are applied. Should be called when the tile claimed state changes (see GameMap::notifyTileClaimChanged)
+    void updateVision();
+
+    //! \brief Adds a vision source on this tile for the given seat and its allies. The seats keep vision
+    //! on the tile until every source is removed with removeVision
+    void addVision(Seat* seat);
+    void removeVision(Seat* seat);
+
+    //! \brief Same as addVision/removeVision but for the given seat only (not its allies)
+    void addSeatVision(Seat* seat);
+    void removeSeatVision(Seat* seat);
+
+    inline bool getIsVisionDirty() const
+    { return mIsVisionDirty; }
+
+    inline void setIsVisionDirty(bool isVisionDirty)
+    { mIsVisionDirty = isVisionDirty; }
+
+    inline bool getIsOcclusionDirty() const
+    { return mIsOcclusionDirty; }
+
+    inline void setIsOcclusionDirty(bool isOcclusionDirty)
+    { mIsOcclusionDirty = isOcclusionDirty; }
 
     void setSeats(const std::vector<Seat*>& seats);
     bool hasChangedForSeat(Seat* seat) const;
     void changeNotifiedForSeat(Seat* seat);
 
-    void notifyEntitiesSeatsWithVision();
+    //! \brief Notifies the entities on this tile of the seats having vision on it. seatsBuffer is only used to
+    //! compute the seats and can be reused between calls to avoid allocating memory
+    void notifyEntitiesSeatsWithVision(std::vector<Seat*>& seatsBuffer);
 
-    const std::vector<Seat*>& getSeatsWithVision()
-    { return mSeatsWithVision; }
+    //! \brief Fills seats with the seats having vision on this tile (see GameMap::hasSeatVision)
+    void fillSeatsWithVision(std::vector<Seat*>& seats) const;
 
-    void resetFloodFill();
+    std::vector<Seat*> getSeatsWithVision() const;
 
     static std::string toString(FloodFillType type);
 
@@ -413,9 +435,6 @@ public:
     //! server and client
     bool isFullTile() const;
 
-    //! Sets the number of teams in this gamemap (after seat configuration). This number includes the rogue team.
-    void setTeamsNumber(uint32_t nbTeams);
-
     //! \brief returns true if the mesh from the tileset should be displayed and false otherwise
     inline bool shouldDisplayTileMesh() const
     { return mDisplayTileMesh; }
@@ -455,6 +474,9 @@ public:
     void canWorkerDig(const Creature& worker, std::vector<Tile*>& tiles);
     bool addWorkerDigging(const Creature& worker, Tile& tile);
     bool removeWorkerDigging(const Creature& worker, Tile& tile);
+    //! \brief Returns true if a ground neighbor can receive another digging worker. Unlike canWorkerDig,
+    //! reachability is not checked so that tiles already having enough workers can be skipped cheaply
+    bool hasFreeDigFace() const;
 
     static void exportToStream(Tile* tile, std::ostream& os);
 
@@ -507,16 +529,13 @@ private:
 
     std::vector<Tile*> mNeighbors;
     std::vector<const Player*> mPlayersMarkingTile;
+    //! TODO: move to a per seat layer in TileContainer like the vision (see TileContainer::mSeatsVisionBits)
     std::vector<std::pair<Seat*, bool>> mTileChangedForSeats;
-    std::vector<Seat*> mSeatsWithVision;
 
     //! \brief List of the entities actually on this tile. Most of the creatures actions will rely on this list
     std::vector<GameEntity*> mEntitiesInTile;
 
     Building* mCoveringBuilding;
-    //! Floodfill values per seat and per floodfill type
-    std::vector<std::vector<uint32_t>> mFloodFillColor;
-
     //! \brief The tile claiming. Used on server side only
     double mClaimedPercentage;
 
@@ -543,14 +562,32 @@ private:
     inline void setFullnessValue(double f)
     { mFullness = f; }
 
+    //! \brief Returns true if the floodfill layers of the game map have a value for the given seat team and type.
+    //! Logs an error otherwise
+    bool isFloodFillIndexValid(Seat* seat, FloodFillType type) const;
+
+    //! \brief Returns true if the vision layers of the game map have a value for the given seat.
+    //! Logs an error otherwise
+    bool isVisionIndexValid(Seat* seat) const;
+
     void setDirtyForAllSeats();
 
     //! \brief Vector with the number of workers digging the tile. The index corresponds
     //! to the index in mNeighbors
+    //! TODO: move to a layer in TileContainer like the claim owners (see TileContainer::mClaimOwners)
     std::vector<uint32_t> mNbWorkersDigging;
     uint32_t mNbWorkersClaiming;
     std::vector<TileStateListener*> mStateListeners;
 
+    //! \brief Seat this tile gives vision to because it is claimed (see updateVision)
+    Seat* mClaimedVisionSeat;
+
+    //! \brief True if the tile is waiting in GameMap for its vision to be updated
+    bool mIsVisionDirty;
+
+    //! \brief True if the tile is waiting in GameMap for the creatures around to compute their vision again
+    bool mIsOcclusionDirty;
+
     void fireTileStateChanged();
 };
 
@@ -399,7 +399,7 @@ void Player::notifyNoMoreDungeonTemple()
 
             seats.push_back(seat);
 
-            ServerNotification *serverNotification = new ServerNotification(
+            ServerNotification *serverNotification = ServerNotification::create(
                 ServerNotificationType::chatServer, seat->getPlayer());
             serverNotification->mPacket << "You lost the game" << EventShortNoticeType::majorGameEvent;
             ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -421,7 +421,7 @@ void Player::notifyNoMoreDungeonTemple()
             if(this == seat->getPlayer())
             {
                 // For the current player, we send the defeat message
-                ServerNotification *serverNotification = new ServerNotification(
+                ServerNotification *serverNotification = ServerNotification::create(
                     ServerNotificationType::chatServer, seat->getPlayer());
                 serverNotification->mPacket << "You lost" << EventShortNoticeType::majorGameEvent;
                 ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -432,7 +432,7 @@ void Player::notifyNoMoreDungeonTemple()
 
             seats.push_back(seat);
 
-            ServerNotification *serverNotification = new ServerNotification(
+            ServerNotification *serverNotification = ServerNotification::create(
                 ServerNotificationType::chatServer, seat->getPlayer());
             serverNotification->mPacket << "An ally has lost" << EventShortNoticeType::majorGameEvent;
             ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -463,7 +463,7 @@ void Player::notifyTeamFighting(Player* player, Tile* tile)
 
     if(isFirstFight)
     {
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::playerFighting, this);
         serverNotification->mPacket << player->getId();
         ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -485,7 +485,7 @@ void Player::notifyNoSkillInQueue()
         mNoSkillInQueueTime = NO_RESEARCH_TIME_COUNT;
 
         std::string chatMsg = "Your skill queue is empty, while there are still skills that could be unlocked.";
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::chatServer, this);
         serverNotification->mPacket << chatMsg << EventShortNoticeType::genericGameInfo;
         ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -500,7 +500,7 @@ void Player::notifyNoWorker()
     mNoWorkerTime = NO_WORKER_TIME_COUNT;
 
     std::string chatMsg = "You have no worker to fulfill your dark wishes.";
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::chatServer, this);
     serverNotification->mPacket << chatMsg << EventShortNoticeType::genericGameInfo;
     ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -513,7 +513,7 @@ void Player::notifyNoTreasuryAvailable()
         mNoTreasuryAvailableTime = NO_TREASURY_TIME_COUNT;
 
         std::string chatMsg = "No treasury available. You should build a bigger one.";
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::chatServer, this);
         serverNotification->mPacket << chatMsg << EventShortNoticeType::genericGameInfo;
         ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -527,7 +527,7 @@ void Player::notifyCreatureCannotFindBed(Creature& creature)
         mCreatureCannotFindBed = CREATURE_CANNOT_FIND_BED_TIME_COUNT;
 
         std::string chatMsg = creature.getName() + " cannot find room for a bed";
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::chatServer, this);
         serverNotification->mPacket << chatMsg << EventShortNoticeType::genericGameInfo;
         ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -545,7 +545,7 @@ void Player::notifyCreatureCannotFindFood(Creature& creature)
         mCreatureCannotFindFood = CREATURE_CANNOT_FIND_FOOD_TIME_COUNT;
 
         std::string chatMsg = creature.getName() + " cannot find food";
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::chatServer, this);
         serverNotification->mPacket << chatMsg << EventShortNoticeType::genericGameInfo;
         ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -562,7 +562,7 @@ void Player::fireEvents()
     if(!mGameMap->isServerGameMap())
         return;
 
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::playerEvents, this);
     uint32_t nbItems = mEvents.size();
     serverNotification->mPacket << nbItems;
@@ -637,7 +637,7 @@ void Player::markTilesForDigging(bool marked, const std::vector<Tile*>& tiles, b
     // On client side, we ask to mark the tile
     if(!asyncMsg)
     {
-        ServerNotification* serverNotification = new ServerNotification(
+        ServerNotification* serverNotification = ServerNotification::create(
             ServerNotificationType::markTiles, this);
         uint32_t nbTiles = tilesMark.size();
         serverNotification->mPacket << marked << nbTiles;
@@ -703,7 +703,7 @@ void Player::upkeepPlayer(double timeSinceLastUpkeep)
     if(wasFightHappening && !isFightHappening)
     {
         // Notify the player he is no longer under attack.
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::playerNoMoreFighting, this);
         ODServer::getSingleton().queueServerNotification(serverNotification);
     }
@@ -780,7 +780,7 @@ void Player::setSpellCooldownTurns(SpellType spellType, uint32_t cooldown)
 
     if(mGameMap->isServerGameMap() && getIsHuman())
     {
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::setSpellCooldown, this);
         serverNotification->mPacket << spellType << cooldown;
         ODServer::getSingleton().queueServerNotification(serverNotification);
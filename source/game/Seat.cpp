@@ -23,6 +23,7 @@
 #include "entities/GameEntityType.h"
 #include "entities/Tile.h"
 #include "game/Player.h"
+#include "game/SeatJobBoard.h"
 #include "game/Skill.h"
 #include "game/SkillManager.h"
 #include "game/SkillType.h"
@@ -41,8 +42,10 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/MakeUnique.h"
 #include "utils/Random.h"
 
+#include <algorithm>
 #include <istream>
 #include <ostream>
 
@@ -62,6 +65,7 @@ TileStateNotified::TileStateNotified():
     mMarkedForDigging(false),
     mVisionTurnLast(false),
     mVisionTurnCurrent(false),
+    mVisionChanged(false),
     mBuilding(nullptr)
 {
 }
@@ -72,7 +76,10 @@ Seat::Seat(GameMap* gameMap) :
     mPlayer(nullptr),
     mGoldMined(0),
     mDefaultWorkerClass(nullptr),
+    mTilesStatesSizeX(0),
+    mTilesStatesSizeY(0),
     mTeamIndex(0),
+    mSeatIndex(0),
     mIsDebuggingVision(false),
     mSkillPoints(0),
     mCurrentSkill(nullptr),
@@ -80,7 +87,13 @@ Seat::Seat(GameMap* gameMap) :
     mConfigPlayerId(-1),
     mConfigTeamId(-1),
     mConfigFactionIndex(-1),
-    mKoCreatures(false)
+    mKoCreatures(false),
+    mTreasuryGold(0),
+    mTreasuryGoldMax(0)
+{
+}
+
+Seat::~Seat()
 {
 }
 
@@ -225,43 +238,26 @@ void Seat::addAlliedSeat(Seat* seat)
     mAlliedSeats.push_back(seat);
 }
 
-void Seat::clearTilesWithVision()
+void Seat::notifyVisionOnTile(Tile* tile, bool hasVision)
 {
     if(mPlayer == nullptr)
         return;
     if(!mPlayer->getIsHuman())
         return;
 
-    for(std::vector<TileStateNotified>& vec : mTilesStates)
-    {
-        for(TileStateNotified& p : vec)
-        {
-            p.mVisionTurnLast = p.mVisionTurnCurrent;
-            p.mVisionTurnCurrent = false;
-        }
-    }
-}
-
-void Seat::notifyVisionOnTile(Tile* tile)
-{
-    if(mPlayer == nullptr)
-        return;
-    if(!mPlayer->getIsHuman())
-        return;
-
-    if(tile->getX() >= static_cast<int>(mTilesStates.size()))
+    if((tile->getX() >= mTilesStatesSizeX) || (tile->getY() >= mTilesStatesSizeY))
     {
         OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
         return;
     }
-    if(tile->getY() >= static_cast<int>(mTilesStates[tile->getX()].size()))
-    {
-        OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
+
+    TileStateNotified& tileState = mTilesStates[getTileStateIndex(tile->getX(), tile->getY())];
+    tileState.mVisionTurnCurrent = hasVision;
+    if(tileState.mVisionChanged)
         return;
-    }
 
-    TileStateNotified& tileState = mTilesStates[tile->getX()][tile->getY()];
-    tileState.mVisionTurnCurrent = true;
+    tileState.mVisionChanged = true;
+    mTilesVisionChanged.push_back(tile);
 }
 
 void Seat::notifyTileClaimedByEnemy(Tile* tile)
@@ -271,23 +267,31 @@ void Seat::notifyTileClaimedByEnemy(Tile* tile)
     if(!mPlayer->getIsHuman())
         return;
 
-    if(tile->getX() >= static_cast<int>(mTilesStates.size()))
-    {
-        OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
-        return;
-    }
-    if(tile->getY() >= static_cast<int>(mTilesStates[tile->getX()].size()))
+    if((tile->getX() >= mTilesStatesSizeX) || (tile->getY() >= mTilesStatesSizeY))
     {
         OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
         return;
     }
 
-    TileStateNotified& tileState = mTilesStates[tile->getX()][tile->getY()];
+    TileStateNotified& tileState = mTilesStates[getTileStateIndex(tile->getX(), tile->getY())];
 
     // By default, we set the tile like if it was not claimed anymore
     tileState.mSeatIdOwner = -1;
     tileState.mTileVisual = TileVisual::dirtGround;
-    tileState.mVisionTurnCurrent = true;
+
+    if(std::find(mTilesTemporaryVision.begin(), mTilesTemporaryVision.end(), tile) != mTilesTemporaryVision.end())
+        return;
+
+    tile->addSeatVision(this);
+    mTilesTemporaryVision.push_back(tile);
+}
+
+void Seat::clearTemporaryVision()
+{
+    for(Tile* tile : mTilesTemporaryVision)
+        tile->removeSeatVision(this);
+
+    mTilesTemporaryVision.clear();
 }
 
 const std::string Seat::getFactionFromLine(const std::string& line)
@@ -344,20 +348,16 @@ bool Seat::hasVisionOnTile(Tile* tile)
     if(!mPlayer->getIsHuman())
         return true;
 
-    if(tile->getX() >= static_cast<int>(mTilesStates.size()))
-    {
-        OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
-        return false;
-    }
-    if(tile->getY() >= static_cast<int>(mTilesStates[tile->getX()].size()))
+    if((tile->getX() >= mTilesStatesSizeX) || (tile->getY() >= mTilesStatesSizeY))
     {
         OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
         return false;
     }
 
-    TileStateNotified& stateTile = mTilesStates[tile->getX()][tile->getY()];
+    if(mSeatIndex >= mGameMap->getNbVisionSeats())
+        return false;
 
-    return stateTile.mVisionTurnCurrent;
+    return mGameMap->hasSeatVision(mSeatIndex, tile->getX(), tile->getY());
 }
 
 void Seat::initSeat()
@@ -439,7 +439,7 @@ void Seat::initSeat()
 
         if(!tilesRefresh.empty())
         {
-            ServerNotification *serverNotification = new ServerNotification(
+            ServerNotification *serverNotification = ServerNotification::create(
                 ServerNotificationType::refreshTiles, getPlayer());
             uint32_t nbTiles = tilesRefresh.size();
             serverNotification->mPacket << nbTiles;
@@ -450,17 +450,12 @@ void Seat::initSeat()
 
                 // We set the tile visual to make sure the tile state is exported if
                 // game is saved again
-                if(tile->getX() >= static_cast<int>(mTilesStates.size()))
+                if((tile->getX() >= mTilesStatesSizeX) || (tile->getY() >= mTilesStatesSizeY))
                 {
                     OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
                     continue;
                 }
-                if(tile->getY() >= static_cast<int>(mTilesStates[tile->getX()].size()))
-                {
-                    OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
-                    continue;
-                }
-                mTilesStates[tile->getX()][tile->getY()] = tileState;
+                mTilesStates[getTileStateIndex(tile->getX(), tile->getY())] = tileState;
 
                 // Then, we export tile state to the client
                 mGameMap->tileToPacket(serverNotification->mPacket, tile);
@@ -473,6 +468,14 @@ void Seat::initSeat()
     }
 }
 
+SeatJobBoard& Seat::getJobBoard()
+{
+    if(mJobBoard == nullptr)
+        mJobBoard = Utils::make_unique<SeatJobBoard>(*mGameMap, *this);
+
+    return *mJobBoard;
+}
+
 void Seat::setMapSize(int x, int y)
 {
     if(mPlayer == nullptr)
@@ -480,7 +483,11 @@ void Seat::setMapSize(int x, int y)
     if(!mPlayer->getIsHuman())
         return;
 
-    mTilesStates = std::vector<std::vector<TileStateNotified>>(x, std::vector<TileStateNotified>(y));
+    mTilesStatesSizeX = x;
+    mTilesStatesSizeY = y;
+    mTilesStates.assign(x * y, TileStateNotified());
+    mTilesVisionChanged.clear();
+    mTilesTemporaryVision.clear();
     // By default, we know that rock (ground & full) will be set as rock full tiles,
     // gold (ground & full) will be set as gold full tiles,
     // other tiles will be set as dirt full tiles
@@ -494,17 +501,17 @@ void Seat::setMapSize(int x, int y)
 
             if(tile->getType() == TileType::gold)
             {
-                mTilesStates[xxx][yyy].mTileVisual = TileVisual::goldFull;
+                mTilesStates[getTileStateIndex(xxx, yyy)].mTileVisual = TileVisual::goldFull;
                 continue;
             }
 
             if(tile->getType() == TileType::rock)
             {
-                mTilesStates[xxx][yyy].mTileVisual = TileVisual::rockFull;
+                mTilesStates[getTileStateIndex(xxx, yyy)].mTileVisual = TileVisual::rockFull;
                 continue;
             }
 
-            mTilesStates[xxx][yyy].mTileVisual = TileVisual::dirtFull;
+            mTilesStates[getTileStateIndex(xxx, yyy)].mTileVisual = TileVisual::dirtFull;
         }
     }
 }
@@ -536,7 +543,7 @@ unsigned int Seat::checkAllGoals()
                getPlayer()->getIsHuman() &&
                !getPlayer()->getHasLost())
             {
-                ServerNotification *serverNotification = new ServerNotification(
+                ServerNotification *serverNotification = ServerNotification::create(
                     ServerNotificationType::chatServer, getPlayer());
 
                 serverNotification->mPacket << "You have met an objective." << EventShortNoticeType::aboutObjectives;
@@ -567,7 +574,7 @@ unsigned int Seat::checkAllGoals()
                    getPlayer()->getIsHuman() &&
                    !getPlayer()->getHasLost())
                 {
-                    ServerNotification *serverNotification = new ServerNotification(
+                    ServerNotification *serverNotification = ServerNotification::create(
                         ServerNotificationType::chatServer, getPlayer());
 
                     serverNotification->mPacket << "You have FAILED an objective!" << EventShortNoticeType::majorGameEvent;
@@ -603,13 +610,11 @@ void Seat::notifyChangedVisibleTiles()
         return;
 
     std::vector<Tile*> tilesToNotify;
-    int xMax = static_cast<int>(mTilesStates.size());
-    for(int xxx = 0; xxx < xMax; ++xxx)
+    for(int yyy = 0; yyy < mTilesStatesSizeY; ++yyy)
     {
-        int yMax = static_cast<int>(mTilesStates[xxx].size());
-        for(int yyy = 0; yyy < yMax; ++yyy)
+        for(int xxx = 0; xxx < mTilesStatesSizeX; ++xxx)
         {
-            if(!mTilesStates[xxx][yyy].mVisionTurnCurrent)
+            if(!mTilesStates[getTileStateIndex(xxx, yyy)].mVisionTurnCurrent)
                 continue;
 
             Tile* tile = mGameMap->getTile(xxx, yyy);
@@ -624,13 +629,12 @@ void Seat::notifyChangedVisibleTiles()
     if(tilesToNotify.empty())
         return;
 
-    uint32_t nbTiles = tilesToNotify.size();
-    ServerNotification *serverNotification = new ServerNotification(
+    // The tiles are sent as a set followed by the data of each tile in the same order
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::refreshTiles, getPlayer());
-    serverNotification->mPacket << nbTiles;
+    mGameMap->tilesToPacket(serverNotification->mPacket, tilesToNotify);
     for(Tile* tile : tilesToNotify)
     {
-        mGameMap->tileToPacket(serverNotification->mPacket, tile);
         updateTileStateForSeat(tile, false);
         tile->exportToPacketForUpdate(serverNotification->mPacket, this);
     }
@@ -709,13 +713,11 @@ void Seat::refreshSeatVisualDebug()
     if(mIsDebuggingVision)
     {
         std::vector<Tile*> tiles;
-        int xMax = static_cast<int>(mTilesStates.size());
-        for(int xxx = 0; xxx < xMax; ++xxx)
+        for(int yyy = 0; yyy < mTilesStatesSizeY; ++yyy)
         {
-            int yMax = static_cast<int>(mTilesStates[xxx].size());
-            for(int yyy = 0; yyy < yMax; ++yyy)
+            for(int xxx = 0; xxx < mTilesStatesSizeX; ++xxx)
             {
-                if(!mTilesStates[xxx][yyy].mVisionTurnCurrent)
+                if(!mTilesStates[getTileStateIndex(xxx, yyy)].mVisionTurnCurrent)
                     continue;
 
                 Tile* tile = mGameMap->getTile(xxx, yyy);
@@ -723,7 +725,7 @@ void Seat::refreshSeatVisualDebug()
             }
         }
         uint32_t nbTiles = tiles.size();
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::refreshSeatVisDebug, nullptr);
         serverNotification->mPacket << seatId;
         serverNotification->mPacket << true;
@@ -736,7 +738,7 @@ void Seat::refreshSeatVisualDebug()
     }
     else
     {
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::refreshSeatVisDebug, nullptr);
         serverNotification->mPacket << seatId;
         serverNotification->mPacket << false;
@@ -755,50 +757,37 @@ void Seat::sendVisibleTiles()
     if(!getPlayer()->getIsHuman())
         return;
 
-    uint32_t nbTiles;
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::refreshVisibleTiles, getPlayer());
     std::vector<Tile*> tilesVisionGained;
     std::vector<Tile*> tilesVisionLost;
-    // Tiles we gained vision
-    int xMax = static_cast<int>(mTilesStates.size());
-    for(int xxx = 0; xxx < xMax; ++xxx)
+    // We only check the tiles where vision changed since the last call. Note that vision may have
+    // been lost and gained again in the meantime
+    for(Tile* tile : mTilesVisionChanged)
     {
-        int yMax = static_cast<int>(mTilesStates[xxx].size());
-        for(int yyy = 0; yyy < yMax; ++yyy)
-        {
-            if(mTilesStates[xxx][yyy].mVisionTurnCurrent == mTilesStates[xxx][yyy].mVisionTurnLast)
-                continue;
+        TileStateNotified& tileState = mTilesStates[getTileStateIndex(tile->getX(), tile->getY())];
+        tileState.mVisionChanged = false;
+        if(tileState.mVisionTurnCurrent == tileState.mVisionTurnLast)
+            continue;
 
-            Tile* tile = mGameMap->getTile(xxx, yyy);
-            if(mTilesStates[xxx][yyy].mVisionTurnCurrent)
-            {
-                // Vision gained
-                tilesVisionGained.push_back(tile);
-            }
-            else
-            {
-                // Vision lost
-                tilesVisionLost.push_back(tile);
-            }
+        tileState.mVisionTurnLast = tileState.mVisionTurnCurrent;
+        if(tileState.mVisionTurnCurrent)
+        {
+            // Vision gained
+            tilesVisionGained.push_back(tile);
+        }
+        else
+        {
+            // Vision lost
+            tilesVisionLost.push_back(tile);
         }
     }
+    mTilesVisionChanged.clear();
 
-    // Notify tiles we gained vision
-    nbTiles = tilesVisionGained.size();
-    serverNotification->mPacket << nbTiles;
-    for(Tile* tile : tilesVisionGained)
-    {
-        mGameMap->tileToPacket(serverNotification->mPacket, tile);
-    }
-
-    // Notify tiles we lost vision
-    nbTiles = tilesVisionLost.size();
-    serverNotification->mPacket << nbTiles;
-    for(Tile* tile : tilesVisionLost)
-    {
-        mGameMap->tileToPacket(serverNotification->mPacket, tile);
-    }
+    // Notify tiles we gained vision then tiles we lost vision. Vision usually changes on
+    // whole areas so the tile sets are compact
+    mGameMap->tilesToPacket(serverNotification->mPacket, tilesVisionGained);
+    mGameMap->tilesToPacket(serverNotification->mPacket, tilesVisionLost);
     ODServer::getSingleton().queueServerNotification(serverNotification);
 }
 
@@ -807,21 +796,15 @@ void Seat::computeSeatBeginTurn()
     if(mPlayer != nullptr)
     {
         std::fill(mNbRooms.begin(), mNbRooms.end(), 0);
-        for(Room* room : mGameMap->getRooms())
+        for(uint32_t index = 0; index < mNbRooms.size(); ++index)
         {
-            if(room->getSeat() != this)
-                continue;
-
-            if(room->getHP(nullptr) <= 0.0)
-                continue;
-
-            uint32_t index = static_cast<uint32_t>(room->getType());
-            if(index >= mNbRooms.size())
+            for(Room* room : mGameMap->getRoomsOfSeat(this, static_cast<RoomType>(index)))
             {
-                OD_LOG_ERR("wrong index=" + Helper::toString(index) + ", size=" + Helper::toString(mNbRooms.size()));
-                return;
+                if(room->getHP(nullptr) <= 0.0)
+                    continue;
+
+                ++mNbRooms[index];
             }
-            ++mNbRooms[index];
         }
     }
 }
@@ -1246,11 +1229,11 @@ bool Seat::exportSeatToStream(std::ostream& os) const
     }
 
     os << "[markedTiles]" << std::endl;
-    for(uint32_t xxx = 0; xxx < mTilesStates.size(); ++xxx)
+    for(int xxx = 0; xxx < mTilesStatesSizeX; ++xxx)
     {
-        for(uint32_t yyy = 0; yyy < mTilesStates[xxx].size(); ++yyy)
+        for(int yyy = 0; yyy < mTilesStatesSizeY; ++yyy)
         {
-            const TileStateNotified& tileState = mTilesStates[xxx][yyy];
+            const TileStateNotified& tileState = mTilesStates[getTileStateIndex(xxx, yyy)];
             if(!tileState.mMarkedForDigging)
                 continue;
 
@@ -1266,11 +1249,11 @@ void Seat::exportTilesVisualInitialStates(TileVisual tileVisual, std::ostream& o
 {
     os << "[" + Tile::tileVisualToString(tileVisual) + "]" << std::endl;
 
-    for(uint32_t xxx = 0; xxx < mTilesStates.size(); ++xxx)
+    for(int xxx = 0; xxx < mTilesStatesSizeX; ++xxx)
     {
-        for(uint32_t yyy = 0; yyy < mTilesStates[xxx].size(); ++yyy)
+        for(int yyy = 0; yyy < mTilesStatesSizeY; ++yyy)
         {
-            const TileStateNotified& tileState = mTilesStates[xxx][yyy];
+            const TileStateNotified& tileState = mTilesStates[getTileStateIndex(xxx, yyy)];
             if(tileState.mTileVisual != tileVisual)
                 continue;
 
@@ -1295,7 +1278,7 @@ bool Seat::addSkill(SkillType type)
        getPlayer()->getIsHuman() &&
        !getPlayer()->getHasLost())
     {
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::chatServer, getPlayer());
 
         std::string msg = Skills::skillTypeToPlayerVisibleString(type) + " is now available.";
@@ -1452,7 +1435,7 @@ void Seat::setSkillsDone(const std::vector<SkillType>& skills)
         if((getPlayer() != nullptr) && getPlayer()->getIsHuman())
         {
             // We notify the client
-            ServerNotification *serverNotification = new ServerNotification(
+            ServerNotification *serverNotification = ServerNotification::create(
                 ServerNotificationType::skillsDone, getPlayer());
 
             uint32_t nbItems = mSkillDone.size();
@@ -1511,7 +1494,7 @@ void Seat::setSkillTree(const std::vector<SkillType>& skills)
         if((getPlayer() != nullptr) && getPlayer()->getIsHuman())
         {
             // We notify the client
-            ServerNotification *serverNotification = new ServerNotification(
+            ServerNotification *serverNotification = ServerNotification::create(
                 ServerNotificationType::skillTree, getPlayer());
 
             uint32_t nbItems = mSkillPending.size();
@@ -1537,18 +1520,13 @@ void Seat::setSkillTree(const std::vector<SkillType>& skills)
 
 void Seat::updateTileStateForSeat(Tile* tile, bool hideSeatId)
 {
-    if(tile->getX() >= static_cast<int>(mTilesStates.size()))
-    {
-        OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
-        return;
-    }
-    if(tile->getY() >= static_cast<int>(mTilesStates[tile->getX()].size()))
+    if((tile->getX() >= mTilesStatesSizeX) || (tile->getY() >= mTilesStatesSizeY))
     {
         OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
         return;
     }
 
-    TileStateNotified& tileState = mTilesStates[tile->getX()][tile->getY()];
+    TileStateNotified& tileState = mTilesStates[getTileStateIndex(tile->getX(), tile->getY())];
     tileState.mTileVisual = tile->getTileVisual();
     switch(tileState.mTileVisual)
     {
@@ -1610,18 +1588,13 @@ void Seat::setVisibleBuildingOnTile(Building* building, Tile* tile)
     if(!getPlayer()->getIsHuman())
         return;
 
-    if(tile->getX() >= static_cast<int>(mTilesStates.size()))
-    {
-        OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
-        return;
-    }
-    if(tile->getY() >= static_cast<int>(mTilesStates[tile->getX()].size()))
+    if((tile->getX() >= mTilesStatesSizeX) || (tile->getY() >= mTilesStatesSizeY))
     {
         OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
         return;
     }
 
-    TileStateNotified& tileState = mTilesStates[tile->getX()][tile->getY()];
+    TileStateNotified& tileState = mTilesStates[getTileStateIndex(tile->getX(), tile->getY())];
 
     if(building == tileState.mBuilding)
         return;
@@ -1644,18 +1617,13 @@ void Seat::exportTileToPacket(ODPacket& os, const Tile* tile,
         return;
     }
 
-    if(tile->getX() >= static_cast<int>(mTilesStates.size()))
-    {
-        OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
-        return;
-    }
-    if(tile->getY() >= static_cast<int>(mTilesStates[tile->getX()].size()))
+    if((tile->getX() >= mTilesStatesSizeX) || (tile->getY() >= mTilesStatesSizeY))
     {
         OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
         return;
     }
 
-    const TileStateNotified& tileState = mTilesStates[tile->getX()][tile->getY()];
+    const TileStateNotified& tileState = mTilesStates[getTileStateIndex(tile->getX(), tile->getY())];
 
     int tileSeatId = -1;
     // We only pass the tile seat to the client if the tile is fully claimed
@@ -1738,18 +1706,13 @@ void Seat::notifyBuildingRemovedFromGameMap(Building* building, Tile* tile)
     if(!getPlayer()->getIsHuman())
         return;
 
-    if(tile->getX() >= static_cast<int>(mTilesStates.size()))
-    {
-        OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
-        return;
-    }
-    if(tile->getY() >= static_cast<int>(mTilesStates[tile->getX()].size()))
+    if((tile->getX() >= mTilesStatesSizeX) || (tile->getY() >= mTilesStatesSizeY))
     {
         OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
         return;
     }
 
-    TileStateNotified& tileState = mTilesStates[tile->getX()][tile->getY()];
+    TileStateNotified& tileState = mTilesStates[getTileStateIndex(tile->getX(), tile->getY())];
     if(tileState.mBuilding == building)
         tileState.mBuilding = nullptr;
 }
@@ -1761,18 +1724,13 @@ void Seat::tileMarkedDiggingNotifiedToPlayer(Tile* tile, bool isDigSet)
     if(!getPlayer()->getIsHuman())
         return;
 
-    if(tile->getX() >= static_cast<int>(mTilesStates.size()))
-    {
-        OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
-        return;
-    }
-    if(tile->getY() >= static_cast<int>(mTilesStates[tile->getX()].size()))
+    if((tile->getX() >= mTilesStatesSizeX) || (tile->getY() >= mTilesStatesSizeY))
     {
         OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
         return;
     }
 
-    TileStateNotified& tileState = mTilesStates[tile->getX()][tile->getY()];
+    TileStateNotified& tileState = mTilesStates[getTileStateIndex(tile->getX(), tile->getY())];
     tileState.mMarkedForDigging = isDigSet;
 }
 
@@ -1780,18 +1738,13 @@ bool Seat::isTileDiggableForClient(Tile* tile) const
 {
     if(!getPlayer()->getIsHuman())
         return false;
-    if(tile->getX() >= static_cast<int>(mTilesStates.size()))
-    {
-        OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
-        return false;
-    }
-    if(tile->getY() >= static_cast<int>(mTilesStates[tile->getX()].size()))
+    if((tile->getX() >= mTilesStatesSizeX) || (tile->getY() >= mTilesStatesSizeY))
     {
         OD_LOG_ERR("Tile=" + Tile::displayAsString(tile));
         return false;
     }
 
-    const TileStateNotified& tileState = mTilesStates[tile->getX()][tile->getY()];
+    const TileStateNotified& tileState = mTilesStates[getTileStateIndex(tile->getX(), tile->getY())];
     // Handle non claimed
     switch(tileState.mTileVisual)
     {
@@ -1935,7 +1888,7 @@ void Seat::setPlayerSettings(bool koCreatures)
         return;
 
     // We send a message to the client to update his settings
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::setPlayerSettings, getPlayer());
 
     serverNotification->mPacket << mKoCreatures;
@@ -22,6 +22,7 @@
 
 #include <OgreVector3.h>
 #include <OgreColourValue.h>
+#include <memory>
 #include <string>
 #include <vector>
 #include <iosfwd>
@@ -36,6 +37,7 @@ class CreatureDefinition;
 class Player;
 class Skill;
 class Seat;
+class SeatJobBoard;
 class Tile;
 
 enum class KeeperAIType;
@@ -54,8 +56,11 @@ public:
     TileVisual mTileVisual;
     int mSeatIdOwner;
     bool mMarkedForDigging;
+    //! \brief Vision last sent to the player (see Seat::sendVisibleTiles)
     bool mVisionTurnLast;
     bool mVisionTurnCurrent;
+    //! \brief True if the tile is in Seat::mTilesVisionChanged
+    bool mVisionChanged;
     Building* mBuilding;
 };
 
@@ -66,6 +71,7 @@ public:
     friend class ODClient;
     // Constructors
     Seat(GameMap* gameMap);
+    ~Seat();
 
     inline Player* getPlayer() const
     { return mPlayer; }
@@ -129,6 +135,12 @@ public:
     inline void setTeamIndex(uint32_t index)
     { mTeamIndex = index; }
 
+    inline uint32_t getSeatIndex() const
+    { return mSeatIndex; }
+
+    inline void setSeatIndex(uint32_t index)
+    { mSeatIndex = index; }
+
     inline int32_t getConfigPlayerId() const
     { return mConfigPlayerId; }
 
@@ -184,6 +196,10 @@ public:
 
     void setMapSize(int x, int y);
 
+    //! \brief Server side function. Returns the jobs available for the workers of this seat. The board
+    //! is built when first used (the map should be loaded)
+    SeatJobBoard& getJobBoard();
+
     //! \brief Returns the next fighter creature class to spawn.
     const CreatureDefinition* getNextFighterClassToSpawn(const GameMap& gameMap, const ConfigManager& configManager );
 
@@ -200,10 +216,16 @@ public:
     bool canOwnedCreatureUseRoomFrom(const Seat* seat) const;
     bool canBuildingBeDestroyedBy(const Seat* seat) const;
 
-    void clearTilesWithVision();
-    void notifyVisionOnTile(Tile* tile);
+    //! \brief Called by the tile when this seat gains or loses vision on it
+    void notifyVisionOnTile(Tile* tile, bool hasVision);
+
+    //! \brief Gives vision until the next call to clearTemporaryVision so that the player is notified
+    //! that the tile is not claimed anymore
     void notifyTileClaimedByEnemy(Tile* tile);
 
+    //! \brief Removes the vision given by notifyTileClaimedByEnemy
+    void clearTemporaryVision();
+
     //! \brief Returns true if this seat can see the given tile and false otherwise
     bool hasVisionOnTile(Tile* tile);
 
@@ -356,19 +378,37 @@ private:
     //! \brief The default workers spawned in temples.
     const CreatureDefinition* mDefaultWorkerClass;
 
-    //! \brief List of all the tiles in the gamemap (used for human players seats only). The first vector stores the X position.
-    //! The second vector stores the Y position. TileStateNotified contains information about the tile
+    //! \brief List of all the tiles in the gamemap (used for human players seats only) stored contiguously
+    //! (see getTileStateIndex). TileStateNotified contains information about the tile
     //! state (last tile state notified, vision last turn for this seat, vision for current turn, ...
-    std::vector<std::vector<TileStateNotified>> mTilesStates;
+    std::vector<TileStateNotified> mTilesStates;
+    int mTilesStatesSizeX;
+    int mTilesStatesSizeY;
+
+    inline uint32_t getTileStateIndex(int x, int y) const
+    { return static_cast<uint32_t>(y * mTilesStatesSizeX + x); }
 
     std::map<std::pair<int, int>, TileStateNotified> mTilesStateLoaded;
 
+    //! \brief Tiles where the vision changed since the last call to sendVisibleTiles
+    std::vector<Tile*> mTilesVisionChanged;
+
+    //! \brief Tiles where vision is given by notifyTileClaimedByEnemy
+    std::vector<Tile*> mTilesTemporaryVision;
+
     std::vector<Tile*> mVisualDebugEntityTiles;
 
+    //! \brief Jobs available for the workers. Kept up to date by the gamemap once built (see getJobBoard)
+    std::unique_ptr<SeatJobBoard> mJobBoard;
+
     //! \brief Index of the team in the gamemap (from 0 to N). Must be set when the seat is added to the gamemap
     //! and never changed after
     uint32_t mTeamIndex;
 
+    //! \brief Index of the seat in the gamemap seats. Set when the seat is added to the gamemap. It is used to
+    //! access the seat layers of the gamemap (claim owners, vision)
+    uint32_t mSeatIndex;
+
     bool mIsDebuggingVision;
 
     //! \brief Counter for skill points
@@ -395,6 +435,11 @@ private:
     //! \brief Should the creatures fight to death or ko enemy creatures
     bool mKoCreatures;
 
+    //! \brief Gold stored and maximum gold storable in the treasuries of this seat. Kept up to date by the
+    //! gamemap each time a treasury changes and copied to mGold/mGoldMax at the beginning of each turn
+    int mTreasuryGold;
+    int mTreasuryGoldMax;
+
     //! \brief Server side function. Sets mCurrentSkill to the first entry in mSkillPending. If the pending
     //! list in empty, mCurrentSkill will be set to null
     //! researchedType is the currently researched type if any (nullSkillType if none)
@@ -0,0 +1,283 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "game/SeatJobBoard.h"
+
+#include "entities/Creature.h"
+#include "entities/CreatureDefinition.h"
+#include "entities/GameEntityType.h"
+#include "entities/Tile.h"
+#include "game/Player.h"
+#include "game/Seat.h"
+#include "gamemap/BucketSearch.h"
+#include "gamemap/GameMap.h"
+#include "utils/Helper.h"
+#include "utils/LogManager.h"
+
+#include <algorithm>
+#include <functional>
+
+//! \brief Size (in tiles) of the side of the buckets
+const int JOB_BUCKET_SIZE = 8;
+
+//! \brief Jobs that depend on the state of the tile itself
+const uint8_t JOBS_TILE = (1 << static_cast<uint32_t>(SeatJobType::dig))
+    | (1 << static_cast<uint32_t>(SeatJobType::claimGround))
+    | (1 << static_cast<uint32_t>(SeatJobType::claimWall));
+
+//! \brief Jobs that depend on the state of the neighbor tiles
+const uint8_t JOBS_NEIGHBORS = (1 << static_cast<uint32_t>(SeatJobType::claimGround))
+    | (1 << static_cast<uint32_t>(SeatJobType::claimWall));
+
+//! \brief Jobs that depend on the entities in the tile
+const uint8_t JOBS_ENTITIES = (1 << static_cast<uint32_t>(SeatJobType::carry));
+
+const uint32_t NB_JOB_TYPES = static_cast<uint32_t>(SeatJobType::nbJobTypes);
+
+SeatJobBoard::SeatJobBoard(GameMap& gameMap, Seat& seat) :
+    mGameMap(gameMap),
+    mSeat(seat),
+    mMapSizeX(gameMap.getMapSizeX()),
+    mMapSizeY(gameMap.getMapSizeY()),
+    mNbBucketsX((mMapSizeX + JOB_BUCKET_SIZE - 1) / JOB_BUCKET_SIZE),
+    mNbBucketsY((mMapSizeY + JOB_BUCKET_SIZE - 1) / JOB_BUCKET_SIZE),
+    mTileJobs(mMapSizeX * mMapSizeY, 0),
+    mTileDirty(mMapSizeX * mMapSizeY, 0)
+{
+    for(uint32_t i = 0; i < NB_JOB_TYPES; ++i)
+        mBuckets[i].resize(mNbBucketsX * mNbBucketsY);
+
+    // Every tile will be checked during the first query
+    for(int xxx = 0; xxx < mMapSizeX; ++xxx)
+    {
+        for(int yyy = 0; yyy < mMapSizeY; ++yyy)
+        {
+            Tile* tile = mGameMap.getTile(xxx, yyy);
+            if(tile == nullptr)
+                continue;
+
+            setTileDirty(*tile, JOBS_TILE | JOBS_ENTITIES);
+        }
+    }
+}
+
+void SeatJobBoard::notifyTileChanged(Tile& tile)
+{
+    setTileDirty(tile, JOBS_TILE);
+    for(Tile* neigh : tile.getAllNeighbors())
+        setTileDirty(*neigh, JOBS_NEIGHBORS);
+}
+
+void SeatJobBoard::notifyTileEntitiesChanged(Tile& tile)
+{
+    setTileDirty(tile, JOBS_ENTITIES);
+}
+
+Tile* SeatJobBoard::findClosestJob(SeatJobType type, const Tile& from, int radius, const std::function<bool(Tile&)>& isValid)
+{
+    refreshDirtyTiles();
+
+    const std::vector<std::vector<Tile*>>& buckets = mBuckets[static_cast<uint32_t>(type)];
+    Tile* closestTile = nullptr;
+    BucketSearch::visitByDistance<Tile*>(JOB_BUCKET_SIZE, mNbBucketsX, mNbBucketsY, from.getX(), from.getY(), radius,
+        [this, &buckets](int bx, int by) -> const std::vector<Tile*>&
+        {
+            return buckets[by * mNbBucketsX + bx];
+        },
+        [](Tile* tile) { return tile->getX(); },
+        [](Tile* tile) { return tile->getY(); },
+        [&isValid, &closestTile](Tile* tile)
+        {
+            if(!isValid(*tile))
+                return false;
+
+            closestTile = tile;
+            return true;
+        });
+
+    return closestTile;
+}
+
+void SeatJobBoard::getJobsInRadius(SeatJobType type, const Tile& from, int radius, std::vector<Tile*>& tiles)
+{
+    refreshDirtyTiles();
+
+    std::vector<std::vector<Tile*>>& buckets = mBuckets[static_cast<uint32_t>(type)];
+    int radiusSquared = radius * radius;
+    int bucketXMin = std::max(0, (from.getX() - radius) / JOB_BUCKET_SIZE);
+    int bucketXMax = std::min(mNbBucketsX - 1, (from.getX() + radius) / JOB_BUCKET_SIZE);
+    int bucketYMin = std::max(0, (from.getY() - radius) / JOB_BUCKET_SIZE);
+    int bucketYMax = std::min(mNbBucketsY - 1, (from.getY() + radius) / JOB_BUCKET_SIZE);
+    for(int by = bucketYMin; by <= bucketYMax; ++by)
+    {
+        for(int bx = bucketXMin; bx <= bucketXMax; ++bx)
+        {
+            for(Tile* tile : buckets[by * mNbBucketsX + bx])
+            {
+                int diffX = tile->getX() - from.getX();
+                int diffY = tile->getY() - from.getY();
+                if(diffX * diffX + diffY * diffY > radiusSquared)
+                    continue;
+
+                tiles.push_back(tile);
+            }
+        }
+    }
+}
+
+bool SeatJobBoard::isCarryCandidate(GameEntity& entity)
+{
+    switch(entity.getObjectType())
+    {
+        case GameEntityType::creature:
+            // Workers are never carried
+            return !static_cast<Creature&>(entity).getDefinition()->isWorker();
+        case GameEntityType::treasuryObject:
+        case GameEntityType::craftedTrap:
+        case GameEntityType::skillEntity:
+        case GameEntityType::giftBoxEntity:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void SeatJobBoard::setTileDirty(Tile& tile, uint8_t jobs)
+{
+    uint32_t index = getTileIndex(tile);
+    if(index >= mTileDirty.size())
+    {
+        OD_LOG_ERR("tile=" + Tile::displayAsString(&tile) + ", seat=" + Seat::displayAsString(&mSeat));
+        return;
+    }
+
+    if(mTileDirty[index] == 0)
+        mDirtyTiles.push_back(&tile);
+
+    mTileDirty[index] |= jobs;
+}
+
+void SeatJobBoard::refreshDirtyTiles()
+{
+    for(Tile* tile : mDirtyTiles)
+    {
+        uint32_t index = getTileIndex(*tile);
+        uint8_t dirty = mTileDirty[index];
+        mTileDirty[index] = 0;
+        for(uint32_t i = 0; i < NB_JOB_TYPES; ++i)
+        {
+            if((dirty & (1 << i)) == 0)
+                continue;
+
+            SeatJobType type = static_cast<SeatJobType>(i);
+            setJob(type, *tile, hasJob(type, *tile));
+        }
+    }
+    mDirtyTiles.clear();
+}
+
+bool SeatJobBoard::hasJob(SeatJobType type, Tile& tile) const
+{
+    Player* player = mSeat.getPlayer();
+    switch(type)
+    {
+        case SeatJobType::dig:
+            return (player != nullptr) && tile.getMarkedForDigging(player);
+
+        case SeatJobType::claimGround:
+        {
+            if(tile.isFullTile())
+                return false;
+            if(!tile.isGroundClaimable(&mSeat))
+                return false;
+
+            // One of the neighbors should be claimed for the seat
+            for(Tile* neigh : tile.getAllNeighbors())
+            {
+                if(neigh->isFullTile())
+                    continue;
+                if(!neigh->isClaimedForSeat(&mSeat))
+                    continue;
+                if(neigh->getClaimedPercentage() < 1.0)
+                    continue;
+
+                return true;
+            }
+            return false;
+        }
+
+        case SeatJobType::claimWall:
+        {
+            if((player != nullptr) && tile.getMarkedForDigging(player))
+                return false;
+
+            return tile.isWallClaimable(&mSeat);
+        }
+
+        case SeatJobType::carry:
+        {
+            for(GameEntity* entity : tile.getEntitiesInTile())
+            {
+                if(isCarryCandidate(*entity))
+                    return true;
+            }
+            return false;
+        }
+
+        default:
+            OD_LOG_ERR("Unexpected job type=" + Helper::toString(static_cast<uint32_t>(type)));
+            return false;
+    }
+}
+
+void SeatJobBoard::setJob(SeatJobType type, Tile& tile, bool hasJob)
+{
+    uint8_t bit = static_cast<uint8_t>(1 << static_cast<uint32_t>(type));
+    uint8_t& tileJobs = mTileJobs[getTileIndex(tile)];
+    if(((tileJobs & bit) != 0) == hasJob)
+        return;
+
+    std::vector<Tile*>& bucket = mBuckets[static_cast<uint32_t>(type)][getBucketIndex(tile)];
+    if(hasJob)
+    {
+        tileJobs |= bit;
+        bucket.push_back(&tile);
+        return;
+    }
+
+    tileJobs &= static_cast<uint8_t>(~bit);
+    auto it = std::find(bucket.begin(), bucket.end(), &tile);
+    if(it == bucket.end())
+    {
+        OD_LOG_ERR("tile=" + Tile::displayAsString(&tile) + ", seat=" + Seat::displayAsString(&mSeat));
+        return;
+    }
+
+    // The order within a bucket does not matter
+    *it = bucket.back();
+    bucket.pop_back();
+}
+
+uint32_t SeatJobBoard::getTileIndex(const Tile& tile) const
+{
+    return static_cast<uint32_t>(tile.getY() * mMapSizeX + tile.getX());
+}
+
+uint32_t SeatJobBoard::getBucketIndex(const Tile& tile) const
+{
+    return static_cast<uint32_t>((tile.getY() / JOB_BUCKET_SIZE) * mNbBucketsX + tile.getX() / JOB_BUCKET_SIZE);
+}
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SEATJOBBOARD_H
+#define SEATJOBBOARD_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class GameEntity;
+class GameMap;
+class Seat;
+class Tile;
+
+//! \brief Kinds of work the workers of a seat look for
+enum class SeatJobType
+{
+    dig,
+    claimGround,
+    claimWall,
+    carry,
+    nbJobTypes
+};
+
+//! \brief Server side list of the tiles where the workers of a seat can work. Instead of having each worker
+//! checking every tile within its sight radius, the tiles are indexed in a grid of buckets and the closest
+//! ones are found by looking at the buckets around the worker.
+//! The board is updated incrementally: when a tile changes, it is marked as dirty (with its neighbors when
+//! their jobs depend on it) and the dirty tiles are checked again at the next query. Some of the conditions
+//! can change without the tile being notified (claimed percentage, carry type of an entity, ...) so the
+//! board only gives candidates that should be checked by the caller.
+class SeatJobBoard
+{
+public:
+    SeatJobBoard(GameMap& gameMap, Seat& seat);
+
+    //! \brief Should be called when the marking, fullness, claiming or covering building of the
+    //! given tile changes
+    void notifyTileChanged(Tile& tile);
+
+    //! \brief Should be called when an entity is added to or removed from the given tile
+    void notifyTileEntitiesChanged(Tile& tile);
+
+    //! \brief Returns the closest tile within radius from the given tile having a job of the given type
+    //! and for which isValid returns true (nullptr if none). The tiles are given to isValid by increasing
+    //! distance so that expensive checks (like pathfinding) are only done on the closest ones
+    Tile* findClosestJob(SeatJobType type, const Tile& from, int radius, const std::function<bool(Tile&)>& isValid);
+
+    //! \brief Fills tiles with the tiles within radius from the given tile having a job of the given type
+    void getJobsInRadius(SeatJobType type, const Tile& from, int radius, std::vector<Tile*>& tiles);
+
+    //! \brief Returns true if an entity of this kind can be carried by workers (now or later, like a
+    //! creature that could be KO)
+    static bool isCarryCandidate(GameEntity& entity);
+
+private:
+    GameMap& mGameMap;
+    Seat& mSeat;
+
+    int mMapSizeX;
+    int mMapSizeY;
+    int mNbBucketsX;
+    int mNbBucketsY;
+
+    //! \brief Jobs (one bit per SeatJobType) indexed for each tile of the map
+    std::vector<uint8_t> mTileJobs;
+
+    //! \brief Jobs to check again for each tile of the map. mDirtyTiles contains the tiles with at
+    //! least one bit set
+    std::vector<uint8_t> mTileDirty;
+    std::vector<Tile*> mDirtyTiles;
+
+    //! \brief For each job type, the tiles having this job in each bucket
+    std::vector<std::vector<Tile*>> mBuckets[static_cast<uint32_t>(SeatJobType::nbJobTypes)];
+
+    void setTileDirty(Tile& tile, uint8_t jobs);
+
+    //! \brief Checks the jobs of the dirty tiles and updates the buckets
+    void refreshDirtyTiles();
+
+    //! \brief Returns true if the given tile has currently a job of the given type for mSeat
+    bool hasJob(SeatJobType type, Tile& tile) const;
+    void setJob(SeatJobType type, Tile& tile, bool hasJob);
+
+    uint32_t getTileIndex(const Tile& tile) const;
+    uint32_t getBucketIndex(const Tile& tile) const;
+};
+
+#endif // SEATJOBBOARD_H
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUCKETSEARCH_H
+#define BUCKETSEARCH_H
+
+#include <algorithm>
+#include <queue>
+#include <vector>
+
+//! \brief Searches in the grids of square buckets used to index things standing on the map (see EntityGrid
+//! and SeatJobBoard)
+namespace BucketSearch
+{
+    /*! \brief Gives to visit the items within radius of the tile (x, y) by increasing distance (then by position in
+     * the map to stay deterministic) until visit returns true.
+     *
+     * The buckets are looked at ring by ring around the bucket containing (x, y). The items of a ring are kept in a
+     * heap and the ones closer than any item of the next rings are given to visit before looking at the next ring.
+     * Thus, when the first items are enough, only the closest buckets are looked at.
+     *
+     * getBucket(bx, by) should return the items (const std::vector<Item>&) of the bucket at the given bucket
+     * coordinates. getX(item) and getY(item) should return the position of an item.
+     * Returns true if visit returned true.
+     */
+    template<typename Item, typename GetBucket, typename GetX, typename GetY, typename Visit>
+    bool visitByDistance(int bucketSize, int nbBucketsX, int nbBucketsY, int x, int y, int radius,
+        const GetBucket& getBucket, const GetX& getX, const GetY& getY, const Visit& visit)
+    {
+        struct Candidate
+        {
+            int mDistSquared;
+            int mY;
+            int mX;
+            Item mItem;
+        };
+        auto isFurther = [](const Candidate& c1, const Candidate& c2)
+        {
+            if(c1.mDistSquared != c2.mDistSquared)
+                return c1.mDistSquared > c2.mDistSquared;
+            if(c1.mY != c2.mY)
+                return c1.mY > c2.mY;
+            return c1.mX > c2.mX;
+        };
+        std::priority_queue<Candidate, std::vector<Candidate>, decltype(isFurther)> candidates(isFurther);
+
+        int radiusSquared = radius * radius;
+        int bucketX = x / bucketSize;
+        int bucketY = y / bucketSize;
+        int maxRing = radius / bucketSize + 1;
+        for(int ring = 0; ring <= maxRing; ++ring)
+        {
+            for(int by = bucketY - ring; by <= bucketY + ring; ++by)
+            {
+                if((by < 0) || (by >= nbBucketsY))
+                    continue;
+
+                // On the first and last rows, we take every bucket. On the others, only the first and the last
+                int step = ((by == bucketY - ring) || (by == bucketY + ring)) ? 1 : std::max(1, 2 * ring);
+                for(int bx = bucketX - ring; bx <= bucketX + ring; bx += step)
+                {
+                    if((bx < 0) || (bx >= nbBucketsX))
+                        continue;
+
+                    for(const Item& item : getBucket(bx, by))
+                    {
+                        int itemX = getX(item);
+                        int itemY = getY(item);
+                        int diffX = itemX - x;
+                        int diffY = itemY - y;
+                        int distSquared = diffX * diffX + diffY * diffY;
+                        if(distSquared > radiusSquared)
+                            continue;
+
+                        candidates.push(Candidate{distSquared, itemY, itemX, item});
+                    }
+                }
+            }
+
+            // Items in the next rings are at least this far so the closer candidates can be checked now
+            int nextRingDist = ring * bucketSize + 1;
+            int nextRingDistSquared = nextRingDist * nextRingDist;
+            bool isLastRing = (ring == maxRing) || (nextRingDistSquared > radiusSquared);
+            while(!candidates.empty() && (isLastRing || (candidates.top().mDistSquared < nextRingDistSquared)))
+            {
+                Item item = candidates.top().mItem;
+                candidates.pop();
+                if(visit(item))
+                    return true;
+            }
+
+            if(isLastRing)
+                break;
+        }
+
+        return false;
+    }
+}
+
+#endif // BUCKETSEARCH_H
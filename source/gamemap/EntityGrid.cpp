@@ -0,0 +1,183 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gamemap/EntityGrid.h"
+
+#include "entities/GameEntityType.h"
+#include "gamemap/BucketSearch.h"
+
+#include <algorithm>
+#include <functional>
+
+//! \brief Size (in tiles) of the side of the buckets
+const int ENTITY_BUCKET_SIZE = 8;
+
+const uint32_t NB_ENTITY_TYPES = static_cast<uint32_t>(GameEntityType::nbEntityTypes);
+
+EntityGrid::EntityGrid() :
+    mMapSizeX(0),
+    mMapSizeY(0),
+    mNbBucketsX(0),
+    mNbBucketsY(0),
+    mNbEntities(NB_ENTITY_TYPES, 0)
+{
+}
+
+void EntityGrid::setMapSize(int mapSizeX, int mapSizeY)
+{
+    mMapSizeX = std::max(0, mapSizeX);
+    mMapSizeY = std::max(0, mapSizeY);
+    mNbBucketsX = (mMapSizeX + ENTITY_BUCKET_SIZE - 1) / ENTITY_BUCKET_SIZE;
+    mNbBucketsY = (mMapSizeY + ENTITY_BUCKET_SIZE - 1) / ENTITY_BUCKET_SIZE;
+    mBuckets.clear();
+    mBuckets.resize(mNbBucketsX * mNbBucketsY * NB_ENTITY_TYPES);
+    mNbEntities.assign(NB_ENTITY_TYPES, 0);
+}
+
+void EntityGrid::addEntity(GameEntity& entity, GameEntityType type, int x, int y)
+{
+    int index = getBucketIndex(type, x, y);
+    if(index < 0)
+        return;
+
+    Entry entry;
+    entry.mEntity = &entity;
+    entry.mX = x;
+    entry.mY = y;
+    mBuckets[index].push_back(entry);
+    ++mNbEntities[static_cast<uint32_t>(type)];
+}
+
+void EntityGrid::removeEntity(GameEntity& entity, GameEntityType type, int x, int y)
+{
+    int index = getBucketIndex(type, x, y);
+    if(index < 0)
+        return;
+
+    std::vector<Entry>& bucket = mBuckets[index];
+    for(Entry& entry : bucket)
+    {
+        if(entry.mEntity != &entity)
+            continue;
+
+        // The order within a bucket does not matter
+        entry = bucket.back();
+        bucket.pop_back();
+        --mNbEntities[static_cast<uint32_t>(type)];
+        return;
+    }
+}
+
+void EntityGrid::getEntitiesInRect(GameEntityType type, int xMin, int yMin, int xMax, int yMax,
+    std::vector<GameEntity*>& entities) const
+{
+    if(mNbEntities[static_cast<uint32_t>(type)] == 0)
+        return;
+
+    xMin = std::max(0, xMin);
+    yMin = std::max(0, yMin);
+    xMax = std::min(mMapSizeX - 1, xMax);
+    yMax = std::min(mMapSizeY - 1, yMax);
+    if((xMin > xMax) || (yMin > yMax))
+        return;
+
+    for(int by = yMin / ENTITY_BUCKET_SIZE; by <= yMax / ENTITY_BUCKET_SIZE; ++by)
+    {
+        for(int bx = xMin / ENTITY_BUCKET_SIZE; bx <= xMax / ENTITY_BUCKET_SIZE; ++bx)
+        {
+            int index = getBucketIndex(type, bx * ENTITY_BUCKET_SIZE, by * ENTITY_BUCKET_SIZE);
+            for(const Entry& entry : mBuckets[index])
+            {
+                if((entry.mX < xMin) || (entry.mX > xMax) || (entry.mY < yMin) || (entry.mY > yMax))
+                    continue;
+
+                entities.push_back(entry.mEntity);
+            }
+        }
+    }
+}
+
+void EntityGrid::getEntitiesInRadius(GameEntityType type, int x, int y, int radius,
+    std::vector<GameEntity*>& entities) const
+{
+    if(mNbEntities[static_cast<uint32_t>(type)] == 0)
+        return;
+
+    int xMin = std::max(0, x - radius);
+    int yMin = std::max(0, y - radius);
+    int xMax = std::min(mMapSizeX - 1, x + radius);
+    int yMax = std::min(mMapSizeY - 1, y + radius);
+    if((xMin > xMax) || (yMin > yMax))
+        return;
+
+    int radiusSquared = radius * radius;
+    for(int by = yMin / ENTITY_BUCKET_SIZE; by <= yMax / ENTITY_BUCKET_SIZE; ++by)
+    {
+        for(int bx = xMin / ENTITY_BUCKET_SIZE; bx <= xMax / ENTITY_BUCKET_SIZE; ++bx)
+        {
+            int index = getBucketIndex(type, bx * ENTITY_BUCKET_SIZE, by * ENTITY_BUCKET_SIZE);
+            for(const Entry& entry : mBuckets[index])
+            {
+                int diffX = entry.mX - x;
+                int diffY = entry.mY - y;
+                if(diffX * diffX + diffY * diffY > radiusSquared)
+                    continue;
+
+                entities.push_back(entry.mEntity);
+            }
+        }
+    }
+}
+
+void EntityGrid::getNearestEntities(GameEntityType type, int x, int y, int radius, uint32_t nbEntities,
+    const std::function<bool(GameEntity&)>& filter, std::vector<GameEntity*>& entities) const
+{
+    if((nbEntities == 0) || (mNbEntities[static_cast<uint32_t>(type)] == 0))
+        return;
+
+    uint32_t nbFound = 0;
+    BucketSearch::visitByDistance<Entry>(ENTITY_BUCKET_SIZE, mNbBucketsX, mNbBucketsY, x, y, radius,
+        [this, type](int bx, int by) -> const std::vector<Entry>&
+        {
+            return mBuckets[getBucketIndex(type, bx * ENTITY_BUCKET_SIZE, by * ENTITY_BUCKET_SIZE)];
+        },
+        [](const Entry& entry) { return entry.mX; },
+        [](const Entry& entry) { return entry.mY; },
+        [&filter, &entities, &nbFound, nbEntities](const Entry& entry)
+        {
+            if(!filter(*entry.mEntity))
+                return false;
+
+            entities.push_back(entry.mEntity);
+            ++nbFound;
+            return nbFound >= nbEntities;
+        });
+}
+
+uint32_t EntityGrid::getNbEntities(GameEntityType type) const
+{
+    return mNbEntities[static_cast<uint32_t>(type)];
+}
+
+int EntityGrid::getBucketIndex(GameEntityType type, int x, int y) const
+{
+    if((x < 0) || (y < 0) || (x >= mMapSizeX) || (y >= mMapSizeY))
+        return -1;
+
+    int bucket = (y / ENTITY_BUCKET_SIZE) * mNbBucketsX + x / ENTITY_BUCKET_SIZE;
+    return bucket * static_cast<int>(NB_ENTITY_TYPES) + static_cast<int>(type);
+}
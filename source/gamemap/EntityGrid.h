@@ -0,0 +1,88 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ENTITYGRID_H
+#define ENTITYGRID_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class GameEntity;
+
+enum class GameEntityType;
+
+//! \brief Index of the entities standing on the map. The map is split in square buckets of a few tiles
+//! and each bucket keeps one list per entity type so that area queries only look at the entities of the
+//! wanted type in the buckets around the area instead of every tile (or every entity).
+//! The grid is kept up to date by Tile::addEntity and Tile::removeEntity. As moving entities are removed
+//! from their old tile and added to the new one, the position of an entity in the grid is always the one
+//! of the tile it is on.
+class EntityGrid
+{
+public:
+    EntityGrid();
+
+    //! \brief Removes every entity and sets the size (in tiles) of the indexed area
+    void setMapSize(int mapSizeX, int mapSizeY);
+
+    //! \brief Adds/removes the entity standing on the tile at the given coordinates
+    void addEntity(GameEntity& entity, GameEntityType type, int x, int y);
+    void removeEntity(GameEntity& entity, GameEntityType type, int x, int y);
+
+    //! \brief Fills entities with the entities of the given type on the tiles of the rectangle (bounds included)
+    void getEntitiesInRect(GameEntityType type, int xMin, int yMin, int xMax, int yMax,
+        std::vector<GameEntity*>& entities) const;
+
+    //! \brief Fills entities with the entities of the given type on the tiles within radius
+    //! of the tile at the given coordinates
+    void getEntitiesInRadius(GameEntityType type, int x, int y, int radius,
+        std::vector<GameEntity*>& entities) const;
+
+    //! \brief Fills entities with the nbEntities closest entities of the given type within radius of the
+    //! tile at the given coordinates for which filter returns true, sorted from the closest. Entities are
+    //! given to filter by increasing distance and the search stops as soon as enough are found
+    void getNearestEntities(GameEntityType type, int x, int y, int radius, uint32_t nbEntities,
+        const std::function<bool(GameEntity&)>& filter, std::vector<GameEntity*>& entities) const;
+
+    //! \brief Returns the number of entities of the given type in the grid
+    uint32_t getNbEntities(GameEntityType type) const;
+
+private:
+    struct Entry
+    {
+        GameEntity* mEntity;
+        int mX;
+        int mY;
+    };
+
+    int mMapSizeX;
+    int mMapSizeY;
+    int mNbBucketsX;
+    int mNbBucketsY;
+
+    //! \brief Entities of each type in each bucket (see getBucketIndex)
+    std::vector<std::vector<Entry>> mBuckets;
+
+    std::vector<uint32_t> mNbEntities;
+
+    //! \brief Returns the index in mBuckets of the list for the given type in the bucket containing
+    //! the given tile. Returns -1 if the tile is outside the grid
+    int getBucketIndex(GameEntityType type, int x, int y) const;
+};
+
+#endif // ENTITYGRID_H
@@ -38,6 +38,7 @@
 #include "game/Skill.h"
 #include "game/SkillType.h"
 #include "game/Seat.h"
+#include "game/SeatJobBoard.h"
 #include "gamemap/MapHandler.h"
 #include "gamemap/Pathfinding.h"
 #include "gamemap/TileSet.h"
@@ -59,7 +60,9 @@
 #include "utils/ConfigManager.h"
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
+#include "utils/MakeUnique.h"
 #include "utils/ResourceManager.h"
+#include "utils/ThreadPool.h"
 
 #include <OgreTimer.h>
 
@@ -73,82 +76,251 @@
 
 const std::string DEFAULT_NICK = "You";
 
+//! \brief Returned by the rooms accessors when there is no room of the wanted type
+const std::vector<Room*> NO_ROOMS;
+
+const uint32_t NB_ROOM_TYPES = static_cast<uint32_t>(RoomType::nbRooms);
+
+//! \brief Costs used by the dig distance fields (see GameMap::findDigPath). The walls claimed by an enemy
+//! have to be claimed back before being dug. Thus, they are only gone through when there is no other way
+const uint32_t DIG_FIELD_WALK_COST = 1;
+const uint32_t DIG_FIELD_DIG_COST = 3;
+const uint32_t DIG_FIELD_CLAIMED_WALL_COST = 30;
+
+//! \brief Maximum number of dig distance fields kept in the cache
+const uint32_t MAX_DIG_DISTANCE_FIELDS = 16;
+
+//! \brief Maximum number of flow fields kept in the cache
+const uint32_t MAX_FLOW_FIELDS = 16;
+
+//! \brief Like the path cache, the flow fields depend on buildings states that are not always notified (like a door being
+//! activated). So they are computed again after this number of turns
+const int64_t FLOW_FIELD_LIFETIME_TURNS = 5;
+
 using namespace std;
 
-/*! \brief A helper class for the A* search in the GameMap::path function.
-*
-* This class stores the requisite information about a tile which is placed in
-* the search queue for the A-star, or A*, algorithm which is used to
-* calculate paths in the path function.
-*
-* The A* description can be found here:
-* http://en.wikipedia.org/wiki/A*_search_algorithm
-*/
-class AstarEntry
+//! \brief Adds the time spent in the current scope to the given counter (in microseconds)
+class PhaseTimer
 {
 public:
-    AstarEntry() :
-        tile    (nullptr),
-        parent  (nullptr),
-        g       (0.0),
-        h       (0.0)
+    PhaseTimer(uint64_t& counter) :
+        mCounter(counter)
     {}
 
-    AstarEntry(Tile* tile, int x1, int y1, int x2, int y2) :
-        tile    (tile),
-        parent  (nullptr),
-        g       (0.0),
-        h       (0.0),
-        mHasBeenProcessed (false)
+    ~PhaseTimer()
     {
-        h = computeHeuristic(x1, y1, x2, y2);
+        mCounter += mStopwatch.getMicroseconds();
     }
 
-    static double computeHeuristic(const int& x1, const int& y1, const int& x2, const int& y2)
-    {
-        return fabs(static_cast<double>(x2 - x1)) + fabs(static_cast<double>(y2 - y1));
-    }
+private:
+    uint64_t& mCounter;
+    Ogre::Timer mStopwatch;
+};
 
-    void setHeuristic(const int& x1, const int& y1, const int& x2, const int& y2)
+/*! \brief Helper class giving the view of the map used by Pathfinding::AstarSearch in the GameMap::path function.
+ *
+ * The A* description can be found here:
+ * http://en.wikipedia.org/wiki/A*_search_algorithm
+ */
+class PathfindingGrid
+{
+public:
+    PathfindingGrid(const GameMap& gameMap, const Creature& creature, const Seat* seat, bool throughDiggableTiles) :
+        mGameMap(gameMap),
+        mCreature(creature),
+        mSeat(seat),
+        mThroughDiggableTiles(throughDiggableTiles)
+    {}
+
+    inline int getSizeX() const
+    { return mGameMap.getMapSizeX(); }
+
+    inline int getSizeY() const
+    { return mGameMap.getMapSizeY(); }
+
+    inline bool isPassable(int x, int y) const
+    { return mCreature.canGoThroughTile(mGameMap.getTile(x, y)); }
+
+    inline bool isDiggable(int x, int y) const
+    { return mThroughDiggableTiles && mGameMap.getTile(x, y)->isDiggable(mSeat); }
+
+    inline double getSpeed(int x, int y) const
     {
-        h = fabs(static_cast<double>(x2 - x1)) + fabs(static_cast<double>(y2 - y1));
+        Tile* tile = mGameMap.getTile(x, y);
+        if(tile->getFullness() == 0)
+            return mCreature.getMoveSpeed(tile);
+
+        return mCreature.getMoveSpeedGround();
     }
 
-    inline double fCost() const
-    { return g + h; }
+private:
+    const GameMap& mGameMap;
+    const Creature& mCreature;
+    const Seat* mSeat;
+    bool mThroughDiggableTiles;
+};
+
+//! \brief Costs of the tiles for the workers of a seat used by the dig distance fields (see GameMap::findDigPath).
+//! The targets are the given tile indexes (sorted) or, if isGoldField is true, the gold tiles that can be mined
+class DigCostGrid
+{
+public:
+    DigCostGrid(const GameMap& gameMap, const Creature& worker, const Seat* seat,
+            const std::vector<uint32_t>& targets, bool isGoldField) :
+        mGameMap(gameMap),
+        mWorker(worker),
+        mSeat(seat),
+        mTargets(targets),
+        mIsGoldField(isGoldField)
+    {}
 
-    inline Tile* getTile() const
-    { return tile; }
+    inline int getSizeX() const
+    { return mGameMap.getMapSizeX(); }
 
-    inline bool getHasBeenProcessed() const
-    { return mHasBeenProcessed; }
+    inline int getSizeY() const
+    { return mGameMap.getMapSizeY(); }
 
-    inline void setHasBeenProcessed()
-    { mHasBeenProcessed = true; }
+    inline uint32_t getCost(int x, int y) const
+    {
+        Tile* tile = mGameMap.getTile(x, y);
+        if(mWorker.canGoThroughTile(tile))
+            return DIG_FIELD_WALK_COST;
 
-    inline void setTile(Tile* newTile)
-    { tile = newTile; }
+        if(tile->isDiggable(mSeat))
+            return DIG_FIELD_DIG_COST;
 
-    inline AstarEntry* getParent() const
-    { return parent; }
+        if((tile->getTileVisual() == TileVisual::claimedFull) && tile->isClaimed())
+            return DIG_FIELD_CLAIMED_WALL_COST;
 
-    inline void setParent(AstarEntry* newParent)
-    { parent = newParent; }
+        return Pathfinding::DistanceField::IMPASSABLE;
+    }
 
-    inline const double& getG() const
-    { return g; }
+    inline bool isTarget(int x, int y) const
+    {
+        if(!mIsGoldField)
+            return std::binary_search(mTargets.begin(), mTargets.end(), Pathfinding::AstarSearch::getIndex(x, y, getSizeX()));
 
-    inline void setG(const double& newG)
-    { g = newG; }
+        Tile* tile = mGameMap.getTile(x, y);
+        return (tile->getType() == TileType::gold) && (tile->getFullness() > 0.0);
+    }
 
 private:
-    Tile*       tile;
-    AstarEntry* parent;
-    double      g;
-    double      h;
-    bool        mHasBeenProcessed;
+    const GameMap& mGameMap;
+    const Creature& mWorker;
+    const Seat* mSeat;
+    const std::vector<uint32_t>& mTargets;
+    bool mIsGoldField;
 };
 
+//! \brief Returns the floodfill type matching the tiles the given creature can walk through
+static FloodFillType getCreatureFloodFillType(const Creature& creature)
+{
+    FloodFillType floodFill = FloodFillType::ground;
+    if((creature.getMoveSpeedGround() > 0.0) &&
+        (creature.getMoveSpeedWater() > 0.0) &&
+        (creature.getMoveSpeedLava() > 0.0))
+    {
+        floodFill = FloodFillType::groundWaterLava;
+    }
+    if((creature.getMoveSpeedGround() > 0.0) &&
+        (creature.getMoveSpeedWater() > 0.0))
+    {
+        floodFill = FloodFillType::groundWater;
+    }
+    if((creature.getMoveSpeedGround() > 0.0) &&
+        (creature.getMoveSpeedLava() > 0.0))
+    {
+        floodFill = FloodFillType::groundLava;
+    }
+
+    return floodFill;
+}
+
+//! \brief Returns a value that is the same for the creatures that can go through the same tiles. Note that
+//! enemies cannot go through a locked door while they are fighting or fleeing (see TrapDoor::getCreatureSpeed)
+static uint32_t getCreatureMovementClass(const Creature& creature)
+{
+    uint32_t movementClass = 0;
+    if(creature.getMoveSpeedGround() > 0.0)
+        movementClass |= 0x01;
+    if(creature.getMoveSpeedWater() > 0.0)
+        movementClass |= 0x02;
+    if(creature.getMoveSpeedLava() > 0.0)
+        movementClass |= 0x04;
+    if(creature.isActionInList(CreatureActionType::fight) ||
+       creature.isActionInList(CreatureActionType::flee))
+    {
+        movementClass |= 0x08;
+    }
+
+    return movementClass;
+}
+
+//! \brief Sets the fields of the path cache and flow field keys describing how the given creature moves
+template<typename Key>
+static void setCreatureMovementKey(Key& key, const Creature& creature)
+{
+    key.mMovementClass = getCreatureMovementClass(creature);
+    key.mGroundSpeed = creature.getMoveSpeedGround();
+    key.mWaterSpeed = creature.getMoveSpeedWater();
+    key.mLavaSpeed = creature.getMoveSpeedLava();
+}
+
+//! \brief Helpers used to keep the registries of entities by name in sync with the entities vectors
+template<typename T>
+static void registerEntityName(std::unordered_map<std::string, T*>& entities, T* entity)
+{
+    if(entities.emplace(entity->getName(), entity).second)
+        return;
+
+    // If several entities have the same name, we keep the first one like when searching in the vector
+    OD_LOG_ERR("Entity already registered name=" + entity->getName());
+}
+
+//! \brief Should be called once entity has been removed from entitiesVector. If another entity with the same
+//! name is still in entitiesVector, the first one is registered so that it can still be found
+template<typename T>
+static void unregisterEntityName(std::unordered_map<std::string, T*>& entities, const std::vector<T*>& entitiesVector,
+    T* entity)
+{
+    typename std::unordered_map<std::string, T*>::iterator it = entities.find(entity->getName());
+    if((it == entities.end()) || (it->second != entity))
+        return;
+
+    for(T* otherEntity : entitiesVector)
+    {
+        if(otherEntity->getName() != entity->getName())
+            continue;
+
+        it->second = otherEntity;
+        return;
+    }
+
+    entities.erase(it);
+}
+
+template<typename T>
+static T* getEntityByName(const std::unordered_map<std::string, T*>& entities, const std::string& name)
+{
+    typename std::unordered_map<std::string, T*>::const_iterator it = entities.find(name);
+    if(it == entities.end())
+        return nullptr;
+
+    return it->second;
+}
+
+//! \brief Removes the given entity from the vector (if it is in it)
+template<typename T>
+static void eraseEntity(std::vector<T*>& entities, T* entity)
+{
+    entities.erase(std::remove(entities.begin(), entities.end(), entity), entities.end());
+}
+
+//! \brief Value stored in the claim owner layer for the tiles claimed by the given seat
+static uint8_t getClaimOwnerFromSeat(const Seat* seat)
+{
+    return static_cast<uint8_t>(seat->getSeatIndex() + 1);
+}
 
 GameMap::GameMap(bool isServerGameMap) :
         TileContainer(isServerGameMap ? 15 : 0),
@@ -161,6 +333,12 @@ GameMap::GameMap(bool isServerGameMap) :
         mFloodFillEnabled(false),
         mIsFOWActivated(true),
         mNumCallsTo_path(0),
+        mNumPathCacheHits(0),
+        mNumPathCacheMisses(0),
+        mIsVisionInitialized(false),
+        mIsSeatsEconomyInitialized(false),
+        mIsVisionGivenOnAllTiles(false),
+        mNbWorkerThreads(ThreadPool::getDefaultNbWorkers()),
         mAiManager(*this),
         mTileSet(nullptr)
 {
@@ -226,6 +404,8 @@ bool GameMap::createNewMap(int sizeX, int sizeY)
     if (!allocateMapMemory(sizeX, sizeY))
         return false;
 
+    mEntityGrid.setMapSize(sizeX, sizeY);
+
     for (int jj = 0; jj < mMapSizeY; ++jj)
     {
         for (int ii = 0; ii < mMapSizeX; ++ii)
@@ -272,6 +452,16 @@ void GameMap::clearAll()
 
     clearTiles();
     processDeletionQueues();
+    mEntityGrid.setMapSize(0, 0);
+    mFloodFillParents.clear();
+    mPathCache.clear();
+    mDigDistanceFields.clear();
+    mFlowFields.clear();
+    mTilesClaimChanged.clear();
+    mTilesOcclusionChanged.clear();
+    mIsVisionInitialized = false;
+    mIsSeatsEconomyInitialized = false;
+    mIsVisionGivenOnAllTiles = false;
 
     clearGoalsForAllSeats();
     clearSeats();
@@ -304,6 +494,8 @@ void GameMap::clearAll()
             OD_LOG_ERR("entity not removed=" + entity->getName());
         }
         mAnimatedObjects.clear();
+        mAnimatedObjectsByName.clear();
+        mAnimatedObjectsById.clear();
     }
     if(!mEntitiesToDelete.empty())
     {
@@ -336,6 +528,8 @@ void GameMap::clearCreatures()
     }
 
     mCreatures.clear();
+    mCreaturesByName.clear();
+    mCreaturesBySeat.clear();
 }
 
 void GameMap::clearAiManager()
@@ -382,6 +576,7 @@ void GameMap::clearRenderedMovableEntities()
     }
 
     mRenderedMovableEntities.clear();
+    mRenderedMovableEntitiesByName.clear();
 }
 
 void GameMap::clearPlayers()
@@ -400,9 +595,35 @@ void GameMap::resetUniqueNumbers()
     mUniqueNumberRenderedMovableEntity = 0;
     mUniqueNumberTrap = 0;
     mUniqueNumberMapLight = 0;
+    mUniqueNumberEntityId = 0;
     mUniqueFloodFillValue = 0;
 }
 
+void GameMap::registerEntityId(MovableGameEntity* entity)
+{
+    if(isServerGameMap() && (entity->getId() == 0))
+        entity->setId(++mUniqueNumberEntityId);
+
+    // Entities created locally on client side have no id. They are never referenced by the server
+    if(entity->getId() == 0)
+        return;
+
+    if(mAnimatedObjectsById.emplace(entity->getId(), entity).second)
+        return;
+
+    OD_LOG_ERR(serverStr() + "Entity already registered id=" + Helper::toString(entity->getId())
+        + ", name=" + entity->getName());
+}
+
+void GameMap::unregisterEntityId(MovableGameEntity* entity)
+{
+    std::unordered_map<uint32_t, MovableGameEntity*>::iterator it = mAnimatedObjectsById.find(entity->getId());
+    if((it == mAnimatedObjectsById.end()) || (it->second != entity))
+        return;
+
+    mAnimatedObjectsById.erase(it);
+}
+
 void GameMap::addClassDescription(const CreatureDefinition *c)
 {
     mClassDescriptions.push_back(std::pair<const CreatureDefinition*,CreatureDefinition*>(c, nullptr));
@@ -490,6 +711,11 @@ void GameMap::addCreature(Creature *cc)
         + ", seatId=" + (cc->getSeat() != nullptr ? Helper::toString(cc->getSeat()->getId()) : std::string("null")));
 
     mCreatures.push_back(cc);
+    registerEntityName(mCreaturesByName, cc);
+    if(cc->getSeat() != nullptr)
+        mCreaturesBySeat[cc->getSeat()->getId()].push_back(cc);
+
+    countCreature(cc, cc->getSeat(), 1);
 }
 
 void GameMap::removeCreature(Creature *c)
@@ -504,6 +730,72 @@ void GameMap::removeCreature(Creature *c)
     }
 
     mCreatures.erase(it);
+    unregisterEntityName(mCreaturesByName, mCreatures, c);
+    if(c->getSeat() != nullptr)
+    {
+        std::vector<Creature*>& creatures = mCreaturesBySeat[c->getSeat()->getId()];
+        creatures.erase(std::remove(creatures.begin(), creatures.end(), c), creatures.end());
+    }
+
+    countCreature(c, c->getSeat(), -1);
+}
+
+void GameMap::notifyCreatureSeatChanging(Creature* creature, Seat* newSeat)
+{
+    // Only the creatures on the gamemap are sorted by seat
+    if(std::find(mCreatures.begin(), mCreatures.end(), creature) == mCreatures.end())
+        return;
+
+    if(creature->getSeat() != nullptr)
+    {
+        std::vector<Creature*>& creatures = mCreaturesBySeat[creature->getSeat()->getId()];
+        creatures.erase(std::remove(creatures.begin(), creatures.end(), creature), creatures.end());
+    }
+
+    if(newSeat != nullptr)
+        mCreaturesBySeat[newSeat->getId()].push_back(creature);
+
+    countCreature(creature, creature->getSeat(), -1);
+    countCreature(creature, newSeat, 1);
+}
+
+void GameMap::notifyCreatureDead(Creature* creature)
+{
+    if(std::find(mCreatures.begin(), mCreatures.end(), creature) == mCreatures.end())
+        return;
+
+    // The creature is already dead so we cannot use countCreature
+    if(!mIsServerGameMap || !mIsSeatsEconomyInitialized || (creature->getSeat() == nullptr))
+        return;
+
+    if(creature->getDefinition()->isWorker())
+        --(creature->getSeat()->mNumCreaturesWorkers);
+    else
+        --(creature->getSeat()->mNumCreaturesFighters);
+}
+
+void GameMap::countCreature(Creature* creature, Seat* seat, int nb)
+{
+    // Before the first count, creatures may not be fully loaded (definition, HP, ...)
+    if(!mIsServerGameMap || !mIsSeatsEconomyInitialized)
+        return;
+
+    if((seat == nullptr) || !creature->isAlive())
+        return;
+
+    if(creature->getDefinition()->isWorker())
+        seat->mNumCreaturesWorkers += nb;
+    else
+        seat->mNumCreaturesFighters += nb;
+}
+
+void GameMap::notifyTreasuryGoldChanged(Seat* seat, int gold, int goldMax)
+{
+    if(!mIsServerGameMap)
+        return;
+
+    seat->mTreasuryGold += gold;
+    seat->mTreasuryGoldMax += goldMax;
 }
 
 void GameMap::queueEntityForDeletion(GameEntity *ge)
@@ -553,11 +845,19 @@ std::vector<Creature*> GameMap::getCreaturesByAlliedSeat(const Seat* seat) const
 {
     std::vector<Creature*> tempVector;
 
-    // Loop over all the creatures in the GameMap and add them to the temp vector if their seat matches the one in parameter.
-    for (Creature* creature : mCreatures)
+    // Loop over the creatures of the allied seats and add the alive ones to the temp vector
+    for (const std::pair<const int, std::vector<Creature*>>& p : mCreaturesBySeat)
     {
-        if (seat->isAlliedSeat(creature->getSeat()) && creature->isAlive())
-            tempVector.push_back(creature);
+        if(p.second.empty())
+            continue;
+        if(!seat->isAlliedSeat(p.second.front()->getSeat()))
+            continue;
+
+        for (Creature* creature : p.second)
+        {
+            if (creature->isAlive())
+                tempVector.push_back(creature);
+        }
     }
 
     return tempVector;
@@ -566,9 +866,12 @@ std::vector<Creature*> GameMap::getCreaturesByAlliedSeat(const Seat* seat) const
 std::vector<Creature*> GameMap::getCreaturesBySeat(const Seat* seat) const
 {
     std::vector<Creature*> tempVector;
+    auto it = mCreaturesBySeat.find(seat->getId());
+    if(it == mCreaturesBySeat.end())
+        return tempVector;
 
-    // Loop over all the creatures in the GameMap and add them to the temp vector if their seat matches the one in parameter.
-    for (Creature* creature : mCreatures)
+    // Loop over the creatures of the seat and add the alive ones to the temp vector
+    for (Creature* creature : it->second)
     {
         if (creature->getSeat() == seat && creature->isAlive())
             tempVector.push_back(creature);
@@ -806,6 +1109,8 @@ Creature* GameMap::getFighterToPickupBySeat(Seat* seat)
 void GameMap::addAnimatedObject(MovableGameEntity *a)
 {
     mAnimatedObjects.push_back(a);
+    registerEntityName(mAnimatedObjectsByName, a);
+    registerEntityId(a);
 }
 
 void GameMap::removeAnimatedObject(MovableGameEntity *a)
@@ -815,17 +1120,22 @@ void GameMap::removeAnimatedObject(MovableGameEntity *a)
         return;
 
     mAnimatedObjects.erase(it);
+    unregisterEntityName(mAnimatedObjectsByName, mAnimatedObjects, a);
+    unregisterEntityId(a);
 }
 
 MovableGameEntity* GameMap::getAnimatedObject(const std::string& name) const
 {
-    for (MovableGameEntity* mge : mAnimatedObjects)
-    {
-        if (mge->getName().compare(name) == 0)
-            return mge;
-    }
+    return getEntityByName(mAnimatedObjectsByName, name);
+}
 
-    return nullptr;
+MovableGameEntity* GameMap::getAnimatedObjectFromId(uint32_t id) const
+{
+    std::unordered_map<uint32_t, MovableGameEntity*>::const_iterator it = mAnimatedObjectsById.find(id);
+    if(it == mAnimatedObjectsById.end())
+        return nullptr;
+
+    return it->second;
 }
 
 void GameMap::addRenderedMovableEntity(RenderedMovableEntity *obj)
@@ -833,6 +1143,7 @@ void GameMap::addRenderedMovableEntity(RenderedMovableEntity *obj)
     OD_LOG_INF(serverStr() + "Adding rendered object " + obj->getName()
         + ",MeshName=" + obj->getMeshName());
     mRenderedMovableEntities.push_back(obj);
+    registerEntityName(mRenderedMovableEntitiesByName, obj);
 }
 
 void GameMap::removeRenderedMovableEntity(RenderedMovableEntity *obj)
@@ -847,16 +1158,30 @@ void GameMap::removeRenderedMovableEntity(RenderedMovableEntity *obj)
     }
 
     mRenderedMovableEntities.erase(it);
+    unregisterEntityName(mRenderedMovableEntitiesByName, mRenderedMovableEntities, obj);
 }
 
 RenderedMovableEntity* GameMap::getRenderedMovableEntity(const std::string& name)
 {
-    for(RenderedMovableEntity* renderedMovableEntity : mRenderedMovableEntities)
+    return getEntityByName(mRenderedMovableEntitiesByName, name);
+}
+
+RenderedMovableEntity* GameMap::getRenderedMovableEntityFromId(uint32_t id) const
+{
+    // Every animated object that is not a creature or a map light is a rendered movable entity
+    MovableGameEntity* entity = getAnimatedObjectFromId(id);
+    if(entity == nullptr)
+        return nullptr;
+
+    switch(entity->getObjectType())
     {
-        if(name.compare(renderedMovableEntity->getName()) == 0)
-            return renderedMovableEntity;
+        case GameEntityType::creature:
+        case GameEntityType::mapLight:
+            return nullptr;
+
+        default:
+            return static_cast<RenderedMovableEntity*>(entity);
     }
-    return nullptr;
 }
 
 void GameMap::addActiveObject(GameEntity *a)
@@ -1064,18 +1389,26 @@ void GameMap::destroyAllEntities()
 
 Creature* GameMap::getCreature(const std::string& cName) const
 {
-    for (Creature* creature : mCreatures)
-    {
-        if (creature->getName().compare(cName) == 0)
-            return creature;
-    }
-    return nullptr;
+    return getEntityByName(mCreaturesByName, cName);
+}
+
+Creature* GameMap::getCreatureFromId(uint32_t id) const
+{
+    MovableGameEntity* entity = getAnimatedObjectFromId(id);
+    if((entity == nullptr) || (entity->getObjectType() != GameEntityType::creature))
+        return nullptr;
+
+    return static_cast<Creature*>(entity);
 }
 
 void GameMap::doTurn(double timeSinceLastTurn)
 {
     OD_LOG_INF("Computing turn " + Helper::toString(mTurnNumber) + ", timeSinceLastTurn=" + Helper::toString(timeSinceLastTurn));
     unsigned int numCallsTo_path_atStart = mNumCallsTo_path;
+    unsigned int numPathCacheHitsAtStart = mNumPathCacheHits;
+    unsigned int numPathCacheMissesAtStart = mNumPathCacheMisses;
+    // Paths depend on creatures and buildings states that may have changed since last turn
+    mPathCache.clear();
 
     uint32_t miscUpkeepTime = doMiscUpkeep(timeSinceLastTurn);
 
@@ -1088,17 +1421,193 @@ void GameMap::doTurn(double timeSinceLastTurn)
     }
 
     OD_LOG_INF("During this turn there were " + Helper::toString(mNumCallsTo_path - numCallsTo_path_atStart)
-        + " calls to GameMap::path(), miscUpkeepTime=" + Helper::toString(miscUpkeepTime));
+        + " calls to GameMap::path() (path cache hits=" + Helper::toString(mNumPathCacheHits - numPathCacheHitsAtStart)
+        + ", misses=" + Helper::toString(mNumPathCacheMisses - numPathCacheMissesAtStart)
+        + "), miscUpkeepTime=" + Helper::toString(miscUpkeepTime));
+}
+
+void GameMap::updateVision()
+{
+    // The vision given when a tile is claimed by an enemy only lasts one turn
+    for(Seat* seat : mSeats)
+        seat->clearTemporaryVision();
+
+    // If the FOW is deactivated, we give vision on every tile to every seat
+    if(mIsFOWActivated == mIsVisionGivenOnAllTiles)
+    {
+        mIsVisionGivenOnAllTiles = !mIsFOWActivated;
+        for(int jj = 0; jj < getMapSizeY(); ++jj)
+        {
+            for(int ii = 0; ii < getMapSizeX(); ++ii)
+            {
+                Tile* tile = getTile(ii, jj);
+                for(Seat* seat : mSeats)
+                {
+                    if(mIsVisionGivenOnAllTiles)
+                        tile->addSeatVision(seat);
+                    else
+                        tile->removeSeatVision(seat);
+                }
+            }
+        }
+    }
+
+    // The first time, we check every tile. Then, only the ones where claiming changed
+    if(!mIsVisionInitialized)
+    {
+        mIsVisionInitialized = true;
+        for(int jj = 0; jj < getMapSizeY(); ++jj)
+        {
+            for(int ii = 0; ii < getMapSizeX(); ++ii)
+                getTile(ii, jj)->updateVision();
+        }
+    }
+
+    for(Tile* tile : mTilesClaimChanged)
+    {
+        tile->setIsVisionDirty(false);
+        tile->updateVision();
+    }
+    mTilesClaimChanged.clear();
+
+    // Creatures only compute their vision again if they moved or if a tile close to them changed. The tiles
+    // in sight are computed in parallel. Then, the vision is given to the seats by this thread
+    std::vector<Creature*> creaturesVision;
+    int sightRadiusMax = 0;
+    for(Creature* creature : mCreatures)
+    {
+        if(!creature->prepareVisionUpdate(mTilesOcclusionChanged))
+            continue;
+
+        creaturesVision.push_back(creature);
+        sightRadiusMax = std::max(sightRadiusMax, creature->getDefinition()->getSightRadius());
+    }
+
+    prepareTileDistance(sightRadiusMax);
+    getThreadPool().parallelFor(creaturesVision.size(), [&creaturesVision](uint32_t index)
+    {
+        creaturesVision[index]->updateTilesInSight();
+    });
+
+    for(Creature* creature : creaturesVision)
+        creature->commitVisionUpdate();
+
+    for(Tile* tile : mTilesOcclusionChanged)
+        tile->setIsOcclusionDirty(false);
+    mTilesOcclusionChanged.clear();
+
+    for(Spell* spell : mSpells)
+        spell->updateVision();
+}
+
+void GameMap::computeCreaturesPerception()
+{
+    PhaseTimer timer(mPhaseTimings.mPerceptionUs);
+
+    // The perception checks if paths exist, which resolves the floodfill colors
+    flattenFloodFillForests();
+
+    getThreadPool().parallelFor(mCreatures.size(), [this](uint32_t index)
+    {
+        mCreatures[index]->computePerception();
+    });
+}
+
+void GameMap::setNbWorkerThreads(uint32_t nbWorkers)
+{
+    mNbWorkerThreads = nbWorkers;
+    mThreadPool.reset();
+}
+
+ThreadPool& GameMap::getThreadPool()
+{
+    if(mThreadPool == nullptr)
+    {
+        OD_LOG_INF(serverStr() + "Starting " + Helper::toString(mNbWorkerThreads) + " worker threads");
+        mThreadPool = Utils::make_unique<ThreadPool>(mNbWorkerThreads);
+    }
+
+    return *mThreadPool;
+}
+
+void GameMap::notifyTileClaimChanged(Tile* tile)
+{
+    if(!mIsServerGameMap)
+        return;
+
+    notifyTileJobsChanged(tile);
+
+    // Claimed walls can only be dug by their team
+    for(DigDistanceField& digField : mDigDistanceFields)
+        digField.mField.setTileChanged(tile->getX(), tile->getY());
+
+    uint8_t claimOwner = getClaimOwner(tile->getX(), tile->getY());
+    uint8_t newClaimOwner = tile->isClaimed() ? getClaimOwnerFromSeat(tile->getSeat()) : NO_CLAIM_OWNER;
+    if(claimOwner != newClaimOwner)
+    {
+        if(claimOwner != NO_CLAIM_OWNER)
+            mSeats[claimOwner - 1]->decrementNumClaimedTiles();
+        if(newClaimOwner != NO_CLAIM_OWNER)
+            mSeats[newClaimOwner - 1]->incrementNumClaimedTiles();
+
+        setClaimOwner(tile->getX(), tile->getY(), newClaimOwner);
+    }
+
+    if(tile->getIsVisionDirty())
+        return;
+
+    tile->setIsVisionDirty(true);
+    mTilesClaimChanged.push_back(tile);
+}
+
+void GameMap::notifyTileOcclusionChanged(Tile* tile)
+{
+    if(!mIsServerGameMap)
+        return;
+
+    if(tile->getIsOcclusionDirty())
+        return;
+
+    tile->setIsOcclusionDirty(true);
+    mTilesOcclusionChanged.push_back(tile);
+}
+
+void GameMap::notifyTileJobsChanged(Tile* tile)
+{
+    if(!mIsServerGameMap)
+        return;
+
+    for(Seat* seat : mSeats)
+    {
+        if(seat->mJobBoard == nullptr)
+            continue;
+
+        seat->mJobBoard->notifyTileChanged(*tile);
+    }
+}
+
+void GameMap::notifyTileEntitiesChanged(Tile* tile)
+{
+    if(!mIsServerGameMap)
+        return;
+
+    for(Seat* seat : mSeats)
+    {
+        if(seat->mJobBoard == nullptr)
+            continue;
+
+        seat->mJobBoard->notifyTileEntitiesChanged(*tile);
+    }
 }
 
 void GameMap::doPlayerAITurn(double timeSinceLastTurn)
 {
+    PhaseTimer timer(mPhaseTimings.mAIUs);
     mAiManager.doTurn(timeSinceLastTurn);
 }
 
 unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
 {
-    Tile *tempTile;
     Ogre::Timer stopwatch;
     unsigned long int timeTaken;
 
@@ -1117,22 +1626,23 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
 
             // We notify the player if he owns a fighter only
             bool isCreatureSeat = false;
-            for(Creature* creature : mCreatures)
+            auto itCreatures = mCreaturesBySeat.find(player->getSeat()->getId());
+            if(itCreatures != mCreaturesBySeat.end())
             {
-                if(creature->getSeat() != player->getSeat())
-                    continue;
-
-                if(creature->getDefinition()->isWorker())
-                    continue;
+                for(Creature* creature : itCreatures->second)
+                {
+                    if(creature->getDefinition()->isWorker())
+                        continue;
 
-                isCreatureSeat = true;
-                break;
+                    isCreatureSeat = true;
+                    break;
+                }
             }
 
             if(!isCreatureSeat)
                 continue;
 
-            ServerNotification *serverNotification = new ServerNotification(
+            ServerNotification *serverNotification = ServerNotification::create(
                 ServerNotificationType::chatServer, player);
             serverNotification->mPacket << "It's pay day !" << EventShortNoticeType::majorGameEvent;
             ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -1160,80 +1670,47 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
             addWinningSeat(seat);
 
         seat->mNumCreaturesFightersMax = getMaxNumberCreatures(seat);
-
-        // Set the creatures count to 0. It will be reset by the next count in doTurn()
-        seat->mNumCreaturesFighters = 0;
-        seat->mNumCreaturesWorkers = 0;
     }
 
-    // Count how many creatures the player controls
-    for(Creature* creature : mCreatures)
-    {
-        // Check to see if the creature has died.
-        if (!creature->isAlive())
-            continue;
-
-        Seat *tempSeat = creature->getSeat();
-        if(tempSeat == nullptr)
-            continue;
-
-        // We only count fighters
-        if (creature->getDefinition()->isWorker())
-            ++(tempSeat->mNumCreaturesWorkers);
-        else
-            ++(tempSeat->mNumCreaturesFighters);
-    }
+    // The gold, claimed tiles and creatures are counted once. Then, the counts are updated
+    // when they change
+    if(!mIsSeatsEconomyInitialized)
+        countSeatsEconomy();
 
-    // At each upkeep, we re-compute tiles with vision
-    for (Seat* seat : mSeats)
-        seat->clearTilesWithVision();
-
-    for (int jj = 0; jj < getMapSizeY(); ++jj)
-    {
-        for (int ii = 0; ii < getMapSizeX(); ++ii)
-        {
-            getTile(ii,jj)->clearVision();
-        }
-    }
+#ifdef OD_DEBUG
+    checkSeatsEconomy();
+#endif
 
     // Compute vision. We need to compute every seats including AI because
     // a human can be allied with an AI and they would share vision
-    for (int jj = 0; jj < getMapSizeY(); ++jj)
-    {
-        for (int ii = 0; ii < getMapSizeX(); ++ii)
-        {
-            getTile(ii,jj)->computeVisibleTiles();
-        }
-    }
-
-    for (Creature* creature : mCreatures)
     {
-        creature->computeVisibleTiles();
-    }
+        PhaseTimer timer(mPhaseTimings.mVisionUs);
+        updateVision();
 
-    for (Spell* spell : mSpells)
-    {
-        spell->computeVisibleTiles();
-    }
+        for (Seat* seat : mSeats)
+        {
+            if(!seat->getIsDebuggingVision())
+                continue;
 
-    for (Seat* seat : mSeats)
-    {
-        if(!seat->getIsDebuggingVision())
-            continue;
+            seat->refreshSeatVisualDebug();
+        }
 
-        seat->refreshSeatVisualDebug();
+        // We send to each seat the list of tiles he has vision on
+        for (Seat* seat : mSeats)
+            seat->sendVisibleTiles();
     }
 
-    // We send to each seat the list of tiles he has vision on
-    for (Seat* seat : mSeats)
-        seat->sendVisibleTiles();
+    computeCreaturesPerception();
 
     // Carry out the upkeep round of all the active objects in the game.
     // Here, we work on a copy of the active objects list because they might
     // try to remove themselves which would break the iterator
-    std::vector<GameEntity*> activeObjects = mActiveObjects;
-    for(GameEntity* ge : activeObjects)
-        ge->doUpkeep();
+    {
+        PhaseTimer timer(mPhaseTimings.mActiveObjectsUs);
+        std::vector<GameEntity*> activeObjects = mActiveObjects;
+        for(GameEntity* ge : activeObjects)
+            ge->doUpkeep();
+    }
 
     // Carry out the upkeep round for each seat. This means recomputing how much gold is
     // available in their treasuries, how much mana they gain/lose during this turn, etc.
@@ -1260,41 +1737,98 @@ unsigned long int GameMap::doMiscUpkeep(double timeSinceLastTurn)
         }
 
         // Update the count on how much gold is available in all of the treasuries claimed by the given seat.
-        seat->mGold = 0;
-        seat->mGoldMax = 0;
-        for (Room* room : getRooms())
-        {
-            if(room->getSeat() != seat)
-                continue;
+        seat->mGold = seat->mTreasuryGold;
+        seat->mGoldMax = seat->mTreasuryGoldMax;
+    }
+
+    timeTaken = stopwatch.getMicroseconds();
+    return timeTaken;
+}
 
-            seat->mGold += room->getTotalGoldStored();
-            seat->mGoldMax += room->getTotalGoldStorage();
+void GameMap::countSeatsEconomy()
+{
+    mIsSeatsEconomyInitialized = true;
+    for(Seat* seat : mSeats)
+    {
+        seat->mTreasuryGold = 0;
+        seat->mTreasuryGoldMax = 0;
+        seat->setNumClaimedTiles(0);
+        seat->mNumCreaturesFighters = 0;
+        seat->mNumCreaturesWorkers = 0;
+    }
+
+    for(Room* room : mRooms)
+        notifyTreasuryGoldChanged(room->getSeat(), room->getTotalGoldStored(), room->getTotalGoldStorage());
+
+    for(int jj = 0; jj < getMapSizeY(); ++jj)
+    {
+        for(int ii = 0; ii < getMapSizeX(); ++ii)
+        {
+            Tile* tile = getTile(ii, jj);
+            uint8_t claimOwner = tile->isClaimed() ? getClaimOwnerFromSeat(tile->getSeat()) : NO_CLAIM_OWNER;
+            setClaimOwner(ii, jj, claimOwner);
+            if(claimOwner != NO_CLAIM_OWNER)
+                mSeats[claimOwner - 1]->incrementNumClaimedTiles();
         }
     }
 
-    // Determine the number of tiles claimed by each seat.
-    // Begin by setting the number of claimed tiles for each seat to 0.
-    for (Seat* seat : mSeats)
-        seat->setNumClaimedTiles(0);
+    for(Creature* creature : mCreatures)
+        countCreature(creature, creature->getSeat(), 1);
+}
 
-    // Now loop over all of the tiles, if the tile is claimed increment the given seats count.
-    for (int jj = 0; jj < getMapSizeY(); ++jj)
+void GameMap::checkSeatsEconomy()
+{
+    for(Seat* seat : mSeats)
     {
-        for (int ii = 0; ii < getMapSizeX(); ++ii)
+        int gold = 0;
+        int goldMax = 0;
+        for(Room* room : mRooms)
         {
-            tempTile = getTile(ii,jj);
+            if(room->getSeat() != seat)
+                continue;
 
-            // Check to see if the current tile is claimed by anyone.
-            if (tempTile->isClaimed())
+            gold += room->getTotalGoldStored();
+            goldMax += room->getTotalGoldStorage();
+        }
+
+        unsigned int nbClaimedTiles = 0;
+        for(int jj = 0; jj < getMapSizeY(); ++jj)
+        {
+            for(int ii = 0; ii < getMapSizeX(); ++ii)
             {
-                // Increment the count of the seat who owns the tile.
-                tempTile->getSeat()->incrementNumClaimedTiles();
+                Tile* tile = getTile(ii, jj);
+                if(tile->isClaimed() && (tile->getSeat() == seat))
+                    ++nbClaimedTiles;
             }
         }
-    }
 
-    timeTaken = stopwatch.getMicroseconds();
-    return timeTaken;
+        int nbFighters = 0;
+        int nbWorkers = 0;
+        for(Creature* creature : mCreatures)
+        {
+            if(!creature->isAlive() || (creature->getSeat() != seat))
+                continue;
+
+            if(creature->getDefinition()->isWorker())
+                ++nbWorkers;
+            else
+                ++nbFighters;
+        }
+
+        if((gold != seat->mTreasuryGold) ||
+           (goldMax != seat->mTreasuryGoldMax) ||
+           (nbClaimedTiles != seat->getNumClaimedTiles()) ||
+           (nbFighters != seat->mNumCreaturesFighters) ||
+           (nbWorkers != seat->mNumCreaturesWorkers))
+        {
+            OD_LOG_ERR("seatId=" + Helper::toString(seat->getId())
+                + ", gold=" + Helper::toString(seat->mTreasuryGold) + "/" + Helper::toString(gold)
+                + ", goldMax=" + Helper::toString(seat->mTreasuryGoldMax) + "/" + Helper::toString(goldMax)
+                + ", claimedTiles=" + Helper::toString(seat->getNumClaimedTiles()) + "/" + Helper::toString(nbClaimedTiles)
+                + ", fighters=" + Helper::toString(seat->mNumCreaturesFighters) + "/" + Helper::toString(nbFighters)
+                + ", workers=" + Helper::toString(seat->mNumCreaturesWorkers) + "/" + Helper::toString(nbWorkers));
+        }
+    }
 }
 
 void GameMap::updateAnimations(Ogre::Real timeSinceLastFrame)
@@ -1392,24 +1926,7 @@ bool GameMap::pathExists(const Creature* creature, Tile* tileStart, Tile* tileEn
     if(creature == nullptr)
         return false;
 
-    FloodFillType floodFill = FloodFillType::ground;
-    if((creature->getMoveSpeedGround() > 0.0) &&
-        (creature->getMoveSpeedWater() > 0.0) &&
-        (creature->getMoveSpeedLava() > 0.0))
-    {
-        floodFill = FloodFillType::groundWaterLava;
-    }
-    if((creature->getMoveSpeedGround() > 0.0) &&
-        (creature->getMoveSpeedWater() > 0.0))
-    {
-        floodFill = FloodFillType::groundWater;
-    }
-    if((creature->getMoveSpeedGround() > 0.0) &&
-        (creature->getMoveSpeedLava() > 0.0))
-    {
-        floodFill = FloodFillType::groundLava;
-    }
-
+    FloodFillType floodFill = getCreatureFloodFillType(*creature);
     if(creature->getDefinition()->isWorker())
     {
         // Workers can go on a tile if and only if the path is open for any creature. If it is closed, that
@@ -1434,6 +1951,8 @@ bool GameMap::pathExists(const Creature* creature, Tile* tileStart, Tile* tileEn
 
 std::list<Tile*> GameMap::path(int x1, int y1, int x2, int y2, const Creature* creature, Seat* seat, bool throughDiggableTiles)
 {
+    PhaseTimer timer(mPhaseTimings.mPathUs);
+    ++mPhaseTimings.mNbPathCalls;
     ++mNumCallsTo_path;
     std::list<Tile*> returnList;
 
@@ -1454,199 +1973,183 @@ std::list<Tile*> GameMap::path(int x1, int y1, int x2, int y2, const Creature* c
     if (!throughDiggableTiles && !pathExists(creature, start, destination))
         return returnList;
 
-    AstarEntry *currentEntry = new AstarEntry(start, x1, y1, x2, y2);
-    AstarEntry neighbor;
+    // Paths through diggable tiles are rarely asked for so we don't cache them
+    PathCacheKey cacheKey = {0, 0, 0, 0, 0.0, 0.0, 0.0};
+    if(!throughDiggableTiles)
+    {
+        cacheKey.mStart = Pathfinding::AstarSearch::getIndex(x1, y1, getMapSizeX());
+        cacheKey.mDestination = Pathfinding::AstarSearch::getIndex(x2, y2, getMapSizeX());
+        cacheKey.mSeatId = creature->getSeat()->getId();
+        setCreatureMovementKey(cacheKey, *creature);
+        auto it = mPathCache.find(cacheKey);
+        if(it != mPathCache.end())
+        {
+            ++mNumPathCacheHits;
+            return getTilesFromIndexes(it->second);
+        }
+        ++mNumPathCacheMisses;
+    }
 
-    std::vector<AstarEntry*> openList;
-    openList.push_back(currentEntry);
+    PathfindingGrid grid(*this, *creature, seat, throughDiggableTiles);
+    if(!mAstarSearch.search(grid, x1, y1, x2, y2, mPathTileIndexes))
+        mPathTileIndexes.clear();
 
-    // This list will contain the processed and the to process entries
-    // allowing to quickly know if a tile has been processed or not
-    std::vector<std::vector<AstarEntry*>> processList(getMapSizeX(), std::vector<AstarEntry*>(getMapSizeY(), nullptr));
-    processList[currentEntry->getTile()->getX()][currentEntry->getTile()->getY()] = currentEntry;
-    AstarEntry* destinationEntry = nullptr;
-    while (true)
-    {
-        // if the openList is empty we failed to find a path
-        if (openList.empty())
-            break;
+    if(!throughDiggableTiles)
+        mPathCache[cacheKey] = mPathTileIndexes;
+
+    return getTilesFromIndexes(mPathTileIndexes);
+}
 
-        // openList being sorted, the last element is the smallest
-        AstarEntry* smallestAstar = *openList.rbegin();
-        openList.pop_back();
+std::list<Tile*> GameMap::flowFieldPath(const Creature* creature, Tile* destination)
+{
+    std::list<Tile*> returnList;
+    if((creature == nullptr) || (destination == nullptr))
+        return returnList;
 
-        currentEntry = smallestAstar;
-        currentEntry->setHasBeenProcessed();
+    Tile* start = creature->getPositionTile();
+    if(start == nullptr)
+        return returnList;
 
-        // We found the path, break out of the search loop
-        if (currentEntry->getTile() == destination)
+    if(!pathExists(creature, start, destination))
+        return returnList;
+
+    // The field is computed from the destination through the tiles the creature can go through. If the creature is on
+    // a tile it cannot go through (like a locked door) or the destination cannot be walked on, we search the path
+    if(!creature->canGoThroughTile(start) || !creature->canGoThroughTile(destination))
+        return path(creature, destination);
+
+    PhaseTimer timer(mPhaseTimings.mPathUs);
+    FlowFieldKey key;
+    key.mDestination = Pathfinding::AstarSearch::getIndex(destination->getX(), destination->getY(), getMapSizeX());
+    key.mSeatId = creature->getSeat()->getId();
+    setCreatureMovementKey(key, *creature);
+    auto it = mFlowFields.find(key);
+    if((it != mFlowFields.end()) && (it->second.mComputedTurn + FLOW_FIELD_LIFETIME_TURNS < mTurnNumber))
+    {
+        mFlowFields.erase(it);
+        it = mFlowFields.end();
+    }
+
+    if(it == mFlowFields.end())
+    {
+        if(mFlowFields.size() >= MAX_FLOW_FIELDS)
         {
-            destinationEntry = currentEntry;
-            break;
+            auto itOldest = std::min_element(mFlowFields.begin(), mFlowFields.end(),
+                [](const std::pair<const FlowFieldKey, FlowFieldEntry>& entry1,
+                   const std::pair<const FlowFieldKey, FlowFieldEntry>& entry2)
+                {
+                    return entry1.second.mLastUsedTurn < entry2.second.mLastUsedTurn;
+                });
+            mFlowFields.erase(itOldest);
         }
 
-        // Check the tiles surrounding the current square
-        bool areTilesPassable[4] = {false, false, false, false};
-        // Note : to disable diagonals, process tiles from 0 to 3. To allow them, process tiles from 0 to 7
-        for (unsigned int i = 0; i < 8; ++i)
-        {
-            Tile* neighborTile = nullptr;
-            switch(i)
-            {
-                // We process the 4 adjacent tiles
-                case 0:
-                    neighborTile = getTile(currentEntry->getTile()->getX() - 1, currentEntry->getTile()->getY());
-                    break;
-                case 1:
-                    neighborTile = getTile(currentEntry->getTile()->getX() + 1, currentEntry->getTile()->getY());
-                    break;
-                case 2:
-                    neighborTile = getTile(currentEntry->getTile()->getX(), currentEntry->getTile()->getY() - 1);
-                    break;
-                case 3:
-                    neighborTile = getTile(currentEntry->getTile()->getX(), currentEntry->getTile()->getY() + 1);
-                    break;
-                // We process the 4 diagonal tiles. We only process a diagonal tile if the 2 tiles adjacent to the original one are
-                // passable.
-                case 4:
-                    if(areTilesPassable[0] && areTilesPassable[2])
-                        neighborTile = getTile(currentEntry->getTile()->getX() - 1, currentEntry->getTile()->getY() - 1);
-                    break;
-                case 5:
-                    if(areTilesPassable[0] && areTilesPassable[3])
-                        neighborTile = getTile(currentEntry->getTile()->getX() - 1, currentEntry->getTile()->getY() + 1);
-                    break;
-                case 6:
-                    if(areTilesPassable[1] && areTilesPassable[2])
-                        neighborTile = getTile(currentEntry->getTile()->getX() + 1, currentEntry->getTile()->getY() - 1);
-                    break;
-                case 7:
-                    if(areTilesPassable[1] && areTilesPassable[3])
-                        neighborTile = getTile(currentEntry->getTile()->getX() + 1, currentEntry->getTile()->getY() + 1);
-                    break;
-                default:
-                    break;
-            }
-            if(neighborTile == nullptr)
-                continue;
+        it = mFlowFields.emplace(key, FlowFieldEntry()).first;
+        it->second.mComputedTurn = mTurnNumber;
+        PathfindingGrid grid(*this, *creature, creature->getSeat(), false);
+        it->second.mField.compute(grid, destination->getX(), destination->getY());
+    }
+    it->second.mLastUsedTurn = mTurnNumber;
+
+    if(!it->second.mField.getPath(start->getX(), start->getY(), mPathTileIndexes))
+        return returnList;
 
-            neighbor.setTile(neighborTile);
+    return getTilesFromIndexes(mPathTileIndexes);
+}
 
-            bool processNeighbor = false;
-            // We process the tile if the creature can go through. But if it is the first tile that is
-            // not passable, we also process it. That happens if a door is closed
-            if((creature->canGoThroughTile(neighbor.getTile())) ||
-               (neighbor.getTile() == start))
-            {
-                processNeighbor = true;
-                // We set passability for the 4 adjacent tiles only
-                if(i < 4)
-                    areTilesPassable[i] = true;
-             }
-            else if(throughDiggableTiles && neighbor.getTile()->isDiggable(seat))
-                processNeighbor = true;
-
-            if (!processNeighbor)
-                continue;
+std::list<Tile*> GameMap::getTilesFromIndexes(const std::vector<uint32_t>& indexes) const
+{
+    std::list<Tile*> tiles;
+    for(uint32_t index : indexes)
+    {
+        tiles.push_back(getTile(Pathfinding::AstarSearch::getX(index, getMapSizeX()),
+            Pathfinding::AstarSearch::getY(index, getMapSizeX())));
+    }
 
-            // See if the neighbor has already been processed
-            AstarEntry* neighborEntry = processList[neighbor.getTile()->getX()][neighbor.getTile()->getY()];
-            if ((neighborEntry != nullptr) && (neighborEntry->getHasBeenProcessed()))
-                continue;
+    return tiles;
+}
 
-            // If the neighbor is not in the open list
-            if (neighborEntry == nullptr)
-            {
-                double weightToParent = AstarEntry::computeHeuristic(neighbor.getTile()->getX(), neighbor.getTile()->getY(),
-                    currentEntry->getTile()->getX(), currentEntry->getTile()->getY());
-
-                if(currentEntry->getTile()->getFullness() == 0)
-                    weightToParent /= creature->getMoveSpeed(currentEntry->getTile());
-                else
-                    weightToParent /= creature->getMoveSpeedGround();
-                neighbor.setG(currentEntry->getG() + weightToParent);
-
-                // Use the manhattan distance for the heuristic
-                neighbor.setHeuristic(neighbor.getTile()->getX(), neighbor.getTile()->getY(), x2, y2);
-                neighbor.setParent(currentEntry);
-
-                AstarEntry* entry = new AstarEntry(neighbor);
-                auto itr = openList.begin();
-                while((itr != openList.end()) &&
-                      ((*itr)->fCost() > entry->fCost()))
-                {
-                    ++itr;
-                }
+bool GameMap::findDigPath(const Creature& worker, Tile* start, const std::vector<Tile*>& targets, std::vector<Tile*>& path)
+{
+    // The same targets given in another order use the same field
+    std::vector<uint32_t> targetIndexes;
+    for(Tile* tile : targets)
+        targetIndexes.push_back(Pathfinding::AstarSearch::getIndex(tile->getX(), tile->getY(), getMapSizeX()));
 
-                openList.insert(itr, entry);
-                processList[neighbor.getTile()->getX()][neighbor.getTile()->getY()] = entry;
-            }
-            else
-            {
-                // If this path to the given neighbor tile is a shorter path than the
-                // one already given, make this the new parent.
-                double weightToParent = AstarEntry::computeHeuristic(neighbor.getTile()->getX(), neighbor.getTile()->getY(),
-                    currentEntry->getTile()->getX(), currentEntry->getTile()->getY());
+    std::sort(targetIndexes.begin(), targetIndexes.end());
+    targetIndexes.erase(std::unique(targetIndexes.begin(), targetIndexes.end()), targetIndexes.end());
 
-                if(currentEntry->getTile()->getFullness() == 0)
-                    weightToParent /= creature->getMoveSpeed(currentEntry->getTile());
-                else
-                    weightToParent /= creature->getMoveSpeedGround();
+    return findDigPathToTargets(worker, start, targetIndexes, false, path);
+}
 
-                if (currentEntry->getG() + weightToParent < neighborEntry->getG())
-                {
-                    neighborEntry->setG(currentEntry->getG() + weightToParent);
-                    neighborEntry->setParent(currentEntry);
+bool GameMap::findDigPathToGold(const Creature& worker, Tile* start, std::vector<Tile*>& path)
+{
+    return findDigPathToTargets(worker, start, std::vector<uint32_t>(), true, path);
+}
 
-                    // The cost changed. We need to re-order openList
-                    auto itr = std::find(openList.begin(), openList.end(), neighborEntry);
-                    if(itr == openList.end())
-                    {
-                        OD_LOG_ERR("Unexpected entry not found tileStart=" + Tile::displayAsString(start)
-                            + ", tileDest=" + Tile::displayAsString(destination)
-                            + ", tile=" + Tile::displayAsString(neighborEntry->getTile()));
-                    }
-                    else
-                    {
-                        itr = openList.erase(itr);
-                        // We look for the new location
-                        while((itr != openList.end()) &&
-                              ((*itr)->fCost() > neighborEntry->fCost()))
-                        {
-                            ++itr;
-                        }
-
-                        openList.insert(itr, neighborEntry);
-                    }
-                }
-            }
-        }
+bool GameMap::findDigPathToTargets(const Creature& worker, Tile* start, const std::vector<uint32_t>& targetIndexes,
+    bool isGoldField, std::vector<Tile*>& path)
+{
+    PhaseTimer timer(mPhaseTimings.mPathUs);
+    path.clear();
+    Seat* seat = worker.getSeat();
+    if((start == nullptr) || (seat == nullptr))
+        return false;
+    if(!isGoldField && targetIndexes.empty())
+        return false;
+
+    // The workers that cannot go through the same tiles cannot use the same field
+    uint32_t movementClass = getCreatureMovementClass(worker);
+    DigDistanceField* digField = nullptr;
+    for(DigDistanceField& field : mDigDistanceFields)
+    {
+        if(field.mSeatId != seat->getId())
+            continue;
+        if(field.mMovementClass != movementClass)
+            continue;
+        if(field.mIsGoldField != isGoldField)
+            continue;
+        if(field.mTargets != targetIndexes)
+            continue;
+
+        digField = &field;
+        break;
     }
 
-    if (destinationEntry != nullptr)
+    if(digField == nullptr)
     {
-        // Follow the parent chain back the the starting tile
-        AstarEntry* curEntry = destinationEntry;
-        do
+        if(mDigDistanceFields.size() < MAX_DIG_DISTANCE_FIELDS)
         {
-            if (curEntry->getTile() != nullptr)
-            {
-                returnList.push_front(curEntry->getTile());
-                curEntry = curEntry->getParent();
-            }
-
-        } while (curEntry != nullptr);
+            mDigDistanceFields.push_back(DigDistanceField());
+            digField = &mDigDistanceFields.back();
+        }
+        else
+        {
+            digField = &*std::min_element(mDigDistanceFields.begin(), mDigDistanceFields.end(),
+                [](const DigDistanceField& field1, const DigDistanceField& field2)
+                {
+                    return field1.mLastUsedTurn < field2.mLastUsedTurn;
+                });
+        }
+        digField->mSeatId = seat->getId();
+        digField->mMovementClass = movementClass;
+        digField->mIsGoldField = isGoldField;
+        digField->mTargets = targetIndexes;
+        digField->mField = Pathfinding::DistanceField();
     }
+    digField->mLastUsedTurn = mTurnNumber;
+
+    DigCostGrid grid(*this, worker, seat, digField->mTargets, digField->mIsGoldField);
+    digField->mField.update(grid);
+    if(!digField->mField.getPath(start->getX(), start->getY(), mPathTileIndexes))
+        return false;
 
-    // Clean up the memory we allocated by deleting the astarEntries.  Note that
-    // processList contains all the created entries so it is enough to clean it.
-    for (std::vector<AstarEntry*>& column : processList)
+    for(uint32_t index : mPathTileIndexes)
     {
-        for (AstarEntry* entry : column)
-            delete entry;
+        path.push_back(getTile(Pathfinding::AstarSearch::getX(index, getMapSizeX()),
+            Pathfinding::AstarSearch::getY(index, getMapSizeX())));
     }
 
-    return returnList;
+    return true;
 }
 
 bool GameMap::addPlayer(Player* player)
@@ -1705,6 +2208,8 @@ Player* GameMap::getPlayerBySeat(Seat* seat) const
 std::vector<GameEntity*> GameMap::getVisibleForce(const std::vector<Tile*>& visibleTiles, Seat* seat, bool enemyForce)
 {
     std::vector<GameEntity*> returnList;
+    // Buildings can cover many tiles. We keep them apart to not look for them in the creatures
+    std::vector<Building*> buildings;
 
     // Loop over the visible tiles
     for (Tile* tile : visibleTiles)
@@ -1722,8 +2227,9 @@ std::vector<GameEntity*> GameMap::getVisibleForce(const std::vector<Tile*>& visi
             if((building != nullptr) &&
                (!building->getSeat()->isAlliedSeat(seat)) &&
                (building->isAttackable(tile, seat)) &&
-               (std::find(returnList.begin(), returnList.end(), building) == returnList.end()))
+               (std::find(buildings.begin(), buildings.end(), building) == buildings.end()))
             {
+                buildings.push_back(building);
                 returnList.push_back(building);
             }
         }
@@ -1733,8 +2239,9 @@ std::vector<GameEntity*> GameMap::getVisibleForce(const std::vector<Tile*>& visi
             Building* building = tile->getCoveringBuilding();
             if((building != nullptr) &&
                (building->getSeat()->isAlliedSeat(seat)) &&
-               (std::find(returnList.begin(), returnList.end(), building) == returnList.end()))
+               (std::find(buildings.begin(), buildings.end(), building) == buildings.end()))
             {
+                buildings.push_back(building);
                 returnList.push_back(building);
             }
         }
@@ -1743,6 +2250,98 @@ std::vector<GameEntity*> GameMap::getVisibleForce(const std::vector<Tile*>& visi
     return returnList;
 }
 
+std::vector<GameEntity*> GameMap::getVisibleForce(const VisibleTiles& visibleTiles, Seat* seat, bool enemyForce)
+{
+    std::vector<GameEntity*> returnList;
+    fillWithVisibleCreatures(visibleTiles, seat, enemyForce, returnList);
+
+    // Buildings are not in the entity grid. We look for them in the visible tiles
+    std::vector<Building*> buildings;
+    for (Tile* tile : visibleTiles.getTiles())
+    {
+        Building* building = tile->getCoveringBuilding();
+        if(building == nullptr)
+            continue;
+
+        if(enemyForce)
+        {
+            if(building->getSeat()->isAlliedSeat(seat))
+                continue;
+            if(!building->isAttackable(tile, seat))
+                continue;
+        }
+        else if(!building->getSeat()->isAlliedSeat(seat))
+            continue;
+
+        if(std::find(buildings.begin(), buildings.end(), building) != buildings.end())
+            continue;
+
+        buildings.push_back(building);
+        returnList.push_back(building);
+    }
+
+    return returnList;
+}
+
+std::vector<GameEntity*> GameMap::getVisibleCreatures(const VisibleTiles& visibleTiles, Seat* seat, bool enemyCreatures)
+{
+    std::vector<GameEntity*> returnList;
+    fillWithVisibleCreatures(visibleTiles, seat, enemyCreatures, returnList);
+    return returnList;
+}
+
+void GameMap::fillWithVisibleCreatures(const VisibleTiles& visibleTiles, Seat* seat, bool enemyCreatures,
+    std::vector<GameEntity*>& creatures)
+{
+    int centerX = visibleTiles.getCenterX();
+    int centerY = visibleTiles.getCenterY();
+    int radius = visibleTiles.getRadius();
+    // The visible tiles are within the radius of the center
+    std::vector<GameEntity*> entities;
+    mEntityGrid.getEntitiesInRadius(GameEntityType::creature, centerX, centerY, radius, entities);
+
+    // We keep the order of the visible tiles (closest first). The position is used to stay deterministic
+    std::vector<std::tuple<int, int, int, GameEntity*>> sorted;
+    for(GameEntity* entity : entities)
+    {
+        Tile* tile = entity->getPositionTile();
+        if(tile == nullptr)
+            continue;
+        if(!visibleTiles.isTileVisible(tile))
+            continue;
+        if(entity->getSeat() == nullptr)
+            continue;
+
+        Creature* creature = static_cast<Creature*>(entity);
+        if(!creature->isAlive())
+            continue;
+
+        if(enemyCreatures)
+        {
+            if(seat->isAlliedSeat(entity->getSeat()))
+                continue;
+            if(!creature->isAttackable(tile, seat))
+                continue;
+        }
+        else if(!seat->isAlliedSeat(entity->getSeat()))
+            continue;
+
+        int diffX = tile->getX() - centerX;
+        int diffY = tile->getY() - centerY;
+        sorted.push_back(std::make_tuple(diffX * diffX + diffY * diffY, tile->getY(), tile->getX(), entity));
+    }
+
+    std::stable_sort(sorted.begin(), sorted.end(), [](const std::tuple<int, int, int, GameEntity*>& t1,
+        const std::tuple<int, int, int, GameEntity*>& t2)
+    {
+        return std::make_tuple(std::get<0>(t1), std::get<1>(t1), std::get<2>(t1))
+            < std::make_tuple(std::get<0>(t2), std::get<1>(t2), std::get<2>(t2));
+    });
+
+    for(const std::tuple<int, int, int, GameEntity*>& entry : sorted)
+        creatures.push_back(std::get<3>(entry));
+}
+
 std::vector<GameEntity*> GameMap::getVisibleCreatures(const std::vector<Tile*>& visibleTiles, Seat* seat, bool enemyCreatures)
 {
     std::vector<GameEntity*> returnList;
@@ -1799,6 +2398,9 @@ void GameMap::clearRooms()
     }
 
     mRooms.clear();
+    mRoomsByName.clear();
+    mRoomsByType.clear();
+    mRoomsBySeatAndType.clear();
 }
 
 void GameMap::addRoom(Room *r)
@@ -1812,6 +2414,14 @@ void GameMap::addRoom(Room *r)
     }
 
     mRooms.push_back(r);
+    registerEntityName(mRoomsByName, r);
+
+    uint32_t type = static_cast<uint32_t>(r->getType());
+    mRoomsByType.resize(NB_ROOM_TYPES);
+    mRoomsByType[type].push_back(r);
+    std::vector<std::vector<Room*>>& roomsBySeat = mRoomsBySeatAndType[r->getSeat()->getId()];
+    roomsBySeat.resize(NB_ROOM_TYPES);
+    roomsBySeat[type].push_back(r);
 }
 
 void GameMap::removeRoom(Room *r)
@@ -1827,14 +2437,53 @@ void GameMap::removeRoom(Room *r)
     }
 
     mRooms.erase(it);
+    unregisterEntityName(mRoomsByName, mRooms, r);
+
+    uint32_t type = static_cast<uint32_t>(r->getType());
+    eraseEntity(mRoomsByType[type], r);
+    eraseEntity(mRoomsBySeatAndType[r->getSeat()->getId()][type], r);
+}
+
+const std::vector<Room*>& GameMap::getRoomsOfType(RoomType type) const
+{
+    uint32_t index = static_cast<uint32_t>(type);
+    if(index >= mRoomsByType.size())
+        return NO_ROOMS;
+
+    return mRoomsByType[index];
+}
+
+const std::vector<Room*>& GameMap::getRoomsOfSeat(const Seat* seat, RoomType type) const
+{
+    if(seat == nullptr)
+        return NO_ROOMS;
+
+    auto it = mRoomsBySeatAndType.find(seat->getId());
+    uint32_t index = static_cast<uint32_t>(type);
+    if((it == mRoomsBySeatAndType.end()) || (index >= it->second.size()))
+        return NO_ROOMS;
+
+    return it->second[index];
+}
+
+void GameMap::notifyRoomSeatChanging(Room* room, Seat* newSeat)
+{
+    if(std::find(mRooms.begin(), mRooms.end(), room) == mRooms.end())
+        return;
+
+    uint32_t type = static_cast<uint32_t>(room->getType());
+    eraseEntity(mRoomsBySeatAndType[room->getSeat()->getId()][type], room);
+    std::vector<std::vector<Room*>>& roomsBySeat = mRoomsBySeatAndType[newSeat->getId()];
+    roomsBySeat.resize(NB_ROOM_TYPES);
+    roomsBySeat[type].push_back(room);
 }
 
 std::vector<Room*> GameMap::getRoomsByType(RoomType type) const
 {
     std::vector<Room*> returnList;
-    for (Room* room : mRooms)
+    for (Room* room : getRoomsOfType(type))
     {
-        if (room->getType() == type  && room->getHP(nullptr) > 0.0)
+        if (room->getHP(nullptr) > 0.0)
             returnList.push_back(room);
     }
 
@@ -1844,9 +2493,9 @@ std::vector<Room*> GameMap::getRoomsByType(RoomType type) const
 std::vector<Room*> GameMap::getRoomsByTypeAndSeat(RoomType type, const Seat* seat)
 {
     std::vector<Room*> returnList;
-    for (Room* room : mRooms)
+    for (Room* room : getRoomsOfSeat(seat, type))
     {
-        if (room->getType() == type && room->getSeat() == seat && room->getHP(nullptr) > 0.0)
+        if (room->getHP(nullptr) > 0.0)
             returnList.push_back(room);
     }
 
@@ -1856,9 +2505,9 @@ std::vector<Room*> GameMap::getRoomsByTypeAndSeat(RoomType type, const Seat* sea
 std::vector<const Room*> GameMap::getRoomsByTypeAndSeat(RoomType type, const Seat* seat) const
 {
     std::vector<const Room*> returnList;
-    for (const Room* room : mRooms)
+    for (const Room* room : getRoomsOfSeat(seat, type))
     {
-        if (room->getType() == type && room->getSeat() == seat && room->getHP(nullptr) > 0.0)
+        if (room->getHP(nullptr) > 0.0)
             returnList.push_back(room);
     }
 
@@ -1868,9 +2517,9 @@ std::vector<const Room*> GameMap::getRoomsByTypeAndSeat(RoomType type, const Sea
 unsigned int GameMap::numRoomsByTypeAndSeat(RoomType type, const Seat* seat) const
 {
     int cptRooms = 0;
-    for (Room* room : mRooms)
+    for (const Room* room : getRoomsOfSeat(seat, type))
     {
-        if (room->getType() == type && room->getSeat() == seat && room->getHP(nullptr) > 0.0)
+        if (room->getHP(nullptr) > 0.0)
             ++cptRooms;
     }
     return cptRooms;
@@ -1881,15 +2530,51 @@ std::vector<Room*> GameMap::getReachableRooms(const std::vector<Room*>& vec,
                                               const Creature* creature)
 {
     std::vector<Room*> returnVector;
+    std::vector<Seat*> seats;
+    std::vector<uint32_t> startColors;
+    FloodFillType floodFill = FloodFillType::ground;
+    // If floodfill is not enabled, we cannot check if the path exists so we consider it does
+    if(mFloodFillEnabled)
+    {
+        if(creature == nullptr)
+            return returnVector;
+
+        // Like in pathExists, workers need a path open for every seat and fighters for their seat only
+        if(creature->getDefinition()->isWorker())
+            seats = mSeats;
+        else
+            seats.push_back(creature->getSeat());
+
+        // The colors of the start tile are resolved once. Rooms in the same components are reachable
+        floodFill = getCreatureFloodFillType(*creature);
+        for(Seat* seat : seats)
+            startColors.push_back(startTile->getFloodFillValue(seat, floodFill));
+    }
 
-    for (unsigned int i = 0; i < vec.size(); ++i)
+    for (Room* room : vec)
     {
-        Room* room = vec[i];
+        if(room->numCoveredTiles() == 0)
+            continue;
+
+        if(room->getHP(nullptr) <= 0.0)
+            continue;
+
         Tile* coveredTile = room->getCoveredTile(0);
-        if (pathExists(creature, startTile, coveredTile))
+        bool isReachable = true;
+        for(uint32_t i = 0; i < seats.size(); ++i)
         {
-            returnVector.push_back(room);
+            if((startColors[i] != Tile::NO_FLOODFILL) &&
+               (startColors[i] == coveredTile->getFloodFillValue(seats[i], floodFill)))
+            {
+                continue;
+            }
+
+            isReachable = false;
+            break;
         }
+
+        if(isReachable)
+            returnVector.push_back(room);
     }
 
     return returnVector;
@@ -1899,25 +2584,22 @@ std::vector<Building*> GameMap::getReachableBuildingsPerSeat(Seat* seat,
        Tile *startTile, const Creature* creature)
 {
     std::vector<Building*> returnList;
-    for (Room* room : mRooms)
+    for(uint32_t type = 0; type < NB_ROOM_TYPES; ++type)
     {
-        if (room->getSeat() != seat)
-            continue;
-
-        if (room->getHP(nullptr) <= 0.0)
-            continue;
+        std::vector<Room*> rooms = getReachableRooms(getRoomsOfSeat(seat, static_cast<RoomType>(type)),
+            startTile, creature);
+        returnList.insert(returnList.end(), rooms.begin(), rooms.end());
+    }
 
-        if(!pathExists(creature, startTile, room->getCoveredTile(0)))
-            continue;
+    if(seat == nullptr)
+        return returnList;
 
-        returnList.push_back(room);
-    }
+    auto itTraps = mTrapsBySeat.find(seat->getId());
+    if(itTraps == mTrapsBySeat.end())
+        return returnList;
 
-    for (Trap* trap : mTraps)
+    for (Trap* trap : itTraps->second)
     {
-        if (trap->getSeat() != seat)
-            continue;
-
         if (trap->getHP(nullptr) <= 0.0)
             continue;
 
@@ -1932,24 +2614,12 @@ std::vector<Building*> GameMap::getReachableBuildingsPerSeat(Seat* seat,
 
 Room* GameMap::getRoomByName(const std::string& name)
 {
-    for (Room* room : mRooms)
-    {
-        if(room->getName().compare(name) == 0)
-            return room;
-    }
-
-    return nullptr;
+    return getEntityByName(mRoomsByName, name);
 }
 
 Trap* GameMap::getTrapByName(const std::string& name)
 {
-    for (Trap* trap : mTraps)
-    {
-        if(trap->getName().compare(name) == 0)
-            return trap;
-    }
-
-    return nullptr;
+    return getEntityByName(mTrapsByName, name);
 }
 
 void GameMap::clearTraps()
@@ -1963,6 +2633,8 @@ void GameMap::clearTraps()
     }
 
     mTraps.clear();
+    mTrapsByName.clear();
+    mTrapsBySeat.clear();
 }
 
 void GameMap::addTrap(Trap *trap)
@@ -1972,6 +2644,8 @@ void GameMap::addTrap(Trap *trap)
         + Helper::toString(nbTiles) + ", seatId=" + Helper::toString(trap->getSeat()->getId()));
 
     mTraps.push_back(trap);
+    registerEntityName(mTrapsByName, trap);
+    mTrapsBySeat[trap->getSeat()->getId()].push_back(trap);
 }
 
 void GameMap::removeTrap(Trap *t)
@@ -1985,6 +2659,8 @@ void GameMap::removeTrap(Trap *t)
     }
 
     mTraps.erase(it);
+    unregisterEntityName(mTrapsByName, mTraps, t);
+    eraseEntity(mTrapsBySeat[t->getSeat()->getId()], t);
 }
 
 bool GameMap::withdrawFromTreasuries(int gold, Seat* seat)
@@ -2020,12 +2696,14 @@ void GameMap::clearMapLights()
     }
 
     mMapLights.clear();
+    mMapLightsByName.clear();
 }
 
 void GameMap::addMapLight(MapLight *m)
 {
     OD_LOG_INF(serverStr() + "Adding MapLight " + m->getName());
     mMapLights.push_back(m);
+    registerEntityName(mMapLightsByName, m);
 }
 
 void GameMap::removeMapLight(MapLight *m)
@@ -2040,17 +2718,12 @@ void GameMap::removeMapLight(MapLight *m)
     }
 
     mMapLights.erase(it);
+    unregisterEntityName(mMapLightsByName, mMapLights, m);
 }
 
 MapLight* GameMap::getMapLight(const std::string& name) const
 {
-    for (MapLight* mapLight : mMapLights)
-    {
-        if (mapLight->getName() == name)
-            return mapLight;
-    }
-
-    return nullptr;
+    return getEntityByName(mMapLightsByName, name);
 }
 
 void GameMap::clearSeats()
@@ -2078,6 +2751,14 @@ bool GameMap::addSeat(Seat *s)
             return false;
         }
     }
+
+    if(mSeats.size() >= MAX_CLAIM_OWNER_SEATS)
+    {
+        OD_LOG_ERR("Too many seats, seat id=" + Helper::toString(s->getId()));
+        return false;
+    }
+
+    s->setSeatIndex(static_cast<uint32_t>(mSeats.size()));
     mSeats.push_back(s);
     // We set the Seat color value
     const Ogre::ColourValue& colorValue = ConfigManager::getSingleton().getColorFromId(s->getColorId());
@@ -2111,7 +2792,7 @@ void GameMap::addWinningSeat(Seat *s)
     Player* player = getPlayerBySeat(s);
     if (player && player->getIsHuman())
     {
-        ServerNotification* serverNotification = new ServerNotification(
+        ServerNotification* serverNotification = ServerNotification::create(
             ServerNotificationType::chatServer, player);
         serverNotification->mPacket << "You Won" << EventShortNoticeType::majorGameEvent;
         ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -2203,21 +2884,75 @@ bool GameMap::doFloodFill(Seat* seat, Tile* tile)
 
 void GameMap::replaceFloodFill(Seat* seat, FloodFillType floodFillType, uint32_t colorOld, uint32_t colorNew)
 {
-    for (int jj = 0; jj < getMapSizeY(); ++jj)
+    uint32_t forestIndex = seat->getTeamIndex() * static_cast<uint32_t>(FloodFillType::nbValues)
+        + static_cast<uint32_t>(floodFillType);
+    if(forestIndex >= mFloodFillParents.size())
     {
-        for (int ii = 0; ii < getMapSizeX(); ++ii)
+        OD_LOG_ERR("Wrong floodfill seatId=" + Helper::toString(seat->getId())
+            + ", teamIndex=" + Helper::toString(seat->getTeamIndex()) + ", type=" + Tile::toString(floodFillType));
+        return;
+    }
+
+    uint32_t rootOld = getFloodFillRoot(seat->getTeamIndex(), floodFillType, colorOld);
+    uint32_t rootNew = getFloodFillRoot(seat->getTeamIndex(), floodFillType, colorNew);
+    if(rootOld == rootNew)
+        return;
+
+    // Tiles colored with rootOld (or any color merged into it) now resolve to rootNew
+    std::vector<uint32_t>& parents = mFloodFillParents[forestIndex];
+    if(rootOld >= parents.size())
+    {
+        uint32_t size = parents.size();
+        parents.resize(std::max(rootOld, mUniqueFloodFillValue) + 1);
+        for(uint32_t color = size; color < parents.size(); ++color)
+            parents[color] = color;
+    }
+    parents[rootOld] = rootNew;
+}
+
+uint32_t GameMap::getFloodFillRoot(uint32_t teamIndex, FloodFillType floodFillType, uint32_t color)
+{
+    uint32_t forestIndex = teamIndex * static_cast<uint32_t>(FloodFillType::nbValues)
+        + static_cast<uint32_t>(floodFillType);
+    if(forestIndex >= mFloodFillParents.size())
+        return color;
+
+    std::vector<uint32_t>& parents = mFloodFillParents[forestIndex];
+    uint32_t root = color;
+    while((root < parents.size()) && (parents[root] != root))
+        root = parents[root];
+
+    // Path compression: every color on the way now points directly to the root
+    while((color < parents.size()) && (parents[color] != root))
+    {
+        uint32_t parent = parents[color];
+        parents[color] = root;
+        color = parent;
+    }
+
+    return root;
+}
+
+void GameMap::flattenFloodFillForests()
+{
+    for(std::vector<uint32_t>& parents : mFloodFillParents)
+    {
+        for(uint32_t color = 0; color < parents.size(); ++color)
         {
-            Tile* tile = getTile(ii,jj);
-            if(tile->getFloodFillValue(seat, floodFillType) != colorOld)
-                continue;
+            uint32_t root = parents[color];
+            while((root < parents.size()) && (parents[root] != root))
+                root = parents[root];
 
-            tile->replaceFloodFill(seat, floodFillType, colorNew);
+            parents[color] = root;
         }
     }
 }
 
 void GameMap::refreshFloodFill(Seat* seat, Tile* tile)
 {
+    PhaseTimer timer(mPhaseTimings.mFloodFillUs);
+    refreshPathfindingCaches(tile);
+
     std::vector<uint32_t> colors(static_cast<uint32_t>(FloodFillType::nbValues), Tile::NO_FLOODFILL);
 
     // If the tile has opened a new place, we use the same floodfillcolor for all the areas
@@ -2276,15 +3011,10 @@ void GameMap::refreshFloodFill(Seat* seat, Tile* tile)
 
 void GameMap::enableFloodFill()
 {
+    PhaseTimer timer(mPhaseTimings.mFloodFillUs);
     // Carry out a flood fill of the whole level to make sure everything is good.
-    // Start by setting the flood fill color for every tile on the map to -1.
-    for (int jj = 0; jj < getMapSizeY(); ++jj)
-    {
-        for (int ii = 0; ii < getMapSizeX(); ++ii)
-        {
-            getTile(ii,jj)->resetFloodFill();
-        }
-    }
+    // Start by removing the flood fill color of every tile on the map.
+    resetFloodFillLayers();
 
     // The algorithm used to find a path is efficient when the path exists but not if it doesn't.
     // To improve path finding, we tag the contiguous tiles to know if a path exists between 2 tiles or not.
@@ -2292,6 +3022,9 @@ void GameMap::enableFloodFill()
     // Note : when a tile is digged, floodfill will have to be refreshed.
     mFloodFillEnabled = true;
 
+    // Colors are given again from scratch so the previous merges are forgotten
+    mFloodFillParents.assign(mTeamIds.size() * static_cast<uint32_t>(FloodFillType::nbValues), std::vector<uint32_t>());
+
     // To optimize floodfilling, we start by tagging the dirt tiles with fullness = 0
     // because they are walkable for most creatures. When we will have tagged all
     // thoses, we will deal with water/lava remaining (there can be some left if
@@ -2803,13 +3536,14 @@ Creature* GameMap::getWorkerForPathFinding(Seat* seat)
 
 void GameMap::updateVisibleEntities()
 {
-    // Notify what happened to entities on visible tiles
+    // Notify what happened to entities on visible tiles. The seats buffer is reused for every tile
+    std::vector<Seat*> seatsWithVision;
     for (int jj = 0; jj < getMapSizeY(); ++jj)
     {
         for (int ii = 0; ii < getMapSizeX(); ++ii)
         {
             Tile* tile = getTile(ii,jj);
-            tile->notifyEntitiesSeatsWithVision();
+            tile->notifyEntitiesSeatsWithVision(seatsWithVision);
         }
     }
 }
@@ -2820,10 +3554,64 @@ void GameMap::fireRefreshEntities()
     for(Seat* seat : mSeats)
         seat->notifyChangedVisibleTiles();
 
+    // The entities that changed during the turn are sent to each seat with vision on them. We
+    // send one notification per seat containing all the entities it can see
+    std::vector<MovableGameEntity*> entities;
     for(Creature* creature : mCreatures)
     {
-        creature->fireCreatureRefreshIfNeeded();
+        if(creature->getNeedFireRefresh())
+            entities.push_back(creature);
+    }
+    for(RenderedMovableEntity* entity : mRenderedMovableEntities)
+    {
+        if(entity->getNeedFireRefresh())
+            entities.push_back(entity);
+    }
+
+    if(entities.empty())
+        return;
+
+    std::vector<MovableGameEntity*> entitiesSeat;
+    ODPacket entityPacket;
+    for(Seat* seat : mSeats)
+    {
+        if(seat->getPlayer() == nullptr)
+            continue;
+        if(!seat->getPlayer()->getIsHuman())
+            continue;
+
+        entitiesSeat.clear();
+        for(MovableGameEntity* entity : entities)
+        {
+            const std::vector<Seat*>& seats = entity->getSeatsWithVisionNotified();
+            if(std::find(seats.begin(), seats.end(), seat) == seats.end())
+                continue;
+
+            entitiesSeat.push_back(entity);
+        }
+
+        if(entitiesSeat.empty())
+            continue;
+
+        ServerNotification *serverNotification = ServerNotification::create(
+            ServerNotificationType::entitiesRefresh, seat->getPlayer());
+        uint32_t nbEntities = entitiesSeat.size();
+        serverNotification->mPacket << nbEntities;
+        for(MovableGameEntity* entity : entitiesSeat)
+        {
+            // Each entity is written with the size of its data so that the client can skip
+            // the entities it does not know and still read the following ones
+            entityPacket.clear();
+            entity->exportToPacketForUpdate(entityPacket, seat);
+            uint32_t entityDataSize = entityPacket.getDataSize();
+            serverNotification->mPacket << entity->getId() << entityDataSize;
+            serverNotification->mPacket.append(entityPacket.getData(), entityDataSize);
+        }
+        ODServer::getSingleton().queueServerNotification(serverNotification);
     }
+
+    for(MovableGameEntity* entity : entities)
+        entity->setNeedFireRefresh(false);
 }
 
 void GameMap::addSpell(Spell *spell)
@@ -2831,6 +3619,9 @@ void GameMap::addSpell(Spell *spell)
     OD_LOG_INF(serverStr() + "Adding spell " + spell->getName()
         + ",MeshName=" + spell->getMeshName());
     mSpells.push_back(spell);
+    registerEntityName(mSpellsByName, spell);
+    if(spell->getSeat() != nullptr)
+        mSpellsBySeat[spell->getSeat()->getId()].push_back(spell);
 }
 
 void GameMap::removeSpell(Spell *spell)
@@ -2845,16 +3636,14 @@ void GameMap::removeSpell(Spell *spell)
     }
 
     mSpells.erase(it);
+    unregisterEntityName(mSpellsByName, mSpells, spell);
+    if(spell->getSeat() != nullptr)
+        eraseEntity(mSpellsBySeat[spell->getSeat()->getId()], spell);
 }
 
 Spell* GameMap::getSpell(const std::string& name) const
 {
-    for(Spell* spell : mSpells)
-    {
-        if(name.compare(spell->getName()) == 0)
-            return spell;
-    }
-    return nullptr;
+    return getEntityByName(mSpellsByName, name);
 }
 
 void GameMap::clearSpells()
@@ -2868,16 +3657,22 @@ void GameMap::clearSpells()
     }
 
     mSpells.clear();
+    mSpellsByName.clear();
+    mSpellsBySeat.clear();
 }
 
 std::vector<Spell*> GameMap::getSpellsBySeatAndType(Seat* seat, SpellType type) const
 {
     std::vector<Spell*> ret;
-    for (Spell* spell : mSpells)
-    {
-        if(spell->getSeat() != seat)
-            continue;
+    if(seat == nullptr)
+        return ret;
 
+    auto it = mSpellsBySeat.find(seat->getId());
+    if(it == mSpellsBySeat.end())
+        return ret;
+
+    for (Spell* spell : it->second)
+    {
         if(spell->getSpellType() != type)
             continue;
 
@@ -2935,9 +3730,11 @@ uint32_t GameMap::getMaxNumberCreatures(Seat* seat) const
 {
     uint32_t nbCreatures = ConfigManager::getSingleton().getMaxCreaturesPerSeatDefault();
 
-    std::vector<const Room*> portals = getRoomsByTypeAndSeat(RoomType::portal, seat);
-    for(const Room* room : portals)
+    for(const Room* room : getRoomsOfSeat(seat, RoomType::portal))
     {
+        if(room->getHP(nullptr) <= 0.0)
+            continue;
+
         const RoomPortal* roomPortal = static_cast<const RoomPortal*>(room);
         nbCreatures += roomPortal->getNbCreatureMaxIncrease();
     }
@@ -3056,8 +3853,28 @@ void GameMap::clientUpKeep(int64_t turnNumber)
     }
 }
 
+void GameMap::refreshPathfindingCaches(Tile* tile)
+{
+    mPathCache.clear();
+
+    for(DigDistanceField& digField : mDigDistanceFields)
+        digField.mField.setTileChanged(tile->getX(), tile->getY());
+
+    // The flow fields that could go through the tile will be computed again when needed
+    for(auto it = mFlowFields.begin(); it != mFlowFields.end();)
+    {
+        if(it->second.mField.isNearField(tile->getX(), tile->getY()))
+            it = mFlowFields.erase(it);
+        else
+            ++it;
+    }
+}
+
 void GameMap::doorLock(Tile* tileDoor, Seat* seat, bool locked)
 {
+    refreshPathfindingCaches(tileDoor);
+    notifyTileOcclusionChanged(tileDoor);
+
     if(!locked)
     {
         // When a door is unlocked, we check all its neighboors to find a floodfill value for each possible
@@ -3160,6 +3977,7 @@ void GameMap::doorLock(Tile* tileDoor, Seat* seat, bool locked)
 void GameMap::changeFloodFillConnectedTiles(Tile* startTile, Seat* seat, const std::vector<uint32_t>& oldColors,
     const std::vector<uint32_t>& newColors, Tile* tileIgnored)
 {
+    PhaseTimer timer(mPhaseTimings.mFloodFillUs);
     std::vector<Tile*> tiles;
     tiles.push_back(startTile);
     while(!tiles.empty())
@@ -3185,7 +4003,7 @@ void GameMap::changeFloodFillConnectedTiles(Tile* startTile, Seat* seat, const s
                     continue;
 
                 if((neighColor == oldColors[i]) &&
-                   (std::find(tiles.begin(), tiles.end(), tile) == tiles.end()))
+                   (std::find(tiles.begin(), tiles.end(), neigh) == tiles.end()))
                 {
                     tiles.push_back(neigh);
                     break;
@@ -3234,17 +4052,8 @@ void GameMap::notifySeatsConfigured()
     }
 
     uint32_t nbTeams = mTeamIds.size();
-    for(int xxx = 0; xxx < getMapSizeX(); ++xxx)
-    {
-        for(int yyy = 0; yyy < getMapSizeY(); ++yyy)
-        {
-            Tile* tile = getTile(xxx, yyy);
-            if(tile == nullptr)
-                continue;
-
-            tile->setTeamsNumber(nbTeams);
-        }
-    }
+    allocateFloodFillLayers(nbTeams, static_cast<uint32_t>(FloodFillType::nbValues));
+    allocateVisionLayers(static_cast<uint32_t>(mSeats.size()));
     // Now that team ids are set and tiles are configured, we can compute floodfill
     enableFloodFill();
 }
@@ -3259,7 +4068,7 @@ void GameMap::fireGameSound(Tile& tile, const std::string& soundFamily)
         if(!seat->getPlayer()->getIsHuman())
             continue;
 
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::playSpatialSound, seat->getPlayer());
         serverNotification->mPacket << sound << tile.getX() << tile.getY();
         ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -3275,7 +4084,7 @@ void GameMap::fireRelativeSound(const std::vector<Seat*>& seats, const std::stri
         if(!seat->getPlayer()->getIsHuman())
             continue;
 
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::playRelativeSound, seat->getPlayer());
         serverNotification->mPacket << soundFamily;
         ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -18,6 +18,8 @@
 #ifndef GAMEMAP_H
 #define GAMEMAP_H
 
+#include "gamemap/EntityGrid.h"
+#include "gamemap/Pathfinding.h"
 #include "gamemap/TileContainer.h"
 
 #include "ai/AIManager.h"
@@ -32,6 +34,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 
 #include <OgreVector3.h>
 
@@ -53,6 +57,7 @@ class Room;
 class Spell;
 class TileSet;
 class TileSetValue;
+class ThreadPool;
 
 enum class GameEntityType;
 enum class FloodFillType;
@@ -85,6 +90,29 @@ enum class SelectionEntityWanted
     creatureAliveEnemyAttackable
 };
 
+//! \brief Time spent (in microseconds) in the main phases of the server turns since the last
+//! call to GameMap::resetPhaseTimings. Used to measure the cost of the simulation
+struct GameMapPhaseTimings
+{
+    GameMapPhaseTimings() :
+        mVisionUs(0),
+        mPerceptionUs(0),
+        mActiveObjectsUs(0),
+        mAIUs(0),
+        mFloodFillUs(0),
+        mPathUs(0),
+        mNbPathCalls(0)
+    {}
+
+    uint64_t mVisionUs;
+    uint64_t mPerceptionUs;
+    uint64_t mActiveObjectsUs;
+    uint64_t mAIUs;
+    uint64_t mFloodFillUs;
+    uint64_t mPathUs;
+    uint64_t mNbPathCalls;
+};
+
 /*! \brief The class which stores the entire game state on the server and a subset of this on each client.
  *
  * This class is one of the key classes in the OpenDungeons game.  The map
@@ -154,6 +182,10 @@ public:
     //! nullptr if it is not found
     Creature* getCreature(const std::string& cName) const;
 
+    //! \brief Returns a pointer to the creature with the given network id or
+    //! nullptr if it is not found
+    Creature* getCreatureFromId(uint32_t id) const;
+
     inline bool getIsFOWActivated() const
     { return mIsFOWActivated; }
 
@@ -161,6 +193,25 @@ public:
     std::vector<Creature*> getCreaturesByAlliedSeat(const Seat* seat) const;
     std::vector<Creature*> getCreaturesBySeat(const Seat* seat) const;
 
+    //! \brief Should be called when a creature on the gamemap changes seat (before the change is
+    //! done) to keep the creatures per seat up to date
+    void notifyCreatureSeatChanging(Creature* creature, Seat* newSeat);
+
+    //! \brief Should be called when a creature on the gamemap dies (when its HP reach 0) to keep
+    //! the number of fighters and workers of its seat up to date
+    void notifyCreatureDead(Creature* creature);
+
+    //! \brief Should be called by the treasuries of the given seat when the gold they contain or the
+    //! maximum gold they can store changes. The values are the differences with the previous ones
+    void notifyTreasuryGoldChanged(Seat* seat, int gold, int goldMax);
+
+    //! \brief Index of the entities standing on the map (see EntityGrid)
+    inline EntityGrid& getEntityGrid()
+    { return mEntityGrid; }
+
+    inline const EntityGrid& getEntityGrid() const
+    { return mEntityGrid; }
+
     inline const std::vector<Creature*>& getCreatures() const
     { return mCreatures; }
 
@@ -171,6 +222,9 @@ public:
     void addAnimatedObject(MovableGameEntity *a);
     void removeAnimatedObject(MovableGameEntity *a);
     MovableGameEntity* getAnimatedObject(const std::string& name) const;
+    //! \brief Returns the animated object with the given network id (see GameEntity::getId)
+    //! or nullptr if it is not found
+    MovableGameEntity* getAnimatedObjectFromId(uint32_t id) const;
 
     void addClientUpkeepEntity(GameEntity* entity);
     void removeClientUpkeepEntity(GameEntity* entity);
@@ -226,6 +280,16 @@ public:
     inline const std::vector<Room*>& getRooms() const
     { return mRooms; }
 
+    //! \brief Returns the rooms of the given type (and owned by the given seat) without building a new vector.
+    //! Like getRooms, they contain the rooms destroyed or absorbed (with no HP left) that will be removed during
+    //! their next upkeep. The functions below do not return them
+    const std::vector<Room*>& getRoomsOfType(RoomType type) const;
+    const std::vector<Room*>& getRoomsOfSeat(const Seat* seat, RoomType type) const;
+
+    //! \brief Should be called when a room on the gamemap changes seat (before the change is
+    //! done) to keep the rooms per seat up to date
+    void notifyRoomSeatChanging(Room* room, Seat* newSeat);
+
     std::vector<Room*> getRoomsByType(RoomType type) const;
     std::vector<Room*> getRoomsByTypeAndSeat(RoomType type,
                         const Seat* seat);
@@ -233,6 +297,8 @@ public:
                           const Seat* seat) const;
     unsigned int numRoomsByTypeAndSeat(RoomType type,
                       const Seat* seat) const;
+    //! \brief Returns the rooms from vec that the given creature can reach from startTile. The floodfill colors
+    //! of startTile are resolved once and compared with the ones of each room. Rooms with no HP left are ignored
     std::vector<Room*> getReachableRooms(const std::vector<Room*> &vec,
                        Tile *startTile, const Creature* creature);
     std::vector<Building*> getReachableBuildingsPerSeat(Seat* seat,
@@ -343,6 +409,16 @@ public:
 
     void doPlayerAITurn(double timeSinceLastTurn);
 
+    inline const GameMapPhaseTimings& getPhaseTimings() const
+    { return mPhaseTimings; }
+
+    inline void resetPhaseTimings()
+    { mPhaseTimings = GameMapPhaseTimings(); }
+
+    //! \brief Sets the number of threads helping the server thread to compute the creatures vision and perception.
+    //! If 0, everything is computed by the server thread. By default, there is one thread per core
+    void setNbWorkerThreads(uint32_t nbWorkers);
+
     //! \brief Tells whether a path exists between two tiles for the given creature.
     bool pathExists(const Creature* creature, Tile* tileStart, Tile* tileEnd);
 
@@ -374,13 +450,40 @@ public:
     //! \note Returns a path for the given creature to the given destination.
     std::list<Tile*> path(const Creature* creature, Tile* destination, bool throughDiggableTiles = false);
 
+    /*! \brief Returns the same path as path(creature, destination) but uses a flow field shared by every creature of
+     * the same seat and movement class going to the same destination (like when answering a call to war or fleeing to
+     * the dungeon temple). The field is computed once for all of them and dropped when a tile it goes through changes
+     * (see refreshPathfindingCaches). Thus, each creature only pays for the length of its path.
+     */
+    std::list<Tile*> flowFieldPath(const Creature* creature, Tile* destination);
+
+    /*! \brief Fills path with the tiles from start to the closest of the given targets (both included) going through
+     * the tiles the given worker can walk through or its seat can dig. Digging a tile costs more than walking through
+     * it so that the path goes around the walls when it is not much longer. The walls claimed by an enemy are only
+     * gone through if there is no other way (like for a dungeon temple surrounded by claimed walls). Since they cannot
+     * be dug before being claimed back, the caller should check Tile::isDiggable before marking the tiles of the path.
+     * The distances to the targets are cached for each seat and updated when tiles change (see Pathfinding::DistanceField).
+     * Thus, asking again for the same targets only costs the length of the path.
+     * Returns false if no target can be reached.
+     */
+    bool findDigPath(const Creature& worker, Tile* start, const std::vector<Tile*>& targets, std::vector<Tile*>& path);
+
+    //! \brief Same as findDigPath with every gold tile that can still be mined as targets. The same field is used while
+    //! gold is mined since the mined tiles are removed from the targets when they change
+    bool findDigPathToGold(const Creature& worker, Tile* start, std::vector<Tile*>& path);
+
     //! \brief Loops over the visibleTiles and returns any creature/room/trap in those tiles allied with the given seat
     //! (or if enemyForce is true, is not allied)
     std::vector<GameEntity*> getVisibleForce(const std::vector<Tile*>& visibleTiles, Seat* seat, bool enemyForce);
 
+    //! \brief Same as above for the tiles seen by a creature or a trap. The creatures are taken from the
+    //! entity grid around the visible area instead of looking in every visible tile
+    std::vector<GameEntity*> getVisibleForce(const VisibleTiles& visibleTiles, Seat* seat, bool enemyForce);
+
     //! \brief Loops over the visibleTiles and returns any creature in those tiles allied with the given seat.
     //! (or if enemyCreatures is true, is not allied)
     std::vector<GameEntity*> getVisibleCreatures(const std::vector<Tile*>& visibleTiles, Seat* seat, bool enemyCreatures);
+    std::vector<GameEntity*> getVisibleCreatures(const VisibleTiles& visibleTiles, Seat* seat, bool enemyCreatures);
 
     //! \brief Loops over the given tiles and returns any carryable entity in those tiles
     std::vector<GameEntity*> getCarryableEntities(Creature* carrier, const std::vector<Tile*>& tiles);
@@ -390,8 +493,15 @@ public:
     //! already know that no path exists.
     bool doFloodFill(Seat* seat, Tile* tile);
     void refreshFloodFill(Seat* seat, Tile* tile);
+
+    //! \brief Merges the floodfill colorOld into colorNew for the given seat team. Every tile colored with colorOld
+    //! will be considered as colored with colorNew (see getFloodFillRoot)
     void replaceFloodFill(Seat* seat, FloodFillType floodFillType, uint32_t colorOld, uint32_t colorNew);
 
+    //! \brief Returns the color the given floodfill value has been merged into for the given team index
+    //! and floodfill type. Tiles store the color they have been given and resolve it through this function.
+    uint32_t getFloodFillRoot(uint32_t teamIndex, FloodFillType floodFillType, uint32_t color);
+
     //! \brief Temporarily disables the flood fill computations on this game map.
     void disableFloodFill()
     { mFloodFillEnabled = false; }
@@ -401,6 +511,26 @@ public:
      */
     void enableFloodFill();
 
+    //! \brief Notifies the dig distance fields, drops the flow fields around the tile and clears the path cache. Should be
+    //! called each time the floodfill of the tile is changed in a way that may open or close a path
+    void refreshPathfindingCaches(Tile* tile);
+
+    //! \brief Should be called when the tile gets claimed or unclaimed. The vision given by
+    //! this tile will be computed again during the next upkeep and the claimed tiles count of
+    //! the seats is updated
+    void notifyTileClaimChanged(Tile* tile);
+
+    //! \brief Should be called when the tile may have started or stopped blocking vision. Creatures
+    //! seeing it will compute their vision again during the next upkeep
+    void notifyTileOcclusionChanged(Tile* tile);
+
+    //! \brief Should be called when something the workers jobs depend on (marking for digging, fullness,
+    //! claiming, covering building) changes on the tile. The job boards of the seats will be updated
+    void notifyTileJobsChanged(Tile* tile);
+
+    //! \brief Should be called when an entity is added to or removed from the tile
+    void notifyTileEntitiesChanged(Tile* tile);
+
     inline void setLocalPlayer(Player* player)
     { mLocalPlayer = player; }
 
@@ -470,6 +600,7 @@ public:
     void addRenderedMovableEntity(RenderedMovableEntity *obj);
     void removeRenderedMovableEntity(RenderedMovableEntity *obj);
     RenderedMovableEntity* getRenderedMovableEntity(const std::string& name);
+    RenderedMovableEntity* getRenderedMovableEntityFromId(uint32_t id) const;
     void clearRenderedMovableEntities();
     GameEntity* getEntityFromTypeAndName(GameEntityType entityType,
         const std::string& entityName);
@@ -560,6 +691,8 @@ private:
     int mUniqueNumberRenderedMovableEntity;
     int mUniqueNumberTrap;
     int mUniqueNumberMapLight;
+    //! \brief Last id given to an entity added to the server gamemap
+    uint32_t mUniqueNumberEntityId;
     uint32_t mUniqueFloodFillValue;
 
     //! \brief When paused, the GameMap is not updated.
@@ -578,6 +711,12 @@ private:
 
     std::vector<Creature*> mCreatures;
 
+    //! \brief Creatures in mCreatures sorted by seat id
+    std::map<int, std::vector<Creature*>> mCreaturesBySeat;
+
+    //! \brief Entities standing on the map. Kept up to date by the tiles (see Tile::addEntity)
+    EntityGrid mEntityGrid;
+
     //! \brief The creature definition data. We use a pair to be able to make the difference between the original
     //! data from the global creature definition file and the specific data from the level file. With this trick,
     //! we will be able to compare and write the differences in the level file.
@@ -593,6 +732,13 @@ private:
     std::vector<Trap*> mTraps;
     std::vector<MapLight*> mMapLights;
 
+    //! \brief Rooms sorted by type (index is the RoomType) and by seat id then type. Traps and spells sorted
+    //! by seat id. They are kept in sync with the entities vectors by the add/remove functions
+    std::vector<std::vector<Room*>> mRoomsByType;
+    std::map<int, std::vector<std::vector<Room*>>> mRoomsBySeatAndType;
+    std::map<int, std::vector<Trap*>> mTrapsBySeat;
+    std::map<int, std::vector<Spell*>> mSpellsBySeat;
+
     //! \brief Players and available game player slots (Seats)
     std::vector<Player*> mPlayers;
     std::vector<Seat*> mSeats;
@@ -618,10 +764,139 @@ private:
     //! \brief Debug member used to know how many call to pathfinding has been made within the same turn.
     unsigned int mNumCallsTo_path;
 
+    //! \brief A* search state reused by every call to path(). A game map is only used by one
+    //! thread (the server thread for the server game map) so there is no need to lock it.
+    Pathfinding::AstarSearch mAstarSearch;
+
+    //! \brief Tiles indexes of the last computed path. Kept to avoid reallocating it at each call to path()
+    std::vector<uint32_t> mPathTileIndexes;
+
+    //! \brief Key of the path cache. Creatures of the same seat that can go through the same tiles (see
+    //! getCreatureMovementClass in GameMap.cpp) at the same speeds (used as costs by the search) share the paths
+    struct PathCacheKey
+    {
+        uint32_t mStart;
+        uint32_t mDestination;
+        int mSeatId;
+        uint32_t mMovementClass;
+        double mGroundSpeed;
+        double mWaterSpeed;
+        double mLavaSpeed;
+
+        bool operator<(const PathCacheKey& other) const
+        {
+            return std::tie(mStart, mDestination, mSeatId, mMovementClass, mGroundSpeed, mWaterSpeed, mLavaSpeed)
+                < std::tie(other.mStart, other.mDestination, other.mSeatId, other.mMovementClass,
+                    other.mGroundSpeed, other.mWaterSpeed, other.mLavaSpeed);
+        }
+    };
+
+    //! \brief Indexes of the tiles of the paths computed during the current turn. Cleared at the beginning of each
+    //! turn and each time the floodfill changes (see refreshPathfindingCaches)
+    std::map<PathCacheKey, std::vector<uint32_t>> mPathCache;
+
+    //! \brief Key of the flow fields. Like for the path cache, creatures of the same seat that can go
+    //! through the same tiles at the same speeds share the fields
+    struct FlowFieldKey
+    {
+        uint32_t mDestination;
+        int mSeatId;
+        uint32_t mMovementClass;
+        double mGroundSpeed;
+        double mWaterSpeed;
+        double mLavaSpeed;
+
+        bool operator<(const FlowFieldKey& other) const
+        {
+            return std::tie(mDestination, mSeatId, mMovementClass, mGroundSpeed, mWaterSpeed, mLavaSpeed)
+                < std::tie(other.mDestination, other.mSeatId, other.mMovementClass,
+                    other.mGroundSpeed, other.mWaterSpeed, other.mLavaSpeed);
+        }
+    };
+
+    struct FlowFieldEntry
+    {
+        int64_t mComputedTurn;
+        int64_t mLastUsedTurn;
+        Pathfinding::FlowField mField;
+    };
+
+    //! \brief Flow fields used recently (see flowFieldPath). When there are too many, the least recently used is dropped
+    std::map<FlowFieldKey, FlowFieldEntry> mFlowFields;
+
+    //! \brief Distances to dig to a set of targets for the workers of a seat with the given movement class (see
+    //! findDigPath). The targets are mTargets (sorted tile indexes) or the gold tiles if mIsGoldField is true
+    struct DigDistanceField
+    {
+        int mSeatId;
+        uint32_t mMovementClass;
+        bool mIsGoldField;
+        std::vector<uint32_t> mTargets;
+        int64_t mLastUsedTurn;
+        Pathfinding::DistanceField mField;
+    };
+
+    //! \brief Dig distance fields used recently. When there are too many, the least recently used is replaced
+    std::vector<DigDistanceField> mDigDistanceFields;
+
+    //! \brief Returns the tiles matching the given indexes (see Pathfinding::AstarSearch::getIndex)
+    std::list<Tile*> getTilesFromIndexes(const std::vector<uint32_t>& indexes) const;
+
+    //! \brief Common part of findDigPath and findDigPathToGold. targetIndexes should be sorted
+    bool findDigPathToTargets(const Creature& worker, Tile* start, const std::vector<uint32_t>& targetIndexes,
+        bool isGoldField, std::vector<Tile*>& path);
+
+    //! \brief Debug members used to know how many paths were found in the cache
+    unsigned int mNumPathCacheHits;
+    unsigned int mNumPathCacheMisses;
+
+    GameMapPhaseTimings mPhaseTimings;
+
+    //! \brief Tiles where claiming changed since the last call to updateVision
+    std::vector<Tile*> mTilesClaimChanged;
+
+    //! \brief Tiles that may have started or stopped blocking vision since the last call to updateVision
+    std::vector<Tile*> mTilesOcclusionChanged;
+
+    //! \brief False until updateVision checked every tile once
+    bool mIsVisionInitialized;
+
+    //! \brief False until the economy of the seats (gold, claimed tiles, fighters and workers) has been
+    //! counted once. Then, the counts are updated when something changes (see notifyTileClaimChanged,
+    //! notifyTreasuryGoldChanged, ...)
+    bool mIsSeatsEconomyInitialized;
+
+    //! \brief True if vision on every tile has been given to every seat because the FOW is deactivated
+    bool mIsVisionGivenOnAllTiles;
+
+    //! \brief Threads used to compute the creatures vision and perception. Created on the first server turn
+    std::unique_ptr<ThreadPool> mThreadPool;
+    uint32_t mNbWorkerThreads;
+
+    //! \brief Disjoint-set forests of the floodfill colors. There is one for each team and each floodfill
+    //! type (index is teamIndex * FloodFillType::nbValues + floodFillType). For each color, it gives the color it has been merged into. Colors
+    //! not in the vector or pointing to themselves are roots. Merging 2 colors only changes the root of one
+    //! of them instead of coloring again every tile.
+    std::vector<std::vector<uint32_t>> mFloodFillParents;
+
     std::vector<RenderedMovableEntity*> mRenderedMovableEntities;
 
     std::vector<Spell*> mSpells;
 
+    //! \brief Entities registered by name. They are kept in sync with the entities vectors by the add/remove
+    //! functions and allow to find an entity from its name (like when received from network) in constant time
+    std::unordered_map<std::string, Creature*> mCreaturesByName;
+    std::unordered_map<std::string, MovableGameEntity*> mAnimatedObjectsByName;
+    std::unordered_map<std::string, RenderedMovableEntity*> mRenderedMovableEntitiesByName;
+    std::unordered_map<std::string, Room*> mRoomsByName;
+    std::unordered_map<std::string, Trap*> mTrapsByName;
+    std::unordered_map<std::string, MapLight*> mMapLightsByName;
+    std::unordered_map<std::string, Spell*> mSpellsByName;
+
+    //! \brief Animated objects registered by network id. Every entity sent to the clients
+    //! (creatures, rendered movable entities, spells and map lights) is an animated object
+    std::unordered_map<uint32_t, MovableGameEntity*> mAnimatedObjectsById;
+
     std::vector<int> mTeamIds;
 
     //! AI Handling manager
@@ -635,8 +910,44 @@ private:
     //! Updates active objects (creatures, rooms, ...), goals, count each team Workers, gold, mana and claimed tiles.
     unsigned long int doMiscUpkeep(double timeSinceLastTurn);
 
+    //! \brief Updates the vision of the seats. Only the tiles, creatures and spells
+    //! that changed since the last call are computed again
+    void updateVision();
+
+    //! \brief Counts the treasuries gold, claimed tiles, fighters and workers of every seat
+    //! by checking every room, tile and creature
+    void countSeatsEconomy();
+
+    //! \brief Checks that the counts kept up to date since countSeatsEconomy are still right. Used in debug
+    //! builds only
+    void checkSeatsEconomy();
+
+    //! \brief Adds nb to the number of fighters or workers of the given seat if the creature is alive
+    void countCreature(Creature* creature, Seat* seat, int nb);
+
+    //! \brief Computes in parallel the visible and reachable entities every creature will use during its upkeep. The
+    //! results are stored in each creature so the upkeep itself stays serial and does not depend on the number of threads
+    void computeCreaturesPerception();
+
+    //! \brief Makes every color of the floodfill forests point directly to its root. After that, getFloodFillRoot does not
+    //! modify the forests until the next merge and can be called from several threads
+    void flattenFloodFillForests();
+
+    ThreadPool& getThreadPool();
+
     //! \brief Resets the unique numbers
     void resetUniqueNumbers();
+
+    //! \brief Registers the given animated object by its network id. On server side, the id
+    //! is given here the first time the entity is added. On client side, it has been received
+    //! with the entity
+    void registerEntityId(MovableGameEntity* entity);
+    void unregisterEntityId(MovableGameEntity* entity);
+
+    //! \brief Fills creatures with the alive creatures on the visible tiles allied with the given seat (or if
+    //! enemyCreatures is true, not allied and attackable), sorted from the closest to the center
+    void fillWithVisibleCreatures(const VisibleTiles& visibleTiles, Seat* seat, bool enemyCreatures,
+        std::vector<GameEntity*>& creatures);
 };
 
 #endif // GAMEMAP_H
@@ -17,7 +17,374 @@
 
 #include "Pathfinding.h"
 
+#include <functional>
+
 namespace Pathfinding
 {
 
+const uint32_t AstarSearch::NO_PARENT = 0xFFFFFFFF;
+const uint32_t AstarSearch::CLOSED = 0xFFFFFFFF;
+
+AstarSearch::AstarSearch() :
+    mGeneration(0),
+    mOrder(0),
+    mNbNodesProcessed(0)
+{
+}
+
+void AstarSearch::prepare(uint32_t nbNodes)
+{
+    mOpenHeap.clear();
+    mOrder = 0;
+    mNbNodesProcessed = 0;
+
+    if(mNodes.size() != nbNodes)
+    {
+        Node node;
+        node.mGeneration = 0;
+        mNodes.assign(nbNodes, node);
+        mGeneration = 0;
+    }
+
+    ++mGeneration;
+    // If the generation counter wrapped, some nodes could wrongly be considered as already reached
+    if(mGeneration == 0)
+    {
+        for(Node& node : mNodes)
+            node.mGeneration = 0;
+
+        mGeneration = 1;
+    }
+}
+
+void AstarSearch::openNode(uint32_t index, uint32_t parent, double g, double h)
+{
+    Node& node = mNodes[index];
+    node.mG = g;
+    node.mH = h;
+    node.mOrder = ++mOrder;
+    node.mParent = parent;
+    node.mGeneration = mGeneration;
+    node.mHeapIndex = static_cast<uint32_t>(mOpenHeap.size());
+    mOpenHeap.push_back(index);
+    siftUp(node.mHeapIndex);
+}
+
+uint32_t AstarSearch::popBestNode()
+{
+    uint32_t index = mOpenHeap.front();
+    mNodes[index].mHeapIndex = CLOSED;
+
+    uint32_t last = mOpenHeap.back();
+    mOpenHeap.pop_back();
+    if(!mOpenHeap.empty())
+    {
+        mOpenHeap[0] = last;
+        mNodes[last].mHeapIndex = 0;
+        siftDown(0);
+    }
+
+    return index;
+}
+
+void AstarSearch::updateNode(uint32_t index, uint32_t parent, double g)
+{
+    // Like when it is inserted, an updated node is processed after the nodes with the same cost. Note that
+    // because of rounding, the cost may stay the same even if g is smaller. In this case, the node keeps its place
+    Node& node = mNodes[index];
+    if(g + node.mH != node.mG + node.mH)
+        node.mOrder = ++mOrder;
+
+    node.mG = g;
+    node.mParent = parent;
+    uint32_t heapIndex = node.mHeapIndex;
+    siftUp(heapIndex);
+    if(node.mHeapIndex == heapIndex)
+        siftDown(heapIndex);
+}
+
+void AstarSearch::siftUp(uint32_t heapIndex)
+{
+    uint32_t index = mOpenHeap[heapIndex];
+    while(heapIndex > 0)
+    {
+        uint32_t parentHeapIndex = (heapIndex - 1) / 2;
+        uint32_t parentIndex = mOpenHeap[parentHeapIndex];
+        if(!isBefore(index, parentIndex))
+            break;
+
+        mOpenHeap[heapIndex] = parentIndex;
+        mNodes[parentIndex].mHeapIndex = heapIndex;
+        heapIndex = parentHeapIndex;
+    }
+    mOpenHeap[heapIndex] = index;
+    mNodes[index].mHeapIndex = heapIndex;
+}
+
+void AstarSearch::siftDown(uint32_t heapIndex)
+{
+    uint32_t index = mOpenHeap[heapIndex];
+    uint32_t size = static_cast<uint32_t>(mOpenHeap.size());
+    while(true)
+    {
+        uint32_t childHeapIndex = 2 * heapIndex + 1;
+        if(childHeapIndex >= size)
+            break;
+
+        if((childHeapIndex + 1 < size) && isBefore(mOpenHeap[childHeapIndex + 1], mOpenHeap[childHeapIndex]))
+            ++childHeapIndex;
+
+        uint32_t childIndex = mOpenHeap[childHeapIndex];
+        if(!isBefore(childIndex, index))
+            break;
+
+        mOpenHeap[heapIndex] = childIndex;
+        mNodes[childIndex].mHeapIndex = heapIndex;
+        heapIndex = childHeapIndex;
+    }
+    mOpenHeap[heapIndex] = index;
+    mNodes[index].mHeapIndex = heapIndex;
+}
+
+const uint32_t DistanceField::IMPASSABLE = 0xFFFFFFFF;
+
+//! \brief The 4 adjacent neighbors used by DistanceField
+static const int FIELD_NEIGHBOR_DIFF_X[4] = { -1, 1, 0, 0 };
+static const int FIELD_NEIGHBOR_DIFF_Y[4] = { 0, 0, -1, 1 };
+
+DistanceField::DistanceField() :
+    mSizeX(0),
+    mSizeY(0),
+    mIsComputed(false),
+    mNbFullComputations(0)
+{
+}
+
+void DistanceField::setTileChanged(int x, int y)
+{
+    if(!mIsComputed)
+        return;
+
+    if((x < 0) || (x >= mSizeX) || (y < 0) || (y >= mSizeY))
+        return;
+
+    // If the field is not used for a long time, we will compute it again instead of storing every change
+    if(mChangedTiles.size() >= mCosts.size())
+    {
+        mIsComputed = false;
+        mChangedTiles.clear();
+        return;
+    }
+
+    mChangedTiles.push_back(AstarSearch::getIndex(x, y, mSizeX));
+}
+
+uint32_t DistanceField::getDistance(int x, int y) const
+{
+    if(!mIsComputed)
+        return IMPASSABLE;
+
+    if((x < 0) || (x >= mSizeX) || (y < 0) || (y >= mSizeY))
+        return IMPASSABLE;
+
+    return mDistances[AstarSearch::getIndex(x, y, mSizeX)];
+}
+
+bool DistanceField::getPath(int x, int y, std::vector<uint32_t>& path) const
+{
+    path.clear();
+    uint32_t distance = getDistance(x, y);
+    if(distance == IMPASSABLE)
+        return false;
+
+    uint32_t index = AstarSearch::getIndex(x, y, mSizeX);
+    path.push_back(index);
+    while(distance > 0)
+    {
+        int currentX = AstarSearch::getX(index, mSizeX);
+        int currentY = AstarSearch::getY(index, mSizeX);
+        uint32_t bestIndex = index;
+        for(int i = 0; i < 4; ++i)
+        {
+            int neighborX = currentX + FIELD_NEIGHBOR_DIFF_X[i];
+            int neighborY = currentY + FIELD_NEIGHBOR_DIFF_Y[i];
+            if((neighborX < 0) || (neighborX >= mSizeX) || (neighborY < 0) || (neighborY >= mSizeY))
+                continue;
+
+            uint32_t neighborIndex = AstarSearch::getIndex(neighborX, neighborY, mSizeX);
+            if(mDistances[neighborIndex] >= distance)
+                continue;
+
+            bestIndex = neighborIndex;
+            distance = mDistances[neighborIndex];
+        }
+
+        // The distance of a tile comes from one of its neighbors so that should not happen
+        if(bestIndex == index)
+        {
+            path.clear();
+            return false;
+        }
+
+        index = bestIndex;
+        path.push_back(index);
+    }
+
+    return true;
+}
+
+void DistanceField::computeAll()
+{
+    mIsComputed = true;
+    ++mNbFullComputations;
+    mDistances.assign(mCosts.size(), IMPASSABLE);
+    mOpenList.clear();
+    for(uint32_t index = 0; index < mTargets.size(); ++index)
+    {
+        if(!mTargets[index])
+            continue;
+
+        // The targets are reached whatever their cost
+        mDistances[index] = 0;
+        mOpenList.push_back(OpenEntry(0, index));
+        std::push_heap(mOpenList.begin(), mOpenList.end(), std::greater<OpenEntry>());
+    }
+
+    propagate();
+}
+
+bool DistanceField::setCost(uint32_t index, uint32_t cost, bool isTarget)
+{
+    uint32_t oldCost = mCosts[index];
+    bool wasTarget = mTargets[index];
+    mCosts[index] = cost;
+    mTargets[index] = isTarget;
+    if(wasTarget && !isTarget)
+        return false;
+
+    // The targets always have a distance of 0
+    if(isTarget)
+    {
+        if(!wasTarget)
+        {
+            mDistances[index] = 0;
+            mOpenList.push_back(OpenEntry(0, index));
+            std::push_heap(mOpenList.begin(), mOpenList.end(), std::greater<OpenEntry>());
+        }
+        return true;
+    }
+
+    if(cost == oldCost)
+        return true;
+
+    if(cost > oldCost)
+        return false;
+
+    int x = AstarSearch::getX(index, mSizeX);
+    int y = AstarSearch::getY(index, mSizeX);
+    uint32_t bestDistance = IMPASSABLE;
+    for(int i = 0; i < 4; ++i)
+    {
+        int neighborX = x + FIELD_NEIGHBOR_DIFF_X[i];
+        int neighborY = y + FIELD_NEIGHBOR_DIFF_Y[i];
+        if((neighborX < 0) || (neighborX >= mSizeX) || (neighborY < 0) || (neighborY >= mSizeY))
+            continue;
+
+        bestDistance = std::min(bestDistance, mDistances[AstarSearch::getIndex(neighborX, neighborY, mSizeX)]);
+    }
+
+    if(bestDistance == IMPASSABLE)
+        return true;
+
+    uint32_t distance = bestDistance + cost;
+    if(distance >= mDistances[index])
+        return true;
+
+    mDistances[index] = distance;
+    mOpenList.push_back(OpenEntry(distance, index));
+    std::push_heap(mOpenList.begin(), mOpenList.end(), std::greater<OpenEntry>());
+    return true;
+}
+
+void DistanceField::propagate()
+{
+    // A tile can be pushed more than once. Outdated entries are skipped when popped
+    while(!mOpenList.empty())
+    {
+        std::pop_heap(mOpenList.begin(), mOpenList.end(), std::greater<OpenEntry>());
+        OpenEntry entry = mOpenList.back();
+        mOpenList.pop_back();
+
+        uint32_t currentIndex = entry.second;
+        if(entry.first > mDistances[currentIndex])
+            continue;
+
+        int currentX = AstarSearch::getX(currentIndex, mSizeX);
+        int currentY = AstarSearch::getY(currentIndex, mSizeX);
+        for(int i = 0; i < 4; ++i)
+        {
+            int neighborX = currentX + FIELD_NEIGHBOR_DIFF_X[i];
+            int neighborY = currentY + FIELD_NEIGHBOR_DIFF_Y[i];
+            if((neighborX < 0) || (neighborX >= mSizeX) || (neighborY < 0) || (neighborY >= mSizeY))
+                continue;
+
+            uint32_t neighborIndex = AstarSearch::getIndex(neighborX, neighborY, mSizeX);
+            uint32_t cost = mCosts[neighborIndex];
+            if(cost == IMPASSABLE)
+                continue;
+
+            uint32_t distance = entry.first + cost;
+            if(distance >= mDistances[neighborIndex])
+                continue;
+
+            mDistances[neighborIndex] = distance;
+            mOpenList.push_back(OpenEntry(distance, neighborIndex));
+            std::push_heap(mOpenList.begin(), mOpenList.end(), std::greater<OpenEntry>());
+        }
+    }
+}
+
+const uint32_t FlowField::NO_NEXT_TILE = 0xFFFFFFFF;
+
+FlowField::FlowField() :
+    mSizeX(0),
+    mSizeY(0),
+    mDestination(NO_NEXT_TILE)
+{
+}
+
+bool FlowField::isNearField(int x, int y) const
+{
+    for(int neighborY = std::max(0, y - 1); neighborY <= std::min(mSizeY - 1, y + 1); ++neighborY)
+    {
+        for(int neighborX = std::max(0, x - 1); neighborX <= std::min(mSizeX - 1, x + 1); ++neighborX)
+        {
+            if(mNextTiles[AstarSearch::getIndex(neighborX, neighborY, mSizeX)] != NO_NEXT_TILE)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+bool FlowField::getPath(int x, int y, std::vector<uint32_t>& path) const
+{
+    path.clear();
+    if((x < 0) || (x >= mSizeX) || (y < 0) || (y >= mSizeY))
+        return false;
+
+    uint32_t index = AstarSearch::getIndex(x, y, mSizeX);
+    if(mNextTiles[index] == NO_NEXT_TILE)
+        return false;
+
+    path.push_back(index);
+    while(index != mDestination)
+    {
+        index = mNextTiles[index];
+        path.push_back(index);
+    }
+
+    return true;
+}
+
 }
@@ -18,7 +18,11 @@
 #ifndef PATHFINDING_H
 #define PATHFINDING_H
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace Pathfinding
 {
@@ -42,6 +46,412 @@ namespace Pathfinding
     {
         return squaredDistance(ent1.getX(), ent2.getX(), ent1.getY(), ent2.getY());
     }
+
+    //! \brief Returns the manhattan distance between the 2 given coordinates. It is used as the A* heuristic
+    //! and as the base cost to move from a tile to one of its neighbors
+    inline double manhattanDistance(int x1, int y1, int x2, int y2)
+    {
+        return std::fabs(static_cast<double>(x2 - x1)) + std::fabs(static_cast<double>(y2 - y1));
+    }
+
+    /*! \brief Reusable A* search engine.
+     *
+     * The search nodes are stored in a flat array (one node per tile) that is kept between searches.
+     * Each node is stamped with the generation of the last search that reached it. Thus, starting a new
+     * search only increments the generation counter: nothing has to be cleared nor allocated as long as
+     * the map size does not change. The open list is an indexed binary heap so that both extracting the
+     * best node and updating a node with a shorter path are O(log n).
+     * When 2 nodes have the same f cost, the first one inserted (or updated) is processed first. That
+     * gives the same paths as the sorted open list used before.
+     *
+     * The Grid type given to search() is expected to provide:
+     * int getSizeX() const and int getSizeY() const
+     * bool isPassable(int x, int y) const : true if the tile can be walked through
+     * bool isDiggable(int x, int y) const : true if the tile is not passable but can be dug through
+     * double getSpeed(int x, int y) const : the speed when leaving the tile
+     */
+    class AstarSearch
+    {
+    public:
+        AstarSearch();
+
+        /*! \brief Searches the path between (x1, y1) and (x2, y2). Both coordinates are expected to be in the grid.
+         * If a path is found, returns true and fills path with the indexes of the tiles from the start
+         * to the destination (both included). An index can be converted back with getX/getY.
+         * If no path is found, returns false and path is empty.
+         */
+        template<typename Grid>
+        bool search(const Grid& grid, int x1, int y1, int x2, int y2, std::vector<uint32_t>& path);
+
+        static inline uint32_t getIndex(int x, int y, int sizeX)
+        { return static_cast<uint32_t>(y * sizeX + x); }
+
+        static inline int getX(uint32_t index, int sizeX)
+        { return static_cast<int>(index % static_cast<uint32_t>(sizeX)); }
+
+        static inline int getY(uint32_t index, int sizeX)
+        { return static_cast<int>(index / static_cast<uint32_t>(sizeX)); }
+
+        //! \brief Returns the number of nodes processed during the last search
+        inline uint32_t getNbNodesProcessed() const
+        { return mNbNodesProcessed; }
+
+    private:
+        struct Node
+        {
+            double mG;
+            double mH;
+            //! \brief Insertion order in the open list. Used to break ties between nodes with the same f cost
+            uint32_t mOrder;
+            uint32_t mParent;
+            //! \brief Position in mOpenHeap or CLOSED once the node has been processed
+            uint32_t mHeapIndex;
+            //! \brief Search generation that last reached this node. If it is different from
+            //! mGeneration, the node has not been reached yet during the current search
+            uint32_t mGeneration;
+        };
+
+        static const uint32_t NO_PARENT;
+        static const uint32_t CLOSED;
+
+        std::vector<Node> mNodes;
+        std::vector<uint32_t> mOpenHeap;
+        uint32_t mGeneration;
+        uint32_t mOrder;
+        uint32_t mNbNodesProcessed;
+
+        //! \brief Starts a new search on a grid with the given number of tiles
+        void prepare(uint32_t nbNodes);
+
+        void openNode(uint32_t index, uint32_t parent, double g, double h);
+        uint32_t popBestNode();
+        //! \brief Sets a shorter path to an open node and restores the heap order
+        void updateNode(uint32_t index, uint32_t parent, double g);
+
+        inline bool isBefore(uint32_t index1, uint32_t index2) const
+        {
+            const Node& node1 = mNodes[index1];
+            const Node& node2 = mNodes[index2];
+            double f1 = node1.mG + node1.mH;
+            double f2 = node2.mG + node2.mH;
+            if(f1 != f2)
+                return f1 < f2;
+
+            return node1.mOrder < node2.mOrder;
+        }
+
+        void siftUp(uint32_t heapIndex);
+        void siftDown(uint32_t heapIndex);
+    };
+
+    template<typename Grid>
+    bool AstarSearch::search(const Grid& grid, int x1, int y1, int x2, int y2, std::vector<uint32_t>& path)
+    {
+        // The 4 first neighbors are the adjacent tiles and the 4 last ones the diagonals. A diagonal
+        // tile is only processed if the 2 adjacent tiles leading to it are passable
+        static const int NEIGHBOR_DIFF_X[8] = { -1, 1, 0, 0, -1, -1, 1, 1 };
+        static const int NEIGHBOR_DIFF_Y[8] = { 0, 0, -1, 1, -1, 1, -1, 1 };
+        static const int DIAGONAL_ADJACENT[4][2] = { {0, 2}, {0, 3}, {1, 2}, {1, 3} };
+
+        path.clear();
+        const int sizeX = grid.getSizeX();
+        const int sizeY = grid.getSizeY();
+        prepare(static_cast<uint32_t>(sizeX * sizeY));
+
+        const uint32_t startIndex = getIndex(x1, y1, sizeX);
+        const uint32_t destIndex = getIndex(x2, y2, sizeX);
+        openNode(startIndex, NO_PARENT, 0.0, manhattanDistance(x1, y1, x2, y2));
+
+        while(!mOpenHeap.empty())
+        {
+            uint32_t currentIndex = popBestNode();
+            ++mNbNodesProcessed;
+            if(currentIndex == destIndex)
+            {
+                for(uint32_t index = destIndex; index != NO_PARENT; index = mNodes[index].mParent)
+                    path.push_back(index);
+
+                std::reverse(path.begin(), path.end());
+                return true;
+            }
+
+            const int currentX = getX(currentIndex, sizeX);
+            const int currentY = getY(currentIndex, sizeX);
+            const double currentG = mNodes[currentIndex].mG;
+            const double currentSpeed = grid.getSpeed(currentX, currentY);
+            bool areTilesPassable[4] = {false, false, false, false};
+            for(int i = 0; i < 8; ++i)
+            {
+                if((i >= 4) &&
+                   (!areTilesPassable[DIAGONAL_ADJACENT[i - 4][0]] || !areTilesPassable[DIAGONAL_ADJACENT[i - 4][1]]))
+                {
+                    continue;
+                }
+
+                int neighborX = currentX + NEIGHBOR_DIFF_X[i];
+                int neighborY = currentY + NEIGHBOR_DIFF_Y[i];
+                if((neighborX < 0) || (neighborX >= sizeX) || (neighborY < 0) || (neighborY >= sizeY))
+                    continue;
+
+                uint32_t neighborIndex = getIndex(neighborX, neighborY, sizeX);
+                // We process the tile if it is passable. But if it is the start tile, we also process it
+                // even if it is not passable. That happens if a door is closed
+                if(grid.isPassable(neighborX, neighborY) || (neighborIndex == startIndex))
+                {
+                    // We set passability for the 4 adjacent tiles only
+                    if(i < 4)
+                        areTilesPassable[i] = true;
+                }
+                else if(!grid.isDiggable(neighborX, neighborY))
+                    continue;
+
+                double g = currentG + manhattanDistance(neighborX, neighborY, currentX, currentY) / currentSpeed;
+                Node& neighbor = mNodes[neighborIndex];
+                if(neighbor.mGeneration != mGeneration)
+                {
+                    openNode(neighborIndex, currentIndex, g, manhattanDistance(neighborX, neighborY, x2, y2));
+                    continue;
+                }
+
+                if(neighbor.mHeapIndex == CLOSED)
+                    continue;
+
+                // If this path to the given neighbor tile is shorter than the one already given,
+                // we use it
+                if(g < neighbor.mG)
+                    updateNode(neighborIndex, currentIndex, g);
+            }
+        }
+
+        return false;
+    }
+
+    /*! \brief Weighted distance from every tile to the closest of a set of target tiles.
+     *
+     * The distances are computed with a Dijkstra search starting from all the targets at once. Then, the path from
+     * any tile to its closest target is found by moving each time to the neighbor with the lowest distance. Thus,
+     * it only costs the length of the path. Only the 4 adjacent neighbors are used because walls are dug from
+     * their sides.
+     * The field is kept up to date with setTileChanged: the changed tiles are checked on the next update. If a tile
+     * got cheaper (like a wall that has been dug), the shorter distances are propagated from it. If it got more
+     * expensive, the whole field is computed again.
+     *
+     * The CostGrid type given to update() is expected to provide:
+     * int getSizeX() const and int getSizeY() const
+     * uint32_t getCost(int x, int y) const : the cost (at least 1) to go through the tile or IMPASSABLE
+     * bool isTarget(int x, int y) const : true if the tile is one of the targets. As the costs, it is only checked
+     * for the changed tiles. Thus, the targets can change (like gold tiles that are mined) without a new field
+     */
+    class DistanceField
+    {
+    public:
+        //! \brief Cost of the tiles that cannot be gone through. It is also the distance of the unreachable tiles
+        static const uint32_t IMPASSABLE;
+
+        DistanceField();
+
+        //! \brief Should be called when the cost of the given tile or whether it is a target may have changed
+        void setTileChanged(int x, int y);
+
+        //! \brief Computes the field if needed and takes into account the tiles changed since the last update
+        template<typename CostGrid>
+        void update(const CostGrid& grid);
+
+        //! \brief Returns the distance from the given tile to the closest target or IMPASSABLE if none can be reached
+        uint32_t getDistance(int x, int y) const;
+
+        /*! \brief Fills path with the indexes of the tiles from (x, y) to the closest target (both included).
+         * Returns false if no target can be reached. Should be called after update
+         */
+        bool getPath(int x, int y, std::vector<uint32_t>& path) const;
+
+        //! \brief Returns the number of times the whole field has been computed
+        inline uint32_t getNbFullComputations() const
+        { return mNbFullComputations; }
+
+    private:
+        //! \brief Distance and index of a tile to process
+        typedef std::pair<uint32_t, uint32_t> OpenEntry;
+
+        int mSizeX;
+        int mSizeY;
+        //! \brief Cost of each tile used to compute the current distances
+        std::vector<uint32_t> mCosts;
+        //! \brief Whether each tile is a target. The targets have a distance of 0 whatever their cost
+        std::vector<bool> mTargets;
+        std::vector<uint32_t> mDistances;
+        std::vector<uint32_t> mChangedTiles;
+        std::vector<OpenEntry> mOpenList;
+        bool mIsComputed;
+        uint32_t mNbFullComputations;
+
+        //! \brief Computes the distances of every tile from mCosts
+        void computeAll();
+
+        //! \brief Sets the cost of the given tile and whether it is a target. If it is cheaper or a new target, its new
+        //! distance is added to mOpenList. Returns false if the tile got more expensive or is no longer a target
+        bool setCost(uint32_t index, uint32_t cost, bool isTarget);
+
+        //! \brief Dijkstra search from the tiles in mOpenList
+        void propagate();
+    };
+
+    template<typename CostGrid>
+    void DistanceField::update(const CostGrid& grid)
+    {
+        const int sizeX = grid.getSizeX();
+        const int sizeY = grid.getSizeY();
+        if(!mIsComputed || (sizeX != mSizeX) || (sizeY != mSizeY))
+        {
+            mSizeX = sizeX;
+            mSizeY = sizeY;
+            mCosts.resize(static_cast<uint32_t>(sizeX * sizeY));
+            mTargets.resize(mCosts.size());
+            for(int y = 0; y < sizeY; ++y)
+            {
+                for(int x = 0; x < sizeX; ++x)
+                {
+                    uint32_t index = AstarSearch::getIndex(x, y, sizeX);
+                    mCosts[index] = grid.getCost(x, y);
+                    mTargets[index] = grid.isTarget(x, y);
+                }
+            }
+            mChangedTiles.clear();
+            computeAll();
+            return;
+        }
+
+        if(mChangedTiles.empty())
+            return;
+
+        bool isCostIncreased = false;
+        for(uint32_t index : mChangedTiles)
+        {
+            int x = AstarSearch::getX(index, sizeX);
+            int y = AstarSearch::getY(index, sizeX);
+            if(!setCost(index, grid.getCost(x, y), grid.isTarget(x, y)))
+                isCostIncreased = true;
+        }
+        mChangedTiles.clear();
+
+        if(isCostIncreased)
+            computeAll();
+        else
+            propagate();
+    }
+
+    /*! \brief Next tile to go to from every tile to reach a destination.
+     *
+     * When many creatures go to the same place (like a call to war), searching a path for each of them repeats the same
+     * work. The flow field is computed once with a Dijkstra search starting from the destination and going through the
+     * tiles that can reach it. It uses the same moves and costs as AstarSearch so the paths have the same length. Then,
+     * following the field from any tile only costs the length of the path.
+     *
+     * The Grid type given to compute() is the same as the one given to AstarSearch::search (isDiggable is not used).
+     */
+    class FlowField
+    {
+    public:
+        FlowField();
+
+        //! \brief Computes the field leading to (x, y). The coordinates are expected to be in the grid
+        template<typename Grid>
+        void compute(const Grid& grid, int x, int y);
+
+        inline uint32_t getDestination() const
+        { return mDestination; }
+
+        //! \brief Returns true if the given tile or one of its neighbors can reach the destination. If the
+        //! tile changes, the field may not be valid anymore
+        bool isNearField(int x, int y) const;
+
+        /*! \brief Fills path with the indexes of the tiles from (x, y) to the destination (both included).
+         * Returns false if the destination cannot be reached from (x, y)
+         */
+        bool getPath(int x, int y, std::vector<uint32_t>& path) const;
+
+    private:
+        static const uint32_t NO_NEXT_TILE;
+
+        //! \brief Cost to the destination and index of a tile to process
+        typedef std::pair<double, uint32_t> OpenEntry;
+
+        int mSizeX;
+        int mSizeY;
+        uint32_t mDestination;
+        //! \brief Next tile to go to from each tile or NO_NEXT_TILE if it cannot reach the destination
+        std::vector<uint32_t> mNextTiles;
+        std::vector<double> mCosts;
+        std::vector<OpenEntry> mOpenList;
+    };
+
+    template<typename Grid>
+    void FlowField::compute(const Grid& grid, int x, int y)
+    {
+        // The 4 first neighbors are the adjacent tiles and the 4 last ones the diagonals. Like in AstarSearch,
+        // a diagonal is only used if the 2 adjacent tiles leading to it are passable
+        static const int NEIGHBOR_DIFF_X[8] = { -1, 1, 0, 0, -1, -1, 1, 1 };
+        static const int NEIGHBOR_DIFF_Y[8] = { 0, 0, -1, 1, -1, 1, -1, 1 };
+        static const int DIAGONAL_ADJACENT[4][2] = { {0, 2}, {0, 3}, {1, 2}, {1, 3} };
+
+        mSizeX = grid.getSizeX();
+        mSizeY = grid.getSizeY();
+        const uint32_t nbTiles = static_cast<uint32_t>(mSizeX * mSizeY);
+        mDestination = AstarSearch::getIndex(x, y, mSizeX);
+        mNextTiles.assign(nbTiles, NO_NEXT_TILE);
+        mCosts.assign(nbTiles, 0.0);
+        mOpenList.clear();
+
+        auto isAfter = [](const OpenEntry& entry1, const OpenEntry& entry2) { return entry1 > entry2; };
+        mNextTiles[mDestination] = mDestination;
+        mOpenList.push_back(OpenEntry(0.0, mDestination));
+        while(!mOpenList.empty())
+        {
+            std::pop_heap(mOpenList.begin(), mOpenList.end(), isAfter);
+            OpenEntry entry = mOpenList.back();
+            mOpenList.pop_back();
+
+            // A tile can be pushed more than once. Outdated entries are skipped
+            const uint32_t currentIndex = entry.second;
+            if(entry.first > mCosts[currentIndex])
+                continue;
+
+            const int currentX = AstarSearch::getX(currentIndex, mSizeX);
+            const int currentY = AstarSearch::getY(currentIndex, mSizeX);
+            bool areTilesPassable[4] = {false, false, false, false};
+            for(int i = 0; i < 8; ++i)
+            {
+                if((i >= 4) &&
+                   (!areTilesPassable[DIAGONAL_ADJACENT[i - 4][0]] || !areTilesPassable[DIAGONAL_ADJACENT[i - 4][1]]))
+                {
+                    continue;
+                }
+
+                int neighborX = currentX + NEIGHBOR_DIFF_X[i];
+                int neighborY = currentY + NEIGHBOR_DIFF_Y[i];
+                if((neighborX < 0) || (neighborX >= mSizeX) || (neighborY < 0) || (neighborY >= mSizeY))
+                    continue;
+
+                if(!grid.isPassable(neighborX, neighborY))
+                    continue;
+
+                if(i < 4)
+                    areTilesPassable[i] = true;
+
+                // The cost of a move depends on the speed on the tile it starts from (see AstarSearch::search)
+                uint32_t neighborIndex = AstarSearch::getIndex(neighborX, neighborY, mSizeX);
+                double cost = entry.first + manhattanDistance(neighborX, neighborY, currentX, currentY)
+                    / grid.getSpeed(neighborX, neighborY);
+                if((mNextTiles[neighborIndex] != NO_NEXT_TILE) && (cost >= mCosts[neighborIndex]))
+                    continue;
+
+                mNextTiles[neighborIndex] = currentIndex;
+                mCosts[neighborIndex] = cost;
+                mOpenList.push_back(OpenEntry(cost, neighborIndex));
+                std::push_heap(mOpenList.begin(), mOpenList.end(), isAfter);
+            }
+        }
+    }
 }
 
 #endif // PATHFINDING_H
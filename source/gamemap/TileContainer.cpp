@@ -23,6 +23,9 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
+#include <algorithm>
+#include <map>
+
 const std::vector<Tile*> EMPTY_TILES;
 
 class TileDistance
@@ -262,65 +265,31 @@ private:
     std::vector<std::pair<uint32_t, double>> mHiddenTilesSouth;
 };
 
-class TileDistanceProcess
+//! \brief Transformation from the 1/8 tiles computed in buildTileDistance to one of the 8 octants:
+//! x = centerX + mXX * diffX + mXY * diffY and y = centerY + mYX * diffX + mYY * diffY
+struct OctantTransform
 {
-public:
-    TileDistanceProcess(const TileDistance& tileDistance, Tile* tile):
-        mTileDistance(tileDistance),
-        mTile(tile),
-        mHiddenValueNorth(0.0),
-        mHiddenValueSouth(0.0)
-    {
-    }
-
-    inline const TileDistance& getTileDistance() const
-    {
-        return mTileDistance;
-    }
-
-    void addHiddenValueNorth(double val)
-    {
-        // We only add the highest value
-        if(val <= mHiddenValueNorth)
-            return;
-
-        mHiddenValueNorth = val;
-    }
-
-    void addHiddenValueSouth(double val)
-    {
-        // We only add the highest value
-        if(val <= mHiddenValueSouth)
-            return;
-
-        mHiddenValueSouth = val;
-    }
-
-    inline bool isTileVisible() const
-    {
-        return (mHiddenValueNorth + mHiddenValueSouth) <= 0.5;
-    }
-
-    inline double getHiddenValueNorth() const
-    {
-        return mHiddenValueNorth;
-    }
-
-    inline double getHiddenValueSouth() const
-    {
-        return mHiddenValueSouth;
-    }
-
-    inline Tile* getTile() const
-    {
-        return mTile;
-    }
+    int mXX;
+    int mXY;
+    int mYX;
+    int mYY;
+};
 
-private:
-    const TileDistance& mTileDistance;
-    Tile* mTile;
-    double mHiddenValueNorth;
-    double mHiddenValueSouth;
+// We process the octants in this order (c being the starting tile):
+// 514
+// 2c0
+// 637
+// Octants k and k + 4 share their diagonal tiles. Octants k and (k + 1) % 4 share their horizontal tiles
+const OctantTransform OCTANT_TRANSFORMS[8] =
+{
+    {  1,  0,  0,  1 },
+    {  0,  1, -1,  0 },
+    { -1,  0,  0, -1 },
+    {  0, -1,  1,  0 },
+    {  0,  1,  1,  0 },
+    {  1,  0,  0, -1 },
+    {  0, -1, -1,  0 },
+    { -1,  0,  0,  1 }
 };
 
 bool sortByDistSquared(const TileDistance& tileDist1, const TileDistance& tileDist2)
@@ -328,11 +297,18 @@ bool sortByDistSquared(const TileDistance& tileDist1, const TileDistance& tileDi
     return tileDist1.getDistSquared() < tileDist2.getDistSquared();
 }
 
+const uint8_t TileContainer::NO_CLAIM_OWNER = 0;
+const uint32_t TileContainer::MAX_CLAIM_OWNER_SEATS = 255;
+
 TileContainer::TileContainer(int initTileDistance):
     mMapSizeX(0),
     mMapSizeY(0),
     mRr(0),
     mTiles(nullptr),
+    mNbFloodFillTeams(0),
+    mNbFloodFillTypes(0),
+    mNbVisionSeats(0),
+    mNbVisionWordsPerSeat(0),
     mTileDistanceComputed(0)
 {
     buildTileDistance(initTileDistance);
@@ -361,6 +337,19 @@ void TileContainer::clearTiles()
     }
     mMapSizeX = 0;
     mMapSizeY = 0;
+    clearLayers();
+}
+
+void TileContainer::clearLayers()
+{
+    mFloodFillColors.clear();
+    mNbFloodFillTeams = 0;
+    mNbFloodFillTypes = 0;
+    mClaimOwners.clear();
+    mSeatsVisionCounts.clear();
+    mSeatsVisionBits.clear();
+    mNbVisionSeats = 0;
+    mNbVisionWordsPerSeat = 0;
 }
 
 bool TileContainer::addTile(Tile* t)
@@ -432,6 +421,43 @@ Tile* TileContainer::tileFromPacket(ODPacket& packet) const
     return tile;
 }
 
+void TileContainer::tilesToPacket(ODPacket& packet, std::vector<Tile*>& tiles) const
+{
+    std::sort(tiles.begin(), tiles.end(), [](const Tile* tile1, const Tile* tile2)
+    {
+        if(tile1->getY() != tile2->getY())
+            return tile1->getY() < tile2->getY();
+
+        return tile1->getX() < tile2->getX();
+    });
+    // A tile given twice is sent once. The duplicates are next to each other once sorted
+    tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+
+    std::vector<uint32_t> indexes;
+    indexes.reserve(tiles.size());
+    for(Tile* tile : tiles)
+        indexes.push_back(static_cast<uint32_t>(tile->getY() * getMapSizeX() + tile->getX()));
+
+    packet.writeSortedIndexes(indexes);
+}
+
+bool TileContainer::tilesFromPacket(ODPacket& packet, std::vector<Tile*>& tiles) const
+{
+    std::vector<uint32_t> indexes;
+    uint32_t nbTiles = static_cast<uint32_t>(getMapSizeX() * getMapSizeY());
+    if(!packet.readSortedIndexes(indexes, nbTiles))
+    {
+        OD_LOG_ERR("Invalid tile set nbTiles=" + Helper::toString(nbTiles));
+        return false;
+    }
+
+    tiles.reserve(tiles.size() + indexes.size());
+    for(uint32_t index : indexes)
+        tiles.push_back(getTile(static_cast<int>(index) % getMapSizeX(), static_cast<int>(index) / getMapSizeX()));
+
+    return true;
+}
+
 bool TileContainer::allocateMapMemory(int xSize, int ySize)
 {
     if (xSize <= 0 || ySize <= 0)
@@ -473,6 +499,55 @@ bool TileContainer::allocateMapMemory(int xSize, int ySize)
         }
     }
 
+    // The floodfill and vision layers depend on the map size. They will be allocated when the seats are known
+    clearLayers();
+    mClaimOwners.assign(static_cast<uint32_t>(mMapSizeX * mMapSizeY), NO_CLAIM_OWNER);
+
+    return true;
+}
+
+void TileContainer::allocateFloodFillLayers(uint32_t nbTeams, uint32_t nbFloodFillTypes)
+{
+    mNbFloodFillTeams = nbTeams;
+    mNbFloodFillTypes = nbFloodFillTypes;
+    mFloodFillColors.assign(nbTeams * nbFloodFillTypes * static_cast<uint32_t>(mMapSizeX * mMapSizeY), 0);
+}
+
+void TileContainer::resetFloodFillLayers()
+{
+    std::fill(mFloodFillColors.begin(), mFloodFillColors.end(), 0);
+}
+
+void TileContainer::allocateVisionLayers(uint32_t nbSeats)
+{
+    uint32_t nbTiles = static_cast<uint32_t>(mMapSizeX * mMapSizeY);
+    mNbVisionSeats = nbSeats;
+    mNbVisionWordsPerSeat = (nbTiles + 63) / 64;
+    mSeatsVisionCounts.assign(nbSeats * nbTiles, 0);
+    mSeatsVisionBits.assign(nbSeats * mNbVisionWordsPerSeat, 0);
+}
+
+bool TileContainer::addSeatVisionSource(uint32_t seatIndex, int x, int y)
+{
+    uint32_t index = getTileIndex(x, y);
+    uint32_t& count = mSeatsVisionCounts[seatIndex * static_cast<uint32_t>(mMapSizeX * mMapSizeY) + index];
+    ++count;
+    if(count > 1)
+        return false;
+
+    mSeatsVisionBits[seatIndex * mNbVisionWordsPerSeat + index / 64] |= static_cast<uint64_t>(1) << (index % 64);
+    return true;
+}
+
+bool TileContainer::removeSeatVisionSource(uint32_t seatIndex, int x, int y)
+{
+    uint32_t index = getTileIndex(x, y);
+    uint32_t& count = mSeatsVisionCounts[seatIndex * static_cast<uint32_t>(mMapSizeX * mMapSizeY) + index];
+    --count;
+    if(count > 0)
+        return false;
+
+    mSeatsVisionBits[seatIndex * mNbVisionWordsPerSeat + index / 64] &= ~(static_cast<uint64_t>(1) << (index % 64));
     return true;
 }
 
@@ -715,6 +790,35 @@ void TileContainer::buildTileDistance(int distance)
         }
     }
 
+    // We store the occlusion tables in a flat form with the north and south values merged
+    mHiddenTilesOffsets.clear();
+    mHiddenTiles.clear();
+    for(const TileDistance& tileDistance : mTileDistance)
+    {
+        mHiddenTilesOffsets.push_back(mHiddenTiles.size());
+        std::map<uint32_t, std::pair<double, double>> hiddenTiles;
+        for(const std::pair<uint32_t, double>& p : tileDistance.getHiddenTilesNorth())
+        {
+            std::pair<double, double>& hiddenValues = hiddenTiles[p.first];
+            hiddenValues.first = std::max(hiddenValues.first, p.second);
+        }
+        for(const std::pair<uint32_t, double>& p : tileDistance.getHiddenTilesSouth())
+        {
+            std::pair<double, double>& hiddenValues = hiddenTiles[p.first];
+            hiddenValues.second = std::max(hiddenValues.second, p.second);
+        }
+
+        for(const std::pair<const uint32_t, std::pair<double, double>>& p : hiddenTiles)
+        {
+            HiddenTile hiddenTile;
+            hiddenTile.mIndex = p.first;
+            hiddenTile.mHiddenValueNorth = p.second.first;
+            hiddenTile.mHiddenValueSouth = p.second.second;
+            mHiddenTiles.push_back(hiddenTile);
+        }
+    }
+    mHiddenTilesOffsets.push_back(mHiddenTiles.size());
+
     mTileDistanceComputed = distance;
 }
 
@@ -808,164 +912,158 @@ std::list<Tile*> TileContainer::tilesBetween(int x1, int y1, int x2, int y2) con
     return path;
 }
 
-std::vector<Tile*> TileContainer::visibleTiles(int x, int y, int radius)
+void TileContainer::prepareTileDistance(int radius)
+{
+    if(radius > mTileDistanceComputed)
+        buildTileDistance(radius);
+}
+
+void TileContainer::visibleTiles(int x, int y, int radius, VisibleTiles& visibleTiles)
 {
     // To compute the tiles within this region, we use the symmetry of the square. That's why we mix tile x/y coordinate
     // with tileDist diffX/diffY. More explanation can be found in the buildTileDistance function
-    std::vector<Tile*> returnList;
-
     if(radius > mTileDistanceComputed)
         buildTileDistance(radius);
 
-    int radiusSquared = radius * radius;
+    visibleTiles.reset(x, y, radius);
 
-    // To have all the tiles around, we process mTileDistance 8 times.
-    // We will process in, this order (c being the starting tile):
-    // 514
-    // 2c0
-    // 637
-    // Then, we will have to merge diagonal/horizontal tiles
-    // Because we want the index to be correct, we will add tiles even when null in tilesProcess
-    std::vector<TileDistanceProcess> tilesProcess[8];
-    for(uint32_t k = 0; k < 8; ++k)
+    // mTileDistance is sorted by distance so we only need to process the first tiles
+    int radiusSquared = radius * radius;
+    uint32_t nbTiles = 0;
+    while((nbTiles < mTileDistance.size()) &&
+          (mTileDistance[nbTiles].getDistSquared() <= radiusSquared))
     {
-        for(const TileDistance& tileDist : mTileDistance)
-        {
-            if(tileDist.getDistSquared() > radiusSquared)
-                break;
-
-            switch(k)
-            {
-                case 0:
-                {
-                    Tile* tile = getTile(x + tileDist.getDiffX(), y + tileDist.getDiffY());
-                    tilesProcess[k].push_back(TileDistanceProcess(tileDist, tile));
-                    break;
-                }
-                case 1:
-                {
-                    Tile* tile = getTile(x + tileDist.getDiffY(), y - tileDist.getDiffX());
-                    tilesProcess[k].push_back(TileDistanceProcess(tileDist, tile));
-                    break;
-                }
-                case 2:
-                {
-                    Tile* tile = getTile(x - tileDist.getDiffX(), y - tileDist.getDiffY());
-                    tilesProcess[k].push_back(TileDistanceProcess(tileDist, tile));
-                    break;
-                }
-                case 3:
-                {
-                    Tile* tile = getTile(x - tileDist.getDiffY(), y + tileDist.getDiffX());
-                    tilesProcess[k].push_back(TileDistanceProcess(tileDist, tile));
-                    break;
-                }
-                case 4:
-                {
-                    Tile* tile = getTile(x + tileDist.getDiffY(), y + tileDist.getDiffX());
-                    tilesProcess[k].push_back(TileDistanceProcess(tileDist, tile));
-                    break;
-                }
-                case 5:
-                {
-                    Tile* tile = getTile(x + tileDist.getDiffX(), y - tileDist.getDiffY());
-                    tilesProcess[k].push_back(TileDistanceProcess(tileDist, tile));
-                    break;
-                }
-                case 6:
-                {
-                    Tile* tile = getTile(x - tileDist.getDiffY(), y - tileDist.getDiffX());
-                    tilesProcess[k].push_back(TileDistanceProcess(tileDist, tile));
-                    break;
-                }
-                case 7:
-                {
-                    Tile* tile = getTile(x - tileDist.getDiffX(), y + tileDist.getDiffY());
-                    tilesProcess[k].push_back(TileDistanceProcess(tileDist, tile));
-                    break;
-                }
-                default:
-                    break;
-            }
-        }
+        ++nbTiles;
     }
 
-    // The array of tiles is filled. Now, we apply the visibility.
+    // To have all the tiles around, we process mTileDistance 8 times (once for each octant).
+    // Because we want the index to be correct, we will add tiles even when null in the buffers
+    std::vector<Tile*>& octantTiles = visibleTiles.mOctantTiles;
+    std::vector<double>& hiddenValuesNorth = visibleTiles.mHiddenValuesNorth;
+    std::vector<double>& hiddenValuesSouth = visibleTiles.mHiddenValuesSouth;
+    octantTiles.resize(8 * nbTiles);
+    hiddenValuesNorth.assign(8 * nbTiles, 0.0);
+    hiddenValuesSouth.assign(8 * nbTiles, 0.0);
     for(uint32_t k = 0; k < 8; ++k)
     {
-        for(TileDistanceProcess& tileDistanceProcess : tilesProcess[k])
+        const OctantTransform& transform = OCTANT_TRANSFORMS[k];
+        uint32_t octantIndex = k * nbTiles;
+        for(uint32_t i = 0; i < nbTiles; ++i)
         {
-            if(tileDistanceProcess.getTile() == nullptr)
+            const TileDistance& tileDist = mTileDistance[i];
+            Tile* tile = getTile(x + transform.mXX * tileDist.getDiffX() + transform.mXY * tileDist.getDiffY(),
+                y + transform.mYX * tileDist.getDiffX() + transform.mYY * tileDist.getDiffY());
+            octantTiles[octantIndex + i] = tile;
+            if(tile == nullptr)
                 continue;
 
-            if(tileDistanceProcess.getTile()->permitsVision())
+            if(tile->permitsVision())
                 continue;
 
-            // The tile hides vision. We process tiles it hides
-            for(const std::pair<uint32_t, double>& p : tileDistanceProcess.getTileDistance().getHiddenTilesNorth())
-            {
-                // mTileDistance might be bigger than the actual vector because it can include tiles
-                // farther than the ones currently computed (for example if sight < computedSight)
-                if(p.first >= tilesProcess[k].size())
-                    continue;
-
-                tilesProcess[k][p.first].addHiddenValueNorth(p.second);
-            }
-            for(const std::pair<uint32_t, double>& p : tileDistanceProcess.getTileDistance().getHiddenTilesSouth())
+            // The tile hides vision. We process tiles it hides. Since they are farther than this tile,
+            // they have not been processed yet.
+            for(uint32_t indexHidden = mHiddenTilesOffsets[i]; indexHidden < mHiddenTilesOffsets[i + 1]; ++indexHidden)
             {
                 // mTileDistance might be bigger than the actual vector because it can include tiles
                 // farther than the ones currently computed (for example if sight < computedSight)
-                if(p.first >= tilesProcess[k].size())
-                    continue;
+                const HiddenTile& hiddenTile = mHiddenTiles[indexHidden];
+                if(hiddenTile.mIndex >= nbTiles)
+                    break;
 
-                tilesProcess[k][p.first].addHiddenValueSouth(p.second);
+                uint32_t index = octantIndex + hiddenTile.mIndex;
+                hiddenValuesNorth[index] = std::max(hiddenValuesNorth[index], hiddenTile.mHiddenValueNorth);
+                hiddenValuesSouth[index] = std::max(hiddenValuesSouth[index], hiddenTile.mHiddenValueSouth);
             }
         }
     }
 
     // Now, we process all the tiles. Note that horizontal tiles are common for 2 consecutive
-    // vectors in tilesProcess and that diagonal tiles should be merged.
-    // The 8 vectors have the same size
-    for(uint32_t i = 0; i < tilesProcess[0].size(); ++i)
+    // octants and that diagonal tiles should be merged.
+    for(uint32_t i = 0; i < nbTiles; ++i)
     {
+        const TileDistance& tileDist = mTileDistance[i];
         for(uint32_t k = 0; k < 8; ++k)
         {
-            TileDistanceProcess& tileDistanceProcess = tilesProcess[k][i];
-            if(tileDistanceProcess.getTile() == nullptr)
-                continue;
-
             // We avoid adding several times the center tile
-            if((k > 0) && (tileDistanceProcess.getTileDistance().getDistSquared() == 0))
-                continue;
+            if((k > 0) && (tileDist.getDistSquared() == 0))
+                break;
 
-            // Because horizontal tiles are common, we don't process them for the 4 last vectors
-            if((tileDistanceProcess.getTileDistance().getType() == TileDistance::TileDistanceType::Horizontal) &&
-               (k > 3))
+            // Because horizontal tiles are common, we don't process them for the 4 last octants. Diagonal
+            // tiles need to be merged (because south hiding and north hiding are not computed within the
+            // same octant). They will be processed for k < 4
+            if((k > 3) &&
+               ((tileDist.getType() == TileDistance::TileDistanceType::Horizontal) ||
+                (tileDist.getType() == TileDistance::TileDistanceType::Diagonal)))
             {
-                continue;
+                break;
             }
 
-            // Diagonal tiles need to be merged (because south hiding and north hiding are not
-            // computed within the same array). They will be processed for k < 4
-            if((tileDistanceProcess.getTileDistance().getType() == TileDistance::TileDistanceType::Diagonal) &&
-               (k > 3))
-            {
+            uint32_t index = k * nbTiles + i;
+            Tile* tile = octantTiles[index];
+            if(tile == nullptr)
                 continue;
-            }
 
-            if(tileDistanceProcess.getTileDistance().getType() == TileDistance::TileDistanceType::Diagonal)
+            double hiddenValueNorth = hiddenValuesNorth[index];
+            double hiddenValueSouth = hiddenValuesSouth[index];
+            if(tileDist.getType() == TileDistance::TileDistanceType::Diagonal)
             {
                 // We merge diagonal tiles. Because they are inverted, south hidden value becomes north and vice-versa
-                TileDistanceProcess& tileDistanceProcess2 = tilesProcess[k + 4][i];
-                tileDistanceProcess.addHiddenValueNorth(tileDistanceProcess2.getHiddenValueSouth());
-                tileDistanceProcess.addHiddenValueSouth(tileDistanceProcess2.getHiddenValueNorth());
+                uint32_t indexMerged = (k + 4) * nbTiles + i;
+                hiddenValueNorth = std::max(hiddenValueNorth, hiddenValuesSouth[indexMerged]);
+                hiddenValueSouth = std::max(hiddenValueSouth, hiddenValuesNorth[indexMerged]);
             }
 
-            if(!tileDistanceProcess.isTileVisible())
+            if((hiddenValueNorth + hiddenValueSouth) > 0.5)
                 continue;
 
-            returnList.push_back(tileDistanceProcess.getTile());
+            visibleTiles.addTile(tile);
         }
     }
-    return returnList;
+}
+
+VisibleTiles::VisibleTiles() :
+    mCenterX(0),
+    mCenterY(0),
+    mRadius(0),
+    mWindowSize(0)
+{
+}
+
+bool VisibleTiles::isTileVisible(const Tile* tile) const
+{
+    return isVisible(tile->getX(), tile->getY());
+}
+
+void VisibleTiles::clear()
+{
+    reset(0, 0, 0);
+    mWindowSize = 0;
+}
+
+void VisibleTiles::copyTiles(const VisibleTiles& visibleTiles)
+{
+    mCenterX = visibleTiles.mCenterX;
+    mCenterY = visibleTiles.mCenterY;
+    mRadius = visibleTiles.mRadius;
+    mWindowSize = visibleTiles.mWindowSize;
+    mTiles = visibleTiles.mTiles;
+    mBits = visibleTiles.mBits;
+}
+
+void VisibleTiles::reset(int x, int y, int radius)
+{
+    mCenterX = x;
+    mCenterY = y;
+    mRadius = radius;
+    mWindowSize = 2 * radius + 1;
+    mTiles.clear();
+    uint32_t nbBits = static_cast<uint32_t>(mWindowSize * mWindowSize);
+    mBits.assign((nbBits + 63) / 64, 0);
+}
+
+void VisibleTiles::addTile(Tile* tile)
+{
+    mTiles.push_back(tile);
+    uint32_t index = static_cast<uint32_t>((tile->getY() - mCenterY + mRadius) * mWindowSize + tile->getX() - mCenterX + mRadius);
+    mBits[index / 64] |= static_cast<uint64_t>(1) << (index % 64);
 }
@@ -19,6 +19,7 @@
 #define TILECONTAINER_H
 
 #include <cassert>
+#include <cstdint>
 #include <list>
 #include <vector>
 
@@ -28,6 +29,66 @@ class Tile;
 
 enum class TileType;
 
+//! \brief Result of TileContainer::visibleTiles. The visible tiles are sorted from the closest to the furthest and
+//! a bitset covering the square around the center allows to check in O(1) if a tile is visible.
+//! It also keeps the buffers used during the computation so that an object reused between calls does not allocate memory
+class VisibleTiles
+{
+    friend class TileContainer;
+public:
+    VisibleTiles();
+
+    inline const std::vector<Tile*>& getTiles() const
+    { return mTiles; }
+
+    //! \brief Returns true if the tile at the given coordinates is visible
+    inline bool isVisible(int x, int y) const
+    {
+        int xx = x - mCenterX + mRadius;
+        int yy = y - mCenterY + mRadius;
+        if((xx < 0) || (yy < 0) || (xx >= mWindowSize) || (yy >= mWindowSize))
+            return false;
+
+        uint32_t index = static_cast<uint32_t>(yy * mWindowSize + xx);
+        return (mBits[index / 64] & (static_cast<uint64_t>(1) << (index % 64))) != 0;
+    }
+
+    bool isTileVisible(const Tile* tile) const;
+
+    //! \brief The visible tiles are within the square of side 2 * radius + 1 around the center
+    inline int getCenterX() const
+    { return mCenterX; }
+
+    inline int getCenterY() const
+    { return mCenterY; }
+
+    inline int getRadius() const
+    { return mRadius; }
+
+    void clear();
+
+    //! \brief Copies the visible tiles of the given VisibleTiles (but not its buffers)
+    void copyTiles(const VisibleTiles& visibleTiles);
+
+private:
+    //! \brief Clears the visible tiles and sets the window around the given center
+    void reset(int x, int y, int radius);
+    void addTile(Tile* tile);
+
+    int mCenterX;
+    int mCenterY;
+    int mRadius;
+    int mWindowSize;
+    std::vector<Tile*> mTiles;
+    //! \brief One bit per tile of the (2 * radius + 1) square window around the center
+    std::vector<uint64_t> mBits;
+
+    //! \brief Buffers used by TileContainer::visibleTiles to process the 8 octants
+    std::vector<Tile*> mOctantTiles;
+    std::vector<double> mHiddenValuesNorth;
+    std::vector<double> mHiddenValuesSouth;
+};
+
 class TileContainer
 {
 public:
@@ -62,6 +123,14 @@ public:
     void tileToPacket(ODPacket& packet, Tile* tile) const;
     Tile* tileFromPacket(ODPacket& packet) const;
 
+    //! \brief Exports a set of tiles with ODPacket::writeSortedIndexes (tiles are indexed row by row).
+    //! Note that the given vector is modified: it is sorted in the order used by tilesFromPacket and
+    //! the duplicates are removed so that data related to each tile can be sent after the set in the
+    //! same order.
+    void tilesToPacket(ODPacket& packet, std::vector<Tile*>& tiles) const;
+    //! \brief Reads a set of tiles exported with tilesToPacket. Returns false if the data is invalid
+    bool tilesFromPacket(ODPacket& packet, std::vector<Tile*>& tiles) const;
+
     //! \brief Returns all the valid tiles in the rectangular region specified by the two corner points given.
     std::vector<Tile*> rectangularRegion(int x1, int y1, int x2, int y2);
 
@@ -93,9 +162,55 @@ public:
      */
     std::list<Tile*> tilesBetween(int x1, int y1, int x2, int y2) const;
 
-    //! \brief Returns the tiles visible from the given start tile within radius. The tiles are ordered from the closest to
-    //! the furthest
-    std::vector<Tile*> visibleTiles(int x, int y, int radius);
+    //! \brief Fills visibleTiles with the tiles visible from the given start tile within radius. The tiles are ordered
+    //! from the closest to the furthest. The given object can be reused between calls to avoid allocating memory
+    void visibleTiles(int x, int y, int radius, VisibleTiles& visibleTiles);
+
+    //! \brief Computes the tile distances needed by circularRegion and visibleTiles up to the given radius if not already
+    //! done. After that, they do not modify the TileContainer for this radius and can be called from several threads
+    void prepareTileDistance(int radius);
+
+    //! \brief Number of teams the floodfill layers have been allocated for (see allocateFloodFillLayers)
+    inline uint32_t getNbFloodFillTeams() const
+    { return mNbFloodFillTeams; }
+
+    //! \brief Floodfill color given to the tile at (x, y) for the given team index and floodfill type. The
+    //! indexes must be valid (see getNbFloodFillTeams)
+    inline uint32_t getFloodFillColor(uint32_t teamIndex, uint32_t floodFillType, int x, int y) const
+    { return mFloodFillColors[getFloodFillIndex(teamIndex, floodFillType, x, y)]; }
+
+    inline void setFloodFillColor(uint32_t teamIndex, uint32_t floodFillType, int x, int y, uint32_t color)
+    { mFloodFillColors[getFloodFillIndex(teamIndex, floodFillType, x, y)] = color; }
+
+    //! \brief Claim owner value of a tile that is not claimed. Otherwise, the value is the owner seat index + 1
+    static const uint8_t NO_CLAIM_OWNER;
+
+    //! \brief Maximum number of seats the claim owner layer can store
+    static const uint32_t MAX_CLAIM_OWNER_SEATS;
+
+    //! \brief Claim owner of the tile at (x, y) (see NO_CLAIM_OWNER). The coordinates must be valid
+    inline uint8_t getClaimOwner(int x, int y) const
+    { return mClaimOwners[getTileIndex(x, y)]; }
+
+    //! \brief Number of seats the vision layers have been allocated for (see allocateVisionLayers)
+    inline uint32_t getNbVisionSeats() const
+    { return mNbVisionSeats; }
+
+    //! \brief Returns true if the seat at the given index has at least one vision source on the tile at (x, y).
+    //! The indexes must be valid (see getNbVisionSeats)
+    inline bool hasSeatVision(uint32_t seatIndex, int x, int y) const
+    {
+        uint32_t index = getTileIndex(x, y);
+        return (mSeatsVisionBits[seatIndex * mNbVisionWordsPerSeat + index / 64] & (static_cast<uint64_t>(1) << (index % 64))) != 0;
+    }
+
+    //! \brief Adds a vision source for the given seat on the tile at (x, y). Returns true if the seat
+    //! gains vision on the tile
+    bool addSeatVisionSource(uint32_t seatIndex, int x, int y);
+
+    //! \brief Removes a vision source for the given seat on the tile at (x, y). Returns true if the seat
+    //! loses vision on the tile. The seat must have vision on the tile (see hasSeatVision)
+    bool removeSeatVisionSource(uint32_t seatIndex, int x, int y);
 
 protected:
     //! \brief The map size
@@ -106,15 +221,73 @@ protected:
 
     //! \brief Set the map size and memory
     bool allocateMapMemory(int xSize, int ySize);
+
+    //! \brief Allocates the floodfill layers for the given number of teams and floodfill types. Every color
+    //! is set to 0 (no floodfill)
+    void allocateFloodFillLayers(uint32_t nbTeams, uint32_t nbFloodFillTypes);
+
+    //! \brief Sets every floodfill color to 0 (no floodfill)
+    void resetFloodFillLayers();
+
+    inline void setClaimOwner(int x, int y, uint8_t claimOwner)
+    { mClaimOwners[getTileIndex(x, y)] = claimOwner; }
+
+    //! \brief Allocates the vision layers for the given number of seats. No seat has vision on any tile
+    void allocateVisionLayers(uint32_t nbSeats);
+
 private:
     Tile*** mTiles;
 
+    //! \brief Floodfill colors of every tile stored contiguously by team, then floodfill type, then
+    //! tile (index y * mMapSizeX + x). That way, full map passes on a floodfill are linear scans
+    std::vector<uint32_t> mFloodFillColors;
+    uint32_t mNbFloodFillTeams;
+    uint32_t mNbFloodFillTypes;
+
+    inline uint32_t getFloodFillIndex(uint32_t teamIndex, uint32_t floodFillType, int x, int y) const
+    {
+        return ((teamIndex * mNbFloodFillTypes + floodFillType) * static_cast<uint32_t>(mMapSizeY)
+            + static_cast<uint32_t>(y)) * static_cast<uint32_t>(mMapSizeX) + static_cast<uint32_t>(x);
+    }
+
+    //! \brief Claim owner of every tile (index y * mMapSizeX + x, see NO_CLAIM_OWNER)
+    std::vector<uint8_t> mClaimOwners;
+
+    //! \brief Number of vision sources of every seat on every tile stored by seat, then tile (index y * mMapSizeX + x)
+    std::vector<uint32_t> mSeatsVisionCounts;
+
+    //! \brief One bitset per seat with a bit set for every tile where the seat has vision (vision count > 0). Each
+    //! bitset uses mNbVisionWordsPerSeat words. That way, checking the vision of a seat does not read the counts
+    std::vector<uint64_t> mSeatsVisionBits;
+    uint32_t mNbVisionSeats;
+    uint32_t mNbVisionWordsPerSeat;
+
+    inline uint32_t getTileIndex(int x, int y) const
+    { return static_cast<uint32_t>(y) * static_cast<uint32_t>(mMapSizeX) + static_cast<uint32_t>(x); }
+
+    //! \brief Clears the layers depending on the map size
+    void clearLayers();
+
     //! \brief Fills mTileDistance that will help to compute a vector with sorted Tiles more efficiently
     void buildTileDistance(int distance);
 
+    //! \brief Tile hidden by another one when it blocks vision. The index refers to mTileDistance
+    struct HiddenTile
+    {
+        uint32_t mIndex;
+        double mHiddenValueNorth;
+        double mHiddenValueSouth;
+    };
+
     //! \brief Helper to compute tile distances more efficiently
     std::vector<TileDistance> mTileDistance;
 
+    //! \brief Occlusion tables built from mTileDistance in a flat form. The tiles hidden by the tile at index i in
+    //! mTileDistance are stored in mHiddenTiles from mHiddenTilesOffsets[i] to mHiddenTilesOffsets[i + 1] sorted
+    //! by index. They are computed for 1/8 of the tiles and used for the 8 octants
+    std::vector<uint32_t> mHiddenTilesOffsets;
+    std::vector<HiddenTile> mHiddenTiles;
+
     //! \brief Stores the highest distance computed. If a bigger distance is asked, mTileDistance will have to be updated by
     //! calling buildTileDistance with the higher distance
     int mTileDistanceComputed;
@@ -677,8 +677,7 @@ bool GameMode::mousePressed(const OIS::MouseEvent& arg, OIS::MouseButtonID id)
             if(closestEntity != nullptr)
             {
                 ODClient::getSingleton().queueClientNotification(ClientNotificationType::askSlapEntity,
-                     closestEntity->getObjectType(),
-                     closestEntity->getName());
+                     closestEntity->getId());
                 return true;
             }
         }
@@ -725,8 +724,7 @@ bool GameMode::mousePressed(const OIS::MouseEvent& arg, OIS::MouseButtonID id)
         if(closestEntity != nullptr)
         {
             ODClient::getSingleton().queueClientNotification(ClientNotificationType::askEntityPickUp,
-                closestEntity->getObjectType(),
-                closestEntity->getName());
+                closestEntity->getId());
             return true;
         }
     }
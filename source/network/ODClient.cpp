@@ -433,13 +433,12 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
 
         case ServerNotificationType::removeEntity:
         {
-            GameEntityType entityType;
-            std::string entityName;
-            OD_ASSERT_TRUE(packetReceived >> entityType >> entityName);
-            GameEntity* entity = gameMap->getEntityFromTypeAndName(entityType, entityName);
+            uint32_t entityId;
+            OD_ASSERT_TRUE(packetReceived >> entityId);
+            GameEntity* entity = gameMap->getAnimatedObjectFromId(entityId);
             if(entity == nullptr)
             {
-                OD_LOG_ERR("entityType=" + Helper::toString(static_cast<int32_t>(entityType)) + ", entityName=" + entityName);
+                OD_LOG_ERR("entityId=" + Helper::toString(entityId));
                 break;
             }
 
@@ -473,31 +472,27 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
 
         case ServerNotificationType::animatedObjectSetWalkPath:
         {
-            std::string objName;
+            uint32_t objId;
             std::string walkAnim;
             std::string endAnim;
             bool loopEndAnim;
             bool playIdleWhenAnimationEnds;
             uint32_t nbDest;
-            OD_ASSERT_TRUE(packetReceived >> objName >> walkAnim >> endAnim);
+            OD_ASSERT_TRUE(packetReceived >> objId >> walkAnim >> endAnim);
             OD_ASSERT_TRUE(packetReceived >> loopEndAnim >> playIdleWhenAnimationEnds >> nbDest);
 
-            MovableGameEntity *tempAnimatedObject = gameMap->getAnimatedObject(objName);
+            MovableGameEntity *tempAnimatedObject = gameMap->getAnimatedObjectFromId(objId);
             if(tempAnimatedObject == nullptr)
             {
-                OD_LOG_ERR("objName=" + objName);
+                OD_LOG_ERR("objId=" + Helper::toString(objId));
                 break;
             }
 
-            std::vector<Ogre::Vector3> path;
-            while(nbDest > 0)
-            {
-                --nbDest;
-                Ogre::Vector3 dest;
-                OD_ASSERT_TRUE(packetReceived >> dest);
+            std::vector<Ogre::Vector3> path(nbDest);
+            OD_ASSERT_TRUE(packetReceived.readVector3Array(path.data(), path.size()));
+            for(Ogre::Vector3& dest : path)
                 tempAnimatedObject->correctEntityMovePosition(dest);
-                path.push_back(dest);
-            }
+
             tempAnimatedObject->setWalkPath(walkAnim, endAnim, loopEndAnim, playIdleWhenAnimationEnds, path);
             break;
         }
@@ -505,9 +500,8 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
         case ServerNotificationType::entityPickedUp:
         {
             int seatId;
-            GameEntityType entityType;
-            std::string entityName;
-            OD_ASSERT_TRUE(packetReceived >> seatId >> entityType >> entityName);
+            uint32_t entityId;
+            OD_ASSERT_TRUE(packetReceived >> seatId >> entityId);
             Player *tempPlayer = gameMap->getPlayerBySeatId(seatId);
             if(tempPlayer == nullptr)
             {
@@ -515,10 +509,10 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
                 break;
             }
 
-            GameEntity* entity = gameMap->getEntityFromTypeAndName(entityType, entityName);
+            GameEntity* entity = gameMap->getAnimatedObjectFromId(entityId);
             if(entity == nullptr)
             {
-                OD_LOG_ERR("entityType=" + Helper::toString(static_cast<int32_t>(entityType)) + ", entityName=" + entityName);
+                OD_LOG_ERR("entityId=" + Helper::toString(entityId));
                 break;
             }
 
@@ -552,17 +546,17 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
 
         case ServerNotificationType::setObjectAnimationState:
         {
-            std::string objName;
+            uint32_t objId;
             std::string animState;
             bool loop;
             bool playIdleWhenAnimationEnds;
             bool shouldSetWalkDirection;
-            OD_ASSERT_TRUE(packetReceived >> objName >> animState
+            OD_ASSERT_TRUE(packetReceived >> objId >> animState
                 >> loop >> playIdleWhenAnimationEnds >> shouldSetWalkDirection);
-            MovableGameEntity *obj = gameMap->getAnimatedObject(objName);
+            MovableGameEntity *obj = gameMap->getAnimatedObjectFromId(objId);
             if (obj == nullptr)
             {
-                OD_LOG_ERR("objName=" + objName + ", state=" + animState);
+                OD_LOG_ERR("objId=" + Helper::toString(objId) + ", state=" + animState);
                 break;
             }
 
@@ -590,19 +584,22 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
         case ServerNotificationType::entitiesRefresh:
         {
             uint32_t nbEntities;
-            GameEntityType entityType;
-            std::string entityName;
+            uint32_t entityId;
+            uint32_t entityDataSize;
             OD_ASSERT_TRUE(packetReceived >> nbEntities);
             while(nbEntities > 0)
             {
                 --nbEntities;
-                OD_ASSERT_TRUE(packetReceived >> entityType);
-                OD_ASSERT_TRUE(packetReceived >> entityName);
-                GameEntity* entity = gameMap->getEntityFromTypeAndName(entityType, entityName);
+                OD_ASSERT_TRUE(packetReceived >> entityId >> entityDataSize);
+                GameEntity* entity = gameMap->getAnimatedObjectFromId(entityId);
                 if(entity == nullptr)
                 {
-                    OD_LOG_ERR("entityType=" + Helper::toString(static_cast<int32_t>(entityType)) + ", entityName=" + entityName);
-                    break;
+                    // We skip the data of the unknown entity so that the following ones are refreshed
+                    OD_LOG_ERR("entityId=" + Helper::toString(entityId));
+                    if(packetReceived.readSpan(entityDataSize) == nullptr)
+                        break;
+
+                    continue;
                 }
 
                 entity->updateFromPacket(packetReceived);
@@ -638,14 +635,14 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
 
         case ServerNotificationType::setEntityOpacity:
         {
-            std::string entityName;
+            uint32_t entityId;
             float opacity;
-            OD_ASSERT_TRUE(packetReceived >> entityName >> opacity);
+            OD_ASSERT_TRUE(packetReceived >> entityId >> opacity);
 
-            RenderedMovableEntity* entity = gameMap->getRenderedMovableEntity(entityName);
+            RenderedMovableEntity* entity = gameMap->getRenderedMovableEntityFromId(entityId);
             if(entity == nullptr)
             {
-                OD_LOG_ERR("entityName=" + entityName);
+                OD_LOG_ERR("entityId=" + Helper::toString(entityId));
                 break;
             }
 
@@ -673,13 +670,13 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
 
         case ServerNotificationType::notifyCreatureInfo:
         {
-            std::string name;
+            uint32_t creatureId;
             std::string infos;
-            OD_ASSERT_TRUE(packetReceived >> name >> infos);
-            Creature* creature = gameMap->getCreature(name);
+            OD_ASSERT_TRUE(packetReceived >> creatureId >> infos);
+            Creature* creature = gameMap->getCreatureFromId(creatureId);
             if(creature == nullptr)
             {
-                OD_LOG_ERR("name=" + name);
+                OD_LOG_ERR("creatureId=" + Helper::toString(creatureId));
                 break;
             }
 
@@ -757,28 +754,17 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
 
         case ServerNotificationType::refreshVisibleTiles:
         {
-            uint32_t nbTiles;
-            // Tiles we gained vision
-            OD_ASSERT_TRUE(packetReceived >> nbTiles);
-            while(nbTiles > 0)
+            std::vector<Tile*> tilesVisionGained;
+            std::vector<Tile*> tilesVisionLost;
+            OD_ASSERT_TRUE(gameMap->tilesFromPacket(packetReceived, tilesVisionGained));
+            OD_ASSERT_TRUE(gameMap->tilesFromPacket(packetReceived, tilesVisionLost));
+            for(Tile* tile : tilesVisionGained)
             {
-                --nbTiles;
-                Tile* tile = gameMap->tileFromPacket(packetReceived);
-                if(tile == nullptr)
-                    continue;
-
                 tile->setLocalPlayerHasVision(true);
                 tile->refreshMesh();
             }
-            // Tiles we lost vision
-            OD_ASSERT_TRUE(packetReceived >> nbTiles);
-            while(nbTiles > 0)
+            for(Tile* tile : tilesVisionLost)
             {
-                --nbTiles;
-                Tile* tile = gameMap->tileFromPacket(packetReceived);
-                if(tile == nullptr)
-                    continue;
-
                 tile->setLocalPlayerHasVision(false);
                 tile->refreshMesh();
             }
@@ -787,19 +773,14 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
 
         case ServerNotificationType::refreshTiles:
         {
-            uint32_t nbTiles;
-            OD_ASSERT_TRUE(packetReceived >> nbTiles);
+            // The tile set is followed by the data of each tile in the same order
             std::vector<Tile*> tiles;
-            while(nbTiles > 0)
-            {
-                --nbTiles;
-                Tile* gameTile = gameMap->tileFromPacket(packetReceived);
-                if(gameTile == nullptr)
-                    continue;
+            if(!gameMap->tilesFromPacket(packetReceived, tiles))
+                break;
 
+            for(Tile* gameTile : tiles)
                 gameTile->updateFromPacket(packetReceived);
-                tiles.push_back(gameTile);
-            }
+
             gameMap->refreshBorderingTilesOf(tiles);
             break;
         }
@@ -828,21 +809,20 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
 
         case ServerNotificationType::carryEntity:
         {
-            std::string carrierName;
-            GameEntityType entityType;
-            std::string carriedName;
-            OD_ASSERT_TRUE(packetReceived >> carrierName >> entityType >> carriedName);
-            Creature* carrier = gameMap->getCreature(carrierName);
+            uint32_t carrierId;
+            uint32_t carriedId;
+            OD_ASSERT_TRUE(packetReceived >> carrierId >> carriedId);
+            Creature* carrier = gameMap->getCreatureFromId(carrierId);
             if(carrier == nullptr)
             {
-                OD_LOG_ERR("carrierName=" + carrierName);
+                OD_LOG_ERR("carrierId=" + Helper::toString(carrierId));
                 break;
             }
 
-            GameEntity* carried = gameMap->getEntityFromTypeAndName(entityType, carriedName);
+            GameEntity* carried = gameMap->getAnimatedObjectFromId(carriedId);
             if(carried == nullptr)
             {
-                OD_LOG_ERR("entityType=" + Helper::toString(static_cast<int32_t>(entityType)) + ", carriedName=" + carriedName);
+                OD_LOG_ERR("carriedId=" + Helper::toString(carriedId));
                 break;
             }
 
@@ -854,22 +834,21 @@ bool ODClient::processMessage(ServerNotificationType cmd, ODPacket& packetReceiv
 
         case ServerNotificationType::releaseCarriedEntity:
         {
-            std::string carrierName;
-            GameEntityType entityType;
-            std::string carriedName;
+            uint32_t carrierId;
+            uint32_t carriedId;
             Ogre::Vector3 pos;
-            OD_ASSERT_TRUE(packetReceived >> carrierName >> entityType >> carriedName >> pos);
-            Creature* carrier = gameMap->getCreature(carrierName);
+            OD_ASSERT_TRUE(packetReceived >> carrierId >> carriedId >> pos);
+            Creature* carrier = gameMap->getCreatureFromId(carrierId);
             if(carrier == nullptr)
             {
-                OD_LOG_ERR("carrierName=" + carrierName);
+                OD_LOG_ERR("carrierId=" + Helper::toString(carrierId));
                 break;
             }
 
-            GameEntity* carried = gameMap->getEntityFromTypeAndName(entityType, carriedName);
+            GameEntity* carried = gameMap->getAnimatedObjectFromId(carriedId);
             if(carried == nullptr)
             {
-                OD_LOG_ERR("entityType=" + Helper::toString(static_cast<int32_t>(entityType)) + ", carriedName=" + carriedName);
+                OD_LOG_ERR("carriedId=" + Helper::toString(carriedId));
                 break;
             }
 
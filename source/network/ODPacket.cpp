@@ -17,239 +17,544 @@
 
 #include "network/ODPacket.h"
 
-#define OD_INT64TOINT32H(valInt64)              (static_cast<int32_t>(valInt64 >> 32))
-#define OD_INT64TOINT32L(valInt64)              (static_cast<int32_t>(valInt64))
-#define OD_INT32TOINT64(valInt32h,valInt32l)    ((((static_cast<int64_t>(valInt32h)) << 32) & static_cast<int64_t>(0xFFFFFFFF00000000)) + ((static_cast<int64_t>(valInt32l)) & static_cast<int64_t>(0x00000000FFFFFFFF)))
+#include <algorithm>
+#include <cstring>
 
-// The max buffer size when reading packets.
-const int32_t BUFFER_SIZE = 1024;
+const std::size_t ODPacket::HEADER_SIZE = 4;
+const uint32_t ODPacket::MAX_DATA_SIZE = 64 * 1024 * 1024;
+
+// Integers are sent in network byte order (big endian) like sf::Packet does. Floats and doubles
+// are sent as is (like sf::Packet). The shifts are written explicitly so that the compiler can
+// turn them into a single load/store and byte swap
+static inline void writeBigEndian(char* dest, uint16_t data)
+{
+    dest[0] = static_cast<char>(data >> 8);
+    dest[1] = static_cast<char>(data);
+}
+
+static inline void writeBigEndian(char* dest, uint32_t data)
+{
+    dest[0] = static_cast<char>(data >> 24);
+    dest[1] = static_cast<char>(data >> 16);
+    dest[2] = static_cast<char>(data >> 8);
+    dest[3] = static_cast<char>(data);
+}
+
+static inline void writeBigEndian(char* dest, uint64_t data)
+{
+    writeBigEndian(dest, static_cast<uint32_t>(data >> 32));
+    writeBigEndian(dest + 4, static_cast<uint32_t>(data));
+}
+
+static inline uint16_t readBigEndian16(const char* src)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(src);
+    return static_cast<uint16_t>((bytes[0] << 8) | bytes[1]);
+}
+
+static inline uint32_t readBigEndian32(const char* src)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(src);
+    return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16)
+        | (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+}
+
+static inline uint64_t readBigEndian64(const char* src)
+{
+    return (static_cast<uint64_t>(readBigEndian32(src)) << 32) | readBigEndian32(src + 4);
+}
+
+ODPacket::ODPacket() :
+    mData(HEADER_SIZE, 0),
+    mReadPos(HEADER_SIZE),
+    mIsValid(true)
+{
+}
+
+char* ODPacket::allocate(std::size_t size)
+{
+    std::size_t pos = mData.size();
+    mData.resize(pos + size);
+    return mData.data() + pos;
+}
+
+bool ODPacket::checkSize(std::size_t size)
+{
+    mIsValid = mIsValid && (mReadPos + size <= mData.size());
+    return mIsValid;
+}
+
+void ODPacket::writeHeader()
+{
+    writeBigEndian(mData.data(), static_cast<uint32_t>(getDataSize()));
+}
 
 ODPacket& ODPacket::operator >>(bool& data)
 {
-    mPacket>>data;
+    uint8_t value;
+    if(*this >> value)
+        data = (value != 0);
+
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(int8_t& data)
 {
-    mPacket>>data;
+    uint8_t value;
+    if(*this >> value)
+        data = static_cast<int8_t>(value);
+
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(uint8_t& data)
 {
-    mPacket>>data;
+    if(!checkSize(sizeof(data)))
+        return *this;
+
+    data = static_cast<uint8_t>(mData[mReadPos]);
+    mReadPos += sizeof(data);
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(int16_t& data)
 {
-    mPacket>>data;
+    uint16_t value;
+    if(*this >> value)
+        data = static_cast<int16_t>(value);
+
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(uint16_t& data)
 {
-    mPacket>>data;
+    if(!checkSize(sizeof(data)))
+        return *this;
+
+    data = readBigEndian16(mData.data() + mReadPos);
+    mReadPos += sizeof(data);
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(int32_t& data)
 {
-    mPacket>>data;
+    uint32_t value;
+    if(*this >> value)
+        data = static_cast<int32_t>(value);
+
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(uint32_t& data)
 {
-    mPacket>>data;
+    if(!checkSize(sizeof(data)))
+        return *this;
+
+    data = readBigEndian32(mData.data() + mReadPos);
+    mReadPos += sizeof(data);
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(int64_t& data)
 {
-    // Note: currently, SFML 2.1 do not handle int64. We do it ourselves
-    int32_t dataH;
-    int32_t dataL;
-    mPacket>>dataH;
-    mPacket>>dataL;
-    data = OD_INT32TOINT64(dataH,dataL);
+    uint64_t value;
+    if(*this >> value)
+        data = static_cast<int64_t>(value);
+
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(uint64_t& data)
 {
-    // Note: currently, SFML 2.1 do not handle int64. We do it ourselves
-    uint32_t dataH;
-    uint32_t dataL;
-    mPacket>>dataH;
-    mPacket>>dataL;
-    data = OD_INT32TOINT64(dataH,dataL);
+    // Note: SFML 2.1 did not handle int64 so we used to send them as 2 int32 (high part first).
+    // That is the same as sending them in network byte order
+    if(!checkSize(sizeof(data)))
+        return *this;
+
+    data = readBigEndian64(mData.data() + mReadPos);
+    mReadPos += sizeof(data);
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(float& data)
 {
-    mPacket>>data;
+    if(!checkSize(sizeof(data)))
+        return *this;
+
+    std::memcpy(&data, mData.data() + mReadPos, sizeof(data));
+    mReadPos += sizeof(data);
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(double& data)
 {
-    mPacket>>data;
+    if(!checkSize(sizeof(data)))
+        return *this;
+
+    std::memcpy(&data, mData.data() + mReadPos, sizeof(data));
+    mReadPos += sizeof(data);
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(char* data)
 {
-    mPacket>>data;
+    uint32_t length = 0;
+    if(!(*this >> length))
+        return *this;
+
+    const char* chars = readSpan(length);
+    if(chars == nullptr)
+        return *this;
+
+    std::memcpy(data, chars, length);
+    data[length] = '\0';
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(std::string& data)
 {
-    mPacket>>data;
+    uint32_t length = 0;
+    if(!(*this >> length))
+        return *this;
+
+    const char* chars = readSpan(length);
+    if(chars == nullptr)
+        return *this;
+
+    data.assign(chars, length);
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(wchar_t* data)
 {
-    mPacket>>data;
+    uint32_t length = 0;
+    if(!(*this >> length))
+        return *this;
+
+    if(!checkSize(length * sizeof(uint32_t)))
+        return *this;
+
+    for(uint32_t i = 0; i < length; ++i)
+    {
+        uint32_t character = 0;
+        *this >> character;
+        data[i] = static_cast<wchar_t>(character);
+    }
+    data[length] = L'\0';
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(std::wstring& data)
 {
-    mPacket>>data;
+    uint32_t length = 0;
+    if(!(*this >> length))
+        return *this;
+
+    if(!checkSize(length * sizeof(uint32_t)))
+        return *this;
+
+    data.clear();
+    data.reserve(length);
+    for(uint32_t i = 0; i < length; ++i)
+    {
+        uint32_t character = 0;
+        *this >> character;
+        data += static_cast<wchar_t>(character);
+    }
     return *this;
 }
 
 ODPacket& ODPacket::operator >>(Ogre::Vector3& data)
 {
-    mPacket >> data.x >> data.y >> data.z;
-    return *this;
+    return readVector3Array(&data, 1);
 }
+
 ODPacket& ODPacket::operator <<(bool data)
 {
-    mPacket<<data;
-    return *this;
+    return *this << static_cast<uint8_t>(data ? 1 : 0);
 }
 
 ODPacket& ODPacket::operator <<(int8_t data)
 {
-    mPacket<<data;
-    return *this;
+    return *this << static_cast<uint8_t>(data);
 }
 
 ODPacket& ODPacket::operator <<(uint8_t data)
 {
-    mPacket<<data;
+    *allocate(sizeof(data)) = static_cast<char>(data);
     return *this;
 }
 
 ODPacket& ODPacket::operator <<(int16_t data)
 {
-    mPacket<<data;
-    return *this;
+    return *this << static_cast<uint16_t>(data);
 }
 
 ODPacket& ODPacket::operator <<(uint16_t data)
 {
-    mPacket<<data;
+    writeBigEndian(allocate(sizeof(data)), data);
     return *this;
 }
 
 ODPacket& ODPacket::operator <<(int32_t data)
 {
-    mPacket<<data;
-    return *this;
+    return *this << static_cast<uint32_t>(data);
 }
 
 ODPacket& ODPacket::operator <<(uint32_t data)
 {
-    mPacket<<data;
+    writeBigEndian(allocate(sizeof(data)), data);
     return *this;
 }
 
 ODPacket& ODPacket::operator <<(int64_t data)
 {
-    // Note: currently, SFML 2.1 do not handle int64. We do it ourselves
-    int32_t dataH = OD_INT64TOINT32H(data);
-    int32_t dataL = OD_INT64TOINT32L(data);
-    mPacket<<dataH;
-    mPacket<<dataL;
-    return *this;
+    return *this << static_cast<uint64_t>(data);
 }
 
 ODPacket& ODPacket::operator <<(uint64_t data)
 {
-    // Note: currently, SFML 2.1 do not handle int64. We do it ourselves
-    int32_t dataH = OD_INT64TOINT32H(data);
-    int32_t dataL = OD_INT64TOINT32L(data);
-    mPacket<<dataH;
-    mPacket<<dataL;
+    writeBigEndian(allocate(sizeof(data)), data);
     return *this;
 }
 
 ODPacket& ODPacket::operator <<(float data)
 {
-    mPacket<<data;
+    append(&data, sizeof(data));
     return *this;
 }
 
 ODPacket& ODPacket::operator <<(double data)
 {
-    mPacket<<data;
+    append(&data, sizeof(data));
     return *this;
 }
 
 ODPacket& ODPacket::operator <<(const char* data)
 {
-    mPacket<<data;
+    uint32_t length = static_cast<uint32_t>(std::strlen(data));
+    *this << length;
+    append(data, length);
     return *this;
 }
 
 ODPacket& ODPacket::operator <<(const std::string& data)
 {
-    mPacket<<data;
+    uint32_t length = static_cast<uint32_t>(data.size());
+    *this << length;
+    append(data.data(), length);
     return *this;
 }
 
 ODPacket& ODPacket::operator <<(const wchar_t* data)
 {
-    mPacket<<data;
+    uint32_t length = static_cast<uint32_t>(std::wcslen(data));
+    *this << length;
+    char* dest = allocate(length * sizeof(uint32_t));
+    for(uint32_t i = 0; i < length; ++i)
+        writeBigEndian(dest + i * sizeof(uint32_t), static_cast<uint32_t>(data[i]));
+
     return *this;
 }
 
 ODPacket& ODPacket::operator <<(const std::wstring& data)
 {
-    mPacket<<data;
+    return *this << data.c_str();
+}
+
+ODPacket& ODPacket::operator <<(const Ogre::Vector3& data)
+{
+    return writeVector3Array(&data, 1);
+}
+
+ODPacket& ODPacket::writeVector3Array(const Ogre::Vector3* data, std::size_t nb)
+{
+    if(nb == 0)
+        return *this;
+
+    // Ogre::Vector3 is only made of its 3 coordinates so it can be copied directly
+    static_assert(sizeof(Ogre::Vector3) == 3 * sizeof(Ogre::Real), "Unexpected Ogre::Vector3 layout");
+    append(data, nb * sizeof(Ogre::Vector3));
+    return *this;
+}
+
+ODPacket& ODPacket::readVector3Array(Ogre::Vector3* data, std::size_t nb)
+{
+    if(nb == 0)
+        return *this;
+
+    const char* span = readSpan(nb * sizeof(Ogre::Vector3));
+    if(span != nullptr)
+        std::memcpy(static_cast<void*>(data), span, nb * sizeof(Ogre::Vector3));
+
+    return *this;
+}
+
+void ODPacket::writeVarUInt32(uint32_t data)
+{
+    while(data >= 0x80)
+    {
+        *this << static_cast<uint8_t>((data & 0x7F) | 0x80);
+        data >>= 7;
+    }
+    *this << static_cast<uint8_t>(data);
+}
+
+bool ODPacket::readVarUInt32(uint32_t& data)
+{
+    data = 0;
+    // A 32 bits value takes at most 5 bytes
+    for(uint32_t shift = 0; shift < 35; shift += 7)
+    {
+        uint8_t byte = 0;
+        if(!(*this >> byte))
+            return false;
+
+        data |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if((byte & 0x80) == 0)
+            return true;
+    }
+
+    mIsValid = false;
+    return false;
+}
+
+ODPacket& ODPacket::writeSortedIndexes(const std::vector<uint32_t>& indexes)
+{
+    // The gaps between the runs are computed from increasing indexes. If they are not, we write a
+    // sorted copy without the duplicates
+    auto itNotIncreasing = std::adjacent_find(indexes.begin(), indexes.end(),
+        [](uint32_t index1, uint32_t index2) { return index1 >= index2; });
+    if(itNotIncreasing != indexes.end())
+    {
+        std::vector<uint32_t> sortedIndexes(indexes);
+        std::sort(sortedIndexes.begin(), sortedIndexes.end());
+        sortedIndexes.erase(std::unique(sortedIndexes.begin(), sortedIndexes.end()), sortedIndexes.end());
+        return writeSortedIndexes(sortedIndexes);
+    }
+
+    // We count the runs first to send their number
+    uint32_t nbRuns = 0;
+    for(std::size_t i = 0; i < indexes.size(); ++i)
+    {
+        if((i == 0) || (indexes[i] != indexes[i - 1] + 1))
+            ++nbRuns;
+    }
+
+    writeVarUInt32(nbRuns);
+    // Each run is sent as the gap since the end of the previous one and its length - 1
+    uint32_t previousEnd = 0;
+    std::size_t runStart = 0;
+    for(std::size_t i = 1; i <= indexes.size(); ++i)
+    {
+        if((i < indexes.size()) && (indexes[i] == indexes[i - 1] + 1))
+            continue;
+
+        writeVarUInt32(indexes[runStart] - previousEnd);
+        writeVarUInt32(static_cast<uint32_t>(i - runStart - 1));
+        previousEnd = indexes[i - 1] + 1;
+        runStart = i;
+    }
     return *this;
 }
 
-ODPacket& ODPacket::operator <<(const Ogre::Vector3&   data)
+ODPacket& ODPacket::readSortedIndexes(std::vector<uint32_t>& indexes, uint32_t indexEnd)
 {
-    mPacket << data.x << data.y << data.z;
+    indexes.clear();
+    uint32_t nbRuns = 0;
+    if(!readVarUInt32(nbRuns))
+        return *this;
+
+    uint64_t previousEnd = 0;
+    for(uint32_t run = 0; run < nbRuns; ++run)
+    {
+        uint32_t gap = 0;
+        uint32_t length = 0;
+        if(!readVarUInt32(gap) || !readVarUInt32(length))
+            return *this;
+
+        // We check the run before adding it so that corrupted data cannot make us allocate too much
+        uint64_t start = previousEnd + gap;
+        uint64_t end = start + length + 1;
+        if(end > indexEnd)
+        {
+            mIsValid = false;
+            return *this;
+        }
+
+        for(uint64_t index = start; index < end; ++index)
+            indexes.push_back(static_cast<uint32_t>(index));
+
+        previousEnd = end;
+    }
     return *this;
 }
 
 ODPacket::operator bool() const
 {
-    return mPacket;
+    return mIsValid;
 }
 
 void ODPacket::clear()
 {
-    mPacket.clear();
+    // We keep the allocated memory so that the packet can be reused
+    mData.resize(HEADER_SIZE);
+    mReadPos = HEADER_SIZE;
+    mIsValid = true;
+}
+
+std::size_t ODPacket::getDataSize() const
+{
+    return mData.size() - HEADER_SIZE;
+}
+
+const char* ODPacket::getData() const
+{
+    return mData.data() + HEADER_SIZE;
+}
+
+void ODPacket::reserve(std::size_t size)
+{
+    mData.reserve(HEADER_SIZE + size);
+}
+
+std::size_t ODPacket::getCapacity() const
+{
+    return mData.capacity() - HEADER_SIZE;
+}
+
+void ODPacket::append(const void* data, std::size_t size)
+{
+    if(size == 0)
+        return;
+
+    std::memcpy(allocate(size), data, size);
+}
+
+const char* ODPacket::readSpan(std::size_t size)
+{
+    if(!checkSize(size))
+        return nullptr;
+
+    const char* span = mData.data() + mReadPos;
+    mReadPos += size;
+    return span;
+}
+
+void ODPacket::appendToBuffer(std::vector<char>& buffer) const
+{
+    std::size_t pos = buffer.size();
+    buffer.resize(pos + mData.size());
+    writeBigEndian(buffer.data() + pos, static_cast<uint32_t>(getDataSize()));
+    std::memcpy(buffer.data() + pos + HEADER_SIZE, getData(), getDataSize());
 }
 
 void ODPacket::writePacket(int32_t timestamp, std::ofstream& os)
 {
-    int32_t bufferSize = mPacket.getDataSize();
-    const char* buffer = static_cast<const char*>(mPacket.getData());
+    int32_t bufferSize = static_cast<int32_t>(getDataSize());
     os.write(reinterpret_cast<const char*>(&timestamp), sizeof(int32_t));
     os.write(reinterpret_cast<const char*>(&bufferSize), sizeof(int32_t));
-    os.write(buffer, bufferSize);
+    os.write(getData(), bufferSize);
 }
 
 int32_t ODPacket::readPacket(std::ifstream& is)
@@ -262,18 +567,14 @@ int32_t ODPacket::readPacket(std::ifstream& is)
         return -1;
 
     is.read(reinterpret_cast<char*>(&packetSize), sizeof(int32_t));
-    if(is.eof())
+    if(is.eof() || (packetSize < 0))
         return -1;
 
-    mPacket.clear();
-    char buffer[BUFFER_SIZE];
-    while(packetSize > 0)
-    {
-        int32_t sizeToRead = std::min(packetSize, BUFFER_SIZE);
-        is.read(buffer, sizeToRead);
-        mPacket.append(buffer, sizeToRead);
-        packetSize -= sizeToRead;
-    }
+    // We read the data directly in the packet
+    clear();
+    is.read(allocate(static_cast<std::size_t>(packetSize)), packetSize);
+    if(is.gcount() != packetSize)
+        return -1;
 
     return timestamp;
 }
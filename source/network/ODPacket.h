@@ -19,10 +19,11 @@
 #define ODPACKET_H
 
 #include <OgreVector3.h>
-#include <SFML/Network.hpp>
 
 #include <string>
 #include <cstdint>
+#include <fstream>
+#include <vector>
 
 /*! \brief This class is an utility class to transfer data through ODSocketClient.
  * It should also override operators << and >> for each standard types.
@@ -62,14 +63,16 @@
  * Emission : packet << creature->mHp;
  * Reception : packet >> creature->mHp;
  * This way, if mHp changes (from float to double for example), it will still work.
+ * The data is serialized in a contiguous buffer with the same layout as sf::Packet (integers in
+ * network byte order, floats as is, strings prefixed by their size on 32 bits) so that the
+ * packets stay compatible with the saved replays and the sockets framing.
  */
 class ODPacket
 {
     friend class ODSocketClient;
 
     public:
-        ODPacket()
-        {}
+        ODPacket();
         ~ODPacket()
         {}
 
@@ -113,6 +116,21 @@ class ODPacket
         ODPacket& operator <<(const std::wstring&   data);
         ODPacket& operator <<(const Ogre::Vector3&   data);
 
+        /*! \brief Writes a set of indexes sorted in increasing order without duplicates. Consecutive
+         *         indexes are grouped in runs and each run is sent as its distance from the previous
+         *         one and its length, both as variable length integers (7 bits per byte). A region of
+         *         the map (with the tiles indexed row by row) then takes a few bytes per row instead
+         *         of 8 bytes per tile.
+         *         If the given indexes are not strictly increasing, they are written sorted and
+         *         without duplicates.
+         */
+        ODPacket& writeSortedIndexes(const std::vector<uint32_t>& indexes);
+
+        /*! \brief Reads indexes written with writeSortedIndexes. If an index is greater than or
+         *         equal to indexEnd, the packet becomes invalid.
+         */
+        ODPacket& readSortedIndexes(std::vector<uint32_t>& indexes, uint32_t indexEnd);
+
         /*! \brief Return true if there were no error exporting data (operator >>).
          * This behaviour is the same as standard C++ streams :
          * If we try to export data while the packet is empty or from incompatible types,
@@ -125,6 +143,46 @@ class ODPacket
          */
         void clear();
 
+        /*! \brief Returns the size in bytes of the data written in the packet.
+         */
+        std::size_t getDataSize() const;
+
+        /*! \brief Returns a pointer to the data written in the packet (getDataSize bytes).
+         */
+        const char* getData() const;
+
+        /*! \brief Allocates the memory for size bytes of data so that the packet is not
+         *         reallocated while it is written. Should be used when the size of the data to send
+         *         is known (or can be estimated) before writing it.
+         */
+        void reserve(std::size_t size);
+
+        /*! \brief Returns the number of bytes of data the packet can hold without being reallocated.
+         */
+        std::size_t getCapacity() const;
+
+        /*! \brief Appends size raw bytes at the end of the packet.
+         */
+        void append(const void* data, std::size_t size);
+
+        /*! \brief Returns a pointer to the next size bytes of the packet and moves the read position
+         *         after them. The pointer is valid until the packet is modified. If there is not enough
+         *         data left, the packet becomes invalid and nullptr is returned.
+         */
+        const char* readSpan(std::size_t size);
+
+        /*! \brief Writes/reads nb vectors with one copy. The data is the same as if each vector
+         *         was written/read with operator <<(const Ogre::Vector3&) or operator >>(Ogre::Vector3&)
+         */
+        ODPacket& writeVector3Array(const Ogre::Vector3* data, std::size_t nb);
+        ODPacket& readVector3Array(Ogre::Vector3* data, std::size_t nb);
+
+        /*! \brief Appends the packet at the end of buffer framed the same way sf::TcpSocket frames
+         *         a sf::Packet (size on 32 bits in network byte order, then the data). That allows to
+         *         send several packets with one call while the receiver reads them one by one.
+         */
+        void appendToBuffer(std::vector<char>& buffer) const;
+
         /*! \brief Writes the packet content to the given ofstream.
          */
         void writePacket(int32_t timestamp, std::ofstream& os);
@@ -151,8 +209,32 @@ class ODPacket
         }
 
     private:
-        sf::Packet mPacket;
+        //! \brief Space reserved at the beginning of mData for the size of the packet. That allows
+        //! ODSocketClient to send the packet with its size without copying it in another buffer
+        static const std::size_t HEADER_SIZE;
+
+        //! \brief Maximum size of the data of a received packet. The size comes from the peer so a bigger
+        //! one is considered as corrupted instead of being allocated
+        static const uint32_t MAX_DATA_SIZE;
+
+        //! \brief Resizes mData to have room for size more bytes and returns a pointer to them
+        char* allocate(std::size_t size);
+
+        //! \brief Returns true if size bytes can be read. If not, the packet becomes invalid
+        bool checkSize(std::size_t size);
+
+        //! \brief Writes the size of the data in the header (network byte order)
+        void writeHeader();
+
+        //! \brief Writes/reads an unsigned integer on as many bytes as needed, 7 bits per byte
+        //! (the highest bit tells if another byte follows)
+        void writeVarUInt32(uint32_t data);
+        bool readVarUInt32(uint32_t& data);
 
+        //! \brief Header followed by the data
+        std::vector<char> mData;
+        std::size_t mReadPos;
+        bool mIsValid;
 };
 
 #endif // ODPACKET_H
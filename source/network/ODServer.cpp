@@ -64,6 +64,33 @@ static const double MASTER_SERVER_UPDATE_PERIOD_MS = 30000.0;
 static const int32_t MASTER_SERVER_STATUS_PENDING = 0;
 static const int32_t MASTER_SERVER_STATUS_STARTED = 1;
 static const int32_t MASTER_SERVER_STATUS_FINISHED = 2;
+//! \brief Number of turns a client can be late before the server waits for it
+static const int64_t MAX_CLIENT_TURN_LAG = 2;
+//! \brief Number of turns the server can be late before it stops trying to catch up
+static const double MAX_SERVER_TURN_BACKLOG = 3.0;
+//! \brief Number of turns between two logs of the server metrics
+static const uint32_t METRICS_REPORT_PERIOD_TURNS = 600;
+
+//! \brief Server thread metrics accumulated between two reports
+struct TurnMetrics
+{
+    TurnMetrics() :
+        mNbTurns(0),
+        mNbStalledTurns(0),
+        mTotalTurnTimeMs(0.0),
+        mMaxTurnTimeMs(0.0),
+        mMaxInboundQueueSize(0),
+        mMaxOutboundQueueSize(0)
+    {}
+
+    uint32_t mNbTurns;
+    //! \brief Turns not started because a client was too late
+    uint32_t mNbStalledTurns;
+    double mTotalTurnTimeMs;
+    double mMaxTurnTimeMs;
+    uint32_t mMaxInboundQueueSize;
+    uint32_t mMaxOutboundQueueSize;
+};
 
 template<> ODServer* Ogre::Singleton<ODServer>::msSingleton = nullptr;
 
@@ -236,7 +263,7 @@ void ODServer::queueServerNotification(ServerNotification* n)
 {
     if ((n == nullptr) || (!isConnected()))
     {
-        delete n;
+        ServerNotification::release(n);
         return;
     }
     mServerNotificationQueue.push_back(n);
@@ -253,7 +280,7 @@ void ODServer::sendMsg(Player* player, ODPacket& packet)
     {
         // If player is nullptr, we send the message to every connected player
         for (ODSocketClient* client : mSockClients)
-            client->send(packet);
+            sendToClient(client, packet);
 
         return;
     }
@@ -270,7 +297,7 @@ void ODServer::sendMsg(Player* player, ODPacket& packet)
     }
 
     if(client != nullptr)
-        client->send(packet);
+        sendToClient(client, packet);
 }
 
 void ODServer::handleConsoleCommand(Player* player, GameMap* gameMap, const std::vector<std::string>& args)
@@ -293,7 +320,7 @@ void ODServer::handleConsoleCommand(Player* player, GameMap* gameMap, const std:
     }
 
     // We notify all players that a console command has been executed
-    ServerNotification *serverNotification = new ServerNotification(
+    ServerNotification *serverNotification = ServerNotification::create(
         ServerNotificationType::chatServer, nullptr);
 
     std::string msg = "Console cmd launched: " + args[0];
@@ -301,22 +328,26 @@ void ODServer::handleConsoleCommand(Player* player, GameMap* gameMap, const std:
     ODServer::getSingleton().queueServerNotification(serverNotification);
 }
 
-void ODServer::startNewTurn(double timeSinceLastTurn)
+bool ODServer::startNewTurn(double timeSinceLastTurn)
 {
     GameMap* gameMap = mGameMap;
     int64_t turn = gameMap->getTurnNumber();
 
-    // We wait until every client acknowledge the turn to start the next one. This way, we ensure
-    // synchronisation is not too bad
+    // We do not wait for every client to acknowledge the current turn. However, if a client is
+    // too late, we wait for it to catch up. This way, we ensure synchronisation is not too bad
+    // while a client a little bit slower than the others does not stall the game
     for (ODSocketClient* client : mSockClients)
     {
-        if(client->getLastTurnAck() != turn)
-            return;
+        if(client->getLastTurnAck() < 0)
+            return false;
+
+        if(turn - client->getLastTurnAck() > MAX_CLIENT_TURN_LAG)
+            return false;
     }
 
     gameMap->setTurnNumber(++turn);
 
-    ServerNotification* serverNotification = new ServerNotification(
+    ServerNotification* serverNotification = ServerNotification::create(
         ServerNotificationType::turnStarted, nullptr);
     serverNotification->mPacket << turn;
     queueServerNotification(serverNotification);
@@ -332,7 +363,7 @@ void ODServer::startNewTurn(double timeSinceLastTurn)
         Player* player = sock->getPlayer();
         // For now, only the player whose seat changed is notified. If we need it, we could send the event to every player
         // so that they can see how far from the goals the other players are
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::refreshPlayerSeat, player);
         std::string goals = gameMap->getGoalsStringForPlayer(player);
         Seat* seat = player->getSeat();
@@ -342,21 +373,21 @@ void ODServer::startNewTurn(double timeSinceLastTurn)
 
         // Here, the creature list is pulled. It could be possible that the creature dies before the stat window is
         // closed. So, if we cannot find the creature, we just erase it.
-        std::vector<std::string>& creatures = mCreaturesInfoWanted[sock];
-        std::vector<std::string>::iterator itCreatures = creatures.begin();
+        std::vector<uint32_t>& creatures = mCreaturesInfoWanted[sock];
+        std::vector<uint32_t>::iterator itCreatures = creatures.begin();
         while(itCreatures != creatures.end())
         {
-            std::string& name = *itCreatures;
-            Creature* creature = gameMap->getCreature(name);
+            uint32_t creatureId = *itCreatures;
+            Creature* creature = gameMap->getCreatureFromId(creatureId);
             if(creature == nullptr)
                 itCreatures = creatures.erase(itCreatures);
             else
             {
                 std::string creatureInfos = creature->getStatsText();
 
-                ServerNotification *serverNotification = new ServerNotification(
+                ServerNotification *serverNotification = ServerNotification::create(
                     ServerNotificationType::notifyCreatureInfo, player);
-                serverNotification->mPacket << name << creatureInfos;
+                serverNotification->mPacket << creatureId << creatureInfos;
                 ODServer::getSingleton().queueServerNotification(serverNotification);
 
                 ++itCreatures;
@@ -388,6 +419,7 @@ void ODServer::startNewTurn(double timeSinceLastTurn)
 
     gameMap->fireRefreshEntities();
     gameMap->processDeletionQueues();
+    return true;
 }
 
 void ODServer::serverThread()
@@ -395,12 +427,23 @@ void ODServer::serverThread()
     GameMap* gameMap = mGameMap;
     sf::Clock clock;
     double turnLengthMs = 1000.0 / ODApplication::turnsPerSecond;
+    sf::Time turnLength = sf::milliseconds(static_cast<int32_t>(turnLengthMs));
+    sf::Time nextTurnTime = turnLength;
+    TurnMetrics metrics;
     bool isClientConnected = true;
     while(isConnected() && isClientConnected)
     {
-        // doTask should return after the length of 1 turn even if their are communications. When
-        // it returns, we can launch next turn.
-        doTask(static_cast<int32_t>(turnLengthMs));
+        // Turns are launched at a fixed rate. Until the next turn is due, we process the client
+        // messages received by the network thread.
+        metrics.mMaxInboundQueueSize = std::max(metrics.mMaxInboundQueueSize, getInboundQueueSize());
+        sf::Time timeLeft = nextTurnTime - clock.getElapsedTime();
+        doTask(std::max(0, timeLeft.asMilliseconds()));
+        nextTurnTime += turnLength;
+        // If the server is too late (for example, if a turn took too long), we do not try to catch up
+        // by launching several turns in a row
+        if(clock.getElapsedTime() - nextTurnTime > sf::milliseconds(static_cast<int32_t>(turnLengthMs * MAX_SERVER_TURN_BACKLOG)))
+            nextTurnTime = clock.getElapsedTime() + turnLength;
+
         // If all the clients are disconnected during a game, we close the server
         if((mServerState == ServerState::StateGame) &&
            (mSockClients.empty()))
@@ -448,7 +491,7 @@ void ODServer::serverThread()
 
                 // Every client is connected and ready, we can launch the game
                 // Send turn 0 to init the map
-                ServerNotification* serverNotification = new ServerNotification(
+                ServerNotification* serverNotification = ServerNotification::create(
                     ServerNotificationType::turnStarted, nullptr);
                 serverNotification->mPacket << static_cast<int64_t>(0);
                 queueServerNotification(serverNotification);
@@ -466,7 +509,7 @@ void ODServer::serverThread()
                         {
                             for (int ii = 0; ii < gameMap->getMapSizeX(); ++ii)
                             {
-                                gameMap->getTile(ii,jj)->notifyVision(seat);
+                                gameMap->getTile(ii,jj)->addSeatVision(seat);
                             }
                         }
 
@@ -510,9 +553,26 @@ void ODServer::serverThread()
         // to wait for server. If server is in advance, he might send commands before the
         // creatures arrive at their destination. That could result in weird issues like
         // creatures going through walls.
-        startNewTurn(static_cast<double>(clock.restart().asSeconds()) * 0.95);
+        sf::Time turnStartTime = clock.getElapsedTime();
+        if(!startNewTurn(static_cast<double>(turnLength.asSeconds()) * 0.95))
+            ++metrics.mNbStalledTurns;
 
         processServerNotifications();
+        metrics.mMaxOutboundQueueSize = std::max(metrics.mMaxOutboundQueueSize, getOutboundQueueSize());
+        sf::Time turnTime = clock.getElapsedTime() - turnStartTime;
+        metrics.mTotalTurnTimeMs += turnTime.asMicroseconds() / 1000.0;
+        metrics.mMaxTurnTimeMs = std::max(metrics.mMaxTurnTimeMs, turnTime.asMicroseconds() / 1000.0);
+        ++metrics.mNbTurns;
+        if(metrics.mNbTurns >= METRICS_REPORT_PERIOD_TURNS)
+        {
+            OD_LOG_INF("Server turns=" + Helper::toString(metrics.mNbTurns)
+                + ", stalled=" + Helper::toString(metrics.mNbStalledTurns)
+                + ", avgTimeMs=" + Helper::toString(metrics.mTotalTurnTimeMs / metrics.mNbTurns)
+                + ", maxTimeMs=" + Helper::toString(metrics.mMaxTurnTimeMs)
+                + ", maxInboundQueue=" + Helper::toString(metrics.mMaxInboundQueueSize)
+                + ", maxOutboundQueue=" + Helper::toString(metrics.mMaxOutboundQueueSize));
+            metrics = TurnMetrics();
+        }
     }
 
     if(!mMasterServerGameId.empty())
@@ -573,6 +633,7 @@ void ODServer::processServerNotifications()
 
             case ServerNotificationType::exit:
                 running = false;
+                flushClientMessages();
                 stopServer();
                 break;
 
@@ -581,22 +642,24 @@ void ODServer::processServerNotifications()
                 break;
         }
 
-        delete event;
-        event = nullptr;
+        mProcessedServerNotifications.push_back(event);
     }
+
+    ServerNotification::release(mProcessedServerNotifications);
+
+    // Every notification sent to a client during this turn is sent at once
+    if(running)
+        flushClientMessages();
 }
 
-bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
+bool ODServer::processClientNotifications(ODSocketClient* clientSocket, ODSocketClient::ODComStatus status,
+    ODPacket& packetReceived)
 {
     if (!clientSocket)
         return false;
 
     GameMap* gameMap = mGameMap;
 
-    ODPacket packetReceived;
-
-    ODSocketClient::ODComStatus status = clientSocket->recv(packetReceived);
-
     // If the client closed the connection
     if (status != ODSocketClient::ODComStatus::OK)
     {
@@ -639,7 +702,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             mPlayerConfig = otherHumanConnected->getPlayer();
             ODPacket packetSend;
             packetSend << ServerNotificationType::playerConfigChange;
-            otherHumanConnected->send(packetSend);
+            sendToClient(otherHumanConnected, packetSend);
 
             OD_LOG_INF("Changing game host to " + mPlayerConfig->getNick());
         }
@@ -759,7 +822,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 gameMap->tileToPacket(packet, tile);
             }
 
-            clientSocket->send(packet);
+            sendToClient(clientSocket, packet);
             break;
         }
 
@@ -772,7 +835,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             // Tell the client to give us their nickname
             ODPacket packetSend;
             packetSend << ServerNotificationType::pickNick << mServerMode;
-            clientSocket->send(packetSend);
+            sendToClient(clientSocket, packetSend);
             break;
         }
 
@@ -814,7 +877,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 mPlayerConfig = curPlayer;
                 ODPacket packetSend;
                 packetSend << ServerNotificationType::playerConfigChange;
-                clientSocket->send(packetSend);
+                sendToClient(clientSocket, packetSend);
             }
 
             Seat* seat = seats[0];
@@ -831,11 +894,11 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             int32_t teamId = 0;
             seat->setMapSize(gameMap->getMapSizeX(), gameMap->getMapSizeY());
             packetSend << nick << id << seatId << teamId;
-            clientSocket->send(packetSend);
+            sendToClient(clientSocket, packetSend);
 
             packetSend.clear();
             packetSend << ServerNotificationType::startGameMode << seatId << mServerMode;
-            clientSocket->send(packetSend);
+            sendToClient(clientSocket, packetSend);
             mSeatsConfigured = true;
             break;
         }
@@ -852,7 +915,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 OD_LOG_INF("New player host: " + mPlayerConfig->getNick());
                 ODPacket packetSend;
                 packetSend << ServerNotificationType::playerConfigChange;
-                clientSocket->send(packetSend);
+                sendToClient(clientSocket, packetSend);
             }
 
             ODPacket packetSend;
@@ -866,7 +929,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 int32_t id = client->getPlayer()->getId();
                 packetSend << nick << id;
             }
-            clientSocket->send(packetSend);
+            sendToClient(clientSocket, packetSend);
 
             // Then, we notify the newly connected client to every client
             const std::string& clientNick = clientSocket->getPlayer()->getNick();
@@ -880,7 +943,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 if(clientSocket == client)
                     continue;
 
-                client->send(packetSend);
+                sendToClient(client, packetSend);
             }
 
             // Then we look for the first available human seat and assign the player there (if available)
@@ -1082,7 +1145,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                         + Helper::toString(player->getId())
                         + ", nick=" + player->getNick());
                     client->setState("rejected");
-                    client->send(packetSend);
+                    sendToClient(client, packetSend);
                     delete player;
                     client->setPlayer(nullptr);
                 }
@@ -1109,7 +1172,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                 ODPacket packetSend;
                 int seatId = client->getPlayer()->getSeat()->getId();
                 packetSend << ServerNotificationType::startGameMode << seatId << mServerMode;
-                client->send(packetSend);
+                sendToClient(client, packetSend);
             }
 
             for(Seat* seat : gameMap->getSeats())
@@ -1145,24 +1208,23 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
 
         case ClientNotificationType::askEntityPickUp:
         {
-            std::string entityName;
-            GameEntityType entityType;
-            OD_ASSERT_TRUE(packetReceived >> entityType >> entityName);
+            uint32_t entityId;
+            OD_ASSERT_TRUE(packetReceived >> entityId);
 
             Player *player = clientSocket->getPlayer();
-            GameEntity* entity = gameMap->getEntityFromTypeAndName(entityType, entityName);
+            GameEntity* entity = gameMap->getAnimatedObjectFromId(entityId);
             if(entity == nullptr)
             {
-                OD_LOG_ERR("entityType=" + Helper::toString(static_cast<int32_t>(entityType)) + ", entityName=" + entityName);
+                OD_LOG_ERR("entityId=" + Helper::toString(entityId));
                 break;
             }
             bool allowPickup = entity->tryPickup(player->getSeat());
             if(!allowPickup)
             {
                 OD_LOG_INF("player=" + player->getNick()
-                        + " could not pickup entity entityType="
-                        + Helper::toString(static_cast<int32_t>(entityType))
-                        + ", entityName=" + entityName);
+                        + " could not pickup entity entityId="
+                        + Helper::toString(entityId)
+                        + ", entityName=" + entity->getName());
                 break;
             }
 
@@ -1228,23 +1290,22 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
 
         case ClientNotificationType::askSlapEntity:
         {
-            GameEntityType entityType;
-            std::string entityName;
+            uint32_t entityId;
             Player* player = clientSocket->getPlayer();
-            OD_ASSERT_TRUE(packetReceived >> entityType >> entityName);
-            GameEntity* entity = gameMap->getEntityFromTypeAndName(entityType, entityName);
+            OD_ASSERT_TRUE(packetReceived >> entityId);
+            GameEntity* entity = gameMap->getAnimatedObjectFromId(entityId);
             if(entity == nullptr)
             {
-                OD_LOG_WRN("entityType=" + Helper::toString(static_cast<int32_t>(entityType)) + ", entityName=" + entityName);
+                OD_LOG_WRN("entityId=" + Helper::toString(entityId));
                 break;
             }
 
             if(!entity->canSlap(player->getSeat()))
             {
                 OD_LOG_INF("player seatId=" + Helper::toString(player->getSeat()->getId())
-                    + " could not slap entity entityType="
-                    + Helper::toString(static_cast<int32_t>(entityType))
-                    + ", entityName=" + entityName);
+                    + " could not slap entity entityId="
+                    + Helper::toString(entityId)
+                    + ", entityName=" + entity->getName());
                 break;
             }
 
@@ -1336,7 +1397,7 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             if(!rooms.empty())
                 break;
 
-            ServerNotification *serverNotification = new ServerNotification(
+            ServerNotification *serverNotification = ServerNotification::create(
                 ServerNotificationType::chatServer, player);
 
             std::string msg = "You need a workshop to craft the trap!";
@@ -1420,15 +1481,15 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
 
         case ClientNotificationType::askCreatureInfos:
         {
-            std::string name;
+            uint32_t creatureId;
             bool refreshEachTurn;
-            OD_ASSERT_TRUE(packetReceived >> name >> refreshEachTurn);
-            std::vector<std::string>& creatures = mCreaturesInfoWanted[clientSocket];
+            OD_ASSERT_TRUE(packetReceived >> creatureId >> refreshEachTurn);
+            std::vector<uint32_t>& creatures = mCreaturesInfoWanted[clientSocket];
 
-            std::vector<std::string>::iterator it = std::find(creatures.begin(), creatures.end(), name);
+            std::vector<uint32_t>::iterator it = std::find(creatures.begin(), creatures.end(), creatureId);
             if(refreshEachTurn && (it == creatures.end()))
             {
-                creatures.push_back(name);
+                creatures.push_back(creatureId);
             }
             else if(!refreshEachTurn && (it != creatures.end()))
                 creatures.erase(it);
@@ -1608,7 +1669,6 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
             }
             if(!affectedTiles.empty())
             {
-                uint32_t nbTiles = affectedTiles.size();
                 const std::vector<Seat*>& seats = gameMap->getSeats();
                 for(Seat* seat : seats)
                 {
@@ -1618,10 +1678,9 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
                         continue;
 
                     ServerNotification notif(ServerNotificationType::refreshTiles, seat->getPlayer());
-                    notif.mPacket << nbTiles;
+                    gameMap->tilesToPacket(notif.mPacket, affectedTiles);
                     for(Tile* tile : affectedTiles)
                     {
-                        gameMap->tileToPacket(notif.mPacket, tile);
                         seat->updateTileStateForSeat(tile, false);
                         tile->exportToPacketForUpdate(notif.mPacket, seat);
 
@@ -1824,50 +1883,39 @@ bool ODServer::processClientNotifications(ODSocketClient* clientSocket)
     return true;
 }
 
-ODSocketClient* ODServer::notifyNewConnection(sf::TcpListener& sockListener)
+bool ODServer::notifyNewConnection(ODSocketClient* newClient)
 {
-    ODSocketClient* newClient = new ODSocketClient;
-    sf::Socket::Status status = sockListener.accept(newClient->getSockClient());
-    if (status != sf::Socket::Done)
-    {
-        OD_LOG_ERR("Error while listening to socket status=" + Helper::toString(static_cast<uint32_t>(status)));
-        delete newClient;
-        return nullptr;
-    }
-
     switch(mServerState)
     {
         case ServerState::StateNone:
         {
             // It is not normal to receive new connexions while not connected. We are in an unexpected state
             OD_LOG_ERR("Unexpected none server mode");
-            delete newClient;
-            return nullptr;
+            return false;
         }
         case ServerState::StateConfiguration:
         {
             newClient->setState("connected");
-            return newClient;
+            return true;
         }
         case ServerState::StateGame:
         {
             // TODO : handle re-connexion if a client was disconnected and tries to reconnect
             OD_LOG_WRN("Received a reconnexion from a client while in game state");
-            delete newClient;
-            return nullptr;
+            return false;
         }
         default:
             OD_LOG_ERR("Unexpected server state=" + Helper::toString(static_cast<uint32_t>(mServerState)));
             break;
     }
 
-    delete newClient;
-    return nullptr;
+    return false;
 }
 
-bool ODServer::notifyClientMessage(ODSocketClient *clientSocket)
+bool ODServer::notifyClientMessage(ODSocketClient *clientSocket, ODSocketClient::ODComStatus status,
+    ODPacket& packetReceived)
 {
-    bool ret = processClientNotifications(clientSocket);
+    bool ret = processClientNotifications(clientSocket, status, packetReceived);
     if(!ret)
     {
         std::string nick = clientSocket->getPlayer() ? clientSocket->getPlayer()->getNick() : std::string();
@@ -1882,7 +1930,7 @@ bool ODServer::notifyClientMessage(ODSocketClient *clientSocket)
                 if(!player->getIsHuman())
                     continue;
 
-                ServerNotification *serverNotification = new ServerNotification(
+                ServerNotification *serverNotification = ServerNotification::create(
                     ServerNotificationType::chatServer, player);
                 std::string msg = nick.empty() ?
                                   "A client disconnected." :
@@ -1914,7 +1962,7 @@ void ODServer::stopServer()
     // Now that the server is stopped, we can remove all pending messages
     while(!mServerNotificationQueue.empty())
     {
-        delete mServerNotificationQueue.front();
+        ServerNotification::release(mServerNotificationQueue.front());
         mServerNotificationQueue.pop_front();
     }
     mGameMap->clearAll();
@@ -1924,11 +1972,11 @@ void ODServer::notifyExit()
 {
     while(!mServerNotificationQueue.empty())
     {
-        delete mServerNotificationQueue.front();
+        ServerNotification::release(mServerNotificationQueue.front());
         mServerNotificationQueue.pop_front();
     }
 
-    ServerNotification* exitServerNotification = new ServerNotification(
+    ServerNotification* exitServerNotification = ServerNotification::create(
         ServerNotificationType::exit, nullptr);
     queueServerNotification(exitServerNotification);
 }
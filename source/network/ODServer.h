@@ -96,8 +96,8 @@ class ODServer: public Ogre::Singleton<ODServer>,
     int32_t getNetworkPort() const;
 
 protected:
-    ODSocketClient* notifyNewConnection(sf::TcpListener& sockListener) override;
-    bool notifyClientMessage(ODSocketClient *sock) override;
+    bool notifyNewConnection(ODSocketClient* newClient) override;
+    bool notifyClientMessage(ODSocketClient *sock, ODSocketClient::ODComStatus status, ODPacket& packetReceived) override;
     void serverThread() override;
 
 private:
@@ -111,8 +111,10 @@ private:
     std::vector<Player*> mDisconnectedPlayers;
 
     std::deque<ServerNotification*> mServerNotificationQueue;
+    //! \brief Notifications sent by processServerNotifications. They are released together once sent
+    std::vector<ServerNotification*> mProcessedServerNotifications;
 
-    std::map<ODSocketClient*, std::vector<std::string>> mCreaturesInfoWanted;
+    std::map<ODSocketClient*, std::vector<uint32_t>> mCreaturesInfoWanted;
 
     ConsoleInterface mConsoleInterface;
 
@@ -124,8 +126,9 @@ private:
     ODSocketClient* getClientFromPlayer(Player* player);
     ODSocketClient* getClientFromPlayerId(int32_t playerId);
 
-    //! \brief Called when a new turn started.
-    void startNewTurn(double timeSinceLastTurn);
+    //! \brief Called when a new turn should start. Returns false if the turn could not
+    //! be started because a client is too late.
+    bool startNewTurn(double timeSinceLastTurn);
 
     /*! \brief Monitors mServerNotificationQueue for new events and informs the clients about them.
      *
@@ -138,12 +141,13 @@ private:
 
     /*! \brief The function running in server-mode which listens for messages from an individual, already connected, client.
      *
-     * This function receives TCP packets one at a time from a connected client,
+     * This function receives the TCP packets read by the network thread one at a time from a connected client,
      * decodes them, and carries out requests for the client, returning any
-     * results.
+     * results. If status is not OK, the client has disconnected.
      * \returns false When the client has disconnected.
      */
-    bool processClientNotifications(ODSocketClient* clientSocket);
+    bool processClientNotifications(ODSocketClient* clientSocket, ODSocketClient::ODComStatus status,
+        ODPacket& packetReceived);
 
     //! \brief Sends the packet to the given player. If player is nullptr, the packet is sent to every connected player
     void sendMsg(Player* player, ODPacket& packet);
@@ -76,6 +76,10 @@ void ODSocketClient::disconnect(bool keepReplay)
             // if there is any left.
             mSockSelector.clear();
             mSockClient.disconnect();
+            mReceivingPacket.clear();
+            mNbReceivedBytes = 0;
+            mSendingBuffer.clear();
+            mNbSentBytes = 0;
             break;
         }
         case ODSource::file:
@@ -140,7 +144,9 @@ ODSocketClient::ODComStatus ODSocketClient::send(ODPacket& s)
     if(mSource != ODSource::network)
         return ODComStatus::OK;
 
-    sf::Socket::Status status = mSockClient.send(s.mPacket);
+    // The header reserved at the beginning of the packet allows to send it without copying it
+    s.writeHeader();
+    sf::Socket::Status status = mSockClient.send(s.mData.data(), s.mData.size());
     if (status == sf::Socket::Done)
         return ODComStatus::OK;
 
@@ -149,6 +155,79 @@ ODSocketClient::ODComStatus ODSocketClient::send(ODPacket& s)
     return ODComStatus::Error;
 }
 
+ODSocketClient::ODComStatus ODSocketClient::sendBuffer(const std::vector<char>& buffer)
+{
+    if(mSource != ODSource::network)
+        return ODComStatus::OK;
+
+    if(buffer.empty())
+        return ODComStatus::OK;
+
+    // If some data is already waiting, the buffer is sent after it
+    std::size_t sent = 0;
+    if(!hasPendingData())
+    {
+        sf::Socket::Status status = mSockClient.send(buffer.data(), buffer.size(), sent);
+        if (status == sf::Socket::Done)
+            return ODComStatus::OK;
+
+        if((status != sf::Socket::Partial) && (status != sf::Socket::NotReady))
+        {
+            OD_LOG_ERR("Could not send data from client status="
+                + Helper::toString(status));
+            return ODComStatus::Error;
+        }
+
+        mSendingBuffer.clear();
+        mNbSentBytes = 0;
+    }
+
+    std::size_t pendingSize = mSendingBuffer.size() - mNbSentBytes + buffer.size() - sent;
+    if(pendingSize > ODPacket::MAX_DATA_SIZE)
+    {
+        OD_LOG_ERR("Too much data waiting to be sent size=" + Helper::toString(pendingSize));
+        return ODComStatus::Error;
+    }
+
+    mSendingBuffer.insert(mSendingBuffer.end(), buffer.begin() + sent, buffer.end());
+    return ODComStatus::OK;
+}
+
+ODSocketClient::ODComStatus ODSocketClient::sendPendingData()
+{
+    if(!hasPendingData())
+        return ODComStatus::OK;
+
+    std::size_t sent = 0;
+    sf::Socket::Status status = mSockClient.send(mSendingBuffer.data() + mNbSentBytes,
+        mSendingBuffer.size() - mNbSentBytes, sent);
+    mNbSentBytes += sent;
+    if (status == sf::Socket::Done)
+    {
+        // The buffer keeps its capacity for the next data
+        mSendingBuffer.clear();
+        mNbSentBytes = 0;
+        return ODComStatus::OK;
+    }
+
+    if((status != sf::Socket::Partial) && (status != sf::Socket::NotReady))
+    {
+        OD_LOG_ERR("Could not send data from client status="
+            + Helper::toString(status));
+        return ODComStatus::Error;
+    }
+
+    // We remove the sent data once it is bigger than what is left so that the buffer does
+    // not grow while the client reads slowly
+    if(mNbSentBytes > mSendingBuffer.size() - mNbSentBytes)
+    {
+        mSendingBuffer.erase(mSendingBuffer.begin(), mSendingBuffer.begin() + mNbSentBytes);
+        mNbSentBytes = 0;
+    }
+
+    return ODComStatus::NotReady;
+}
+
 ODSocketClient::ODComStatus ODSocketClient::recv(ODPacket& s)
 {
     switch(mSource)
@@ -161,7 +240,7 @@ ODSocketClient::ODComStatus ODSocketClient::recv(ODPacket& s)
         }
         case ODSource::network:
         {
-            sf::Socket::Status status = mSockClient.receive(s.mPacket);
+            sf::Socket::Status status = receivePacket(s);
             if (status == sf::Socket::Done)
             {
                 s.writePacket(mGameClock.getElapsedTime().asMilliseconds(),
@@ -196,6 +275,54 @@ ODSocketClient::ODComStatus ODSocketClient::recv(ODPacket& s)
     return ODComStatus::Error;
 }
 
+sf::Socket::Status ODSocketClient::receivePacket(ODPacket& packet)
+{
+    // We read the header first to know the size of the packet
+    std::vector<char>& data = mReceivingPacket.mData;
+    while(mNbReceivedBytes < ODPacket::HEADER_SIZE)
+    {
+        std::size_t received = 0;
+        sf::Socket::Status status = mSockClient.receive(data.data() + mNbReceivedBytes,
+            ODPacket::HEADER_SIZE - mNbReceivedBytes, received);
+        mNbReceivedBytes += received;
+        if(status != sf::Socket::Done)
+            return status;
+    }
+
+    uint32_t dataSize = 0;
+    for(std::size_t i = 0; i < ODPacket::HEADER_SIZE; ++i)
+        dataSize = (dataSize << 8) | static_cast<uint8_t>(data[i]);
+
+    if(dataSize > ODPacket::MAX_DATA_SIZE)
+    {
+        OD_LOG_ERR("Received packet too big size=" + Helper::toString(dataSize) + ". Closing connection");
+        mReceivingPacket.clear();
+        mNbReceivedBytes = 0;
+        mSockClient.disconnect();
+        return sf::Socket::Error;
+    }
+
+    std::size_t packetSize = ODPacket::HEADER_SIZE + dataSize;
+    data.resize(packetSize);
+    while(mNbReceivedBytes < packetSize)
+    {
+        std::size_t received = 0;
+        sf::Socket::Status status = mSockClient.receive(data.data() + mNbReceivedBytes,
+            packetSize - mNbReceivedBytes, received);
+        mNbReceivedBytes += received;
+        if(status != sf::Socket::Done)
+            return status;
+    }
+
+    // The received packet is given to the caller and we keep its buffer for the next one
+    packet.mData.swap(data);
+    packet.mReadPos = ODPacket::HEADER_SIZE;
+    packet.mIsValid = true;
+    mReceivingPacket.clear();
+    mNbReceivedBytes = 0;
+    return sf::Socket::Done;
+}
+
 bool ODSocketClient::isConnected()
 {
     return mSource != ODSource::none;
@@ -25,6 +25,7 @@
 #include <string>
 #include <cstdint>
 #include <fstream>
+#include <vector>
 
 class Player;
 
@@ -49,7 +50,9 @@ class ODSocketClient
             mSource(ODSource::none),
             mPlayer(nullptr),
             mLastTurnAck(-1),
-            mPendingTimestamp(-1)
+            mPendingTimestamp(-1),
+            mNbReceivedBytes(0),
+            mNbSentBytes(0)
         {}
 
         virtual ~ODSocketClient()
@@ -90,6 +93,20 @@ class ODSocketClient
          */
         ODComStatus send(ODPacket& s);
 
+        /*! \brief Sends packets framed with ODPacket::appendToBuffer with only one call to the socket.
+         * The receiver gets them one by one like if they were sent with send.
+         * If the socket is not blocking, the data that cannot be sent right away is kept and sent by the next
+         * calls to sendPendingData. If the receiver does not read it and too much data is waiting, Error
+         * is returned
+         */
+        ODComStatus sendBuffer(const std::vector<char>& buffer);
+
+        //! \brief Sends the data kept by sendBuffer. Returns NotReady if some of it still could not be sent
+        ODComStatus sendPendingData();
+
+        inline bool hasPendingData() const
+        { return mNbSentBytes < mSendingBuffer.size(); }
+
         /*! \brief Receives a packet through the network
          * ODPacket should preserve integrity. That means that if an ODSocketClient
          * sends an ODPacket, the server should receive exactly 1 similar ODPacket (same data,
@@ -111,6 +128,11 @@ class ODSocketClient
     private :
         bool processOneClientSocketMessage();
 
+        //! \brief Receives the next packet from the socket (its size on 32 bits in network byte order,
+        //! then the data) directly in mReceivingPacket. If the packet is not complete yet, what has been
+        //! received is kept until the next call. Once complete, the packet is swapped with packet
+        sf::Socket::Status receivePacket(ODPacket& packet);
+
         ODSource mSource;
         sf::SocketSelector mSockSelector;
         sf::TcpSocket mSockClient;
@@ -124,6 +146,15 @@ class ODSocketClient
         ODPacket mPendingPacket;
         int32_t mPendingTimestamp;
 
+        //! \brief Packet being received from the network and number of bytes (header included)
+        //! already received
+        ODPacket mReceivingPacket;
+        std::size_t mNbReceivedBytes;
+
+        //! \brief Data that could not be sent yet by sendBuffer and number of bytes of it already sent
+        std::vector<char> mSendingBuffer;
+        std::size_t mNbSentBytes;
+
         //! \brief the replay filename being written. Used to later optionally delete it
         //! if asked to.
         std::string mOutputReplayFilename;
@@ -24,9 +24,18 @@
 
 #include <SFML/System.hpp>
 
+#include <algorithm>
+
+//! \brief Time the network thread waits for socket activity before sending the queued messages
+static const int32_t NETWORK_THREAD_WAIT_MS = 1;
+
+//! \brief Time the server thread waits in doTask when there is no pending event
+static const int32_t SERVER_THREAD_WAIT_MS = 1;
+
 ODSocketServer::ODSocketServer():
     mThread(nullptr),
-    mIsConnected(false)
+    mIsConnected(false),
+    mNetworkThread(nullptr)
 {
 }
 
@@ -52,6 +61,8 @@ bool ODSocketServer::createServer(int listeningPort)
     mSockSelector.add(mSockListener);
     mIsConnected = true;
     OD_LOG_INF("Server connected and listening");
+    mNetworkThread = new sf::Thread(&ODSocketServer::networkThread, this);
+    mNetworkThread->launch();
     mThread = new sf::Thread(&ODSocketServer::serverThread, this);
     mThread->launch();
 
@@ -66,78 +77,283 @@ bool ODSocketServer::isConnected()
 void ODSocketServer::doTask(int timeoutMs)
 {
     mClockMainTask.restart();
-    while((timeoutMs == 0) ||
-          (timeoutMs > mClockMainTask.getElapsedTime().asMilliseconds()))
+    while(mIsConnected)
     {
-        bool isSockReady;
-        if(timeoutMs != 0)
+        InboundEvent* event;
+        if(!mInboundQueue.pop(event))
         {
-            // We adapt the timeout so that the function returns after timeoutMs
-            // even if events occurred
-            int timeoutMsAdjusted = std::max(1, timeoutMs - mClockMainTask.getElapsedTime().asMilliseconds());
-            isSockReady = mSockSelector.wait(sf::milliseconds(timeoutMsAdjusted));
+            // The answers to the processed events can be sent
+            flushClientMessages();
+
+            int timeLeftMs = timeoutMs - mClockMainTask.getElapsedTime().asMilliseconds();
+            if(timeLeftMs <= 0)
+                return;
+
+            sf::sleep(sf::milliseconds(std::min(timeLeftMs, SERVER_THREAD_WAIT_MS)));
+            continue;
         }
-        else
+
+        ODSocketClient* client = event->mClient;
+        switch(event->mType)
+        {
+            case InboundEvent::Type::connected:
+            {
+                if(notifyNewConnection(client))
+                {
+                    OD_LOG_INF("New client connected.");
+                    mSockClients.push_back(client);
+                }
+                else
+                {
+                    // The server do not want to keep the client
+                    removeClient(client);
+                }
+                break;
+            }
+            case InboundEvent::Type::message:
+            case InboundEvent::Type::disconnected:
+            {
+                // Events can still be received from a client that was removed before the
+                // network thread processed the removal
+                if(std::find(mSockClients.begin(), mSockClients.end(), client) == mSockClients.end())
+                    break;
+
+                ODSocketClient::ODComStatus status = (event->mType == InboundEvent::Type::message) ?
+                    ODSocketClient::ODComStatus::OK :
+                    ODSocketClient::ODComStatus::Error;
+                if(!notifyClientMessage(client, status, event->mPacket))
+                {
+                    // The server wants to remove the client
+                    removeClient(client);
+                }
+                break;
+            }
+            default:
+                OD_LOG_ERR("Unexpected event type=" + Helper::toString(static_cast<int32_t>(event->mType)));
+                break;
+        }
+
+        delete event;
+    }
+}
+
+ODSocketServer::OutboundMessage* ODSocketServer::getOutboundMessage(ODSocketClient* client, bool isRemoveClient)
+{
+    OutboundMessage* message;
+    if(!mRecycledQueue.pop(message))
+        message = new OutboundMessage;
+
+    message->mClient = client;
+    message->mIsRemoveClient = isRemoveClient;
+    return message;
+}
+
+void ODSocketServer::sendToClient(ODSocketClient* client, const ODPacket& packet)
+{
+    OutboundMessage* message = nullptr;
+    for(OutboundMessage* pendingMessage : mPendingMessages)
+    {
+        if(pendingMessage->mClient != client)
+            continue;
+
+        message = pendingMessage;
+        break;
+    }
+
+    if(message == nullptr)
+    {
+        message = getOutboundMessage(client, false);
+        mPendingMessages.push_back(message);
+    }
+
+    packet.appendToBuffer(message->mBuffer);
+}
+
+void ODSocketServer::flushClientMessages()
+{
+    for(OutboundMessage* message : mPendingMessages)
+        mOutboundQueue.push(message);
+
+    mPendingMessages.clear();
+}
+
+void ODSocketServer::removeClient(ODSocketClient* client)
+{
+    std::vector<ODSocketClient*>::iterator it = std::find(mSockClients.begin(), mSockClients.end(), client);
+    if(it != mSockClients.end())
+        mSockClients.erase(it);
+
+    // The messages already sent to the client should be sent before it is removed
+    flushClientMessages();
+    mOutboundQueue.push(getOutboundMessage(client, true));
+}
+
+void ODSocketServer::networkThread()
+{
+    while(mIsConnected)
+    {
+        processOutboundMessages();
+
+        // The client sockets are not blocking. What could not be sent is sent when the clients read
+        for(ODSocketClient* client : mNetworkClients)
         {
-            isSockReady = mSockSelector.wait(sf::Time::Zero);
+            if(!client->hasPendingData() || isNetworkClientDisconnected(client))
+                continue;
+
+            if(client->sendPendingData() == ODSocketClient::ODComStatus::Error)
+                notifyNetworkClientDisconnected(client);
         }
 
-        // Check if a client tries to connect or to communicate
-        if(!isSockReady)
+        if(!mSockSelector.wait(sf::milliseconds(NETWORK_THREAD_WAIT_MS)))
             continue;
 
+        // Check if a client tries to connect
         if(mSockSelector.isReady(mSockListener))
         {
-            // New connection
-            ODSocketClient* newClient = notifyNewConnection(mSockListener);
-            if (newClient != nullptr)
+            ODSocketClient* newClient = new ODSocketClient;
+            sf::Socket::Status status = mSockListener.accept(newClient->getSockClient());
+            if (status != sf::Socket::Done)
             {
-                // New connection
-                OD_LOG_INF("New client connected.");
-                // The server wants to keep the client
+                OD_LOG_ERR("Error while listening to socket status=" + Helper::toString(static_cast<uint32_t>(status)));
+                delete newClient;
+            }
+            else
+            {
+                // A client sending a partial packet or not reading what we send should not block the
+                // other clients. The partially received/sent data is kept by the client
+                newClient->getSockClient().setBlocking(false);
                 newClient->setSource(ODSocketClient::ODSource::network);
                 mSockSelector.add(newClient->getSockClient());
-                mSockClients.push_back(newClient);
+                mNetworkClients.push_back(newClient);
+
+                InboundEvent* event = new InboundEvent;
+                event->mType = InboundEvent::Type::connected;
+                event->mClient = newClient;
+                mInboundQueue.push(event);
             }
         }
-        else
+
+        // Check if a client tries to communicate
+        for(ODSocketClient* client : mNetworkClients)
         {
+            if(isNetworkClientDisconnected(client) || !mSockSelector.isReady(client->getSockClient()))
+                continue;
 
-            for(std::vector<ODSocketClient*>::iterator it = mSockClients.begin(); it != mSockClients.end();)
+            // We read every complete packet received
+            ODSocketClient::ODComStatus status = ODSocketClient::ODComStatus::OK;
+            while(status == ODSocketClient::ODComStatus::OK)
             {
-                ODSocketClient* client = *it;
-                if((mSockSelector.isReady(client->getSockClient())) &&
-                    (!notifyClientMessage(client)))
-                {
-                    // The server wants to remove the client
-                    it = mSockClients.erase(it);
-                    mSockSelector.remove(client->getSockClient());
-                    client->disconnect();
-                    delete client;
-                }
+                InboundEvent* event = new InboundEvent;
+                event->mType = InboundEvent::Type::message;
+                event->mClient = client;
+                status = client->recv(event->mPacket);
+                if(status == ODSocketClient::ODComStatus::OK)
+                    mInboundQueue.push(event);
                 else
-                {
-                    ++it;
-                }
+                    delete event;
+            }
+
+            if(status == ODSocketClient::ODComStatus::Error)
+                notifyNetworkClientDisconnected(client);
+        }
+    }
+}
+
+bool ODSocketServer::isNetworkClientDisconnected(ODSocketClient* client) const
+{
+    return std::find(mDisconnectedNetworkClients.begin(), mDisconnectedNetworkClients.end(), client) != mDisconnectedNetworkClients.end();
+}
+
+void ODSocketServer::notifyNetworkClientDisconnected(ODSocketClient* client)
+{
+    // We stop listening and sending to the client. It will be deleted when the
+    // server thread removes it
+    mSockSelector.remove(client->getSockClient());
+    mDisconnectedNetworkClients.push_back(client);
+
+    InboundEvent* event = new InboundEvent;
+    event->mType = InboundEvent::Type::disconnected;
+    event->mClient = client;
+    mInboundQueue.push(event);
+}
+
+void ODSocketServer::processOutboundMessages()
+{
+    OutboundMessage* message;
+    while(mOutboundQueue.pop(message))
+    {
+        ODSocketClient* client = message->mClient;
+        if(!message->mIsRemoveClient)
+        {
+            if(!isNetworkClientDisconnected(client) &&
+               (client->sendBuffer(message->mBuffer) == ODSocketClient::ODComStatus::Error))
+            {
+                notifyNetworkClientDisconnected(client);
+            }
+        }
+        else
+        {
+            std::vector<ODSocketClient*>::iterator it = std::find(mNetworkClients.begin(), mNetworkClients.end(), client);
+            if(it != mNetworkClients.end())
+            {
+                mNetworkClients.erase(it);
+                it = std::find(mDisconnectedNetworkClients.begin(), mDisconnectedNetworkClients.end(), client);
+                if(it != mDisconnectedNetworkClients.end())
+                    mDisconnectedNetworkClients.erase(it);
+
+                mSockSelector.remove(client->getSockClient());
+                client->disconnect();
+                delete client;
             }
         }
+
+        // The buffer keeps its capacity for the next messages
+        message->mBuffer.clear();
+        mRecycledQueue.push(message);
     }
 }
 
+void ODSocketServer::clearQueues()
+{
+    InboundEvent* event;
+    while(mInboundQueue.pop(event))
+        delete event;
+
+    OutboundMessage* message;
+    while(mOutboundQueue.pop(message))
+        delete message;
+
+    while(mRecycledQueue.pop(message))
+        delete message;
+
+    for(OutboundMessage* pendingMessage : mPendingMessages)
+        delete pendingMessage;
+
+    mPendingMessages.clear();
+}
+
 void ODSocketServer::stopServer()
 {
     mIsConnected = false;
     if(mThread != nullptr)
         delete mThread; // Delete waits for the thread to finish
     mThread = nullptr;
+    if(mNetworkThread != nullptr)
+        delete mNetworkThread;
+    mNetworkThread = nullptr;
+
+    // Now that both threads are stopped, we can delete the pending events. Every client
+    // not deleted yet is in the network thread list
+    clearQueues();
     mSockSelector.clear();
     mSockListener.close();
-    for (std::vector<ODSocketClient*>::iterator it = mSockClients.begin(); it != mSockClients.end(); ++it)
+    for (ODSocketClient* client : mNetworkClients)
     {
-        ODSocketClient* client = *it;
         client->disconnect();
         delete client;
     }
 
+    mNetworkClients.clear();
+    mDisconnectedNetworkClients.clear();
     mSockClients.clear();
 }
@@ -19,11 +19,25 @@
 #define ODSOCKETSERVER_H
 
 #include "ODSocketClient.h"
+#include "utils/SpscQueue.h"
 
 #include <SFML/Network.hpp>
 
+#include <atomic>
+
 class ODPacket;
 
+/*! \brief The sockets are handled by a network thread. It accepts the new connections, reads the
+ * messages from the clients and sends the messages queued by the server thread. The server thread
+ * (see serverThread) gets the connections and the messages through an inbound queue when calling
+ * doTask and sends messages through an outbound queue (see sendToClient). Both queues are lock-free
+ * so that a slow client or a long turn never blocks the other thread.
+ * The packets sent to a client are appended to a buffer until flushClientMessages is called. Then, the
+ * network thread sends each buffer with only one call to the socket. Once sent, the buffers are given
+ * back to the server thread to be reused.
+ * The client sockets are not blocking. The packets partially received and the data a client did not read
+ * yet are kept by each ODSocketClient so that a slow client never blocks the network thread.
+ */
 class ODSocketServer
 {
     public:
@@ -36,13 +50,22 @@ class ODSocketServer
         virtual bool createServer(int listeningPort);
         virtual void stopServer();
 
+        //! \brief Number of client events waiting to be processed by the server thread
+        inline uint32_t getInboundQueueSize() const
+        { return mInboundQueue.size(); }
+
+        //! \brief Number of messages waiting to be sent by the network thread
+        inline uint32_t getOutboundQueueSize() const
+        { return mOutboundQueue.size(); }
+
     protected:
-        /*! \brief Function called when a new client connects. If the server returns an ODSocketClient,
-         *! it will be added to the client list
+        /*! \brief Function called from the server thread when a new client connects. If it returns
+         * true, the client will be added to the client list. Otherwise, it will be disconnected
          */
-        virtual ODSocketClient* notifyNewConnection(sf::TcpListener& sockListener) = 0;
+        virtual bool notifyNewConnection(ODSocketClient* client) = 0;
 
-        /*! \brief Function called when a client sends a message. As this function is called
+        /*! \brief Function called from the server thread when a client sends a message. If status is
+         * not OK, the client has been disconnected and packetReceived is empty. As this function is called
          * from the doTask context, it shall return as soon as possible (we should not send
          * a message and wait actively for its answer). The proper way of communicating should be :
          * 1 - read the message
@@ -52,26 +75,103 @@ class ODSocketServer
          *     will be called again
          * If the function returns false, the client will be removed from the list and properly deleted
          */
-        virtual bool notifyClientMessage(ODSocketClient *sock) = 0;
-
-        /*! \brief Main function task. Checks if a new client connects. If so, notifyNewConnection
-         * will be called with the client socket. If it returns true, the client is saved in the
-         * client list. If not, the client is discarded. doTask also checks if a connected client sent
-         * a message. If so, calls notifyClientMessage with the client socket.
-         * If timeoutMs = 0, this function will never return. Otherwise, it will always return after
-         * timeoutMs milliseconds, even if new clients connected or clients are sending messages.
+        virtual bool notifyClientMessage(ODSocketClient *sock, ODSocketClient::ODComStatus status, ODPacket& packetReceived) = 0;
+
+        /*! \brief Processes the connections and the messages received by the network thread. If a new client
+         * connects, notifyNewConnection will be called with the client socket. If it returns true, the client is
+         * saved in the client list. If not, the client is discarded. If a connected client sent a message,
+         * notifyClientMessage is called with the client socket. doTask returns after timeoutMs milliseconds. If
+         * timeoutMs is 0, it only processes the pending events and returns.
          */
         void doTask(int timeoutMs);
+
+        //! \brief Appends the packet to the messages to send to the given client. It will be sent by the
+        //! network thread after the next call to flushClientMessages
+        void sendToClient(ODSocketClient* client, const ODPacket& packet);
+
+        //! \brief Queues the messages appended by sendToClient to be sent by the network thread. It is called
+        //! by doTask when there is no more client event to process
+        void flushClientMessages();
+
+        //! \brief Removes the client from the client list. It will be disconnected and deleted by
+        //! the network thread
+        void removeClient(ODSocketClient* client);
+
+        //! \brief Clients accepted by the server thread. Should only be used from the server thread
         std::vector<ODSocketClient*> mSockClients;
         virtual void serverThread() = 0;
         sf::Thread* mThread;
 
     private:
+        //! \brief Event sent by the network thread to the server thread
+        struct InboundEvent
+        {
+            enum class Type
+            {
+                connected,
+                message,
+                disconnected
+            };
+
+            Type mType;
+            ODSocketClient* mClient;
+            ODPacket mPacket;
+        };
+
+        //! \brief Message sent by the server thread to the network thread. If mIsRemoveClient
+        //! is true, the client should be disconnected and deleted. Otherwise, mBuffer contains the
+        //! packets to send (see ODPacket::appendToBuffer)
+        struct OutboundMessage
+        {
+            ODSocketClient* mClient;
+            bool mIsRemoveClient;
+            std::vector<char> mBuffer;
+        };
+
+        //! \brief Returns a message sent back by the network thread if any or a new one
+        OutboundMessage* getOutboundMessage(ODSocketClient* client, bool isRemoveClient);
+
+        void networkThread();
+
+        //! \brief Returns true if notifyNetworkClientDisconnected was called for the client. Called from the
+        //! network thread
+        bool isNetworkClientDisconnected(ODSocketClient* client) const;
+
+        //! \brief Stops reading from and sending to the client and tells the server thread it is
+        //! disconnected. Called from the network thread
+        void notifyNetworkClientDisconnected(ODSocketClient* client);
+
+        //! \brief Sends the messages queued by the server thread. Called from the network thread
+        void processOutboundMessages();
+
+        //! \brief Deletes the events in both queues. Should only be called when the threads are stopped
+        void clearQueues();
+
         sf::TcpListener mSockListener;
         sf::SocketSelector mSockSelector;
         sf::Clock mClockMainTask;
-        bool mIsConnected;
+        std::atomic<bool> mIsConnected;
+
+        sf::Thread* mNetworkThread;
+
+        //! \brief Every client accepted by the network thread and not deleted yet. Should only
+        //! be used from the network thread
+        std::vector<ODSocketClient*> mNetworkClients;
+
+        //! \brief Clients of mNetworkClients that got a socket error and wait for the server thread to remove
+        //! them. Should only be used from the network thread
+        std::vector<ODSocketClient*> mDisconnectedNetworkClients;
+
+        SpscQueue<InboundEvent*> mInboundQueue;
+        SpscQueue<OutboundMessage*> mOutboundQueue;
+
+        //! \brief Messages already sent by the network thread. They are given back to the server
+        //! thread so that their buffer can be reused
+        SpscQueue<OutboundMessage*> mRecycledQueue;
+
+        //! \brief Messages being filled by sendToClient. There is at most one per client. Should only
+        //! be used from the server thread
+        std::vector<OutboundMessage*> mPendingMessages;
 };
 
 #endif // ODSOCKETSERVER_H
-
@@ -20,6 +20,36 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
+#include <mutex>
+#include <vector>
+
+namespace
+{
+//! \brief Maximum number of released notifications kept. The ones released after that are deleted
+const std::size_t MAX_FREE_NOTIFICATIONS = 4096;
+
+//! \brief Released notifications whose packet allocated more than that are deleted so that the few
+//! big messages (like the tiles refreshes) do not keep their memory for the whole game
+const std::size_t MAX_FREE_NOTIFICATION_CAPACITY = 4 * 1024;
+
+//! \brief Released notifications. Notifications are usually created and released by the server thread
+//! but the lock allows to use them safely from any thread. It is only taken once per notification
+std::mutex freeNotificationsLock;
+std::vector<ServerNotification*> freeNotifications;
+
+void releaseLocked(ServerNotification* notification)
+{
+    if((freeNotifications.size() >= MAX_FREE_NOTIFICATIONS) ||
+       (notification->mPacket.getCapacity() > MAX_FREE_NOTIFICATION_CAPACITY))
+    {
+        delete notification;
+        return;
+    }
+
+    freeNotifications.push_back(notification);
+}
+}
+
 ServerNotification::ServerNotification(ServerNotificationType type,
     Player* concernedPlayer) :
         mType(type),
@@ -28,6 +58,51 @@ ServerNotification::ServerNotification(ServerNotificationType type,
     mPacket << type;
 }
 
+ServerNotification* ServerNotification::create(ServerNotificationType type, Player* concernedPlayer)
+{
+    ServerNotification* notification = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(freeNotificationsLock);
+        if(!freeNotifications.empty())
+        {
+            notification = freeNotifications.back();
+            freeNotifications.pop_back();
+        }
+    }
+
+    if(notification == nullptr)
+        return new ServerNotification(type, concernedPlayer);
+
+    // The packet keeps its memory
+    notification->mType = type;
+    notification->mConcernedPlayer = concernedPlayer;
+    notification->mPacket.clear();
+    notification->mPacket << type;
+    return notification;
+}
+
+void ServerNotification::release(ServerNotification* notification)
+{
+    if(notification == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(freeNotificationsLock);
+    releaseLocked(notification);
+}
+
+void ServerNotification::release(std::vector<ServerNotification*>& notifications)
+{
+    {
+        std::lock_guard<std::mutex> lock(freeNotificationsLock);
+        for(ServerNotification* notification : notifications)
+        {
+            if(notification != nullptr)
+                releaseLocked(notification);
+        }
+    }
+    notifications.clear();
+}
+
 std::string ServerNotification::typeString(ServerNotificationType type)
 {
     switch(type)
@@ -21,6 +21,7 @@
 #include "network/ODPacket.h"
 
 #include <string>
+#include <vector>
 #include <OgreVector3.h>
 
 class Tile;
@@ -105,6 +106,18 @@ class ServerNotification
         virtual ~ServerNotification()
         {}
 
+        /*! \brief Returns a notification to be sent to concernedPlayer (see the constructor). Notifications
+         *         are created by thousands each turn. The released ones are kept with the memory allocated
+         *         by their packet and reused instead of going through the allocator. The returned notification
+         *         should be given to ODServer::queueServerNotification or to release.
+         */
+        static ServerNotification* create(ServerNotificationType type, Player* concernedPlayer);
+
+        //! \brief Gives back notifications returned by create once they are not used anymore
+        static void release(ServerNotification* notification);
+        //! \brief Same as release for every notification in the vector. The vector is cleared
+        static void release(std::vector<ServerNotification*>& notifications);
+
         ODPacket mPacket;
 
         static std::string typeString(ServerNotificationType type);
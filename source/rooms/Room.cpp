@@ -589,14 +589,12 @@ void Room::restoreInitialEntityState()
         if(!p.first->getPlayer()->getIsHuman())
             continue;
 
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::refreshTiles, p.first->getPlayer());
         std::vector<Tile*>& tilesRefresh = p.second;
-        uint32_t nbTiles = tilesRefresh.size();
-        serverNotification->mPacket << nbTiles;
+        getGameMap()->tilesToPacket(serverNotification->mPacket, tilesRefresh);
         for(Tile* tile : tilesRefresh)
         {
-            getGameMap()->tileToPacket(serverNotification->mPacket, tile);
             tile->exportToPacketForUpdate(serverNotification->mPacket, p.first);
         }
         ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -701,7 +699,7 @@ void Room::fireRoomSound(Tile& tile, const std::string& soundFamily)
         if(!seat->getPlayer()->getIsHuman())
             continue;
 
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::playSpatialSound, seat->getPlayer());
         serverNotification->mPacket << sound << tile.getX() << tile.getY();
         ODServer::getSingleton().queueServerNotification(serverNotification);
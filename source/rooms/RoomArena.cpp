@@ -34,6 +34,8 @@
 const std::string RoomArenaName = "Arena";
 const std::string RoomArenaNameDisplay = "Arena room";
 const RoomType RoomArena::mRoomType = RoomType::arena;
+const ConfigParam ArenaCostPerTileParam(ConfigParamCtg::room, "ArenaCostPerTile");
+const ConfigParam ArenaMaxTrainingLevelParam(ConfigParamCtg::room, "ArenaMaxTrainingLevel");
 
 namespace
 {
@@ -49,7 +51,7 @@ class RoomArenaFactory : public RoomFactory
     { return RoomArenaNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("ArenaCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(ArenaCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -137,7 +139,7 @@ bool RoomArena::hasOpenCreatureSpot(Creature* c)
         return false;
 
     // We allow using arena only if level is not too high
-    if (c->getLevel() >= ConfigManager::getSingleton().getRoomConfigUInt32("ArenaMaxTrainingLevel"))
+    if (c->getLevel() >= ConfigManager::getSingleton().getConfigUInt32(ArenaMaxTrainingLevelParam))
         return false;
 
     return true;
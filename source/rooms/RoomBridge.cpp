@@ -330,6 +330,7 @@ bool RoomBridge::removeCoveredTile(Tile* t)
     if(mClaimedValue > CLAIMED_VALUE_PER_TILE)
         mClaimedValue -= CLAIMED_VALUE_PER_TILE;
 
+    getGameMap()->refreshPathfindingCaches(t);
     for(Seat* seat : getGameMap()->getSeats())
         updateFloodFillTileRemoved(seat, t);
 
@@ -351,6 +352,7 @@ void RoomBridge::claimForSeat(Seat* seat, Tile* tile, double danceRate)
 
     OD_LOG_INF("Bridge=" + getName() + " claimed by seat id=" + Helper::toString(seat->getId()));
     mClaimedValue = static_cast<double>(numCoveredTiles());
+    getGameMap()->notifyRoomSeatChanging(this, seat);
     setSeat(seat);
 
     for(Tile* tile : mCoveredTiles)
@@ -369,6 +371,9 @@ double RoomBridge::getCreatureSpeed(const Creature* creature, Tile* tile) const
 
 void RoomBridge::updateFloodFillPathCreated(Seat* seat, const std::vector<Tile*>& tiles)
 {
+    for(Tile* tile : tiles)
+        getGameMap()->refreshPathfindingCaches(tile);
+
     // We look for the first ground flood fill value. That means that all values
     // are expected to be filled since bridges can only be built next to a claimed
     // ground tile
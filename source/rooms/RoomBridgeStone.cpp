@@ -31,6 +31,7 @@
 const std::string RoomBridgeStoneName = "StoneBridge";
 const std::string RoomBridgeStoneNameDisplay = "Stone Bridge room";
 const RoomType RoomBridgeStone::mRoomType = RoomType::bridgeStone;
+const ConfigParam StoneBridgeCostPerTileParam(ConfigParamCtg::room, "StoneBridgeCostPerTile");
 static const std::vector<TileVisual> allowedTilesVisual = {TileVisual::waterGround, TileVisual::lavaGround};
 
 namespace
@@ -47,7 +48,7 @@ class RoomBridgeStoneFactory : public BridgeRoomFactory
     { return RoomBridgeStoneNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("StoneBridgeCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(StoneBridgeCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -31,6 +31,7 @@
 const std::string RoomBridgeWoodenName = "WoodenBridge";
 const std::string RoomBridgeWoodenNameDisplay = "Wooden Bridge room";
 const RoomType RoomBridgeWooden::mRoomType = RoomType::bridgeWooden;
+const ConfigParam WoodenBridgeCostPerTileParam(ConfigParamCtg::room, "WoodenBridgeCostPerTile");
 static const std::vector<TileVisual> allowedTilesVisual = {TileVisual::waterGround};
 
 namespace
@@ -47,7 +48,7 @@ class RoomBridgeWoodenFactory : public BridgeRoomFactory
     { return RoomBridgeWoodenNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("WoodenBridgeCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(WoodenBridgeCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -39,6 +39,12 @@
 const std::string RoomCasinoName = "Casino";
 const std::string RoomCasinoNameDisplay = "Casino room";
 const RoomType RoomCasino::mRoomType = RoomType::casino;
+const ConfigParam CasinoCostPerTileParam(ConfigParamCtg::room, "CasinoCostPerTile");
+const ConfigParam CasinoCooldownWorkMinParam(ConfigParamCtg::room, "CasinoCooldownWorkMin");
+const ConfigParam CasinoCooldownWorkMaxParam(ConfigParamCtg::room, "CasinoCooldownWorkMax");
+const ConfigParam CasinoFeeParam(ConfigParamCtg::room, "CasinoFee");
+const ConfigParam CasinoWakefulnessPerWorkParam(ConfigParamCtg::room, "CasinoWakefulnessPerWork");
+const ConfigParam CasinoBetParam(ConfigParamCtg::room, "CasinoBet");
 
 namespace
 {
@@ -54,7 +60,7 @@ class RoomCasinoFactory : public RoomFactory
     { return RoomCasinoNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("CasinoCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(CasinoCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -375,11 +381,11 @@ void RoomCasino::doUpkeep()
         // TODO: we could use the wall active spots to change feePercent/bets
 
         // We set anim for both creatures
-        uint32_t cooldown = Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("CasinoCooldownWorkMin"),
-            ConfigManager::getSingleton().getRoomConfigUInt32("CasinoCooldownWorkMax"));
-        double feePercent = std::min(ConfigManager::getSingleton().getRoomConfigDouble("CasinoFee"), 1.0);
-        double wakefullness = ConfigManager::getSingleton().getRoomConfigDouble("CasinoWakefulnessPerWork");
-        int32_t creatureBet = ConfigManager::getSingleton().getRoomConfigInt32("CasinoBet");
+        uint32_t cooldown = Random::Uint(ConfigManager::getSingleton().getConfigUInt32(CasinoCooldownWorkMinParam),
+            ConfigManager::getSingleton().getConfigUInt32(CasinoCooldownWorkMaxParam));
+        double feePercent = std::min(ConfigManager::getSingleton().getConfigDouble(CasinoFeeParam), 1.0);
+        double wakefullness = ConfigManager::getSingleton().getConfigDouble(CasinoWakefulnessPerWorkParam);
+        int32_t creatureBet = ConfigManager::getSingleton().getConfigInt32(CasinoBetParam);
         creatureBet = std::min(creatureBet, p.second.mCreature1.mCreature->getGoldCarried());
         creatureBet = std::min(creatureBet, p.second.mCreature2.mCreature->getGoldCarried());
         int32_t totalBet = 0;
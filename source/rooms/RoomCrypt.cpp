@@ -35,6 +35,11 @@
 const std::string RoomCryptName = "Crypt";
 const std::string RoomCryptNameDisplay = "Crypt room";
 const RoomType RoomCrypt::mRoomType = RoomType::crypt;
+const ConfigParam CryptCostPerTileParam(ConfigParamCtg::room, "CryptCostPerTile");
+const ConfigParam CryptRotNbTurnsParam(ConfigParamCtg::room, "CryptRotNbTurns");
+const ConfigParam CryptBonusWallActiveSpotParam(ConfigParamCtg::room, "CryptBonusWallActiveSpot");
+const ConfigParam CryptPointsForSpawnParam(ConfigParamCtg::room, "CryptPointsForSpawn");
+const ConfigParam CryptSpawnClassParam(ConfigParamCtg::room, "CryptSpawnClass");
 
 namespace
 {
@@ -50,7 +55,7 @@ class RoomCryptFactory : public RoomFactory
     { return RoomCryptNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("CryptCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(CryptCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -219,11 +224,11 @@ void RoomCrypt::doUpkeep()
         ConfigManager& configManager = ConfigManager::getSingleton();
 
         ++p.second.second;
-        if(p.second.second < configManager.getRoomConfigInt32("CryptRotNbTurns"))
+        if(p.second.second < configManager.getConfigInt32(CryptRotNbTurnsParam))
             continue;
 
         // We add the rotten creature points to the room and release the active spot
-        double coef = 1.0 + static_cast<double>(mNumActiveSpots - mCentralActiveSpotTiles.size()) * configManager.getRoomConfigDouble("CryptBonusWallActiveSpot");
+        double coef = 1.0 + static_cast<double>(mNumActiveSpots - mCentralActiveSpotTiles.size()) * configManager.getConfigDouble(CryptBonusWallActiveSpotParam);
         Creature* c = p.second.first;
         mRottenPoints += static_cast<int32_t>(c->getMaxHp() * coef);
 
@@ -234,13 +239,13 @@ void RoomCrypt::doUpkeep()
 
         int32_t maxCreatures = configManager.getMaxCreaturesPerSeatAbsolute();
         int32_t numCreatures = getGameMap()->getCreaturesBySeat(getSeat()).size();
-        int32_t cryptPointsForSpawn = configManager.getRoomConfigInt32("CryptPointsForSpawn");
+        int32_t cryptPointsForSpawn = configManager.getConfigInt32(CryptPointsForSpawnParam);
         if((numCreatures < maxCreatures) &&
            (mRottenPoints >= cryptPointsForSpawn))
         {
             Tile* tileSpawn = p.first;
             mRottenPoints -= cryptPointsForSpawn;
-            const std::string& className = configManager.getRoomConfigString("CryptSpawnClass");
+            const std::string& className = configManager.getConfigString(CryptSpawnClassParam);
             const CreatureDefinition* classToSpawn = getGameMap()->getClassDescription(className);
             if(classToSpawn == nullptr)
             {
@@ -252,7 +257,7 @@ void RoomCrypt::doUpkeep()
                getSeat()->getPlayer()->getIsHuman() &&
                !getSeat()->getPlayer()->getHasLost())
             {
-                ServerNotification *serverNotification = new ServerNotification(
+                ServerNotification *serverNotification = ServerNotification::create(
                     ServerNotificationType::chatServer, getSeat()->getPlayer());
                 std::string msg = "A creature has raised in your crypt thanks to the blood of the creatures rotting there";
                 serverNotification->mPacket << msg << EventShortNoticeType::aboutCreatures;
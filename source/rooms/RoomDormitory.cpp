@@ -35,6 +35,7 @@
 const std::string RoomDormitoryName = "Dormitory";
 const std::string RoomDormitoryNameDisplay = "Dormitory room";
 const RoomType RoomDormitory::mRoomType = RoomType::dormitory;
+const ConfigParam DormitoryCostPerTileParam(ConfigParamCtg::room, "DormitoryCostPerTile");
 
 namespace
 {
@@ -50,7 +51,7 @@ class RoomDormitoryFactory : public RoomFactory
     { return RoomDormitoryNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("DormitoryCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(DormitoryCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
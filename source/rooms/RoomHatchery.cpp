@@ -34,6 +34,8 @@
 const std::string RoomHatcheryName = "Hatchery";
 const std::string RoomHatcheryNameDisplay = "Hatchery room";
 const RoomType RoomHatchery::mRoomType = RoomType::hatchery;
+const ConfigParam HatcheryCostPerTileParam(ConfigParamCtg::room, "HatcheryCostPerTile");
+const ConfigParam HatcheryChickenSpawnRateParam(ConfigParamCtg::room, "HatcheryChickenSpawnRate");
 
 namespace
 {
@@ -49,7 +51,7 @@ class RoomHatcheryFactory : public RoomFactory
     { return RoomHatcheryNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("HatcheryCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(HatcheryCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -155,7 +157,7 @@ void RoomHatchery::doUpkeep()
 
     // Chickens have been eaten. We check when we will spawn another one
     ++mSpawnChickenCooldown;
-    if(mSpawnChickenCooldown < ConfigManager::getSingleton().getRoomConfigUInt32("HatcheryChickenSpawnRate"))
+    if(mSpawnChickenCooldown < ConfigManager::getSingleton().getConfigUInt32(HatcheryChickenSpawnRateParam))
         return;
 
     // We spawn 1 chicken per chicken coop (until chickens are maxed)
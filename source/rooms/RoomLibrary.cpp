@@ -36,6 +36,12 @@
 const std::string RoomLibraryName = "Library";
 const std::string RoomLibraryNameDisplay = "Library room";
 const RoomType RoomLibrary::mRoomType = RoomType::library;
+const ConfigParam LibraryCostPerTileParam(ConfigParamCtg::room, "LibraryCostPerTile");
+const ConfigParam LibrarySkillPointsBookParam(ConfigParamCtg::room, "LibrarySkillPointsBook");
+const ConfigParam LibraryPointsPerWorkParam(ConfigParamCtg::room, "LibraryPointsPerWork");
+const ConfigParam LibraryWakefulnessPerWorkParam(ConfigParamCtg::room, "LibraryWakefulnessPerWork");
+const ConfigParam LibraryCooldownWorkMinParam(ConfigParamCtg::room, "LibraryCooldownWorkMin");
+const ConfigParam LibraryCooldownWorkMaxParam(ConfigParamCtg::room, "LibraryCooldownWorkMax");
 
 namespace
 {
@@ -51,7 +57,7 @@ class RoomLibraryFactory : public RoomFactory
     { return RoomLibraryNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("LibraryCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(LibraryCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -324,7 +330,7 @@ void RoomLibrary::doUpkeep()
 
 bool RoomLibrary::useRoom(Creature& creature, bool forced)
 {
-    int32_t skillEntityPoints = ConfigManager::getSingleton().getRoomConfigInt32("LibrarySkillPointsBook");
+    int32_t skillEntityPoints = ConfigManager::getSingleton().getConfigInt32(LibrarySkillPointsBookParam);
     auto it = mCreaturesSpots.find(&creature);
     if(it == mCreaturesSpots.end())
     {
@@ -374,10 +380,10 @@ bool RoomLibrary::useRoom(Creature& creature, bool forced)
     OD_ASSERT_TRUE_MSG(creatureRoomAffinity.getRoomType() == getType(), "name=" + getName() + ", creature=" + creature.getName()
         + ", creatureRoomAffinityType=" + Helper::toString(static_cast<int>(creatureRoomAffinity.getRoomType())));
 
-    int32_t pointsEarned = static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getRoomConfigDouble("LibraryPointsPerWork"));
-    creature.jobDone(ConfigManager::getSingleton().getRoomConfigDouble("LibraryWakefulnessPerWork"));
-    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("LibraryCooldownWorkMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("LibraryCooldownWorkMax")));
+    int32_t pointsEarned = static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getConfigDouble(LibraryPointsPerWorkParam));
+    creature.jobDone(ConfigManager::getSingleton().getConfigDouble(LibraryWakefulnessPerWorkParam));
+    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getConfigUInt32(LibraryCooldownWorkMinParam),
+        ConfigManager::getSingleton().getConfigUInt32(LibraryCooldownWorkMaxParam)));
 
     // We check if we have enough points to create a skill entity
     mSkillPoints += pointsEarned;
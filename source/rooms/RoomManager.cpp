@@ -209,15 +209,13 @@ bool RoomFactory::buildRoomDefault(GameMap* gameMap, Room* room, Seat* seat, con
             }
         }
 
-        for(const std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
+        for(std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
         {
-            uint32_t nbTiles = p.second.size();
             ServerNotification serverNotification(
                 ServerNotificationType::refreshTiles, p.first->getPlayer());
-            serverNotification.mPacket << nbTiles;
+            gameMap->tilesToPacket(serverNotification.mPacket, p.second);
             for(Tile* tile : p.second)
             {
-                gameMap->tileToPacket(serverNotification.mPacket, tile);
                 p.first->updateTileStateForSeat(tile, false);
                 tile->exportToPacketForUpdate(serverNotification.mPacket, p.first);
             }
@@ -604,15 +602,13 @@ void RoomManager::sellRoomTiles(GameMap* gameMap, Player* player, ODPacket& pack
         }
     }
 
-    for(const std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
+    for(std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
     {
-        uint32_t nbTiles = p.second.size();
         ServerNotification serverNotification(
             ServerNotificationType::refreshTiles, p.first->getPlayer());
-        serverNotification.mPacket << nbTiles;
+        gameMap->tilesToPacket(serverNotification.mPacket, p.second);
         for(Tile* tile : p.second)
         {
-            gameMap->tileToPacket(serverNotification.mPacket, tile);
             p.first->updateTileStateForSeat(tile, false);
             tile->exportToPacketForUpdate(serverNotification.mPacket, p.first);
         }
@@ -730,15 +726,13 @@ void RoomManager::sellRoomTilesEditor(GameMap* gameMap, ODPacket& packet)
         }
     }
 
-    for(const std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
+    for(std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
     {
-        uint32_t nbTiles = p.second.size();
         ServerNotification serverNotification(
             ServerNotificationType::refreshTiles, p.first->getPlayer());
-        serverNotification.mPacket << nbTiles;
+        gameMap->tilesToPacket(serverNotification.mPacket, p.second);
         for(Tile* tile : p.second)
         {
-            gameMap->tileToPacket(serverNotification.mPacket, tile);
             p.first->updateTileStateForSeat(tile, false);
             tile->exportToPacketForUpdate(serverNotification.mPacket, p.first);
         }
@@ -38,6 +38,8 @@
 const std::string RoomPortalName = "Portal";
 const std::string RoomPortalNameDisplay = "Portal room";
 const RoomType RoomPortal::mRoomType = RoomType::portal;
+const ConfigParam PortalCooldownSpawnMinParam(ConfigParamCtg::room, "PortalCooldownSpawnMin");
+const ConfigParam PortalCooldownSpawnMaxParam(ConfigParamCtg::room, "PortalCooldownSpawnMax");
 
 namespace
 {
@@ -147,6 +149,7 @@ void RoomPortal::claimForSeat(Seat* seat, Tile* tile, double danceRate)
     }
 
     mClaimedValue = static_cast<double>(numCoveredTiles());
+    getGameMap()->notifyRoomSeatChanging(this, seat);
     setSeat(seat);
 
     for(Tile* tile : mCoveredTiles)
@@ -216,8 +219,8 @@ void RoomPortal::doUpkeep()
         --mSpawnCreatureCountdown;
         return;
     }
-    mSpawnCreatureCountdown = Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("PortalCooldownSpawnMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("PortalCooldownSpawnMax"));
+    mSpawnCreatureCountdown = Random::Uint(ConfigManager::getSingleton().getConfigUInt32(PortalCooldownSpawnMinParam),
+        ConfigManager::getSingleton().getConfigUInt32(PortalCooldownSpawnMaxParam));
 
     if (mCoveredTiles.empty())
         return;
@@ -342,13 +345,11 @@ void RoomPortal::restoreInitialEntityState()
         if(!seat->getPlayer()->getIsHuman())
             continue;
 
-        uint32_t nbTiles = tilesToNotify.size();
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::refreshTiles, seat->getPlayer());
-        serverNotification->mPacket << nbTiles;
+        getGameMap()->tilesToPacket(serverNotification->mPacket, tilesToNotify);
         for(Tile* tile : tilesToNotify)
         {
-            getGameMap()->tileToPacket(serverNotification->mPacket, tile);
             seat->updateTileStateForSeat(tile, true);
             tile->exportToPacketForUpdate(serverNotification->mPacket, seat, true);
         }
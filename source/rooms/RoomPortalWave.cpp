@@ -100,38 +100,6 @@ class RoomPortalWaveFactory : public RoomFactory
 static RoomRegister reg(new RoomPortalWaveFactory);
 }
 
-class TileSearch
-{
-public:
-    TileSearch() :
-        mTile(nullptr),
-        mRotationClockWise(false),
-        mRotationCounterClockWise(false)
-    {}
-
-    static std::pair<int,int> computeNextRotation(const std::pair<int,int>& currentRotation,
-        bool rotationClockWise)
-    {
-        if(rotationClockWise)
-        {
-            int newY = currentRotation.first;
-            int newX = currentRotation.second * -1;
-            return std::pair<int, int>(newX, newY);
-        }
-        else
-        {
-            int newY = currentRotation.first * -1;
-            int newX = currentRotation.second;
-            return std::pair<int, int>(newX, newY);
-        }
-    }
-
-    Tile* mTile;
-    bool mRotationClockWise;
-    bool mRotationCounterClockWise;
-    std::pair<int,int> mDirectionHit;
-};
-
 static const double CLAIMED_VALUE_PER_TILE = 1.0;
 
 RoomPortalWave::RoomPortalWave(GameMap* gameMap) :
@@ -401,7 +369,7 @@ void RoomPortalWave::handleAttack()
                tileSeat->getPlayer()->getIsHuman() &&
                !tileSeat->getPlayer()->getHasLost())
             {
-                ServerNotification *serverNotification = new ServerNotification(
+                ServerNotification *serverNotification = ServerNotification::create(
                     ServerNotificationType::chatServer, tileSeat->getPlayer());
 
                 std::string msg = "Your evil presence has soiled this holy land for too long. You shall be crushed by our blessed swords !";
@@ -848,8 +816,9 @@ bool RoomPortalWave::handleDigging()
         return true;
     }
 
-    // We sort the dungeon temples by distance. We will try to reach the closest accessible one
-    std::vector<std::pair<Room*,Ogre::Real>> tileDungeons;
+    // We look for the dungeon temple we can reach by digging the less
+    std::vector<Room*> dungeons;
+    std::vector<Tile*> tileDungeons;
     std::vector<Room*> dungeonTemples = getGameMap()->getRoomsByType(RoomType::dungeonTemple);
     for(Room* room : dungeonTemples)
     {
@@ -861,16 +830,8 @@ bool RoomPortalWave::handleDigging()
         if(tile == nullptr)
             continue;
 
-        auto it = tileDungeons.begin();
-        Ogre::Real templeDist = Pathfinding::squaredDistanceTile(*tileStart, *tile);
-        while(it != tileDungeons.end())
-        {
-            if(templeDist < it->second)
-                break;
-
-            ++it;
-        }
-        tileDungeons.insert(it, std::pair<Room*,Ogre::Real>(room, templeDist));
+        dungeons.push_back(room);
+        tileDungeons.push_back(tile);
     }
 
     if(tileDungeons.empty())
@@ -879,214 +840,53 @@ bool RoomPortalWave::handleDigging()
         return false;
     }
 
-    bool isWayFound = false;
-    tilesToMark.clear();
-    for(std::pair<Room*,Ogre::Real>& p : tileDungeons)
-    {
-        mMarkedTilesToEnemy.clear();
-        Tile* tileDungeon = p.first->getCentralTile();
-        if(tileDungeon == nullptr)
-            continue;
-
-        if(!findBestDiggablePath(tileStart, tileDungeon, creature, mMarkedTilesToEnemy) &&
-           mMarkedTilesToEnemy.empty())
-        {
-            continue;
-        }
-
-        if(mTargetDungeon != nullptr)
-            mTargetDungeon->removeGameEntityListener(this);
-
-        mTargetDungeon = p.first;
-        mTargetDungeon->addGameEntityListener(this);
-        OD_LOG_INF("PortalWave=" + getName()+ " wants to attack dungeon=" + mTargetDungeon->getName());
-        isWayFound = true;
-        for(Tile* tile : mMarkedTilesToEnemy)
-            tilesToMark.push_back(tile);
-
-        break;
-    }
-
-    if(!isWayFound)
+    mMarkedTilesToEnemy.clear();
+    Tile* tileDungeon = findBestDiggablePath(tileStart, tileDungeons, creature, mMarkedTilesToEnemy);
+    if(tileDungeon == nullptr)
         return false;
 
-    getSeat()->getPlayer()->markTilesForDigging(true, tilesToMark, false);
-
-    return true;
-}
-
-bool RoomPortalWave::findBestDiggablePath(Tile* tileStart, Tile* tileDest, Creature* creature, std::vector<Tile*>& tiles)
-{
-    if(!creature->canGoThroughTile(tileStart) &&
-       !tileStart->isDiggable(creature->getSeat()))
+    auto it = std::find(tileDungeons.begin(), tileDungeons.end(), tileDungeon);
+    if(it == tileDungeons.end())
     {
+        OD_LOG_ERR("room=" + getName() + ", tile=" + Tile::displayAsString(tileDungeon));
         return false;
     }
 
-    std::vector<std::pair<int, int>> rotations;
-    std::vector<TileSearch> blockingTiles;
-    Tile* tile = tileStart;
-    Tile* lastTileBlocked = nullptr;
-    bool currentRotationClockWise = false;
-    while(true)
-    {
-        if(tile == tileDest)
-            return true;
-
-        if(tile == nullptr)
-        {
-            // We reach the end of the map.
-            // We try the last blocking tile we found in the other direction (if any)
-            lastTileBlocked = nullptr;
-            for(auto it = blockingTiles.rbegin(); it != blockingTiles.rend(); ++it)
-            {
-                TileSearch& tileSearch = *it;
-                if(tileSearch.mRotationClockWise &&
-                   tileSearch.mRotationCounterClockWise)
-                {
-                    continue;
-                }
-
-                lastTileBlocked = tileSearch.mTile;
-                if(tileSearch.mRotationClockWise)
-                {
-                    tileSearch.mRotationCounterClockWise = true;
-                    currentRotationClockWise = false;
-                }
-                else
-                {
-                    tileSearch.mRotationClockWise = true;
-                    currentRotationClockWise = true;
-                }
+    if(mTargetDungeon != nullptr)
+        mTargetDungeon->removeGameEntityListener(this);
 
-                rotations.clear();
-                rotations.push_back(tileSearch.mDirectionHit);
-                rotations.push_back(TileSearch::computeNextRotation(rotations.back(), currentRotationClockWise));
-                break;
-            }
+    mTargetDungeon = dungeons[std::distance(tileDungeons.begin(), it)];
+    mTargetDungeon->addGameEntityListener(this);
+    OD_LOG_INF("PortalWave=" + getName()+ " wants to attack dungeon=" + mTargetDungeon->getName());
 
-            if(lastTileBlocked == nullptr)
-                return false;
+    getSeat()->getPlayer()->markTilesForDigging(true, mMarkedTilesToEnemy, false);
 
-            tile = getGameMap()->getTile(lastTileBlocked->getX() + rotations.back().first, lastTileBlocked->getY() + rotations.back().second);
-        }
+    return true;
+}
 
-        // A nullptr tile is possible if we are searching near the map border after applying the rotation
-        if(tile == nullptr)
-            continue;
+Tile* RoomPortalWave::findBestDiggablePath(Tile* tileStart, const std::vector<Tile*>& tileDests, Creature* creature, std::vector<Tile*>& tiles)
+{
+    std::vector<Tile*> path;
+    if(!getGameMap()->findDigPath(*creature, tileStart, tileDests, path))
+        return nullptr;
 
-        bool isTilePassable = false;
-        // If the tile is walkable, no need to dig it
+    // We only keep the tiles that still need to be marked. If the path goes through walls claimed
+    // by an enemy (like when its dungeon temple is surrounded by them), we dig up to the first one
+    for(Tile* tile : path)
+    {
         if(creature->canGoThroughTile(tile))
-        {
-            isTilePassable = true;
-        }
-        else if(tile->getMarkedForDigging(creature->getSeat()->getPlayer()))
-        {
-            isTilePassable = true;
-        }
-        else if(tile->isDiggable(creature->getSeat()))
-        {
-            tiles.push_back(tile);
-            isTilePassable = true;
-        }
-
-        if(isTilePassable)
-        {
-            // The tile is passable. If we were rotating, we try the next rotation
-            // If not, we continue our way
-            if(!rotations.empty())
-                rotations.pop_back();
-
-            if(rotations.empty())
-            {
-                int diffX = tileDest->getX() - tile->getX();
-                int diffY = tileDest->getY() - tile->getY();
-                if(std::abs(diffX) > std::abs(diffY))
-                {
-                    if(diffX < 0)
-                        rotations.push_back(std::pair<int, int>(-1, 0));
-                    else
-                        rotations.push_back(std::pair<int, int>(1, 0));
-                }
-                else
-                {
-                    if(diffY < 0)
-                        rotations.push_back(std::pair<int, int>(0, -1));
-                    else
-                        rotations.push_back(std::pair<int, int>(0, 1));
-                }
-
-                // We are not blocked
-                lastTileBlocked = nullptr;
-            }
-            tile = getGameMap()->getTile(tile->getX() + rotations.back().first, tile->getY() + rotations.back().second);
-        }
-        else
-        {
-            // We start from the previous tile (that was good to go)
-            tile = getGameMap()->getTile(tile->getX() - rotations.back().first, tile->getY() - rotations.back().second);
-            if(tile == nullptr)
-            {
-                OD_LOG_ERR("room=" + getName());
-                return false;
-            }
-
-            // Tile is not passable. We try to go around. If we are not already following a wall, we start to
-            if(lastTileBlocked == nullptr)
-            {
-                // We check if we already hit this tile
-                bool isFound = false;
-                for(TileSearch& tileSearch : blockingTiles)
-                {
-                    if(tileSearch.mTile != tile)
-                        continue;
-
-                    // We already hit this tile. We stop searching this way
-                    isFound = true;
-                }
-
-                if(isFound)
-                {
-                    tile = nullptr;
-                    continue;
-                }
+            continue;
 
-                // We have never been blocked here
-                lastTileBlocked = tile;
+        if(tile->getMarkedForDigging(creature->getSeat()->getPlayer()))
+            continue;
 
-                int diffX = tileDest->getX() - tile->getX();
-                int diffY = tileDest->getY() - tile->getY();
-                if(rotations.back().first == 0)
-                {
-                    if(diffX < 0)
-                        currentRotationClockWise = (rotations.back().second > 0);
-                    else
-                        currentRotationClockWise = (rotations.back().second < 0);
-                }
-                else // rotations.back().second should be 0
-                {
-                    if(diffY < 0)
-                        currentRotationClockWise = (rotations.back().first < 0);
-                    else
-                        currentRotationClockWise = (rotations.back().first > 0);
-                }
-                TileSearch tileSearch;
-                tileSearch.mTile = tile;
-                tileSearch.mDirectionHit = rotations.back();
-                if(currentRotationClockWise)
-                    tileSearch.mRotationClockWise = true;
-                else
-                    tileSearch.mRotationCounterClockWise = true;
-
-                blockingTiles.push_back(tileSearch);
-            }
+        if(!tile->isDiggable(creature->getSeat()))
+            break;
 
-            // We set next direction
-            rotations.push_back(TileSearch::computeNextRotation(rotations.back(), currentRotationClockWise));
-            tile = getGameMap()->getTile(tile->getX() + rotations.back().first, tile->getY() + rotations.back().second);
-        }
+        tiles.push_back(tile);
     }
+
+    return path.back();
 }
 
 void RoomPortalWave::handleFirstUpkeep()
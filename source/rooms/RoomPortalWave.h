@@ -157,11 +157,10 @@ private:
     //! \brief Updates the portal mesh position.
     void updatePortalPosition();
 
-    //! \brief Finds the best diggable path between tileStart and tileDest.
-    //! Note that a path is returned even if tileDest is not reachable. It should go around
-    //! the undiggable tiles
-    //! Returns true if a path was found to the dungeon and false otherwise
-    bool findBestDiggablePath(Tile* tileStart, Tile* tileDest, Creature* creature, std::vector<Tile*>& tiles);
+    //! \brief Finds the path from tileStart to the tile of tileDests that needs the less digging (see GameMap::findDigPath).
+    //! The tiles of the path that should be marked for digging are added to tiles (up to the first wall claimed by an enemy).
+    //! Returns the destination reached or nullptr if none can be reached
+    Tile* findBestDiggablePath(Tile* tileStart, const std::vector<Tile*>& tileDests, Creature* creature, std::vector<Tile*>& tiles);
 
     //! \brief Spawns a wave
     void spawnWave(RoomPortalWaveData* roomPortalWaveData, uint32_t maxCreaturesToSpawn);
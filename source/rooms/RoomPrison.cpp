@@ -38,6 +38,9 @@
 const std::string RoomPrisonName = "Prison";
 const std::string RoomPrisonNameDisplay = "Prison room";
 const RoomType RoomPrison::mRoomType = RoomType::prison;
+const ConfigParam PrisonCostPerTileParam(ConfigParamCtg::room, "PrisonCostPerTile");
+const ConfigParam PrisonDamagePerTurnParam(ConfigParamCtg::room, "PrisonDamagePerTurn");
+const ConfigParam PrisonSpawnClassParam(ConfigParamCtg::room, "PrisonSpawnClass");
 
 namespace
 {
@@ -53,7 +56,7 @@ class RoomPrisonFactory : public RoomFactory
     { return RoomPrisonNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("PrisonCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(PrisonCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -210,7 +213,7 @@ void RoomPrison::doUpkeep()
 
             ++nbCreatures;
             // We slightly damage the prisoner
-            double damage = ConfigManager::getSingleton().getRoomConfigDouble("PrisonDamagePerTurn");
+            double damage = ConfigManager::getSingleton().getConfigDouble(PrisonDamagePerTurnParam);
             creature->takeDamage(this, damage, 0.0, 0.0, 0.0, creatureTile, false);
             creature->increaseTurnsPrison();
 
@@ -224,7 +227,7 @@ void RoomPrison::doUpkeep()
                getSeat()->getPlayer()->getIsHuman() &&
                !getSeat()->getPlayer()->getHasLost())
             {
-                ServerNotification *serverNotification = new ServerNotification(
+                ServerNotification *serverNotification = ServerNotification::create(
                     ServerNotificationType::chatServer, getSeat()->getPlayer());
                 std::string msg = "A creature died starving in your prison";
                 serverNotification->mPacket << msg << EventShortNoticeType::aboutCreatures;
@@ -235,7 +238,7 @@ void RoomPrison::doUpkeep()
             creature->removeFromGameMap();
             creature->deleteYourself();
 
-            const std::string& className = ConfigManager::getSingleton().getRoomConfigString("PrisonSpawnClass");
+            const std::string& className = ConfigManager::getSingleton().getConfigString(PrisonSpawnClassParam);
             const CreatureDefinition* classToSpawn = getGameMap()->getClassDescription(className);
             if(classToSpawn == nullptr)
             {
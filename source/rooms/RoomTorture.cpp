@@ -37,6 +37,11 @@
 const std::string RoomTortureName = "Torture";
 const std::string RoomTortureNameDisplay = "Torture room";
 const RoomType RoomTorture::mRoomType = RoomType::torture;
+const ConfigParam TortureCostPerTileParam(ConfigParamCtg::room, "TortureCostPerTile");
+const ConfigParam TortureDamagePerTurnParam(ConfigParamCtg::room, "TortureDamagePerTurn");
+const ConfigParam TortureRallyPercentParam(ConfigParamCtg::room, "TortureRallyPercent");
+const ConfigParam TortureSessionLengthMinParam(ConfigParamCtg::room, "TortureSessionLengthMin");
+const ConfigParam TortureSessionLengthMaxParam(ConfigParamCtg::room, "TortureSessionLengthMax");
 
 namespace
 {
@@ -52,7 +57,7 @@ class RoomTortureFactory : public RoomFactory
     { return RoomTortureNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("TortureCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(TortureCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -297,7 +302,7 @@ void RoomTorture::doUpkeep()
             break;
         }
         creature->increaseTurnsTorture();
-        double damage = config.getRoomConfigDouble("TortureDamagePerTurn");
+        double damage = config.getConfigDouble(TortureDamagePerTurnParam);
         creature->takeDamage(this, damage, 0.0, 0.0, 0.0, tileCreature, false);
         break;
     }
@@ -328,7 +333,7 @@ bool RoomTorture::useRoom(Creature& creature, bool forced)
         p.second.mIsReady = true;
 
         if((getSeat() != creature.getSeat()) &&
-           (Random::Double(0.0, 1.0) <= config.getRoomConfigDouble("TortureRallyPercent")))
+           (Random::Double(0.0, 1.0) <= config.getConfigDouble(TortureRallyPercentParam)))
         {
             // The creature changes side
             creature.changeSeat(getSeat());
@@ -339,7 +344,7 @@ bool RoomTorture::useRoom(Creature& creature, bool forced)
                getSeat()->getPlayer()->getIsHuman() &&
                !getSeat()->getPlayer()->getHasLost())
             {
-                ServerNotification *serverNotification = new ServerNotification(
+                ServerNotification *serverNotification = ServerNotification::create(
                     ServerNotificationType::chatServer, getSeat()->getPlayer());
                 std::string msg = "Your tormentors have convinced another creature how sweet it is to live under your rule";
                 serverNotification->mPacket << msg << EventShortNoticeType::aboutCreatures;
@@ -349,8 +354,8 @@ bool RoomTorture::useRoom(Creature& creature, bool forced)
         }
 
         // We start the fire effect and we set job cooldown
-        uint32_t nbTurns = Random::Uint(config.getRoomConfigUInt32("TortureSessionLengthMin"),
-            config.getRoomConfigUInt32("TortureSessionLengthMax"));
+        uint32_t nbTurns = Random::Uint(config.getConfigUInt32(TortureSessionLengthMinParam),
+            config.getConfigUInt32(TortureSessionLengthMaxParam));
         creature.setJobCooldown(nbTurns);
 
         BuildingObject* obj = getBuildingObjectFromTile(tileCreature);
@@ -367,7 +372,7 @@ bool RoomTorture::useRoom(Creature& creature, bool forced)
             case 1:
             {
                 obj->addParticleEffect("Flame", nbTurns / 2);
-                obj->fireRefresh();
+                obj->setNeedFireRefresh(true);
                 creature.setAnimationState(EntityAnimation::flee_anim);
                 break;
             }
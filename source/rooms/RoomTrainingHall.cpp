@@ -32,6 +32,13 @@
 const std::string RoomTrainingHallName = "TrainingHall";
 const std::string RoomTrainingHallNameDisplay = "Training hall room";
 const RoomType RoomTrainingHall::mRoomType = RoomType::trainingHall;
+const ConfigParam TrainHallCostPerTileParam(ConfigParamCtg::room, "TrainHallCostPerTile");
+const ConfigParam TrainHallMaxTrainingLevelParam(ConfigParamCtg::room, "TrainHallMaxTrainingLevel");
+const ConfigParam TrainHallBonusWallActiveSpotParam(ConfigParamCtg::room, "TrainHallBonusWallActiveSpot");
+const ConfigParam TrainHallXpPerAttackParam(ConfigParamCtg::room, "TrainHallXpPerAttack");
+const ConfigParam TrainHallWakefulnessPerAttackParam(ConfigParamCtg::room, "TrainHallWakefulnessPerAttack");
+const ConfigParam TrainHallCooldownHitMinParam(ConfigParamCtg::room, "TrainHallCooldownHitMin");
+const ConfigParam TrainHallCooldownHitMaxParam(ConfigParamCtg::room, "TrainHallCooldownHitMax");
 
 namespace
 {
@@ -47,7 +54,7 @@ class RoomTrainingHallFactory : public RoomFactory
     { return RoomTrainingHallNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("TrainHallCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(TrainHallCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -266,7 +273,7 @@ void RoomTrainingHall::refreshCreaturesDummies()
 
 bool RoomTrainingHall::hasOpenCreatureSpot(Creature* c)
 {
-    if (c->getLevel() >= ConfigManager::getSingleton().getRoomConfigUInt32("TrainHallMaxTrainingLevel"))
+    if (c->getLevel() >= ConfigManager::getSingleton().getConfigUInt32(TrainHallMaxTrainingLevelParam))
         return false;
 
     // We accept all creatures as soon as there are free dummies
@@ -389,14 +396,14 @@ bool RoomTrainingHall::useRoom(Creature& creature, bool forced)
         + ", creatureRoomAffinityType=" + Helper::toString(static_cast<int>(creatureRoomAffinity.getRoomType())));
 
     // We add a bonus per wall active spots
-    double coef = 1.0 + static_cast<double>(mNumActiveSpots - mCentralActiveSpotTiles.size()) * ConfigManager::getSingleton().getRoomConfigDouble("TrainHallBonusWallActiveSpot");
-    double expReceived = creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getRoomConfigDouble("TrainHallXpPerAttack");
+    double coef = 1.0 + static_cast<double>(mNumActiveSpots - mCentralActiveSpotTiles.size()) * ConfigManager::getSingleton().getConfigDouble(TrainHallBonusWallActiveSpotParam);
+    double expReceived = creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getConfigDouble(TrainHallXpPerAttackParam);
     expReceived *= coef;
 
     creature.receiveExp(expReceived);
-    creature.jobDone(ConfigManager::getSingleton().getRoomConfigDouble("TrainHallWakefulnessPerAttack"));
-    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("TrainHallCooldownHitMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("TrainHallCooldownHitMax")));
+    creature.jobDone(ConfigManager::getSingleton().getConfigDouble(TrainHallWakefulnessPerAttackParam));
+    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getConfigUInt32(TrainHallCooldownHitMinParam),
+        ConfigManager::getSingleton().getConfigUInt32(TrainHallCooldownHitMaxParam)));
 
     return false;
 }
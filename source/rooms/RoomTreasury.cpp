@@ -41,6 +41,7 @@
 const std::string RoomTreasuryName = "Treasury";
 const std::string RoomTreasuryNameDisplay = "Treasury room";
 const RoomType RoomTreasury::mRoomType = RoomType::treasury;
+const ConfigParam TreasuryCostPerTileParam(ConfigParamCtg::room, "TreasuryCostPerTile");
 
 namespace
 {
@@ -56,7 +57,7 @@ class RoomTreasuryFactory : public RoomFactory
     { return RoomTreasuryNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("TreasuryCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(TreasuryCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -163,15 +164,13 @@ class RoomTreasuryFactory : public RoomFactory
                 }
             }
 
-            for(const std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
+            for(std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
             {
-                uint32_t nbTiles = p.second.size();
                 ServerNotification serverNotification(
                     ServerNotificationType::refreshTiles, p.first->getPlayer());
-                serverNotification.mPacket << nbTiles;
+                gameMap->tilesToPacket(serverNotification.mPacket, p.second);
                 for(Tile* tile : p.second)
                 {
-                    gameMap->tileToPacket(serverNotification.mPacket, tile);
                     p.first->updateTileStateForSeat(tile, false);
                     tile->exportToPacketForUpdate(serverNotification.mPacket, p.first);
                 }
@@ -260,6 +259,32 @@ void RoomTreasury::doUpkeep()
     }
 }
 
+void RoomTreasury::addToGameMap()
+{
+    Room::addToGameMap();
+    getGameMap()->notifyTreasuryGoldChanged(getSeat(), getTotalGoldStored(), getTotalGoldStorage());
+}
+
+void RoomTreasury::removeFromGameMap()
+{
+    Room::removeFromGameMap();
+    getGameMap()->notifyTreasuryGoldChanged(getSeat(), -getTotalGoldStored(), -getTotalGoldStorage());
+}
+
+void RoomTreasury::absorbRoom(Room* r)
+{
+    Room::absorbRoom(r);
+
+    // The gold has been copied with the tiles data. We remove it from the absorbed room so that it
+    // is not counted twice. As both rooms belong to the same seat, its gold does not change
+    RoomTreasury* treasury = static_cast<RoomTreasury*>(r);
+    for (std::pair<Tile* const, TileData*>& p : treasury->mTileData)
+    {
+        RoomTreasuryTileData* roomTreasuryTileData = static_cast<RoomTreasuryTileData*>(p.second);
+        roomTreasuryTileData->mGoldInTile = 0;
+    }
+}
+
 bool RoomTreasury::removeCoveredTile(Tile* t)
 {
     // if the mesh has gold, we erase the mesh
@@ -268,9 +293,11 @@ bool RoomTreasury::removeCoveredTile(Tile* t)
     if(!roomTreasuryTileData->mMeshOfTile.empty())
         removeBuildingObject(t);
 
+    int goldReleased = 0;
     if(roomTreasuryTileData->mGoldInTile > 0)
     {
         int value = roomTreasuryTileData->mGoldInTile;
+        goldReleased = value;
         if(value > 0)
         {
             OD_LOG_INF("Room " + getName()
@@ -287,7 +314,11 @@ bool RoomTreasury::removeCoveredTile(Tile* t)
 
     roomTreasuryTileData->mMeshOfTile.clear();
     roomTreasuryTileData->mGoldInTile = 0;
-    return Room::removeCoveredTile(t);
+    if(!Room::removeCoveredTile(t))
+        return false;
+
+    getGameMap()->notifyTreasuryGoldChanged(getSeat(), -goldReleased, -maxGoldinTile);
+    return true;
 }
 
 int RoomTreasury::getTotalGoldStorage() const
@@ -344,6 +375,7 @@ int RoomTreasury::depositGold(int gold, Tile *tile)
         return wasDeposited;
 
     mGoldChanged = true;
+    getGameMap()->notifyTreasuryGoldChanged(getSeat(), wasDeposited, 0);
 
     // Tells the client to play a deposit gold sound. For now, we only send it to the players
     // with vision on tile
@@ -377,6 +409,7 @@ int RoomTreasury::withdrawGold(int gold)
         }
     }
 
+    getGameMap()->notifyTreasuryGoldChanged(getSeat(), -withdrawlAmount, 0);
     return withdrawlAmount;
 }
 
@@ -55,6 +55,9 @@ public:
     { return mRoomType; }
 
     // Functions overriding virtual functions in the Room base class.
+    void addToGameMap() override;
+    void removeFromGameMap() override;
+    void absorbRoom(Room* r) override;
     bool removeCoveredTile(Tile* t) override;
 
     // Functions specific to this class.
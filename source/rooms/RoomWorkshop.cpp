@@ -38,6 +38,11 @@
 const std::string RoomWorkshopName = "Workshop";
 const std::string RoomWorkshopNameDisplay = "Workshop room";
 const RoomType RoomWorkshop::mRoomType = RoomType::workshop;
+const ConfigParam WorkshopCostPerTileParam(ConfigParamCtg::room, "WorkshopCostPerTile");
+const ConfigParam WorkshopPointsPerWorkParam(ConfigParamCtg::room, "WorkshopPointsPerWork");
+const ConfigParam WorkshopWakefulnessPerWorkParam(ConfigParamCtg::room, "WorkshopWakefulnessPerWork");
+const ConfigParam WorkshopCooldownWorkMinParam(ConfigParamCtg::room, "WorkshopCooldownWorkMin");
+const ConfigParam WorkshopCooldownWorkMaxParam(ConfigParamCtg::room, "WorkshopCooldownWorkMax");
 
 namespace
 {
@@ -53,7 +58,7 @@ class RoomWorkshopFactory : public RoomFactory
     { return RoomWorkshopNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getRoomConfigInt32("WorkshopCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(WorkshopCostPerTileParam); }
 
     void checkBuildRoom(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const override
     {
@@ -471,10 +476,10 @@ bool RoomWorkshop::useRoom(Creature& creature, bool forced)
     OD_ASSERT_TRUE_MSG(creatureRoomAffinity.getRoomType() == getType(), "name=" + getName() + ", creature=" + creature.getName()
         + ", creatureRoomAffinityType=" + Helper::toString(static_cast<int>(creatureRoomAffinity.getRoomType())));
 
-    mPoints += static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getRoomConfigDouble("WorkshopPointsPerWork"));
-    creature.jobDone(ConfigManager::getSingleton().getRoomConfigDouble("WorkshopWakefulnessPerWork"));
-    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getRoomConfigUInt32("WorkshopCooldownWorkMin"),
-        ConfigManager::getSingleton().getRoomConfigUInt32("WorkshopCooldownWorkMax")));
+    mPoints += static_cast<int32_t>(creatureRoomAffinity.getEfficiency() * ConfigManager::getSingleton().getConfigDouble(WorkshopPointsPerWorkParam));
+    creature.jobDone(ConfigManager::getSingleton().getConfigDouble(WorkshopWakefulnessPerWorkParam));
+    creature.setJobCooldown(Random::Uint(ConfigManager::getSingleton().getConfigUInt32(WorkshopCooldownWorkMinParam),
+        ConfigManager::getSingleton().getConfigUInt32(WorkshopCooldownWorkMaxParam)));
 
     return false;
 }
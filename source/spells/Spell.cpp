@@ -38,7 +38,8 @@
 Spell::Spell(GameMap* gameMap, const std::string& baseName, const std::string& meshName, Ogre::Real rotationAngle,
         int32_t nbTurns) :
     RenderedMovableEntity(gameMap, baseName, meshName, rotationAngle, false, 1.0f),
-        mNbTurns(nbTurns)
+        mNbTurns(nbTurns),
+        mIsVisionGiven(false)
 {
 }
 
@@ -47,6 +48,26 @@ GameEntityType Spell::getObjectType() const
     return GameEntityType::spell;
 }
 
+void Spell::updateVision()
+{
+    if(mIsVisionGiven)
+        return;
+
+    mIsVisionGiven = true;
+    computeVisibleTiles(mTilesVisionGiven);
+    for(Tile* tile : mTilesVisionGiven)
+        tile->addVision(getSeat());
+}
+
+void Spell::clearVision()
+{
+    for(Tile* tile : mTilesVisionGiven)
+        tile->removeVision(getSeat());
+
+    mTilesVisionGiven.clear();
+    mIsVisionGiven = false;
+}
+
 void Spell::doUpkeep()
 {
     if(mNbTurns < 0)
@@ -80,6 +101,7 @@ void Spell::removeFromGameMap()
     removeEntityFromPositionTile();
     getGameMap()->removeSpell(this);
     getGameMap()->removeAnimatedObject(this);
+    clearVision();
     getGameMap()->removeClientUpkeepEntity(this);
 
     if(!getIsOnServerMap())
@@ -193,7 +215,7 @@ void Spell::fireSpellSound(Tile& tile, const std::string& soundFamily)
         if(!seat->getPlayer()->getIsHuman())
             continue;
 
-        ServerNotification *serverNotification = new ServerNotification(
+        ServerNotification *serverNotification = ServerNotification::create(
             ServerNotificationType::playSpatialSound, seat->getPlayer());
         serverNotification->mPacket << sound << tile.getX() << tile.getY();
         ODServer::getSingleton().queueServerNotification(serverNotification);
@@ -55,9 +55,12 @@ public:
 
     virtual void doUpkeep() override;
 
-    //! \brief Computes the visible tiles and tags them to know which are visible
-    virtual void computeVisibleTiles()
-    {}
+    //! \brief Gives vision on the tiles returned by computeVisibleTiles. Spells do not move so the
+    //! tiles are only computed once
+    void updateVision();
+
+    //! \brief Removes the vision given by updateVision
+    void clearVision();
 
     static void fireSpellSound(Tile& tile, const std::string& soundFamily);
 
@@ -72,10 +75,18 @@ protected:
 
     static std::string formatCastSpell(SpellType type, uint32_t price);
 
+    //! \brief Fills the given vector with the tiles this spell gives vision on (if any)
+    virtual void computeVisibleTiles(std::vector<Tile*>& tiles)
+    {}
+
 private:
     //! \brief Number of turns the spell should be displayed before automatic deletion.
     //! If < 0, the Spell will not be removed automatically
     int32_t mNbTurns;
+
+    //! \brief True once updateVision has given vision on mTilesVisionGiven
+    bool mIsVisionGiven;
+    std::vector<Tile*> mTilesVisionGiven;
 };
 
 #endif // SPELL_H
@@ -32,8 +32,10 @@
 
 const std::string SpellCallToWarName = "callToWar";
 const std::string SpellCallToWarNameDisplay = "Call to war";
-const std::string SpellCallToWarCooldownKey = "CallToWarCooldown";
+const ConfigParam SpellCallToWarCooldownParam(ConfigParamCtg::spell, "CallToWarCooldown");
 const SpellType SpellCallToWar::mSpellType = SpellType::callToWar;
+const ConfigParam CallToWarNbTurnsMaxParam(ConfigParamCtg::spell, "CallToWarNbTurnsMax");
+const ConfigParam CallToWarPriceParam(ConfigParamCtg::spell, "CallToWarPrice");
 
 namespace
 {
@@ -45,8 +47,8 @@ class SpellCallToWarFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellCallToWarName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellCallToWarCooldownKey; }
+    const ConfigParam& getCooldownParam() const override
+    { return SpellCallToWarCooldownParam; }
 
     const std::string& getNameReadable() const override
     { return SpellCallToWarNameDisplay; }
@@ -70,7 +72,7 @@ static SpellRegister reg(new SpellCallToWarFactory);
 
 SpellCallToWar::SpellCallToWar(GameMap* gameMap) :
     Spell(gameMap, SpellManager::getSpellNameFromSpellType(SpellType::callToWar), "WarBanner", 0.0,
-        ConfigManager::getSingleton().getSpellConfigInt32("CallToWarNbTurnsMax"))
+        ConfigManager::getSingleton().getConfigInt32(CallToWarNbTurnsMaxParam))
 {
     mPrevAnimationState = "Loop";
     mPrevAnimationStateLoop = true;
@@ -110,7 +112,7 @@ void SpellCallToWar::checkSpellCast(GameMap* gameMap, const InputManager& inputM
         return;
 
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
-    int32_t price = ConfigManager::getSingleton().getSpellConfigInt32("CallToWarPrice");
+    int32_t price = ConfigManager::getSingleton().getConfigInt32(CallToWarPriceParam);
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
         if(playerMana < price)
@@ -153,7 +155,7 @@ bool SpellCallToWar::castSpell(GameMap* gameMap, Player* player, ODPacket& packe
         return false;
 
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
-    int32_t manaCost = ConfigManager::getSingleton().getSpellConfigInt32("CallToWarPrice");
+    int32_t manaCost = ConfigManager::getSingleton().getConfigInt32(CallToWarPriceParam);
     if(playerMana < manaCost)
         return false;
 
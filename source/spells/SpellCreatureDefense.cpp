@@ -37,8 +37,11 @@
 
 const std::string SpellCreatureDefenseName = "creatureDefense";
 const std::string SpellCreatureDefenseNameDisplay = "Creature defense";
-const std::string SpellCreatureDefenseCooldownKey = "CreatureDefenseCooldown";
+const ConfigParam SpellCreatureDefenseCooldownParam(ConfigParamCtg::spell, "CreatureDefenseCooldown");
 const SpellType SpellCreatureDefense::mSpellType = SpellType::creatureDefense;
+const ConfigParam CreatureDefensePriceParam(ConfigParamCtg::spell, "CreatureDefensePrice");
+const ConfigParam CreatureDefenseDurationParam(ConfigParamCtg::spell, "CreatureDefenseDuration");
+const ConfigParam CreatureDefenseValueParam(ConfigParamCtg::spell, "CreatureDefenseValue");
 
 namespace
 {
@@ -50,8 +53,8 @@ class SpellCreatureDefenseFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellCreatureDefenseName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellCreatureDefenseCooldownKey; }
+    const ConfigParam& getCooldownParam() const override
+    { return SpellCreatureDefenseCooldownParam; }
 
     const std::string& getNameReadable() const override
     { return SpellCreatureDefenseNameDisplay; }
@@ -76,7 +79,7 @@ static SpellRegister reg(new SpellCreatureDefenseFactory);
 void SpellCreatureDefense::checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand)
 {
     Player* player = gameMap->getLocalPlayer();
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureDefensePrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getConfigInt32(CreatureDefensePriceParam);
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -194,13 +197,13 @@ bool SpellCreatureDefense::castSpell(GameMap* gameMap, Player* player, ODPacket&
         return false;
     }
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureDefensePrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getConfigInt32(CreatureDefensePriceParam);
 
     if(!player->getSeat()->takeMana(pricePerTarget))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureDefenseDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureDefenseValue");
+    uint32_t duration = ConfigManager::getSingleton().getConfigUInt32(CreatureDefenseDurationParam);
+    double value = ConfigManager::getSingleton().getConfigDouble(CreatureDefenseValueParam);
     CreatureEffectDefense* effect = new CreatureEffectDefense(duration, value, 0.0, 0.0, "SpellCreatureDefense");
     creature->addCreatureEffect(effect);
 
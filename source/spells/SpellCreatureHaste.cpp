@@ -36,8 +36,11 @@
 
 const std::string SpellCreatureHasteName = "creatureHaste";
 const std::string SpellCreatureHasteNameDisplay = "Creature haste";
-const std::string SpellCreatureHasteCooldownKey = "CreatureHasteCooldown";
+const ConfigParam SpellCreatureHasteCooldownParam(ConfigParamCtg::spell, "CreatureHasteCooldown");
 const SpellType SpellCreatureHaste::mSpellType = SpellType::creatureHaste;
+const ConfigParam CreatureHastePriceParam(ConfigParamCtg::spell, "CreatureHastePrice");
+const ConfigParam CreatureHasteDurationParam(ConfigParamCtg::spell, "CreatureHasteDuration");
+const ConfigParam CreatureHasteValueParam(ConfigParamCtg::spell, "CreatureHasteValue");
 
 namespace
 {
@@ -49,8 +52,8 @@ class SpellCreatureHasteFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellCreatureHasteName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellCreatureHasteCooldownKey; }
+    const ConfigParam& getCooldownParam() const override
+    { return SpellCreatureHasteCooldownParam; }
 
     const std::string& getNameReadable() const override
     { return SpellCreatureHasteNameDisplay; }
@@ -75,7 +78,7 @@ static SpellRegister reg(new SpellCreatureHasteFactory);
 void SpellCreatureHaste::checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand)
 {
     Player* player = gameMap->getLocalPlayer();
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureHastePrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getConfigInt32(CreatureHastePriceParam);
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -193,13 +196,13 @@ bool SpellCreatureHaste::castSpell(GameMap* gameMap, Player* player, ODPacket& p
         return false;
     }
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureHastePrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getConfigInt32(CreatureHastePriceParam);
 
     if(!player->getSeat()->takeMana(pricePerTarget))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureHasteDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureHasteValue");
+    uint32_t duration = ConfigManager::getSingleton().getConfigUInt32(CreatureHasteDurationParam);
+    double value = ConfigManager::getSingleton().getConfigDouble(CreatureHasteValueParam);
     CreatureEffectSpeedChange* effect = new CreatureEffectSpeedChange(duration, value, "SpellCreatureHaste");
     creature->addCreatureEffect(effect);
 
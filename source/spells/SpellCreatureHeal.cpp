@@ -36,8 +36,11 @@
 
 const std::string SpellCreatureHealName = "creatureHeal";
 const std::string SpellCreatureHealNameDisplay = "Creature heal";
-const std::string SpellCreatureHealCooldownKey = "CreatureHealCooldown";
+const ConfigParam SpellCreatureHealCooldownParam(ConfigParamCtg::spell, "CreatureHealCooldown");
 const SpellType SpellCreatureHeal::mSpellType = SpellType::creatureHeal;
+const ConfigParam CreatureHealPriceParam(ConfigParamCtg::spell, "CreatureHealPrice");
+const ConfigParam CreatureHealDurationParam(ConfigParamCtg::spell, "CreatureHealDuration");
+const ConfigParam CreatureHealValueParam(ConfigParamCtg::spell, "CreatureHealValue");
 
 namespace
 {
@@ -49,8 +52,8 @@ class SpellCreatureHealFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellCreatureHealName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellCreatureHealCooldownKey; }
+    const ConfigParam& getCooldownParam() const override
+    { return SpellCreatureHealCooldownParam; }
 
     const std::string& getNameReadable() const override
     { return SpellCreatureHealNameDisplay; }
@@ -76,7 +79,7 @@ void SpellCreatureHeal::checkSpellCast(GameMap* gameMap, const InputManager& inp
 {
     Player* player = gameMap->getLocalPlayer();
     int32_t priceTotal = 0;
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureHealPrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getConfigInt32(CreatureHealPriceParam);
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -233,7 +236,7 @@ bool SpellCreatureHeal::castSpell(GameMap* gameMap, Player* player, ODPacket& pa
     if(creatures.empty())
         return false;
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureHealPrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getConfigInt32(CreatureHealPriceParam);
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     uint32_t nbTargets = std::min(static_cast<uint32_t>(playerMana / pricePerTarget), static_cast<uint32_t>(creatures.size()));
     int32_t priceTotal = nbTargets * pricePerTarget;
@@ -244,8 +247,8 @@ bool SpellCreatureHeal::castSpell(GameMap* gameMap, Player* player, ODPacket& pa
     if(!player->getSeat()->takeMana(priceTotal))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureHealDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureHealValue");
+    uint32_t duration = ConfigManager::getSingleton().getConfigUInt32(CreatureHealDurationParam);
+    double value = ConfigManager::getSingleton().getConfigDouble(CreatureHealValueParam);
     std::vector<Tile*> affectedTiles;
     for(Creature* creature : creatures)
     {
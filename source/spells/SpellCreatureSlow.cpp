@@ -36,8 +36,11 @@
 
 const std::string SpellCreatureSlowName = "creatureSlow";
 const std::string SpellCreatureSlowNameDisplay = "Creature Slow";
-const std::string SpellCreatureSlowCooldownKey = "CreatureSlowCooldown";
+const ConfigParam SpellCreatureSlowCooldownParam(ConfigParamCtg::spell, "CreatureSlowCooldown");
 const SpellType SpellCreatureSlow::mSpellType = SpellType::creatureSlow;
+const ConfigParam CreatureSlowPriceParam(ConfigParamCtg::spell, "CreatureSlowPrice");
+const ConfigParam CreatureSlowDurationParam(ConfigParamCtg::spell, "CreatureSlowDuration");
+const ConfigParam CreatureSlowValueParam(ConfigParamCtg::spell, "CreatureSlowValue");
 
 namespace
 {
@@ -49,8 +52,8 @@ class SpellCreatureSlowFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellCreatureSlowName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellCreatureSlowCooldownKey; }
+    const ConfigParam& getCooldownParam() const override
+    { return SpellCreatureSlowCooldownParam; }
 
     const std::string& getNameReadable() const override
     { return SpellCreatureSlowNameDisplay; }
@@ -75,7 +78,7 @@ static SpellRegister reg(new SpellCreatureSlowFactory);
 void SpellCreatureSlow::checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand)
 {
     Player* player = gameMap->getLocalPlayer();
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureSlowPrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getConfigInt32(CreatureSlowPriceParam);
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -193,13 +196,13 @@ bool SpellCreatureSlow::castSpell(GameMap* gameMap, Player* player, ODPacket& pa
         return false;
     }
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureSlowPrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getConfigInt32(CreatureSlowPriceParam);
 
     if(!player->getSeat()->takeMana(pricePerTarget))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureSlowDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureSlowValue");
+    uint32_t duration = ConfigManager::getSingleton().getConfigUInt32(CreatureSlowDurationParam);
+    double value = ConfigManager::getSingleton().getConfigDouble(CreatureSlowValueParam);
     CreatureEffectSpeedChange* effect = new CreatureEffectSpeedChange(duration, value, "SpellCreatureSlow");
     creature->addCreatureEffect(effect);
 
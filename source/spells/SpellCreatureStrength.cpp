@@ -36,8 +36,11 @@
 
 const std::string SpellCreatureStrengthName = "creatureStrength";
 const std::string SpellCreatureStrengthNameDisplay = "Creature Strength";
-const std::string SpellCreatureStrengthCooldownKey = "CreatureStrengthCooldown";
+const ConfigParam SpellCreatureStrengthCooldownParam(ConfigParamCtg::spell, "CreatureStrengthCooldown");
 const SpellType SpellCreatureStrength::mSpellType = SpellType::creatureStrength;
+const ConfigParam CreatureStrengthPriceParam(ConfigParamCtg::spell, "CreatureStrengthPrice");
+const ConfigParam CreatureStrengthDurationParam(ConfigParamCtg::spell, "CreatureStrengthDuration");
+const ConfigParam CreatureStrengthValueParam(ConfigParamCtg::spell, "CreatureStrengthValue");
 
 namespace
 {
@@ -49,8 +52,8 @@ class SpellCreatureStrengthFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellCreatureStrengthName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellCreatureStrengthCooldownKey; }
+    const ConfigParam& getCooldownParam() const override
+    { return SpellCreatureStrengthCooldownParam; }
 
     const std::string& getNameReadable() const override
     { return SpellCreatureStrengthNameDisplay; }
@@ -75,7 +78,7 @@ static SpellRegister reg(new SpellCreatureStrengthFactory);
 void SpellCreatureStrength::checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand)
 {
     Player* player = gameMap->getLocalPlayer();
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureStrengthPrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getConfigInt32(CreatureStrengthPriceParam);
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -193,13 +196,13 @@ bool SpellCreatureStrength::castSpell(GameMap* gameMap, Player* player, ODPacket
         return false;
     }
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureStrengthPrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getConfigInt32(CreatureStrengthPriceParam);
 
     if(!player->getSeat()->takeMana(pricePerTarget))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureStrengthDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureStrengthValue");
+    uint32_t duration = ConfigManager::getSingleton().getConfigUInt32(CreatureStrengthDurationParam);
+    double value = ConfigManager::getSingleton().getConfigDouble(CreatureStrengthValueParam);
     CreatureEffectStrengthChange* effect = new CreatureEffectStrengthChange(duration, value, "SpellCreatureStrength");
     creature->addCreatureEffect(effect);
 
@@ -36,8 +36,11 @@
 
 const std::string SpellCreatureWeakName = "creatureWeak";
 const std::string SpellCreatureWeakNameDisplay = "Creature Weak";
-const std::string SpellCreatureWeakCooldownKey = "CreatureWeakCooldown";
+const ConfigParam SpellCreatureWeakCooldownParam(ConfigParamCtg::spell, "CreatureWeakCooldown");
 const SpellType SpellCreatureWeak::mSpellType = SpellType::creatureWeak;
+const ConfigParam CreatureWeakPriceParam(ConfigParamCtg::spell, "CreatureWeakPrice");
+const ConfigParam CreatureWeakDurationParam(ConfigParamCtg::spell, "CreatureWeakDuration");
+const ConfigParam CreatureWeakValueParam(ConfigParamCtg::spell, "CreatureWeakValue");
 
 namespace
 {
@@ -49,8 +52,8 @@ class SpellCreatureWeakFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellCreatureWeakName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellCreatureWeakCooldownKey; }
+    const ConfigParam& getCooldownParam() const override
+    { return SpellCreatureWeakCooldownParam; }
 
     const std::string& getNameReadable() const override
     { return SpellCreatureWeakNameDisplay; }
@@ -75,7 +78,7 @@ static SpellRegister reg(new SpellCreatureWeakFactory);
 void SpellCreatureWeak::checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand)
 {
     Player* player = gameMap->getLocalPlayer();
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureWeakPrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getConfigInt32(CreatureWeakPriceParam);
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
@@ -193,13 +196,13 @@ bool SpellCreatureWeak::castSpell(GameMap* gameMap, Player* player, ODPacket& pa
         return false;
     }
 
-    int32_t pricePerTarget = ConfigManager::getSingleton().getSpellConfigInt32("CreatureWeakPrice");
+    int32_t pricePerTarget = ConfigManager::getSingleton().getConfigInt32(CreatureWeakPriceParam);
 
     if(!player->getSeat()->takeMana(pricePerTarget))
         return false;
 
-    uint32_t duration = ConfigManager::getSingleton().getSpellConfigUInt32("CreatureWeakDuration");
-    double value = ConfigManager::getSingleton().getSpellConfigDouble("CreatureWeakValue");
+    uint32_t duration = ConfigManager::getSingleton().getConfigUInt32(CreatureWeakDurationParam);
+    double value = ConfigManager::getSingleton().getConfigDouble(CreatureWeakValueParam);
     CreatureEffectStrengthChange* effect = new CreatureEffectStrengthChange(duration, value, "SpellCreatureWeak");
     creature->addCreatureEffect(effect);
 
@@ -32,8 +32,11 @@
 
 const std::string SpellEyeEvilName = "eyeEvil";
 const std::string SpellEyeEvilNameDisplay = "Eye of Evil";
-const std::string SpellEyeEvilCooldownKey = "EyeEvilCooldown";
+const ConfigParam SpellEyeEvilCooldownParam(ConfigParamCtg::spell, "EyeEvilCooldown");
 const SpellType SpellEyeEvil::mSpellType = SpellType::eyeEvil;
+const ConfigParam EyeEvilNbTurnsParam(ConfigParamCtg::spell, "EyeEvilNbTurns");
+const ConfigParam EyeEvilRadiusTilesParam(ConfigParamCtg::spell, "EyeEvilRadiusTiles");
+const ConfigParam EyeEvilPriceParam(ConfigParamCtg::spell, "EyeEvilPrice");
 
 namespace
 {
@@ -45,8 +48,8 @@ class SpellEyeEvilFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellEyeEvilName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellEyeEvilCooldownKey; }
+    const ConfigParam& getCooldownParam() const override
+    { return SpellEyeEvilCooldownParam; }
 
     const std::string& getNameReadable() const override
     { return SpellEyeEvilNameDisplay; }
@@ -70,7 +73,7 @@ static SpellRegister reg(new SpellEyeEvilFactory);
 
 SpellEyeEvil::SpellEyeEvil(GameMap* gameMap) :
     Spell(gameMap, SpellManager::getSpellNameFromSpellType(getSpellType()), "FlyingSkull", 0.0,
-        ConfigManager::getSingleton().getSpellConfigInt32("EyeEvilNbTurns"))
+        ConfigManager::getSingleton().getConfigInt32(EyeEvilNbTurnsParam))
 {
     mPrevAnimationState = "Triggered";
     mPrevAnimationStateLoop = true;
@@ -80,9 +83,9 @@ SpellEyeEvil::~SpellEyeEvil()
 {
 }
 
-void SpellEyeEvil::computeVisibleTiles()
+void SpellEyeEvil::computeVisibleTiles(std::vector<Tile*>& tiles)
 {
-    uint32_t radius = ConfigManager::getSingleton().getSpellConfigUInt32("EyeEvilRadiusTiles");
+    uint32_t radius = ConfigManager::getSingleton().getConfigUInt32(EyeEvilRadiusTilesParam);
     Tile* posTile = getPositionTile();
     if(posTile == nullptr)
     {
@@ -90,9 +93,7 @@ void SpellEyeEvil::computeVisibleTiles()
         return;
     }
 
-    std::vector<Tile*> tiles = getGameMap()->circularRegion(posTile->getX(), posTile->getY(), radius);
-    for(Tile* tile : tiles)
-        tile->notifyVision(getSeat());
+    tiles = getGameMap()->circularRegion(posTile->getX(), posTile->getY(), radius);
 }
 
 void SpellEyeEvil::checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand)
@@ -104,7 +105,7 @@ void SpellEyeEvil::checkSpellCast(GameMap* gameMap, const InputManager& inputMan
         return;
 
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
-    int32_t price = ConfigManager::getSingleton().getSpellConfigInt32("EyeEvilPrice");
+    int32_t price = ConfigManager::getSingleton().getConfigInt32(EyeEvilPriceParam);
     if(inputManager.mCommandState == InputCommandState::infoOnly)
     {
         if(playerMana < price)
@@ -147,7 +148,7 @@ bool SpellEyeEvil::castSpell(GameMap* gameMap, Player* player, ODPacket& packet)
         return false;
 
     int32_t playerMana = static_cast<int32_t>(player->getSeat()->getMana());
-    int32_t manaCost = ConfigManager::getSingleton().getSpellConfigInt32("EyeEvilPrice");
+    int32_t manaCost = ConfigManager::getSingleton().getConfigInt32(EyeEvilPriceParam);
     if(playerMana < manaCost)
         return false;
 
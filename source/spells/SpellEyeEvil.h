@@ -34,8 +34,6 @@ public:
     SpellType getSpellType() const override
     { return SpellType::eyeEvil; }
 
-    void computeVisibleTiles() override;
-
     static void checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand);
     static bool castSpell(GameMap* gameMap, Player* player, ODPacket& packet);
 
@@ -43,6 +41,9 @@ public:
     static Spell* getSpellFromPacket(GameMap* gameMap, ODPacket &is);
 
     static const SpellType mSpellType;
+
+protected:
+    void computeVisibleTiles(std::vector<Tile*>& tiles) override;
 };
 
 #endif // SPELLEYEEVIL_H
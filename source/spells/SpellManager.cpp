@@ -255,5 +255,5 @@ uint32_t SpellManager::getSpellCooldown(SpellType type)
     }
 
     const SpellFactory& factory = *factories[index];
-    return ConfigManager::getSingleton().getSpellConfigUInt32(factory.getCooldownKey());
+    return ConfigManager::getSingleton().getConfigUInt32(factory.getCooldownParam());
 }
@@ -23,6 +23,7 @@
 #include <cstdint>
 
 class ClientNotification;
+class ConfigParam;
 class GameMap;
 class InputCommand;
 class InputManager;
@@ -43,7 +44,7 @@ public:
     virtual SpellType getSpellType() const = 0;
     virtual const std::string& getName() const = 0;
     virtual const std::string& getNameReadable() const = 0;
-    virtual const std::string& getCooldownKey() const = 0;
+    virtual const ConfigParam& getCooldownParam() const = 0;
 
     virtual void checkSpellCast(GameMap* gameMap, const InputManager& inputManager, InputCommand& inputCommand) const = 0;
     virtual bool castSpell(GameMap* gameMap, Player* player, ODPacket& packet) const = 0;
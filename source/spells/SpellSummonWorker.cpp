@@ -35,8 +35,10 @@
 
 const std::string SpellSummonWorkerName = "summonWorker";
 const std::string SpellSummonWorkerNameDisplay = "Summon worker";
-const std::string SpellSummonWorkerCooldownKey = "SummonWorkerCooldown";
+const ConfigParam SpellSummonWorkerCooldownParam(ConfigParamCtg::spell, "SummonWorkerCooldown");
 const SpellType SpellSummonWorker::mSpellType = SpellType::summonWorker;
+const ConfigParam SummonWorkerNbFreeParam(ConfigParamCtg::spell, "SummonWorkerNbFree");
+const ConfigParam SummonWorkerBasePriceParam(ConfigParamCtg::spell, "SummonWorkerBasePrice");
 
 namespace
 {
@@ -48,8 +50,8 @@ class SpellSummonWorkerFactory : public SpellFactory
     const std::string& getName() const override
     { return SpellSummonWorkerName; }
 
-    const std::string& getCooldownKey() const override
-    { return SpellSummonWorkerCooldownKey; }
+    const ConfigParam& getCooldownParam() const override
+    { return SpellSummonWorkerCooldownParam; }
 
     const std::string& getNameReadable() const override
     { return SpellSummonWorkerNameDisplay; }
@@ -97,9 +99,9 @@ void SpellSummonWorker::checkSpellCast(GameMap* gameMap, const InputManager& inp
     gameMap->playerSelects(targets, inputManager.mXPos, inputManager.mYPos, inputManager.mLStartDragX,
         inputManager.mLStartDragY, SelectionTileAllowed::groundClaimedAllied, SelectionEntityWanted::tiles, player);
 
-    int32_t nbFreeWorkers = ConfigManager::getSingleton().getSpellConfigInt32("SummonWorkerNbFree");
+    int32_t nbFreeWorkers = ConfigManager::getSingleton().getConfigInt32(SummonWorkerNbFreeParam);
     int32_t nbWorkers = player->getSeat()->getNumCreaturesWorkers();
-    int32_t pricePerWorker = ConfigManager::getSingleton().getSpellConfigInt32("SummonWorkerBasePrice");
+    int32_t pricePerWorker = ConfigManager::getSingleton().getConfigInt32(SummonWorkerBasePriceParam);
     if(nbWorkers > nbFreeWorkers)
         pricePerWorker *= std::pow(2, nbWorkers - nbFreeWorkers);
 
@@ -187,9 +189,9 @@ bool SpellSummonWorker::summonWorkersOnTiles(GameMap* gameMap, Player* player, c
         return false;
     }
 
-    int32_t nbFreeWorkers = ConfigManager::getSingleton().getSpellConfigInt32("SummonWorkerNbFree");
+    int32_t nbFreeWorkers = ConfigManager::getSingleton().getConfigInt32(SummonWorkerNbFreeParam);
     int32_t nbWorkers = player->getSeat()->getNumCreaturesWorkers();
-    int32_t pricePerWorker = ConfigManager::getSingleton().getSpellConfigInt32("SummonWorkerBasePrice");
+    int32_t pricePerWorker = ConfigManager::getSingleton().getConfigInt32(SummonWorkerBasePriceParam);
     if(nbWorkers > nbFreeWorkers)
         pricePerWorker *= std::pow(2, nbWorkers - nbFreeWorkers);
 
@@ -238,11 +240,11 @@ bool SpellSummonWorker::summonWorkersOnTiles(GameMap* gameMap, Player* player, c
 int32_t SpellSummonWorker::getNextWorkerPriceForPlayer(GameMap* gameMap, Player* player)
 {
     int32_t nbWorkers = player->getSeat()->getNumCreaturesWorkers();
-    int32_t nbFreeWorkers = ConfigManager::getSingleton().getSpellConfigInt32("SummonWorkerNbFree");
+    int32_t nbFreeWorkers = ConfigManager::getSingleton().getConfigInt32(SummonWorkerNbFreeParam);
     if(nbWorkers < nbFreeWorkers)
         return 0;
 
-    int32_t price = ConfigManager::getSingleton().getSpellConfigInt32("SummonWorkerBasePrice");
+    int32_t price = ConfigManager::getSingleton().getConfigInt32(SummonWorkerBasePriceParam);
     price *= std::pow(2, nbWorkers - nbFreeWorkers);
 
     return price;
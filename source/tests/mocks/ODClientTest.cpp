@@ -17,6 +17,7 @@
 
 #include "ODClientTest.h"
 
+#include "entities/GameEntityType.h"
 #include "game/SeatData.h"
 #include "network/ClientNotification.h"
 #include "network/ServerMode.h"
@@ -394,15 +395,31 @@ bool ODClientTest::processMessage(ServerNotificationType cmd, ODPacket& packetRe
             BOOST_CHECK(packetReceived >> mPlayers[mLocalPlayerIndex].mGoals);
             break;
         }
-        case ServerNotificationType::setObjectAnimationState:
+        case ServerNotificationType::addEntity:
         {
+            // We only read the creatures headers to know their names. Other entities
+            // send specific data before the common one
+            int32_t entityType;
+            BOOST_CHECK(packetReceived >> entityType);
+            if(entityType != static_cast<int32_t>(GameEntityType::creature))
+                break;
+
+            int seatId;
+            uint32_t entityId;
             std::string entityName;
+            BOOST_CHECK(packetReceived >> seatId >> entityId >> entityName);
+            mEntityNames[entityId] = entityName;
+            break;
+        }
+        case ServerNotificationType::setObjectAnimationState:
+        {
+            uint32_t entityId;
             std::string animState;
             bool loop;
             bool playIdleWhenAnimationEnds;
             bool shouldSetWalkDirection;
             Ogre::Vector3 walkDirection(0, 0, 0);
-            BOOST_CHECK(packetReceived >> entityName >> animState
+            BOOST_CHECK(packetReceived >> entityId >> animState
                 >> loop >> playIdleWhenAnimationEnds >> shouldSetWalkDirection);
 
             if(shouldSetWalkDirection)
@@ -410,18 +427,18 @@ bool ODClientTest::processMessage(ServerNotificationType cmd, ODPacket& packetRe
                 BOOST_CHECK(packetReceived >> walkDirection);
             }
 
-            animationPlayed(entityName, animState, loop, playIdleWhenAnimationEnds, shouldSetWalkDirection, walkDirection);
+            animationPlayed(getEntityName(entityId), animState, loop, playIdleWhenAnimationEnds, shouldSetWalkDirection, walkDirection);
             break;
         }
         case ServerNotificationType::animatedObjectSetWalkPath:
         {
-            std::string entityName;
+            uint32_t entityId;
             std::string walkAnim;
             std::string endAnim;
             bool loopEndAnim;
             bool playIdleWhenAnimationEnds;
             uint32_t nbDest;
-            BOOST_CHECK(packetReceived >> entityName >> walkAnim >> endAnim);
+            BOOST_CHECK(packetReceived >> entityId >> walkAnim >> endAnim);
             BOOST_CHECK(packetReceived >> loopEndAnim >> playIdleWhenAnimationEnds >> nbDest);
             std::vector<Ogre::Vector3> path;
             while(nbDest)
@@ -433,6 +450,7 @@ bool ODClientTest::processMessage(ServerNotificationType cmd, ODPacket& packetRe
             }
 
             //! We want to make sure animationPlayed is played for both animations (if required)
+            const std::string& entityName = getEntityName(entityId);
             if(!walkAnim.empty())
                 animationPlayed(entityName, walkAnim, true, false, false, Ogre::Vector3::ZERO);
             if(!endAnim.empty())
@@ -464,6 +482,16 @@ SeatData* ODClientTest::getLocalSeat() const
     return mPlayers[mLocalPlayerIndex].mSeat;
 }
 
+const std::string& ODClientTest::getEntityName(uint32_t entityId) const
+{
+    static const std::string EMPTY_STRING;
+    std::map<uint32_t, std::string>::const_iterator it = mEntityNames.find(entityId);
+    if(it == mEntityNames.end())
+        return EMPTY_STRING;
+
+    return it->second;
+}
+
 void ODClientTest::runFor(int32_t timeInMillis)
 {
     if(!isConnected())
@@ -21,6 +21,7 @@
 
 #include "network/ODSocketClient.h"
 
+#include <map>
 #include <string>
 
 class SeatData;
@@ -90,6 +91,12 @@ private:
     std::vector<PlayerInfo> mPlayers;
     std::vector<SeatData*> mSeats;
     uint32_t mLocalPlayerIndex;
+
+    //! \brief Names of the creatures received from the server. The server only sends the
+    //! name when an entity is created and then references it by id
+    std::map<uint32_t, std::string> mEntityNames;
+
+    const std::string& getEntityName(uint32_t entityId) const;
 };
 
 #endif // ODCLIENTTEST_H
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "entities/GameEntityType.h"
+#include "gamemap/EntityGrid.h"
+
+#define BOOST_TEST_MODULE EntityGrid
+#include "BoostTestTargetConfig.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+//! \brief The grid only stores pointers so the entities are represented by addresses in a buffer
+struct TestEntity
+{
+    GameEntity* mEntity;
+    int mX;
+    int mY;
+};
+
+//! \brief Returns the index in storage of the given entity
+static int getIndex(const GameEntity* entity, const std::vector<char>& storage)
+{
+    return static_cast<int>(reinterpret_cast<const char*>(entity) - storage.data());
+}
+
+static const int MAP_SIZE_X = 67;
+static const int MAP_SIZE_Y = 45;
+
+static std::vector<TestEntity> createEntities(EntityGrid& grid, std::vector<char>& storage)
+{
+    std::srand(42);
+    std::vector<TestEntity> entities;
+    for(uint32_t i = 0; i < storage.size(); ++i)
+    {
+        TestEntity entity;
+        entity.mEntity = reinterpret_cast<GameEntity*>(&storage[i]);
+        entity.mX = std::rand() % MAP_SIZE_X;
+        entity.mY = std::rand() % MAP_SIZE_Y;
+        grid.addEntity(*entity.mEntity, GameEntityType::creature, entity.mX, entity.mY);
+        entities.push_back(entity);
+    }
+    return entities;
+}
+
+BOOST_AUTO_TEST_CASE(test_EntityGridQueries)
+{
+    EntityGrid grid;
+    grid.setMapSize(MAP_SIZE_X, MAP_SIZE_Y);
+    std::vector<char> storage(500);
+    std::vector<TestEntity> entities = createEntities(grid, storage);
+    BOOST_CHECK_EQUAL(grid.getNbEntities(GameEntityType::creature), 500u);
+    BOOST_CHECK_EQUAL(grid.getNbEntities(GameEntityType::chickenEntity), 0u);
+
+    // We remove some entities
+    for(uint32_t i = 0; i < entities.size(); i += 3)
+        grid.removeEntity(*entities[i].mEntity, GameEntityType::creature, entities[i].mX, entities[i].mY);
+
+    std::vector<TestEntity> remaining;
+    for(uint32_t i = 0; i < entities.size(); ++i)
+    {
+        if((i % 3) != 0)
+            remaining.push_back(entities[i]);
+    }
+    BOOST_CHECK_EQUAL(grid.getNbEntities(GameEntityType::creature), remaining.size());
+
+    std::vector<GameEntity*> result;
+    grid.getEntitiesInRect(GameEntityType::chickenEntity, 0, 0, MAP_SIZE_X, MAP_SIZE_Y, result);
+    BOOST_CHECK(result.empty());
+
+    for(int x : {0, 5, 33, 66})
+    {
+        for(int y : {0, 17, 44})
+        {
+            for(int radius : {0, 3, 9, 20})
+            {
+                // Radius
+                std::vector<GameEntity*> expected;
+                for(const TestEntity& entity : remaining)
+                {
+                    int diffX = entity.mX - x;
+                    int diffY = entity.mY - y;
+                    if(diffX * diffX + diffY * diffY <= radius * radius)
+                        expected.push_back(entity.mEntity);
+                }
+                result.clear();
+                grid.getEntitiesInRadius(GameEntityType::creature, x, y, radius, result);
+                std::sort(expected.begin(), expected.end());
+                std::sort(result.begin(), result.end());
+                BOOST_REQUIRE(result == expected);
+
+                // Rectangle
+                expected.clear();
+                for(const TestEntity& entity : remaining)
+                {
+                    if((entity.mX >= x - radius) && (entity.mX <= x + radius) &&
+                       (entity.mY >= y) && (entity.mY <= y + radius))
+                    {
+                        expected.push_back(entity.mEntity);
+                    }
+                }
+                result.clear();
+                grid.getEntitiesInRect(GameEntityType::creature, x - radius, y, x + radius, y + radius, result);
+                std::sort(expected.begin(), expected.end());
+                std::sort(result.begin(), result.end());
+                BOOST_REQUIRE(result == expected);
+
+                // Nearest entities accepted by the filter (we skip every other entity)
+                std::vector<std::pair<int, GameEntity*>> sorted;
+                for(const TestEntity& entity : remaining)
+                {
+                    int diffX = entity.mX - x;
+                    int diffY = entity.mY - y;
+                    int dist = diffX * diffX + diffY * diffY;
+                    if(dist > radius * radius)
+                        continue;
+                    if((getIndex(entity.mEntity, storage) % 2) != 0)
+                        continue;
+
+                    sorted.push_back(std::make_pair(dist, entity.mEntity));
+                }
+                std::sort(sorted.begin(), sorted.end());
+                result.clear();
+                grid.getNearestEntities(GameEntityType::creature, x, y, radius, 5, [&storage](GameEntity& entity)
+                {
+                    return (getIndex(&entity, storage) % 2) == 0;
+                }, result);
+                BOOST_REQUIRE_EQUAL(result.size(), std::min<size_t>(5, sorted.size()));
+                for(uint32_t i = 0; i < result.size(); ++i)
+                {
+                    int diffX = 0;
+                    int diffY = 0;
+                    for(const TestEntity& entity : remaining)
+                    {
+                        if(entity.mEntity != result[i])
+                            continue;
+
+                        diffX = entity.mX - x;
+                        diffY = entity.mY - y;
+                    }
+                    // Entities at the same distance may come in any order
+                    BOOST_CHECK_EQUAL(diffX * diffX + diffY * diffY, sorted[i].first);
+                }
+            }
+        }
+    }
+}
@@ -18,8 +18,18 @@
 #define BOOST_TEST_MODULE ODPacket
 #include "BoostTestTargetConfig.h"
 
+#include "entities/CreatureNetworkState.h"
 #include "network/ODPacket.h"
 
+#include <SFML/Network.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
 BOOST_AUTO_TEST_CASE(test_ODPacket)
 {
     //Test input/output
@@ -54,3 +64,549 @@ BOOST_AUTO_TEST_CASE(test_ODPacket)
 
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_ODPacketEntityIdSize)
+{
+    // Entities are referenced by their id in the network messages. We compare the size of a typical
+    // animation message (entity, animation, loop, playIdleWhenAnimationEnds, shouldSetWalkDirection)
+    // when the entity is referenced by type and name and when it is referenced by id
+    const int32_t entityType = 1;
+    const std::string entityName("Creature_Goblin_123");
+    const uint32_t entityId = 123;
+    const std::string animation("Walk");
+
+    ODPacket packetName;
+    packetName << entityType << entityName << animation << true << false << false;
+    ODPacket packetId;
+    packetId << entityId << animation << true << false << false;
+
+    // The name is sent as its size followed by its characters
+    BOOST_CHECK_EQUAL(packetName.getDataSize() - packetId.getDataSize(),
+        sizeof(entityType) + sizeof(uint32_t) + entityName.size() - sizeof(entityId));
+    BOOST_CHECK(packetId.getDataSize() < packetName.getDataSize());
+
+    uint32_t outId = 0;
+    std::string outAnimation;
+    bool loop = false;
+    BOOST_CHECK(packetId >> outId >> outAnimation >> loop);
+    BOOST_CHECK_EQUAL(outId, entityId);
+    BOOST_CHECK(outAnimation == animation);
+    BOOST_CHECK(loop);
+}
+
+static void checkCreatureNetworkStateEqual(const CreatureNetworkState& state1, const CreatureNetworkState& state2)
+{
+    BOOST_CHECK_EQUAL(state1.mLevel, state2.mLevel);
+    BOOST_CHECK_EQUAL(state1.mSeatId, state2.mSeatId);
+    BOOST_CHECK_EQUAL(state1.mOverlayHealthValue, state2.mOverlayHealthValue);
+    BOOST_CHECK_EQUAL(state1.mOverlayMoodValue, state2.mOverlayMoodValue);
+    BOOST_CHECK_EQUAL(state1.mGroundSpeed, state2.mGroundSpeed);
+    BOOST_CHECK_EQUAL(state1.mWaterSpeed, state2.mWaterSpeed);
+    BOOST_CHECK_EQUAL(state1.mLavaSpeed, state2.mLavaSpeed);
+    BOOST_CHECK_EQUAL(state1.mSpeedModifier, state2.mSpeedModifier);
+    BOOST_CHECK_EQUAL(state1.mSeatPrisonId, state2.mSeatPrisonId);
+}
+
+BOOST_AUTO_TEST_CASE(test_ODPacketCreatureDelta)
+{
+    // Speeds are chosen so that they are not changed when sent as float
+    CreatureNetworkState serverState;
+    serverState.mLevel = 12;
+    serverState.mSeatId = 3;
+    serverState.mOverlayHealthValue = 2;
+    serverState.mOverlayMoodValue = 0x15;
+    serverState.mGroundSpeed = 0.75;
+    serverState.mWaterSpeed = 0.5;
+    serverState.mLavaSpeed = 0.0;
+    serverState.mSpeedModifier = 1.25;
+    serverState.mSeatPrisonId = -1;
+
+    // The client starts from a default state. The first update has no baseline and sends every field
+    CreatureNetworkState clientState;
+    ODPacket packetFull;
+    CreatureNetworkState::exportDeltaToPacket(packetFull, nullptr, serverState);
+    BOOST_CHECK(CreatureNetworkState::importDeltaFromPacket(packetFull, clientState));
+    checkCreatureNetworkStateEqual(serverState, clientState);
+
+    // Typical update during a fight: only the health overlay changes
+    CreatureNetworkState baseline = serverState;
+    serverState.mOverlayHealthValue = 3;
+    ODPacket packetDelta;
+    CreatureNetworkState::exportDeltaToPacket(packetDelta, &baseline, serverState);
+    BOOST_CHECK(CreatureNetworkState::importDeltaFromPacket(packetDelta, clientState));
+    checkCreatureNetworkStateEqual(serverState, clientState);
+
+    // Several fields changing at once (level up in prison)
+    baseline = serverState;
+    serverState.mLevel = 13;
+    serverState.mGroundSpeed = 0.875;
+    serverState.mSeatPrisonId = 1;
+    ODPacket packetLevelUp;
+    CreatureNetworkState::exportDeltaToPacket(packetLevelUp, &baseline, serverState);
+    BOOST_CHECK(CreatureNetworkState::importDeltaFromPacket(packetLevelUp, clientState));
+    checkCreatureNetworkStateEqual(serverState, clientState);
+
+    // Nothing changed: only the mask is sent
+    ODPacket packetEmpty;
+    CreatureNetworkState::exportDeltaToPacket(packetEmpty, &serverState, serverState);
+    BOOST_CHECK_EQUAL(packetEmpty.getDataSize(), sizeof(uint16_t));
+    BOOST_CHECK(CreatureNetworkState::importDeltaFromPacket(packetEmpty, clientState));
+    checkCreatureNetworkStateEqual(serverState, clientState);
+
+    // Size of the fields sent before delta compression
+    const std::size_t fullSize = sizeof(uint32_t) + sizeof(int32_t) + sizeof(uint32_t) + sizeof(uint32_t)
+        + 4 * sizeof(double) + sizeof(int32_t);
+    BOOST_CHECK(packetFull.getDataSize() < fullSize);
+    // The mask, the level and the health overlay on 8 bits, the seat ids and the mood as 32 bits integers
+    // and the speeds as floats
+    BOOST_CHECK_EQUAL(packetFull.getDataSize(), sizeof(uint16_t) + 2 * sizeof(uint8_t) + 3 * sizeof(int32_t)
+        + 4 * sizeof(float));
+    BOOST_CHECK_EQUAL(packetDelta.getDataSize(), sizeof(uint16_t) + sizeof(uint8_t));
+    BOOST_CHECK_EQUAL(packetLevelUp.getDataSize(), sizeof(uint16_t) + sizeof(uint8_t) + sizeof(float) + sizeof(int32_t));
+    BOOST_TEST_MESSAGE("Creature update: " << fullSize << " bytes before delta compression, "
+        << packetFull.getDataSize() << " bytes for a full update (" << fullSize - packetFull.getDataSize() << " saved), "
+        << packetDelta.getDataSize() << " bytes for an health change (" << fullSize - packetDelta.getDataSize() << " saved), "
+        << packetLevelUp.getDataSize() << " bytes for a level up (" << fullSize - packetLevelUp.getDataSize() << " saved)");
+}
+
+BOOST_AUTO_TEST_CASE(test_ODPacketAppendToBuffer)
+{
+    // Packets sent together to a client are concatenated. Each one is preceded by its size in network byte order
+    ODPacket packet1;
+    packet1 << static_cast<uint32_t>(42);
+    ODPacket packet2;
+    packet2 << std::string("turnStarted") << static_cast<int64_t>(1234);
+
+    std::vector<char> buffer;
+    packet1.appendToBuffer(buffer);
+    packet2.appendToBuffer(buffer);
+    BOOST_REQUIRE_EQUAL(buffer.size(), 2 * sizeof(uint32_t) + packet1.getDataSize() + packet2.getDataSize());
+
+    uint32_t size1 = (static_cast<uint32_t>(static_cast<uint8_t>(buffer[0])) << 24)
+        | (static_cast<uint32_t>(static_cast<uint8_t>(buffer[1])) << 16)
+        | (static_cast<uint32_t>(static_cast<uint8_t>(buffer[2])) << 8)
+        | static_cast<uint32_t>(static_cast<uint8_t>(buffer[3]));
+    BOOST_CHECK_EQUAL(size1, packet1.getDataSize());
+
+    std::size_t offset2 = sizeof(uint32_t) + size1;
+    uint32_t size2 = (static_cast<uint32_t>(static_cast<uint8_t>(buffer[offset2])) << 24)
+        | (static_cast<uint32_t>(static_cast<uint8_t>(buffer[offset2 + 1])) << 16)
+        | (static_cast<uint32_t>(static_cast<uint8_t>(buffer[offset2 + 2])) << 8)
+        | static_cast<uint32_t>(static_cast<uint8_t>(buffer[offset2 + 3]));
+    BOOST_CHECK_EQUAL(size2, packet2.getDataSize());
+}
+
+BOOST_AUTO_TEST_CASE(test_ODPacketSFMLCompatibility)
+{
+    // ODPacket should serialize data exactly like sf::Packet so that the replays and the
+    // clients using the previous version can still be read
+    ODPacket packet;
+    sf::Packet sfPacket;
+    const std::string str("Creature_Goblin_123");
+    const std::wstring wstr(L"Kobold");
+    packet << true << static_cast<int8_t>(-3) << static_cast<uint8_t>(200) << static_cast<int16_t>(-1234)
+        << static_cast<uint16_t>(60000) << static_cast<int32_t>(-123456) << static_cast<uint32_t>(3000000000u)
+        << 1.5f << -2.25 << str << "turnStarted" << wstr;
+    sfPacket << true << static_cast<sf::Int8>(-3) << static_cast<sf::Uint8>(200) << static_cast<sf::Int16>(-1234)
+        << static_cast<sf::Uint16>(60000) << static_cast<sf::Int32>(-123456) << static_cast<sf::Uint32>(3000000000u)
+        << 1.5f << -2.25 << str << "turnStarted" << wstr;
+
+    BOOST_REQUIRE_EQUAL(packet.getDataSize(), sfPacket.getDataSize());
+    BOOST_CHECK(std::memcmp(packet.getData(), sfPacket.getData(), packet.getDataSize()) == 0);
+
+    // 64 bits integers used to be sent as 2 int32 (high part first)
+    ODPacket packet64;
+    packet64 << static_cast<int64_t>(-5000000000LL);
+    sf::Packet sfPacket64;
+    sfPacket64 << static_cast<sf::Int32>(-2) << static_cast<sf::Int32>(-705032704);
+    BOOST_REQUIRE_EQUAL(packet64.getDataSize(), sfPacket64.getDataSize());
+    BOOST_CHECK(std::memcmp(packet64.getData(), sfPacket64.getData(), packet64.getDataSize()) == 0);
+
+    bool outBool = false;
+    int8_t outInt8 = 0;
+    uint8_t outUint8 = 0;
+    int16_t outInt16 = 0;
+    uint16_t outUint16 = 0;
+    int32_t outInt32 = 0;
+    uint32_t outUint32 = 0;
+    float outFloat = 0;
+    double outDouble = 0;
+    std::string outStr;
+    char outChars[32];
+    std::wstring outWstr;
+    BOOST_CHECK(packet >> outBool >> outInt8 >> outUint8 >> outInt16 >> outUint16 >> outInt32 >> outUint32
+        >> outFloat >> outDouble >> outStr >> outChars >> outWstr);
+    BOOST_CHECK(outBool);
+    BOOST_CHECK_EQUAL(outInt8, -3);
+    BOOST_CHECK_EQUAL(outUint8, 200);
+    BOOST_CHECK_EQUAL(outInt16, -1234);
+    BOOST_CHECK_EQUAL(outUint16, 60000);
+    BOOST_CHECK_EQUAL(outInt32, -123456);
+    BOOST_CHECK_EQUAL(outUint32, 3000000000u);
+    BOOST_CHECK_EQUAL(outFloat, 1.5f);
+    BOOST_CHECK_EQUAL(outDouble, -2.25);
+    BOOST_CHECK(outStr == str);
+    BOOST_CHECK(std::string(outChars) == "turnStarted");
+    BOOST_CHECK(outWstr == wstr);
+
+    int64_t outInt64 = 0;
+    BOOST_CHECK(packet64 >> outInt64);
+    BOOST_CHECK_EQUAL(outInt64, -5000000000LL);
+
+    // Reading after the end invalidates the packet
+    BOOST_CHECK(!(packet >> outInt32));
+}
+
+BOOST_AUTO_TEST_CASE(test_ODPacketSpan)
+{
+    std::vector<Ogre::Vector3> path;
+    for(int i = 0; i < 10; ++i)
+        path.push_back(Ogre::Vector3(static_cast<Ogre::Real>(i), static_cast<Ogre::Real>(i * 2), 0.5));
+
+    // Writing the array at once gives the same data as writing the vectors one by one
+    ODPacket packetArray;
+    packetArray << static_cast<uint32_t>(path.size());
+    packetArray.writeVector3Array(path.data(), path.size());
+    ODPacket packetLoop;
+    packetLoop << static_cast<uint32_t>(path.size());
+    for(const Ogre::Vector3& v : path)
+        packetLoop << v;
+    BOOST_REQUIRE_EQUAL(packetArray.getDataSize(), packetLoop.getDataSize());
+    BOOST_CHECK(std::memcmp(packetArray.getData(), packetLoop.getData(), packetArray.getDataSize()) == 0);
+
+    uint32_t nb = 0;
+    BOOST_REQUIRE(packetLoop >> nb);
+    std::vector<Ogre::Vector3> outPath(nb);
+    BOOST_CHECK(packetLoop.readVector3Array(outPath.data(), outPath.size()));
+    BOOST_CHECK(outPath == path);
+
+    // Spans point directly to the data of the packet
+    ODPacket packet;
+    const char raw[] = { 1, 2, 3, 4, 5 };
+    packet.append(raw, sizeof(raw));
+    const char* span = packet.readSpan(3);
+    BOOST_REQUIRE(span != nullptr);
+    BOOST_CHECK(std::memcmp(span, raw, 3) == 0);
+    BOOST_CHECK(packet.readSpan(3) == nullptr);
+    BOOST_CHECK(!packet);
+
+    // A cleared packet can be reused
+    packet.clear();
+    BOOST_CHECK(packet);
+    BOOST_CHECK_EQUAL(packet.getDataSize(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(test_ODPacketEntitiesRefreshUnknownEntity)
+{
+    // Entities refreshes are sent in batches where each entity is written with its id and the size
+    // of its data (see GameMap::fireRefreshEntities). If the receiver does not know an entity, it
+    // should be able to skip it and read the following ones
+    const std::vector<uint32_t> ids = { 1, 2, 3 };
+    ODPacket batch;
+    ODPacket entityPacket;
+    batch << static_cast<uint32_t>(ids.size());
+    for(uint32_t id : ids)
+    {
+        entityPacket.clear();
+        // The entity with id 2 writes more data than the others
+        entityPacket << std::string("Entity") << static_cast<int32_t>(id * 10);
+        if(id == 2)
+            entityPacket << Ogre::Vector3(1, 2, 3) << true;
+
+        uint32_t entityDataSize = entityPacket.getDataSize();
+        batch << id << entityDataSize;
+        batch.append(entityPacket.getData(), entityDataSize);
+    }
+
+    // The reader does not know the entity in the middle of the batch
+    uint32_t nbEntities = 0;
+    BOOST_REQUIRE(batch >> nbEntities);
+    BOOST_REQUIRE_EQUAL(nbEntities, ids.size());
+    std::vector<uint32_t> readIds;
+    std::vector<int32_t> readValues;
+    while(nbEntities > 0)
+    {
+        --nbEntities;
+        uint32_t entityId = 0;
+        uint32_t entityDataSize = 0;
+        BOOST_REQUIRE(batch >> entityId >> entityDataSize);
+        if(entityId == 2)
+        {
+            BOOST_REQUIRE(batch.readSpan(entityDataSize) != nullptr);
+            continue;
+        }
+
+        std::string name;
+        int32_t value = 0;
+        BOOST_REQUIRE(batch >> name >> value);
+        readIds.push_back(entityId);
+        readValues.push_back(value);
+    }
+
+    BOOST_CHECK((readIds == std::vector<uint32_t>{ 1, 3 }));
+    BOOST_CHECK((readValues == std::vector<int32_t>{ 10, 30 }));
+    // Everything was read
+    int32_t outInt = 0;
+    BOOST_CHECK(!(batch >> outInt));
+}
+
+template<typename Packet>
+static void serializeTurn(Packet& packet, const std::vector<std::string>& names, const std::vector<Ogre::Vector3>& positions)
+{
+    for(std::size_t i = 0; i < names.size(); ++i)
+    {
+        const Ogre::Vector3& pos = positions[i];
+        packet << static_cast<uint32_t>(i) << names[i] << true << static_cast<int32_t>(i * 3) << 0.75
+            << pos.x << pos.y << pos.z;
+    }
+}
+
+template<typename Packet>
+static double deserializeTurn(Packet& packet, std::size_t nbEntities)
+{
+    // We return a value depending on the data read so that the compiler cannot skip the reading
+    double sum = 0;
+    std::string name;
+    for(std::size_t i = 0; i < nbEntities; ++i)
+    {
+        uint32_t id = 0;
+        bool flag = false;
+        int32_t value = 0;
+        double speed = 0;
+        float x = 0;
+        float y = 0;
+        float z = 0;
+        packet >> id >> name >> flag >> value >> speed >> x >> y >> z;
+        sum += id + name.size() + value + speed + x + y + z;
+    }
+    return sum;
+}
+
+//! \brief Writes/reads a replay packet with sf::Packet like ODPacket::writePacket/readPacket did
+//! before ODPacket had its own buffer (the data was copied through a 1 KB buffer)
+static void writeReplaySFML(const sf::Packet& packet, int32_t timestamp, std::ofstream& os)
+{
+    int32_t bufferSize = static_cast<int32_t>(packet.getDataSize());
+    os.write(reinterpret_cast<const char*>(&timestamp), sizeof(int32_t));
+    os.write(reinterpret_cast<const char*>(&bufferSize), sizeof(int32_t));
+    os.write(static_cast<const char*>(packet.getData()), bufferSize);
+}
+
+static int32_t readReplaySFML(sf::Packet& packet, std::ifstream& is)
+{
+    const int32_t bufferSize = 1024;
+    int32_t timestamp;
+    int32_t packetSize;
+    is.read(reinterpret_cast<char*>(&timestamp), sizeof(int32_t));
+    if(is.eof())
+        return -1;
+
+    is.read(reinterpret_cast<char*>(&packetSize), sizeof(int32_t));
+    if(is.eof())
+        return -1;
+
+    packet.clear();
+    char buffer[bufferSize];
+    while(packetSize > 0)
+    {
+        int32_t sizeToRead = std::min(packetSize, bufferSize);
+        is.read(buffer, sizeToRead);
+        packet.append(buffer, sizeToRead);
+        packetSize -= sizeToRead;
+    }
+
+    return timestamp;
+}
+
+static double getDurationMs(const std::chrono::steady_clock::time_point& startTime)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+BOOST_AUTO_TEST_CASE(test_ODPacketThroughput)
+{
+    // Compares ODPacket with sf::Packet when serializing/deserializing a typical turn refresh (entity ids,
+    // names, flags and positions), when writing/reading arrays of positions (creature paths) and when
+    // writing/reading a replay. Both should process the same data
+    const std::size_t nbEntities = 500;
+    const int nbIterations = 200;
+    std::vector<std::string> names;
+    std::vector<Ogre::Vector3> positions;
+    std::size_t namesSize = 0;
+    for(std::size_t i = 0; i < nbEntities; ++i)
+    {
+        names.push_back("Creature_Goblin_" + std::to_string(i));
+        positions.push_back(Ogre::Vector3(static_cast<Ogre::Real>(i), 2.0, 0.0));
+        namesSize += names.back().size();
+    }
+
+    // Turn refresh
+    double sumOD = 0;
+    std::size_t bytesOD = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    ODPacket packetOD;
+    for(int it = 0; it < nbIterations; ++it)
+    {
+        // The packet is reused like the server does with its notifications
+        packetOD.clear();
+        serializeTurn(packetOD, names, positions);
+        sumOD += deserializeTurn(packetOD, nbEntities);
+        bytesOD += packetOD.getDataSize();
+    }
+    BOOST_CHECK(packetOD);
+    double timeTurnOD = getDurationMs(startTime);
+
+    double sumSFML = 0;
+    std::size_t bytesSFML = 0;
+    startTime = std::chrono::steady_clock::now();
+    sf::Packet packetSFML;
+    for(int it = 0; it < nbIterations; ++it)
+    {
+        packetSFML.clear();
+        serializeTurn(packetSFML, names, positions);
+        sumSFML += deserializeTurn(packetSFML, nbEntities);
+        bytesSFML += packetSFML.getDataSize();
+    }
+    BOOST_CHECK(packetSFML);
+    double timeTurnSFML = getDurationMs(startTime);
+
+    // For each entity: id, name size and characters, flag (as 8 bits), value, speed and position
+    BOOST_CHECK_EQUAL(bytesOD, bytesSFML);
+    BOOST_CHECK_EQUAL(sumOD, sumSFML);
+    const std::size_t entitiesSize = nbEntities * (sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint8_t)
+        + sizeof(int32_t) + sizeof(double) + 3 * sizeof(float)) + namesSize;
+    BOOST_CHECK_EQUAL(bytesOD, nbIterations * entitiesSize);
+
+    // Arrays of positions. ODPacket copies them at once while sf::Packet writes each coordinate
+    std::vector<Ogre::Vector3> positionsOD(nbEntities);
+    startTime = std::chrono::steady_clock::now();
+    for(int it = 0; it < nbIterations; ++it)
+    {
+        packetOD.clear();
+        packetOD.writeVector3Array(positions.data(), positions.size());
+        packetOD.readVector3Array(positionsOD.data(), positionsOD.size());
+    }
+    BOOST_CHECK(packetOD);
+    double timeArrayOD = getDurationMs(startTime);
+
+    std::vector<Ogre::Vector3> positionsSFML(nbEntities);
+    startTime = std::chrono::steady_clock::now();
+    for(int it = 0; it < nbIterations; ++it)
+    {
+        packetSFML.clear();
+        for(const Ogre::Vector3& pos : positions)
+            packetSFML << pos.x << pos.y << pos.z;
+        for(Ogre::Vector3& pos : positionsSFML)
+            packetSFML >> pos.x >> pos.y >> pos.z;
+    }
+    BOOST_CHECK(packetSFML);
+    double timeArraySFML = getDurationMs(startTime);
+
+    BOOST_CHECK(positionsOD == positions);
+    BOOST_CHECK(positionsSFML == positions);
+    std::size_t bytesArray = packetOD.getDataSize();
+    BOOST_CHECK_EQUAL(bytesArray, packetSFML.getDataSize());
+    BOOST_CHECK_EQUAL(bytesArray, nbEntities * 3 * sizeof(float));
+
+    // Replay with one turn refresh per turn
+    const std::string replayFileName("test_ODPacketThroughput.replay");
+    packetOD.clear();
+    serializeTurn(packetOD, names, positions);
+    startTime = std::chrono::steady_clock::now();
+    {
+        std::ofstream os(replayFileName, std::ios::binary);
+        for(int it = 0; it < nbIterations; ++it)
+            packetOD.writePacket(it, os);
+    }
+    sumOD = 0;
+    {
+        std::ifstream is(replayFileName, std::ios::binary);
+        int32_t timestamp;
+        while((timestamp = packetOD.readPacket(is)) != -1)
+            sumOD += timestamp + deserializeTurn(packetOD, nbEntities);
+    }
+    double timeReplayOD = getDurationMs(startTime);
+
+    packetSFML.clear();
+    serializeTurn(packetSFML, names, positions);
+    startTime = std::chrono::steady_clock::now();
+    {
+        std::ofstream os(replayFileName, std::ios::binary);
+        for(int it = 0; it < nbIterations; ++it)
+            writeReplaySFML(packetSFML, it, os);
+    }
+    sumSFML = 0;
+    {
+        std::ifstream is(replayFileName, std::ios::binary);
+        int32_t timestamp;
+        while((timestamp = readReplaySFML(packetSFML, is)) != -1)
+            sumSFML += timestamp + deserializeTurn(packetSFML, nbEntities);
+    }
+    double timeReplaySFML = getDurationMs(startTime);
+    std::remove(replayFileName.c_str());
+
+    BOOST_CHECK(sumOD > 0);
+    BOOST_CHECK_EQUAL(sumOD, sumSFML);
+
+    std::cout << "Packet throughput (" << nbIterations << " iterations of " << nbEntities << " entities)" << std::endl;
+    std::cout << "Turn refresh (" << bytesOD / nbIterations << " bytes): ODPacket " << timeTurnOD
+        << " ms, sf::Packet " << timeTurnSFML << " ms" << std::endl;
+    std::cout << "Positions array (" << bytesArray << " bytes): ODPacket " << timeArrayOD
+        << " ms, sf::Packet " << timeArraySFML << " ms" << std::endl;
+    std::cout << "Replay write/read: ODPacket " << timeReplayOD << " ms, sf::Packet " << timeReplaySFML
+        << " ms" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(test_ODPacketSortedIndexes)
+{
+    // Tiles revealed by a creature with a vision radius of 15 on a 200x200 map (indexed row by row)
+    const int mapSizeX = 200;
+    const int mapSizeY = 200;
+    const int radius = 15;
+    std::vector<uint32_t> indexes;
+    for(int yy = 100 - radius; yy <= 100 + radius; ++yy)
+    {
+        for(int xx = 100 - radius; xx <= 100 + radius; ++xx)
+        {
+            if((xx - 100) * (xx - 100) + (yy - 100) * (yy - 100) > radius * radius)
+                continue;
+
+            indexes.push_back(static_cast<uint32_t>(yy * mapSizeX + xx));
+        }
+    }
+
+    ODPacket packet;
+    packet.writeSortedIndexes(indexes);
+    std::vector<uint32_t> outIndexes;
+    BOOST_CHECK(packet.readSortedIndexes(outIndexes, mapSizeX * mapSizeY));
+    BOOST_CHECK(outIndexes == indexes);
+
+    // Each tile used to be sent as 2 int32
+    const std::size_t sizeBefore = sizeof(uint32_t) + indexes.size() * 2 * sizeof(int32_t);
+    BOOST_CHECK(packet.getDataSize() * 10 < sizeBefore);
+    // There is one run per row. The number of runs and the run lengths (up to 31) take 1 byte, the gaps
+    // between the rows (more than 127) 2 bytes and the gap before the first row (17100) 3 bytes
+    const std::size_t nbRows = 2 * radius + 1;
+    BOOST_CHECK_EQUAL(packet.getDataSize(), 1 + (3 + 1) + (nbRows - 1) * (2 + 1));
+
+    // Scattered tiles and empty sets
+    std::vector<uint32_t> scattered = { 0, 2, 3, 4, 1000, 39999 };
+    ODPacket packetScattered;
+    packetScattered.writeSortedIndexes(scattered);
+    packetScattered.writeSortedIndexes(std::vector<uint32_t>());
+    BOOST_CHECK(packetScattered.readSortedIndexes(outIndexes, mapSizeX * mapSizeY));
+    BOOST_CHECK(outIndexes == scattered);
+    BOOST_CHECK(packetScattered.readSortedIndexes(outIndexes, mapSizeX * mapSizeY));
+    BOOST_CHECK(outIndexes.empty());
+
+    // Indexes outside of the map invalidate the packet
+    ODPacket packetOutside;
+    packetOutside.writeSortedIndexes(scattered);
+    BOOST_CHECK(!packetOutside.readSortedIndexes(outIndexes, 1000));
+
+    // Duplicated or unsorted indexes are written sorted without the duplicates
+    ODPacket packetDuplicates;
+    packetDuplicates.writeSortedIndexes({ 4, 3, 1000, 0, 3, 2, 39999, 0 });
+    BOOST_CHECK(packetDuplicates.readSortedIndexes(outIndexes, mapSizeX * mapSizeY));
+    BOOST_CHECK(outIndexes == scattered);
+}
@@ -20,6 +20,10 @@
 
 #include "gamemap/Pathfinding.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 struct Point
 {
     int x;
@@ -39,3 +43,251 @@ BOOST_AUTO_TEST_CASE(test_Pathfinding)
     BOOST_CHECK((Pathfinding::distanceTile(a, b) - std::sqrt(128.0f)) < 0.0001f);
     BOOST_CHECK(Pathfinding::squaredDistance(9,1,1,9) == 128);
 }
+
+//! \brief Small grid where 'X' is a wall, 'D' a diggable wall and 'C' a wall claimed by an enemy. 'G' is a
+//! diggable wall that is a target of the distance fields (like gold)
+struct Grid
+{
+    std::vector<std::string> mLines;
+    std::vector<uint32_t> mTargets;
+    bool mCanDig = false;
+    int getSizeX() const
+    { return static_cast<int>(mLines[0].size()); }
+    int getSizeY() const
+    { return static_cast<int>(mLines.size()); }
+    bool isPassable(int x, int y) const
+    { return mLines[y][x] == '.'; }
+    bool isDiggable(int x, int y) const
+    { return mCanDig && ((mLines[y][x] == 'D') || (mLines[y][x] == 'G')); }
+    double getSpeed(int, int) const
+    { return 1.0; }
+    uint32_t getCost(int x, int y) const
+    {
+        if(isPassable(x, y))
+            return 1;
+        if((mLines[y][x] == 'D') || (mLines[y][x] == 'G'))
+            return 3;
+        if(mLines[y][x] == 'C')
+            return 30;
+        return Pathfinding::DistanceField::IMPASSABLE;
+    }
+    bool isTarget(int x, int y) const
+    {
+        if(mLines[y][x] == 'G')
+            return true;
+        return std::find(mTargets.begin(), mTargets.end(), Pathfinding::AstarSearch::getIndex(x, y, getSizeX())) != mTargets.end();
+    }
+};
+
+BOOST_AUTO_TEST_CASE(test_AstarSearch)
+{
+    Grid grid;
+    grid.mLines = {
+        ".....",
+        ".XXX.",
+        ".X.D.",
+        ".X.X.",
+        "....."
+    };
+    Pathfinding::AstarSearch search;
+    std::vector<uint32_t> path;
+
+    // Going around the wall. Diagonals are allowed when the 2 adjacent tiles are passable
+    BOOST_CHECK(search.search(grid, 0, 0, 2, 3, path));
+    BOOST_CHECK(path.size() == 8);
+    BOOST_CHECK(path.front() == Pathfinding::AstarSearch::getIndex(0, 0, grid.getSizeX()));
+    BOOST_CHECK(path.back() == Pathfinding::AstarSearch::getIndex(2, 3, grid.getSizeX()));
+
+    // The search state is reused: a second search on the same grid should give the same result
+    std::vector<uint32_t> path2;
+    BOOST_CHECK(search.search(grid, 0, 0, 2, 3, path2));
+    BOOST_CHECK(path == path2);
+
+    // Closing the wall makes the inner tiles unreachable...
+    grid.mLines[4][2] = 'X';
+    BOOST_CHECK(!search.search(grid, 4, 2, 2, 2, path));
+    BOOST_CHECK(path.empty());
+
+    // ... unless we can dig through
+    grid.mCanDig = true;
+    BOOST_CHECK(search.search(grid, 4, 2, 2, 2, path));
+    BOOST_CHECK(path.size() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(test_DistanceField)
+{
+    Grid grid;
+    grid.mLines = {
+        ".....",
+        ".XXX.",
+        ".XDX.",
+        ".X.X.",
+        "....."
+    };
+    const int sizeX = grid.getSizeX();
+    Pathfinding::DistanceField field;
+    grid.mTargets = {Pathfinding::AstarSearch::getIndex(2, 3, sizeX)};
+    field.update(grid);
+    BOOST_CHECK(field.getNbFullComputations() == 1);
+
+    // Walking around the walls is cheaper than digging through them
+    std::vector<uint32_t> path;
+    BOOST_CHECK(field.getDistance(2, 0) == 9);
+    BOOST_CHECK(field.getPath(2, 0, path));
+    BOOST_CHECK(path.size() == 10);
+    BOOST_CHECK(path.front() == Pathfinding::AstarSearch::getIndex(2, 0, sizeX));
+    BOOST_CHECK(path.back() == Pathfinding::AstarSearch::getIndex(2, 3, sizeX));
+    BOOST_CHECK(field.getDistance(1, 1) == Pathfinding::DistanceField::IMPASSABLE);
+    BOOST_CHECK(!field.getPath(1, 1, path));
+
+    // Cheaper tiles are propagated without computing the whole field again
+    grid.mLines[1][2] = 'D';
+    field.setTileChanged(2, 1);
+    field.update(grid);
+    BOOST_CHECK(field.getDistance(2, 0) == 7);
+    BOOST_CHECK(field.getPath(2, 0, path));
+    BOOST_CHECK(path.size() == 4);
+    grid.mLines[2][2] = '.';
+    field.setTileChanged(2, 2);
+    field.update(grid);
+    BOOST_CHECK(field.getDistance(2, 0) == 5);
+    BOOST_CHECK(field.getNbFullComputations() == 1);
+
+    // A more expensive tile needs a full computation
+    grid.mLines[4][2] = 'X';
+    field.setTileChanged(2, 4);
+    field.update(grid);
+    BOOST_CHECK(field.getNbFullComputations() == 2);
+    BOOST_CHECK(field.getDistance(2, 0) == 5);
+    BOOST_CHECK(field.getDistance(2, 4) == Pathfinding::DistanceField::IMPASSABLE);
+
+    // With several targets, the path leads to the closest one. A new target is propagated from
+    grid.mTargets.push_back(Pathfinding::AstarSearch::getIndex(4, 4, sizeX));
+    field.setTileChanged(4, 4);
+    field.update(grid);
+    BOOST_CHECK(field.getNbFullComputations() == 2);
+    BOOST_CHECK(field.getDistance(4, 0) == 4);
+    BOOST_CHECK(field.getPath(4, 0, path));
+    BOOST_CHECK(path.back() == Pathfinding::AstarSearch::getIndex(4, 4, sizeX));
+
+    // A removed target needs a full computation
+    grid.mTargets.pop_back();
+    field.setTileChanged(4, 4);
+    field.update(grid);
+    BOOST_CHECK(field.getNbFullComputations() == 3);
+    BOOST_CHECK(field.getDistance(4, 0) == 7);
+}
+
+BOOST_AUTO_TEST_CASE(test_DistanceFieldGold)
+{
+    // The targets come from the grid. When gold is mined, the same field leads to the next gold tile
+    Grid grid;
+    grid.mLines = {
+        "G.....",
+        "XXXX.X",
+        "DDDD.G",
+    };
+    const int sizeX = grid.getSizeX();
+    Pathfinding::DistanceField field;
+    field.update(grid);
+    std::vector<uint32_t> path;
+    BOOST_CHECK(field.getPath(4, 2, path));
+    BOOST_CHECK(path.back() == Pathfinding::AstarSearch::getIndex(5, 2, sizeX));
+
+    grid.mLines[2][5] = '.';
+    field.setTileChanged(5, 2);
+    field.update(grid);
+    BOOST_CHECK(field.getPath(4, 2, path));
+    BOOST_CHECK(path.back() == Pathfinding::AstarSearch::getIndex(0, 0, sizeX));
+    BOOST_CHECK(path.size() == 7);
+}
+
+BOOST_AUTO_TEST_CASE(test_DistanceFieldWalledInTemple)
+{
+    // The target (a dungeon temple) is surrounded by walls claimed by an enemy. They cannot be
+    // dug but the path should still lead to the target through one of them
+    Grid grid;
+    grid.mLines = {
+        ".......",
+        "..CCC..",
+        "..C.C..",
+        "..CCC..",
+        "DDDDDDD",
+    };
+    const int sizeX = grid.getSizeX();
+    grid.mTargets = {Pathfinding::AstarSearch::getIndex(3, 2, sizeX)};
+    Pathfinding::DistanceField field;
+    field.update(grid);
+    std::vector<uint32_t> path;
+    BOOST_CHECK(field.getPath(3, 0, path));
+    BOOST_CHECK(path.size() == 3);
+    BOOST_CHECK(path.back() == Pathfinding::AstarSearch::getIndex(3, 2, sizeX));
+    BOOST_CHECK(path[1] == Pathfinding::AstarSearch::getIndex(3, 1, sizeX));
+
+    // Digging around is preferred when there is a way without claimed walls
+    grid.mLines[2][4] = 'D';
+    field.setTileChanged(4, 2);
+    field.update(grid);
+    BOOST_CHECK(field.getPath(3, 0, path));
+    BOOST_CHECK(std::find(path.begin(), path.end(), Pathfinding::AstarSearch::getIndex(4, 2, sizeX)) != path.end());
+    BOOST_CHECK(std::find(path.begin(), path.end(), Pathfinding::AstarSearch::getIndex(3, 1, sizeX)) == path.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_FlowField)
+{
+    Grid grid;
+    grid.mLines = {
+        "........",
+        ".XXXXX..",
+        ".X...X..",
+        ".X.X.X..",
+        "...X....",
+        "XXXX.XX."
+    };
+    const int sizeX = grid.getSizeX();
+    Pathfinding::FlowField field;
+    field.compute(grid, 2, 3);
+    BOOST_CHECK(field.getDestination() == Pathfinding::AstarSearch::getIndex(2, 3, sizeX));
+
+    // The paths from the field have the same cost as the ones from A*
+    auto getCost = [sizeX](const std::vector<uint32_t>& path)
+    {
+        double cost = 0.0;
+        for(uint32_t i = 1; i < path.size(); ++i)
+        {
+            cost += Pathfinding::manhattanDistance(
+                Pathfinding::AstarSearch::getX(path[i - 1], sizeX), Pathfinding::AstarSearch::getY(path[i - 1], sizeX),
+                Pathfinding::AstarSearch::getX(path[i], sizeX), Pathfinding::AstarSearch::getY(path[i], sizeX));
+        }
+        return cost;
+    };
+    Pathfinding::AstarSearch search;
+    std::vector<uint32_t> path;
+    std::vector<uint32_t> astarPath;
+    for(int y = 0; y < grid.getSizeY(); ++y)
+    {
+        for(int x = 0; x < sizeX; ++x)
+        {
+            bool isReachable = search.search(grid, x, y, 2, 3, astarPath);
+            BOOST_CHECK(field.getPath(x, y, path) == (isReachable && grid.isPassable(x, y)));
+            if(!isReachable || !grid.isPassable(x, y))
+                continue;
+
+            BOOST_CHECK(path.front() == Pathfinding::AstarSearch::getIndex(x, y, sizeX));
+            BOOST_CHECK(path.back() == field.getDestination());
+            BOOST_CHECK(getCost(path) == getCost(astarPath));
+        }
+    }
+
+    // Walls are not in the field but changing one next to it could open a shorter path
+    BOOST_CHECK(!field.getPath(0, 5, path));
+    BOOST_CHECK(field.isNearField(0, 5));
+
+    // Tiles that cannot reach the destination are not in the field
+    grid.mLines[4][2] = 'X';
+    grid.mLines[4][4] = 'X';
+    field.compute(grid, 2, 3);
+    BOOST_CHECK(!field.getPath(7, 0, path));
+    BOOST_CHECK(!field.isNearField(7, 0));
+    BOOST_CHECK(field.getPath(4, 2, path));
+}
@@ -0,0 +1,318 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE PathfindingBenchmark
+#include "BoostTestTargetConfig.h"
+
+#include "gamemap/Pathfinding.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef OD_TEST_LEVELS_PATH
+#define OD_TEST_LEVELS_PATH "levels"
+#endif
+
+//! \brief Walkability grid read from the [Tiles] section of a level file. The speeds are the
+//! ones of a creature walking on ground and water but not on lava.
+class LevelGrid
+{
+public:
+    bool load(const std::string& fileName)
+    {
+        std::ifstream levelFile(fileName);
+        if(!levelFile.is_open())
+            return false;
+
+        std::string line;
+        while(std::getline(levelFile, line))
+        {
+            if(line.compare(0, 7, "[Tiles]") == 0)
+                break;
+        }
+
+        std::vector<int> values;
+        while(std::getline(levelFile, line))
+        {
+            if(line.compare(0, 8, "[/Tiles]") == 0)
+                break;
+
+            // We remove comments
+            line = line.substr(0, line.find('#'));
+            std::stringstream ss(line);
+            int value;
+            values.clear();
+            while(ss >> value)
+                values.push_back(value);
+
+            if(values.empty())
+                continue;
+
+            // The map size is on the 2 first lines
+            if(mSizeX == 0)
+            {
+                mSizeX = values[0];
+                continue;
+            }
+            if(mSizeY == 0)
+            {
+                mSizeY = values[0];
+                // Tiles not described in the level are full dirt
+                mSpeeds.assign(mSizeX * mSizeY, 0.0);
+                continue;
+            }
+
+            if(values.size() < 4)
+                continue;
+
+            // Format: posX posY type fullness seatId(optional). Type 4 is water and 5 lava
+            int x = values[0];
+            int y = values[1];
+            int type = values[2];
+            int fullness = values[3];
+            if(fullness > 0)
+                continue;
+
+            double speed = 1.0;
+            if(type == 4)
+                speed = 0.7;
+            else if(type == 5)
+                speed = 0.0;
+
+            mSpeeds[Pathfinding::AstarSearch::getIndex(x, y, mSizeX)] = speed;
+        }
+
+        return (mSizeX > 0) && (mSizeY > 0);
+    }
+
+    int getSizeX() const
+    { return mSizeX; }
+    int getSizeY() const
+    { return mSizeY; }
+    bool isPassable(int x, int y) const
+    { return getSpeed(x, y) > 0.0; }
+    bool isDiggable(int, int) const
+    { return false; }
+    double getSpeed(int x, int y) const
+    { return mSpeeds[Pathfinding::AstarSearch::getIndex(x, y, mSizeX)]; }
+
+private:
+    int mSizeX = 0;
+    int mSizeY = 0;
+    std::vector<double> mSpeeds;
+};
+
+//! \brief Reference implementation: the A* with a sorted open list that was used in GameMap::path
+//! before Pathfinding::AstarSearch. It is used to check that both give the same paths.
+static bool legacyPath(const LevelGrid& grid, int x1, int y1, int x2, int y2, std::vector<uint32_t>& path)
+{
+    struct Entry
+    {
+        int x;
+        int y;
+        Entry* parent;
+        double g;
+        double h;
+        bool processed;
+        double fCost() const
+        { return g + h; }
+    };
+
+    static const int NEIGHBOR_DIFF_X[8] = { -1, 1, 0, 0, -1, -1, 1, 1 };
+    static const int NEIGHBOR_DIFF_Y[8] = { 0, 0, -1, 1, -1, 1, -1, 1 };
+
+    path.clear();
+    const int sizeX = grid.getSizeX();
+    std::vector<std::vector<Entry*>> processList(sizeX, std::vector<Entry*>(grid.getSizeY(), nullptr));
+    std::vector<Entry*> openList;
+    Entry* start = new Entry{x1, y1, nullptr, 0.0, Pathfinding::manhattanDistance(x1, y1, x2, y2), false};
+    processList[x1][y1] = start;
+    openList.push_back(start);
+    Entry* destination = nullptr;
+    while(!openList.empty())
+    {
+        Entry* current = openList.back();
+        openList.pop_back();
+        current->processed = true;
+        if((current->x == x2) && (current->y == y2))
+        {
+            destination = current;
+            break;
+        }
+
+        bool areTilesPassable[4] = {false, false, false, false};
+        for(int i = 0; i < 8; ++i)
+        {
+            if(((i == 4) && !(areTilesPassable[0] && areTilesPassable[2])) ||
+               ((i == 5) && !(areTilesPassable[0] && areTilesPassable[3])) ||
+               ((i == 6) && !(areTilesPassable[1] && areTilesPassable[2])) ||
+               ((i == 7) && !(areTilesPassable[1] && areTilesPassable[3])))
+            {
+                continue;
+            }
+            int x = current->x + NEIGHBOR_DIFF_X[i];
+            int y = current->y + NEIGHBOR_DIFF_Y[i];
+            if((x < 0) || (x >= sizeX) || (y < 0) || (y >= grid.getSizeY()))
+                continue;
+
+            if(!grid.isPassable(x, y) && ((x != x1) || (y != y1)))
+                continue;
+
+            if(i < 4)
+                areTilesPassable[i] = true;
+
+            Entry* neighbor = processList[x][y];
+            if((neighbor != nullptr) && neighbor->processed)
+                continue;
+
+            double g = current->g + Pathfinding::manhattanDistance(x, y, current->x, current->y)
+                / grid.getSpeed(current->x, current->y);
+            if(neighbor == nullptr)
+            {
+                neighbor = new Entry{x, y, current, g, Pathfinding::manhattanDistance(x, y, x2, y2), false};
+                auto itr = openList.begin();
+                while((itr != openList.end()) && ((*itr)->fCost() > neighbor->fCost()))
+                    ++itr;
+
+                openList.insert(itr, neighbor);
+                processList[x][y] = neighbor;
+            }
+            else if(g < neighbor->g)
+            {
+                neighbor->g = g;
+                neighbor->parent = current;
+                auto itr = openList.erase(std::find(openList.begin(), openList.end(), neighbor));
+                while((itr != openList.end()) && ((*itr)->fCost() > neighbor->fCost()))
+                    ++itr;
+
+                openList.insert(itr, neighbor);
+            }
+        }
+    }
+
+    for(Entry* entry = destination; entry != nullptr; entry = entry->parent)
+        path.push_back(Pathfinding::AstarSearch::getIndex(entry->x, entry->y, sizeX));
+
+    std::reverse(path.begin(), path.end());
+
+    for(std::vector<Entry*>& column : processList)
+    {
+        for(Entry* entry : column)
+            delete entry;
+    }
+
+    return destination != nullptr;
+}
+
+BOOST_AUTO_TEST_CASE(test_PathfindingBenchmark)
+{
+    LevelGrid grid;
+    BOOST_REQUIRE(grid.load(std::string(OD_TEST_LEVELS_PATH) + "/multiplayer/TestBigMap.level"));
+
+    // We group the walkable tiles by connected area and pick random couples of tiles in the same
+    // area with a fixed seed to always run the same paths
+    const int sizeX = grid.getSizeX();
+    std::vector<int> areaIds(grid.getSizeX() * grid.getSizeY(), -1);
+    std::vector<std::vector<uint32_t>> areas;
+    for(uint32_t index = 0; index < areaIds.size(); ++index)
+    {
+        if((areaIds[index] != -1) || !grid.isPassable(Pathfinding::AstarSearch::getX(index, sizeX), Pathfinding::AstarSearch::getY(index, sizeX)))
+            continue;
+
+        areas.push_back(std::vector<uint32_t>());
+        std::vector<uint32_t>& area = areas.back();
+        areaIds[index] = static_cast<int>(areas.size() - 1);
+        area.push_back(index);
+        for(std::size_t k = 0; k < area.size(); ++k)
+        {
+            int x = Pathfinding::AstarSearch::getX(area[k], sizeX);
+            int y = Pathfinding::AstarSearch::getY(area[k], sizeX);
+            const int diffs[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+            for(const int* diff : diffs)
+            {
+                int neighborX = x + diff[0];
+                int neighborY = y + diff[1];
+                if((neighborX < 0) || (neighborX >= grid.getSizeX()) || (neighborY < 0) || (neighborY >= grid.getSizeY()))
+                    continue;
+
+                uint32_t neighborIndex = Pathfinding::AstarSearch::getIndex(neighborX, neighborY, sizeX);
+                if((areaIds[neighborIndex] != -1) || !grid.isPassable(neighborX, neighborY))
+                    continue;
+
+                areaIds[neighborIndex] = areaIds[index];
+                area.push_back(neighborIndex);
+            }
+        }
+    }
+    BOOST_REQUIRE(!areas.empty());
+
+    std::vector<uint32_t> walkableTiles;
+    for(const std::vector<uint32_t>& area : areas)
+        walkableTiles.insert(walkableTiles.end(), area.begin(), area.end());
+
+    const uint32_t nbPaths = 200;
+    std::mt19937 generator(42);
+    std::vector<std::pair<uint32_t, uint32_t>> couples;
+    for(uint32_t i = 0; i < nbPaths; ++i)
+    {
+        uint32_t start = walkableTiles[std::uniform_int_distribution<std::size_t>(0, walkableTiles.size() - 1)(generator)];
+        const std::vector<uint32_t>& area = areas[areaIds[start]];
+        uint32_t dest = area[std::uniform_int_distribution<std::size_t>(0, area.size() - 1)(generator)];
+        couples.push_back(std::make_pair(start, dest));
+    }
+
+    Pathfinding::AstarSearch search;
+    std::vector<std::vector<uint32_t>> paths(nbPaths);
+    uint32_t nbPathsFound = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < nbPaths; ++i)
+    {
+        const std::pair<uint32_t, uint32_t>& couple = couples[i];
+        if(search.search(grid, Pathfinding::AstarSearch::getX(couple.first, sizeX), Pathfinding::AstarSearch::getY(couple.first, sizeX),
+                Pathfinding::AstarSearch::getX(couple.second, sizeX), Pathfinding::AstarSearch::getY(couple.second, sizeX), paths[i]))
+        {
+            ++nbPathsFound;
+        }
+    }
+    auto durationSearch = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::vector<uint32_t> legacy;
+    uint32_t nbDifferentPaths = 0;
+    startTime = std::chrono::steady_clock::now();
+    for(uint32_t i = 0; i < nbPaths; ++i)
+    {
+        const std::pair<uint32_t, uint32_t>& couple = couples[i];
+        legacyPath(grid, Pathfinding::AstarSearch::getX(couple.first, sizeX), Pathfinding::AstarSearch::getY(couple.first, sizeX),
+            Pathfinding::AstarSearch::getX(couple.second, sizeX), Pathfinding::AstarSearch::getY(couple.second, sizeX), legacy);
+        if(legacy != paths[i])
+            ++nbDifferentPaths;
+    }
+    auto durationLegacy = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::cout << "Pathfinding benchmark on " << grid.getSizeX() << "x" << grid.getSizeY() << " map: "
+        << nbPaths << " searches, " << nbPathsFound << " paths found" << std::endl;
+    std::cout << "AstarSearch: " << durationSearch.count() << " us, sorted list A*: "
+        << durationLegacy.count() << " us" << std::endl;
+
+    BOOST_CHECK(nbDifferentPaths == 0);
+}
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/ThreadPool.h"
+
+#define BOOST_TEST_MODULE ThreadPool
+#include "BoostTestTargetConfig.h"
+
+#include <vector>
+
+//! \brief Runs several jobs on the given pool and checks that every item is processed exactly once
+static void checkParallelFor(ThreadPool& pool)
+{
+    for(uint32_t nbItems : {0u, 1u, 7u, 1000u, 12345u})
+    {
+        std::vector<uint32_t> nbCalls(nbItems, 0);
+        pool.parallelFor(nbItems, [&nbCalls](uint32_t index)
+        {
+            ++nbCalls[index];
+        });
+
+        for(uint32_t i = 0; i < nbItems; ++i)
+            BOOST_REQUIRE_EQUAL(nbCalls[i], 1u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_ThreadPoolSerial)
+{
+    ThreadPool pool(0);
+    BOOST_CHECK_EQUAL(pool.getNbWorkers(), 0u);
+    checkParallelFor(pool);
+}
+
+BOOST_AUTO_TEST_CASE(test_ThreadPoolWorkers)
+{
+    ThreadPool pool(4);
+    BOOST_CHECK_EQUAL(pool.getNbWorkers(), 4u);
+    // The same pool is used for many jobs like during a game
+    for(uint32_t i = 0; i < 50; ++i)
+        checkParallelFor(pool);
+}
@@ -31,6 +31,12 @@
 const std::string TrapBoulderName = "Boulder";
 const std::string TrapBoulderNameDisplay = "Boulder trap";
 const TrapType TrapBoulder::mTrapType = TrapType::boulder;
+const ConfigParam BoulderCostPerTileParam(ConfigParamCtg::trap, "BoulderCostPerTile");
+const ConfigParam BoulderReloadTurnsParam(ConfigParamCtg::trap, "BoulderReloadTurns");
+const ConfigParam BoulderDamagePerHitMinParam(ConfigParamCtg::trap, "BoulderDamagePerHitMin");
+const ConfigParam BoulderDamagePerHitMaxParam(ConfigParamCtg::trap, "BoulderDamagePerHitMax");
+const ConfigParam BoulderNbShootsBeforeDeactivationParam(ConfigParamCtg::trap, "BoulderNbShootsBeforeDeactivation");
+const ConfigParam BoulderSpeedParam(ConfigParamCtg::trap, "BoulderSpeed");
 
 namespace
 {
@@ -46,7 +52,7 @@ class TrapBoulderFactory : public TrapFactory
     { return TrapBoulderNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getTrapConfigInt32("BoulderCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(BoulderCostPerTileParam); }
 
     const std::string& getMeshName() const override
     {
@@ -114,10 +120,10 @@ static TrapRegister reg(new TrapBoulderFactory);
 TrapBoulder::TrapBoulder(GameMap* gameMap) :
     Trap(gameMap)
 {
-    mReloadTime = ConfigManager::getSingleton().getTrapConfigUInt32("BoulderReloadTurns");
-    mMinDamage = ConfigManager::getSingleton().getTrapConfigDouble("BoulderDamagePerHitMin");
-    mMaxDamage = ConfigManager::getSingleton().getTrapConfigDouble("BoulderDamagePerHitMax");
-    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getTrapConfigUInt32("BoulderNbShootsBeforeDeactivation");
+    mReloadTime = ConfigManager::getSingleton().getConfigUInt32(BoulderReloadTurnsParam);
+    mMinDamage = ConfigManager::getSingleton().getConfigDouble(BoulderDamagePerHitMinParam);
+    mMaxDamage = ConfigManager::getSingleton().getConfigDouble(BoulderDamagePerHitMaxParam);
+    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getConfigUInt32(BoulderNbShootsBeforeDeactivationParam);
     setMeshName("");
 }
 
@@ -150,7 +156,7 @@ bool TrapBoulder::shoot(Tile* tile)
     position.z = 0;
     direction.normalise();
     MissileBoulder* missile = new MissileBoulder(getGameMap(), getSeat(), getName(), "Boulder",
-        direction, ConfigManager::getSingleton().getTrapConfigDouble("BoulderSpeed"),
+        direction, ConfigManager::getSingleton().getConfigDouble(BoulderSpeedParam),
         Random::Double(mMinDamage, mMaxDamage), nullptr, true);
     missile->addToGameMap();
     missile->createMesh();
@@ -17,6 +17,7 @@
 
 #include "traps/TrapCannon.h"
 
+#include "entities/GameEntityType.h"
 #include "entities/Tile.h"
 #include "entities/TrapEntity.h"
 #include "entities/MissileOneHit.h"
@@ -32,6 +33,16 @@
 const std::string TrapCannonName = "Cannon";
 const std::string TrapCannonNameDisplay = "Cannon trap";
 const TrapType TrapCannon::mTrapType = TrapType::cannon;
+const ConfigParam CannonCostPerTileParam(ConfigParamCtg::trap, "CannonCostPerTile");
+const ConfigParam CannonReloadTurnsParam(ConfigParamCtg::trap, "CannonReloadTurns");
+const ConfigParam CannonRangeParam(ConfigParamCtg::trap, "CannonRange");
+const ConfigParam CannonDamagePerHitMinParam(ConfigParamCtg::trap, "CannonDamagePerHitMin");
+const ConfigParam CannonDamagePerHitMaxParam(ConfigParamCtg::trap, "CannonDamagePerHitMax");
+const ConfigParam CannonNbShootsBeforeDeactivationParam(ConfigParamCtg::trap, "CannonNbShootsBeforeDeactivation");
+const ConfigParam CannonSpeedParam(ConfigParamCtg::trap, "CannonSpeed");
+const ConfigParam CannonPhyDefParam(ConfigParamCtg::trap, "CannonPhyDef");
+const ConfigParam CannonMagDefParam(ConfigParamCtg::trap, "CannonMagDef");
+const ConfigParam CannonEleDefParam(ConfigParamCtg::trap, "CannonEleDef");
 
 namespace
 {
@@ -47,7 +58,7 @@ class TrapCannonFactory : public TrapFactory
     { return TrapCannonNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getTrapConfigInt32("CannonCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(CannonCostPerTileParam); }
 
     const std::string& getMeshName() const override
     {
@@ -118,18 +129,26 @@ TrapCannon::TrapCannon(GameMap* gameMap) :
     Trap(gameMap),
     mRange(0)
 {
-    mReloadTime = ConfigManager::getSingleton().getTrapConfigUInt32("CannonReloadTurns");
-    mRange = ConfigManager::getSingleton().getTrapConfigUInt32("CannonRange");
-    mMinDamage = ConfigManager::getSingleton().getTrapConfigDouble("CannonDamagePerHitMin");
-    mMaxDamage = ConfigManager::getSingleton().getTrapConfigDouble("CannonDamagePerHitMax");
-    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getTrapConfigUInt32("CannonNbShootsBeforeDeactivation");
+    mReloadTime = ConfigManager::getSingleton().getConfigUInt32(CannonReloadTurnsParam);
+    mRange = ConfigManager::getSingleton().getConfigUInt32(CannonRangeParam);
+    mMinDamage = ConfigManager::getSingleton().getConfigDouble(CannonDamagePerHitMinParam);
+    mMaxDamage = ConfigManager::getSingleton().getConfigDouble(CannonDamagePerHitMaxParam);
+    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getConfigUInt32(CannonNbShootsBeforeDeactivationParam);
     setMeshName("");
 }
 
 bool TrapCannon::shoot(Tile* tile)
 {
-    std::vector<Tile*> visibleTiles = getGameMap()->visibleTiles(tile->getX(), tile->getY(), mRange);
-    std::vector<GameEntity*> enemyObjects = getGameMap()->getVisibleCreatures(visibleTiles, getSeat(), true);
+    // Computing the visible tiles is expensive. We only do it if there is a creature around
+    int range = static_cast<int>(mRange);
+    std::vector<GameEntity*> creaturesAround;
+    getGameMap()->getEntityGrid().getEntitiesInRect(GameEntityType::creature, tile->getX() - range, tile->getY() - range,
+        tile->getX() + range, tile->getY() + range, creaturesAround);
+    if(creaturesAround.empty())
+        return false;
+
+    getGameMap()->visibleTiles(tile->getX(), tile->getY(), mRange, mVisibleTiles);
+    std::vector<GameEntity*> enemyObjects = getGameMap()->getVisibleCreatures(mVisibleTiles, getSeat(), true);
 
     if(enemyObjects.empty())
         return false;
@@ -149,7 +168,7 @@ bool TrapCannon::shoot(Tile* tile)
     direction = direction - position;
     direction.normalise();
     MissileOneHit* missile = new MissileOneHit(getGameMap(), getSeat(), getName(), "Cannonball",
-        "", direction, ConfigManager::getSingleton().getTrapConfigDouble("CannonSpeed"),
+        "", direction, ConfigManager::getSingleton().getConfigDouble(CannonSpeedParam),
         Random::Double(mMinDamage, mMaxDamage), 0.0, 0.0, nullptr, false, false, true);
     missile->addToGameMap();
     missile->createMesh();
@@ -171,15 +190,15 @@ TrapEntity* TrapCannon::getTrapEntity(Tile* tile)
 
 double TrapCannon::getPhysicalDefense() const
 {
-    return ConfigManager::getSingleton().getTrapConfigUInt32("CannonPhyDef");
+    return ConfigManager::getSingleton().getConfigUInt32(CannonPhyDefParam);
 }
 
 double TrapCannon::getMagicalDefense() const
 {
-    return ConfigManager::getSingleton().getTrapConfigUInt32("CannonMagDef");
+    return ConfigManager::getSingleton().getConfigUInt32(CannonMagDefParam);
 }
 
 double TrapCannon::getElementDefense() const
 {
-    return ConfigManager::getSingleton().getTrapConfigUInt32("CannonEleDef");
+    return ConfigManager::getSingleton().getConfigUInt32(CannonEleDefParam);
 }
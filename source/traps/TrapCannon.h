@@ -19,6 +19,7 @@
 #define TRAPCANNON_H
 
 #include "Trap.h"
+#include "gamemap/TileContainer.h"
 #include "traps/TrapType.h"
 
 class ODPacket;
@@ -50,6 +51,9 @@ public:
 
 private:
     uint32_t mRange;
+
+    //! \brief Buffer used to compute the tiles visible from the cannon when shooting
+    VisibleTiles mVisibleTiles;
 };
 
 #endif // TRAPCANNON_H
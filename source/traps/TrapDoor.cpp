@@ -39,6 +39,7 @@
 const std::string TrapDoorName = "DoorWooden";
 const std::string TrapDoorNameDisplay = "Wooden door";
 const TrapType TrapDoor::mTrapType = TrapType::doorWooden;
+const ConfigParam WoodenDoorCostPerTileParam(ConfigParamCtg::trap, "WoodenDoorCostPerTile");
 
 namespace
 {
@@ -54,7 +55,7 @@ class TrapDoorFactory : public TrapFactory
     { return TrapDoorNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getTrapConfigInt32("WoodenDoorCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(WoodenDoorCostPerTileParam); }
 
     const std::string& getMeshName() const override
     {
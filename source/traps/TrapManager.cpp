@@ -34,6 +34,11 @@
 #include "utils/Helper.h"
 #include "utils/LogManager.h"
 
+const ConfigParam CannonWorkshopPointsPerTileParam(ConfigParamCtg::trap, "CannonWorkshopPointsPerTile");
+const ConfigParam SpikeWorkshopPointsPerTileParam(ConfigParamCtg::trap, "SpikeWorkshopPointsPerTile");
+const ConfigParam BoulderWorkshopPointsPerTileParam(ConfigParamCtg::trap, "BoulderWorkshopPointsPerTile");
+const ConfigParam WoodenDoorPointsPerTileParam(ConfigParamCtg::trap, "WoodenDoorPointsPerTile");
+
 static const std::string EMPTY_STRING;
 
 namespace
@@ -168,15 +173,13 @@ bool TrapFactory::buildTrapDefault(GameMap* gameMap, Trap* trap, Seat* seat, con
             }
         }
 
-        for(const std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
+        for(std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
         {
-            uint32_t nbTiles = p.second.size();
             ServerNotification serverNotification(
                 ServerNotificationType::refreshTiles, p.first->getPlayer());
-            serverNotification.mPacket << nbTiles;
+            gameMap->tilesToPacket(serverNotification.mPacket, p.second);
             for(Tile* tile : p.second)
             {
-                gameMap->tileToPacket(serverNotification.mPacket, tile);
                 p.first->updateTileStateForSeat(tile, false);
                 tile->exportToPacketForUpdate(serverNotification.mPacket, p.first);
             }
@@ -601,15 +604,13 @@ void TrapManager::sellTrapTiles(GameMap* gameMap, Seat* seatSell, ODPacket& pack
         }
     }
 
-    for(const std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
+    for(std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
     {
-        uint32_t nbTiles = p.second.size();
         ServerNotification serverNotification(
             ServerNotificationType::refreshTiles, p.first->getPlayer());
-        serverNotification.mPacket << nbTiles;
+        gameMap->tilesToPacket(serverNotification.mPacket, p.second);
         for(Tile* tile : p.second)
         {
-            gameMap->tileToPacket(serverNotification.mPacket, tile);
             p.first->updateTileStateForSeat(tile, false);
             tile->exportToPacketForUpdate(serverNotification.mPacket, p.first);
         }
@@ -715,15 +716,13 @@ void TrapManager::sellTrapTilesEditor(GameMap* gameMap, ODPacket& packet)
         }
     }
 
-    for(const std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
+    for(std::pair<Seat* const,std::vector<Tile*>>& p : tilesPerSeat)
     {
-        uint32_t nbTiles = p.second.size();
         ServerNotification serverNotification(
             ServerNotificationType::refreshTiles, p.first->getPlayer());
-        serverNotification.mPacket << nbTiles;
+        gameMap->tilesToPacket(serverNotification.mPacket, p.second);
         for(Tile* tile : p.second)
         {
-            gameMap->tileToPacket(serverNotification.mPacket, tile);
             p.first->updateTileStateForSeat(tile, false);
             tile->exportToPacketForUpdate(serverNotification.mPacket, p.first);
         }
@@ -784,13 +783,13 @@ int32_t TrapManager::getNeededWorkshopPointsPerTrap(TrapType trapType)
         case TrapType::nullTrapType:
             return 0;
         case TrapType::cannon:
-            return ConfigManager::getSingleton().getTrapConfigInt32("CannonWorkshopPointsPerTile");
+            return ConfigManager::getSingleton().getConfigInt32(CannonWorkshopPointsPerTileParam);
         case TrapType::spike:
-            return ConfigManager::getSingleton().getTrapConfigInt32("SpikeWorkshopPointsPerTile");
+            return ConfigManager::getSingleton().getConfigInt32(SpikeWorkshopPointsPerTileParam);
         case TrapType::boulder:
-            return ConfigManager::getSingleton().getTrapConfigInt32("BoulderWorkshopPointsPerTile");
+            return ConfigManager::getSingleton().getConfigInt32(BoulderWorkshopPointsPerTileParam);
         case TrapType::doorWooden:
-            return ConfigManager::getSingleton().getTrapConfigInt32("WoodenDoorPointsPerTile");
+            return ConfigManager::getSingleton().getConfigInt32(WoodenDoorPointsPerTileParam);
         default:
             OD_LOG_ERR("Asked for wrong trap type=" + getTrapNameFromTrapType(trapType));
             break;
@@ -30,6 +30,11 @@
 const std::string TrapSpikeName = "Spike";
 const std::string TrapSpikeNameDisplay = "Spike trap";
 const TrapType TrapSpike::mTrapType = TrapType::spike;
+const ConfigParam SpikeCostPerTileParam(ConfigParamCtg::trap, "SpikeCostPerTile");
+const ConfigParam SpikeReloadTurnsParam(ConfigParamCtg::trap, "SpikeReloadTurns");
+const ConfigParam SpikeDamagePerHitMinParam(ConfigParamCtg::trap, "SpikeDamagePerHitMin");
+const ConfigParam SpikeDamagePerHitMaxParam(ConfigParamCtg::trap, "SpikeDamagePerHitMax");
+const ConfigParam SpikeNbShootsBeforeDeactivationParam(ConfigParamCtg::trap, "SpikeNbShootsBeforeDeactivation");
 
 namespace
 {
@@ -45,7 +50,7 @@ class TrapSpikeFactory : public TrapFactory
     { return TrapSpikeNameDisplay; }
 
     int getCostPerTile() const override
-    { return ConfigManager::getSingleton().getTrapConfigInt32("SpikeCostPerTile"); }
+    { return ConfigManager::getSingleton().getConfigInt32(SpikeCostPerTileParam); }
 
     const std::string& getMeshName() const override
     {
@@ -113,10 +118,10 @@ static TrapRegister reg(new TrapSpikeFactory);
 TrapSpike::TrapSpike(GameMap* gameMap) :
     Trap(gameMap)
 {
-    mReloadTime = ConfigManager::getSingleton().getTrapConfigUInt32("SpikeReloadTurns");
-    mMinDamage = ConfigManager::getSingleton().getTrapConfigDouble("SpikeDamagePerHitMin");
-    mMaxDamage = ConfigManager::getSingleton().getTrapConfigDouble("SpikeDamagePerHitMax");
-    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getTrapConfigUInt32("SpikeNbShootsBeforeDeactivation");
+    mReloadTime = ConfigManager::getSingleton().getConfigUInt32(SpikeReloadTurnsParam);
+    mMinDamage = ConfigManager::getSingleton().getConfigDouble(SpikeDamagePerHitMinParam);
+    mMaxDamage = ConfigManager::getSingleton().getConfigDouble(SpikeDamagePerHitMaxParam);
+    mNbShootsBeforeDeactivation = ConfigManager::getSingleton().getConfigUInt32(SpikeNbShootsBeforeDeactivationParam);
     setMeshName("");
 }
 
@@ -38,6 +38,39 @@ const std::string ConfigManager::DEFAULT_KEEPER_VOICE = "Default";
 
 const std::string ConfigManager::DefaultWorkerCreatureDefinition = "DefaultWorker";
 
+namespace
+{
+struct ConfigParamDefinition
+{
+    ConfigParamCtg mCategory;
+    std::string mName;
+};
+
+//! \brief Parameters registered by ConfigParam. As ConfigParam are global variables, the list is
+//! a static local variable to be sure it is constructed before them
+std::vector<ConfigParamDefinition>& getConfigParamDefinitions()
+{
+    static std::vector<ConfigParamDefinition> definitions;
+    return definitions;
+}
+}
+
+ConfigParam::ConfigParam(ConfigParamCtg category, const std::string& name)
+{
+    std::vector<ConfigParamDefinition>& definitions = getConfigParamDefinitions();
+    for(uint32_t index = 0; index < definitions.size(); ++index)
+    {
+        if((definitions[index].mCategory == category) && (definitions[index].mName == name))
+        {
+            mIndex = index;
+            return;
+        }
+    }
+
+    mIndex = static_cast<uint32_t>(definitions.size());
+    definitions.push_back({ category, name });
+}
+
 template<> ConfigManager* Ogre::Singleton<ConfigManager>::msSingleton = nullptr;
 
 ConfigManager::ConfigManager(const std::string& configPath, const std::string& userConfigPath,
@@ -117,6 +150,7 @@ ConfigManager::ConfigManager(const std::string& configPath, const std::string& u
         OD_LOG_ERR("Couldn't read loadSpellConfig");
         exit(1);
     }
+    loadConfigParams();
     fileName = configPath + mFilenameSkills;
     if(!loadSkills(fileName))
     {
@@ -1016,6 +1050,46 @@ bool ConfigManager::loadSpellConfig(const std::string& fileName)
     return true;
 }
 
+void ConfigManager::loadConfigParams()
+{
+    const std::vector<ConfigParamDefinition>& definitions = getConfigParamDefinitions();
+    mConfigParamValues.clear();
+    mConfigParamValues.resize(definitions.size(), ConfigParamValue{ std::string(), 0, 0, 0.0 });
+    for(uint32_t index = 0; index < definitions.size(); ++index)
+    {
+        const ConfigParamDefinition& definition = definitions[index];
+        const std::map<const std::string, std::string>* config = nullptr;
+        switch(definition.mCategory)
+        {
+            case ConfigParamCtg::room:
+                config = &mRoomsConfig;
+                break;
+            case ConfigParamCtg::trap:
+                config = &mTrapsConfig;
+                break;
+            case ConfigParamCtg::spell:
+                config = &mSpellConfig;
+                break;
+            default:
+                OD_LOG_ERR("Unexpected category for param=" + definition.mName);
+                continue;
+        }
+
+        auto it = config->find(definition.mName);
+        if(it == config->end())
+        {
+            OD_LOG_ERR("Unknown parameter param=" + definition.mName);
+            continue;
+        }
+
+        ConfigParamValue& value = mConfigParamValues[index];
+        value.mString = it->second;
+        value.mUInt32 = Helper::toUInt32(it->second);
+        value.mInt32 = Helper::toInt(it->second);
+        value.mDouble = Helper::toDouble(it->second);
+    }
+}
+
 bool ConfigManager::loadSkills(const std::string& fileName)
 {
     OD_LOG_INF("Load Skills file: " + fileName);
@@ -1372,148 +1446,48 @@ const std::string ConfigManager::getUserValue(Config::Ctg category,
     return it->second;
 }
 
-const std::string& ConfigManager::getRoomConfigString(const std::string& param) const
-{
-    auto it = mRoomsConfig.find(param);
-    if(it == mRoomsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return EMPTY_STRING;
-    }
-
-    return it->second;
-}
-
-uint32_t ConfigManager::getRoomConfigUInt32(const std::string& param) const
-{
-    auto it = mRoomsConfig.find(param);
-    if(it == mRoomsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toUInt32(it->second);
-}
-
-int32_t ConfigManager::getRoomConfigInt32(const std::string& param) const
-{
-    auto it = mRoomsConfig.find(param);
-    if(it == mRoomsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toInt(it->second);
-}
-
-double ConfigManager::getRoomConfigDouble(const std::string& param) const
-{
-    auto it = mRoomsConfig.find(param);
-    if(it == mRoomsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0.0;
-    }
-
-    return Helper::toDouble(it->second);
-}
-
-const std::string& ConfigManager::getTrapConfigString(const std::string& param) const
-{
-    auto it = mTrapsConfig.find(param);
-    if(it == mTrapsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return EMPTY_STRING;
-    }
-
-    return it->second;
-}
-
-uint32_t ConfigManager::getTrapConfigUInt32(const std::string& param) const
+const std::string& ConfigManager::getConfigString(const ConfigParam& param) const
 {
-    auto it = mTrapsConfig.find(param);
-    if(it == mTrapsConfig.end())
+    if(param.getIndex() >= mConfigParamValues.size())
     {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toUInt32(it->second);
-}
-
-int32_t ConfigManager::getTrapConfigInt32(const std::string& param) const
-{
-    auto it = mTrapsConfig.find(param);
-    if(it == mTrapsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0;
-    }
-
-    return Helper::toInt(it->second);
-}
-
-double ConfigManager::getTrapConfigDouble(const std::string& param) const
-{
-    auto it = mTrapsConfig.find(param);
-    if(it == mTrapsConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
-        return 0.0;
-    }
-
-    return Helper::toDouble(it->second);
-}
-
-const std::string& ConfigManager::getSpellConfigString(const std::string& param) const
-{
-    auto it = mSpellConfig.find(param);
-    if(it == mSpellConfig.end())
-    {
-        OD_LOG_ERR("Unknown parameter param=" + param);
+        OD_LOG_ERR("Parameter registered after the configuration was loaded index=" + Helper::toString(param.getIndex()));
         return EMPTY_STRING;
     }
 
-    return it->second;
+    return mConfigParamValues[param.getIndex()].mString;
 }
 
-uint32_t ConfigManager::getSpellConfigUInt32(const std::string& param) const
+uint32_t ConfigManager::getConfigUInt32(const ConfigParam& param) const
 {
-    auto it = mSpellConfig.find(param);
-    if(it == mSpellConfig.end())
+    if(param.getIndex() >= mConfigParamValues.size())
     {
-        OD_LOG_ERR("Unknown parameter param=" + param);
+        OD_LOG_ERR("Parameter registered after the configuration was loaded index=" + Helper::toString(param.getIndex()));
         return 0;
     }
 
-    return Helper::toUInt32(it->second);
+    return mConfigParamValues[param.getIndex()].mUInt32;
 }
 
-int32_t ConfigManager::getSpellConfigInt32(const std::string& param) const
+int32_t ConfigManager::getConfigInt32(const ConfigParam& param) const
 {
-    auto it = mSpellConfig.find(param);
-    if(it == mSpellConfig.end())
+    if(param.getIndex() >= mConfigParamValues.size())
     {
-        OD_LOG_ERR("Unknown parameter param=" + param);
+        OD_LOG_ERR("Parameter registered after the configuration was loaded index=" + Helper::toString(param.getIndex()));
         return 0;
     }
 
-    return Helper::toInt(it->second);
+    return mConfigParamValues[param.getIndex()].mInt32;
 }
 
-double ConfigManager::getSpellConfigDouble(const std::string& param) const
+double ConfigManager::getConfigDouble(const ConfigParam& param) const
 {
-    auto it = mSpellConfig.find(param);
-    if(it == mSpellConfig.end())
+    if(param.getIndex() >= mConfigParamValues.size())
     {
-        OD_LOG_ERR("Unknown parameter param=" + param);
+        OD_LOG_ERR("Parameter registered after the configuration was loaded index=" + Helper::toString(param.getIndex()));
         return 0.0;
     }
 
-    return Helper::toDouble(it->second);
+    return mConfigParamValues[param.getIndex()].mDouble;
 }
 
 int32_t ConfigManager::getSkillPoints(const std::string& res) const
@@ -64,6 +64,32 @@ const std::string MINIMAP_TYPE = "MinimapType";
 const std::string LIGHT_FACTOR = "LightFactor";
 }
 
+//! \brief Categories of the room, trap and spell parameters (see ConfigParam)
+enum class ConfigParamCtg
+{
+    room,
+    trap,
+    spell
+};
+
+//! \brief Handle on a room, trap or spell parameter. Handles should be declared as global constants
+//! in the files using them so that they are all registered before ConfigManager loads the configuration.
+//! The value of each registered parameter is then parsed once (parameters missing from the configuration
+//! are reported at that time) and getting it through the handle is only an array access.
+class ConfigParam
+{
+public:
+    ConfigParam(ConfigParamCtg category, const std::string& name);
+
+    inline uint32_t getIndex() const
+    { return mIndex; }
+
+private:
+    //! \brief Index of the parameter in the registered parameters (2 handles on the same
+    //! parameter share the same index)
+    uint32_t mIndex;
+};
+
 //! \brief This class is used to manage global configuration such as network configuration, global creature stats, ...
 //! It should NOT be used to load level specific stuff. For that, there is GameMap.
 class ConfigManager : public Ogre::Singleton<ConfigManager>
@@ -174,23 +200,11 @@ public:
     inline const std::vector<std::string>& getFactions() const
     { return mFactions; }
 
-    //! Rooms configuration
-    const std::string& getRoomConfigString(const std::string& param) const;
-    uint32_t getRoomConfigUInt32(const std::string& param) const;
-    int32_t getRoomConfigInt32(const std::string& param) const;
-    double getRoomConfigDouble(const std::string& param) const;
-
-    //! Traps configuration
-    const std::string& getTrapConfigString(const std::string& param) const;
-    uint32_t getTrapConfigUInt32(const std::string& param) const;
-    int32_t getTrapConfigInt32(const std::string& param) const;
-    double getTrapConfigDouble(const std::string& param) const;
-
-    //! Spells configuration
-    const std::string& getSpellConfigString(const std::string& param) const;
-    uint32_t getSpellConfigUInt32(const std::string& param) const;
-    int32_t getSpellConfigInt32(const std::string& param) const;
-    double getSpellConfigDouble(const std::string& param) const;
+    //! Rooms, traps and spells configuration
+    const std::string& getConfigString(const ConfigParam& param) const;
+    uint32_t getConfigUInt32(const ConfigParam& param) const;
+    int32_t getConfigInt32(const ConfigParam& param) const;
+    double getConfigDouble(const ConfigParam& param) const;
 
     int32_t getSkillPoints(const std::string& res) const;
 
@@ -258,6 +272,10 @@ private:
     bool loadRooms(const std::string& fileName);
     bool loadTraps(const std::string& fileName);
     bool loadSpellConfig(const std::string& fileName);
+
+    //! \brief Parses the values of the registered ConfigParam and reports the ones
+    //! missing from the configuration
+    void loadConfigParams();
     bool loadSkills(const std::string& fileName);
     bool loadTilesets(const std::string& fileName);
     bool loadTilesetValues(std::istream& defFile, TileVisual tileVisual, std::vector<TileSetValue>& tileValues);
@@ -320,6 +338,18 @@ private:
     std::map<const std::string, std::string> mRoomsConfig;
     std::map<const std::string, std::string> mTrapsConfig;
     std::map<const std::string, std::string> mSpellConfig;
+
+    //! \brief Value of a ConfigParam parsed in every type it can be read as
+    struct ConfigParamValue
+    {
+        std::string mString;
+        uint32_t mUInt32;
+        int32_t mInt32;
+        double mDouble;
+    };
+
+    //! \brief Values of the registered ConfigParam (indexed by ConfigParam::getIndex)
+    std::vector<ConfigParamValue> mConfigParamValues;
     std::map<const std::string, int32_t> mSkillPoints;
 
     //! \brief Default definition for the editor. At map loading, it will spawn a creature from
@@ -27,7 +27,8 @@ template<> LogManager* Ogre::Singleton<LogManager>::msSingleton = nullptr;
 const std::string LogManager::GAMELOG_NAME = "gameLog";
 
 LogManager::LogManager()
-    : mLevel(LogMessageLevel::NORMAL)
+    : mLevel(LogMessageLevel::NORMAL),
+      mGeneration(1)
 {
 
 }
@@ -44,12 +45,55 @@ void LogManager::addSink(std::unique_ptr<LogSink> sink)
 
 void LogManager::setLevel(LogMessageLevel level)
 {
+    sf::Lock locked(mLock);
     mLevel = level;
+    invalidateCallSites();
 }
 
 void LogManager::setModuleLevel(const char* module, LogMessageLevel level)
 {
+    sf::Lock locked(mLock);
     mModuleLevel[module] = level;
+    invalidateCallSites();
+}
+
+void LogManager::invalidateCallSites()
+{
+    // The generation is stored on 24 bits in the call sites. 0 is never used because it is
+    // the value of call sites that have not been used yet
+    uint32_t generation = (mGeneration.load() + 1) & 0xFFFFFF;
+    if (generation == 0)
+        generation = 1;
+
+    mGeneration.store(generation);
+}
+
+uint32_t LogManager::refreshCallSite(LogCallSite& callSite)
+{
+    sf::Lock locked(mLock);
+
+    if (callSite.mModule.empty())
+    {
+        const boost::filesystem::path strippedPath(callSite.mFilepath);
+        callSite.mModule = strippedPath.stem().string();
+        callSite.mFilename = strippedPath.filename().string();
+    }
+
+    // Per-module levels override the global logging level if they are lower
+    LogMessageLevel level = mLevel;
+    auto found = mModuleLevel.find(callSite.mModule);
+    if (found != mModuleLevel.end() && found->second < level)
+        level = found->second;
+
+    uint32_t cachedLevel = (mGeneration.load() << 8) | static_cast<uint32_t>(level);
+    callSite.mCachedLevel.store(cachedLevel, std::memory_order_relaxed);
+    return cachedLevel;
+}
+
+void LogManager::logMessage(LogMessageLevel level, LogCallSite& callSite, int line, const std::string& message)
+{
+    sf::Lock locked(mLock);
+    writeToSinks(level, callSite.mModule, callSite.mFilename, line, message);
 }
 
 void LogManager::logMessage(LogMessageLevel level, const char* filepath, int line, const std::string& message)
@@ -80,10 +124,12 @@ void LogManager::logMessage(LogMessageLevel level, const char* filepath, int lin
         }
     }
 
-    // filename
-
-    std::string filename = strippedPath.filename().string();
+    writeToSinks(level, module, strippedPath.filename().string(), line, message);
+}
 
+void LogManager::writeToSinks(LogMessageLevel level, const std::string& module, const std::string& filename,
+    int line, const std::string& message)
+{
     // timestamp
 
     time_t current_time = ::time(0);
@@ -18,6 +18,8 @@
 #ifndef LOGMANAGER_H
 #define LOGMANAGER_H
 
+#include <atomic>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -29,14 +31,45 @@
 #include "utils/LogMessageLevel.h"
 #include "utils/LogSink.h"
 
-#define OD_LOG_ERR(_message)                      LogManager::getSingleton().logMessage(LogMessageLevel::CRITICAL, __FILE__, __LINE__, (std::string("") + _message))
-#define OD_LOG_WRN(_message)                      LogManager::getSingleton().logMessage(LogMessageLevel::WARNING, __FILE__, __LINE__, (std::string("") + _message))
-#define OD_LOG_INF(_message)                      LogManager::getSingleton().logMessage(LogMessageLevel::NORMAL, __FILE__, __LINE__, (std::string("") + _message))
-#define OD_LOG_DBG(_message)                      LogManager::getSingleton().logMessage(LogMessageLevel::TRIVIAL, __FILE__, __LINE__, (std::string("") + _message))
+//! \brief The message is only built if the level is logged for the calling module. The module
+//! level is cached in the call site so that disabled levels only cost an integer comparison
+#define OD_LOG_MESSAGE(_level, _message)          do \
+                                                  { \
+                                                      static LogCallSite odLogCallSite(__FILE__); \
+                                                      LogManager& odLogManager = LogManager::getSingleton(); \
+                                                      if (odLogManager.isLogged(_level, odLogCallSite)) \
+                                                          odLogManager.logMessage(_level, odLogCallSite, __LINE__, (std::string("") + _message)); \
+                                                  } while(false)
+
+#define OD_LOG_ERR(_message)                      OD_LOG_MESSAGE(LogMessageLevel::CRITICAL, _message)
+#define OD_LOG_WRN(_message)                      OD_LOG_MESSAGE(LogMessageLevel::WARNING, _message)
+#define OD_LOG_INF(_message)                      OD_LOG_MESSAGE(LogMessageLevel::NORMAL, _message)
+#define OD_LOG_DBG(_message)                      OD_LOG_MESSAGE(LogMessageLevel::TRIVIAL, _message)
 
 #define OD_ASSERT_TRUE(_condition)                if (!(_condition)) LogManager::getSingleton().logMessage(LogMessageLevel::CRITICAL, __FILE__, __LINE__, std::string(#_condition))
 #define OD_ASSERT_TRUE_MSG(_condition, _message)  if (!(_condition)) LogManager::getSingleton().logMessage(LogMessageLevel::CRITICAL, __FILE__, __LINE__, (std::string("") + _message))
 
+//! \brief Data kept by each place logging messages. It allows to check if a message should be
+//! logged without looking for the module level each time
+class LogCallSite
+{
+public:
+    LogCallSite(const char* filepath) :
+        mFilepath(filepath),
+        mCachedLevel(0)
+    {}
+
+    const char* mFilepath;
+
+    //! \brief Module and file names. They are computed the first time the call site is used
+    std::string mModule;
+    std::string mFilename;
+
+    //! \brief Minimum level logged by this call site (8 low bits) and generation of the
+    //! log levels when it was computed (other bits)
+    std::atomic<uint32_t> mCachedLevel;
+};
+
 //! \brief Helper/wrapper class to provide thread-safe logging when ogre is compiled without threads.
 class LogManager : public Ogre::Singleton<LogManager>
 {
@@ -53,7 +86,20 @@ public:
     //! \brief Set the minimum logging level per module.
     void setModuleLevel(const char* module, LogMessageLevel level);
 
-    //! \brief Log a message to the sinks.
+    //! \brief Returns true if messages with the given level should be logged from the given call site.
+    inline bool isLogged(LogMessageLevel level, LogCallSite& callSite)
+    {
+        uint32_t cachedLevel = callSite.mCachedLevel.load(std::memory_order_relaxed);
+        if ((cachedLevel >> 8) != mGeneration.load(std::memory_order_relaxed))
+            cachedLevel = refreshCallSite(callSite);
+
+        return static_cast<uint32_t>(level) >= (cachedLevel & 0xFF);
+    }
+
+    //! \brief Log a message to the sinks. The level should have been checked with isLogged.
+    void logMessage(LogMessageLevel level, LogCallSite& callSite, int line, const std::string& message);
+
+    //! \brief Log a message to the sinks if the level is logged for the module the file belongs to.
     void logMessage(LogMessageLevel level, const char* filepath, int line, const std::string& message);
 
     static const std::string GAMELOG_NAME;
@@ -61,8 +107,21 @@ private:
     LogManager(const LogManager&) = delete;
     LogManager& operator=(const LogManager&) = delete;
 
+    //! \brief Forces the call sites to compute their level again. mLock should be locked
+    void invalidateCallSites();
+
+    //! \brief Computes the minimum level logged by the given call site and caches it
+    uint32_t refreshCallSite(LogCallSite& callSite);
+
+    //! \brief Writes the message to the sinks. mLock should be locked
+    void writeToSinks(LogMessageLevel level, const std::string& module, const std::string& filename,
+        int line, const std::string& message);
+
     LogMessageLevel mLevel;
     std::map<std::string, LogMessageLevel> mModuleLevel;
+    //! \brief Incremented each time a log level is changed so that the call sites
+    //! know they have to refresh their cached level
+    std::atomic<uint32_t> mGeneration;
     sf::Mutex mLock;
     std::vector<std::unique_ptr<LogSink>> mSinks;
     std::stringstream mTimestampStream;
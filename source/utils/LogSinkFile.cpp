@@ -19,15 +19,40 @@
 
 #include "utils/Helper.h"
 
-LogSinkFile::LogSinkFile(const std::string& filepath)
+#include <SFML/System.hpp>
+
+//! \brief Time the background thread waits when there is nothing to write
+static const int32_t WRITE_THREAD_SLEEP_MS = 10;
+
+LogSinkFile::LogSinkFile(const std::string& filepath, bool isAsync) :
+    mIsAsync(isAsync),
+    mRingBufferHead(0),
+    mRingBufferTail(0),
+    mNbDroppedLines(0),
+    mIsStopping(false)
 {
     // Clear previous log
 
     mFile.open(filepath.c_str(), std::ios::out | std::ios::trunc);
+
+    if (!mIsAsync || !mFile.is_open())
+        return;
+
+    mRingBuffer.resize(RING_BUFFER_SIZE);
+    mThread.reset(new sf::Thread(&LogSinkFile::writeThread, this));
+    mThread->launch();
 }
 
 LogSinkFile::~LogSinkFile()
 {
+    if (mThread != nullptr)
+    {
+        // The thread writes the remaining lines before exiting
+        mIsStopping.store(true, std::memory_order_release);
+        mThread->wait();
+        mThread.reset();
+    }
+
     if (mFile.is_open())
         mFile.close();
 }
@@ -37,17 +62,65 @@ void LogSinkFile::write(LogMessageLevel level, const std::string& module, const
     if (!mFile.is_open())
         return;
 
-    mFile
-        << "(" << timestamp << ") "
-        << "(" << module << ") "
-        << "[" << LogMessageLevelToString(level) << "] ";
+    std::string logLine = "(" + timestamp + ") "
+        + "(" + module + ") "
+        + "[" + LogMessageLevelToString(level) + "] ";
 
     if (level >= LogMessageLevel::WARNING)
-        mFile << "(" << filename << ":" << line << ") ";
+        logLine += "(" + filename + ":" + Helper::toString(line) + ") ";
+
+    logLine += message;
+
+    if (!mIsAsync)
+    {
+        mFile << logLine << std::endl;
+        mFile.flush();
+        return;
+    }
+
+    uint32_t head = mRingBufferHead.load(std::memory_order_relaxed);
+    uint32_t tail = mRingBufferTail.load(std::memory_order_acquire);
+    if (head - tail >= RING_BUFFER_SIZE)
+    {
+        mNbDroppedLines.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    mRingBuffer[head % RING_BUFFER_SIZE] = std::move(logLine);
+    mRingBufferHead.store(head + 1, std::memory_order_release);
+}
+
+void LogSinkFile::writeThread()
+{
+    while (true)
+    {
+        // We check if we should stop before reading the ring buffer to make sure every line
+        // written before the stop request is written to the file
+        bool isStopping = mIsStopping.load(std::memory_order_acquire);
+        uint32_t tail = mRingBufferTail.load(std::memory_order_relaxed);
+        uint32_t head = mRingBufferHead.load(std::memory_order_acquire);
+        if (tail == head)
+        {
+            if (isStopping)
+                break;
+
+            sf::sleep(sf::milliseconds(WRITE_THREAD_SLEEP_MS));
+            continue;
+        }
+
+        while (tail != head)
+        {
+            std::string& logLine = mRingBuffer[tail % RING_BUFFER_SIZE];
+            mFile << logLine << "\n";
+            logLine.clear();
+            ++tail;
+            mRingBufferTail.store(tail, std::memory_order_release);
+        }
 
-    mFile
-        << message
-        << std::endl;
+        uint32_t nbDroppedLines = mNbDroppedLines.exchange(0, std::memory_order_relaxed);
+        if (nbDroppedLines > 0)
+            mFile << "Log buffer full: " << nbDroppedLines << " lines dropped" << std::endl;
 
-    mFile.flush();
+        mFile.flush();
+    }
 }
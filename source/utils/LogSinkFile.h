@@ -18,19 +18,53 @@
 #ifndef _LOGSINKFILE_H_
 #define _LOGSINKFILE_H_
 
+#include <atomic>
 #include <fstream>
+#include <memory>
+#include <vector>
 
 #include "LogSink.h"
 
+namespace sf
+{
+class Thread;
+}
+
 class LogSinkFile : public LogSink
 {
 public:
-    LogSinkFile(const std::string& filepath);
+    //! \brief If isAsync is true, the lines are written to the file by a background thread
+    //! so that logging never waits for the disk. In this mode, the lines are given to the
+    //! thread through a lock-free ring buffer and are dropped if it is full.
+    LogSinkFile(const std::string& filepath, bool isAsync = false);
     ~LogSinkFile();
 
+    //! \brief Note that write should not be called by several threads at the same time (the
+    //! LogManager ensures it), the ring buffer only supports one writer and one reader.
     virtual void write(LogMessageLevel level, const std::string& module, const std::string& timestamp, const std::string& filename, int line, const std::string& message) override;
 private:
+    //! \brief Number of lines the ring buffer can hold
+    static const uint32_t RING_BUFFER_SIZE = 4096;
+
+    //! \brief Loop of the background thread writing the lines from the ring buffer
+    void writeThread();
+
     std::ofstream mFile;
+
+    bool mIsAsync;
+
+    //! \brief Lines waiting to be written. mRingBufferHead is the next slot written by write
+    //! and mRingBufferTail the next slot read by the background thread. They are only incremented
+    //! and the slot used is the index modulo RING_BUFFER_SIZE
+    std::vector<std::string> mRingBuffer;
+    std::atomic<uint32_t> mRingBufferHead;
+    std::atomic<uint32_t> mRingBufferTail;
+
+    //! \brief Number of lines dropped because the ring buffer was full
+    std::atomic<uint32_t> mNbDroppedLines;
+
+    std::atomic<bool> mIsStopping;
+    std::unique_ptr<sf::Thread> mThread;
 };
 
 #endif // _LOGSINKFILE_H_
@@ -28,6 +28,9 @@ namespace Random
     //! \brief initializes the semaphore and seeds the generator
     void initialize();
 
+    //! \brief seeds the generator with the given value. Used to get reproducible games
+    void initialize(unsigned long seed);
+
     /*! \brief generate a random double
      *
      *  \param min, max One or both can be negative
@@ -87,6 +87,7 @@ ResourceManager::ResourceManager(boost::program_options::variables_map& options)
         mServerMode(false),
         mForcedNetworkPort(-1),
         mLogLevel(LogMessageLevel::NORMAL),
+        mIsLogAsync(false),
         mGameDataPath("./"),
         mUserDataPath("./"),
         mUserConfigPath("./")
@@ -434,6 +435,8 @@ void ResourceManager::setupUserDataFolders(boost::program_options::variables_map
     if(itOption != options.end())
         mLogLevel = static_cast<LogMessageLevel>(itOption->second.as<int32_t>());
 
+    mIsLogAsync = (options.find("asynclog") != options.end());
+
     mUserConfigFile = mUserConfigPath + USERCFGFILENAME;
     mCeguiLogFile = mUserDataPath + CEGUILOGFILENAME;
     mShaderCachePath = mUserDataPath + SHADERCACHESUBPATH;
@@ -594,6 +597,7 @@ void ResourceManager::buildCommandOptions(boost::program_options::options_descri
         ("mscreator", boost::program_options::value<std::string>(), "Sets the creator for this map to connect to the master server. server/servercustom/serversave option needs to be on")
         ("port", boost::program_options::value<int32_t>(), "Sets the port used. Note that the port is used for both single and multi player")
         ("loglevel", boost::program_options::value<int32_t>(), "Sets the log level (between 0=Trivial and 3=Critical)")
+        ("asynclog", "Writes the log file from a background thread so that the game never waits for the disk")
     ;
 }
 
@@ -151,6 +151,9 @@ public:
     inline LogMessageLevel getLogLevel() const
     { return mLogLevel; }
 
+    inline bool isLogAsync() const
+    { return mIsLogAsync; }
+
 private:
     //! \brief used when the executable is launched in server mode
     bool mServerMode;
@@ -163,6 +166,9 @@ private:
     //! \brief The log level
     LogMessageLevel mLogLevel;
 
+    //! \brief If true, the log file is written by a background thread
+    bool mIsLogAsync;
+
     //! \brief The application data path
     //! \example "/usr/share/game/opendungeons" on linux
     //! \example "C:/opendungeons" on windows
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+
+//! \brief Unbounded lock-free queue allowing one thread to push values while another one pops them.
+//! push should always be called from the same thread (producer) and pop from the same thread (consumer).
+//! The queue is a linked list starting with a dummy node owned by the consumer. The producer only
+//! links new nodes after the last one so both threads never modify the same node.
+template<typename T>
+class SpscQueue
+{
+public:
+    SpscQueue() :
+        mFirst(new Node),
+        mLast(mFirst),
+        mSize(0)
+    {}
+
+    ~SpscQueue()
+    {
+        while(mFirst != nullptr)
+        {
+            Node* node = mFirst;
+            mFirst = node->mNext.load(std::memory_order_relaxed);
+            delete node;
+        }
+    }
+
+    //! \brief Adds the value at the end of the queue. Should only be called by the producer thread
+    void push(const T& value)
+    {
+        Node* node = new Node;
+        node->mValue = value;
+        // The size is increased before linking the node so that it cannot be popped before
+        mSize.fetch_add(1, std::memory_order_relaxed);
+        mLast->mNext.store(node, std::memory_order_release);
+        mLast = node;
+    }
+
+    //! \brief Removes the first value of the queue and copies it in value. Returns false if the queue
+    //! was empty. Should only be called by the consumer thread
+    bool pop(T& value)
+    {
+        Node* next = mFirst->mNext.load(std::memory_order_acquire);
+        if(next == nullptr)
+            return false;
+
+        // next becomes the dummy node
+        value = next->mValue;
+        delete mFirst;
+        mFirst = next;
+        mSize.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    //! \brief Number of values in the queue. As it can be called from any thread, it should
+    //! only be used as an indication (for metrics, for example)
+    inline uint32_t size() const
+    { return mSize.load(std::memory_order_relaxed); }
+
+private:
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    struct Node
+    {
+        Node() :
+            mValue(),
+            mNext(nullptr)
+        {}
+
+        T mValue;
+        std::atomic<Node*> mNext;
+    };
+
+    //! \brief Dummy node. Only used by the consumer thread
+    Node* mFirst;
+
+    //! \brief Last node of the list. Only used by the producer thread
+    Node* mLast;
+
+    std::atomic<uint32_t> mSize;
+};
+
+#endif // SPSCQUEUE_H
@@ -0,0 +1,136 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+
+//! \brief Number of chunks each thread should get on average. More chunks balance the load
+//! better when items have different costs but increase the contention on the shared counter
+const uint32_t NB_CHUNKS_PER_THREAD = 8;
+
+ThreadPool::ThreadPool(uint32_t nbWorkers) :
+    mJobId(0),
+    mIsStopping(false),
+    mNbBusyWorkers(0),
+    mTask(nullptr),
+    mNbItems(0),
+    mChunkSize(1),
+    mNextItem(0)
+{
+    for(uint32_t i = 0; i < nbWorkers; ++i)
+        mWorkers.emplace_back(&ThreadPool::workerThread, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mIsStopping = true;
+    }
+    mJobStarted.notify_all();
+
+    for(std::thread& worker : mWorkers)
+        worker.join();
+}
+
+uint32_t ThreadPool::getDefaultNbWorkers()
+{
+    // hardware_concurrency may return 0 if the number of cores is unknown
+    uint32_t nbCores = std::thread::hardware_concurrency();
+    if(nbCores <= 1)
+        return 0;
+
+    return nbCores - 1;
+}
+
+void ThreadPool::parallelFor(uint32_t nbItems, const std::function<void(uint32_t)>& task)
+{
+    if(nbItems == 0)
+        return;
+
+    // Not worth waking up the workers
+    if(mWorkers.empty() || (nbItems == 1))
+    {
+        for(uint32_t i = 0; i < nbItems; ++i)
+            task(i);
+
+        return;
+    }
+
+    uint32_t nbThreads = getNbWorkers() + 1;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mTask = &task;
+        mNbItems = nbItems;
+        mChunkSize = std::max(1u, nbItems / (nbThreads * NB_CHUNKS_PER_THREAD));
+        mNextItem.store(0, std::memory_order_relaxed);
+        mNbBusyWorkers = getNbWorkers();
+        ++mJobId;
+    }
+    mJobStarted.notify_all();
+
+    processItems();
+
+    // We wait for the workers to be done before returning because task may not be valid afterwards
+    std::unique_lock<std::mutex> lock(mLock);
+    mJobDone.wait(lock, [this]() { return mNbBusyWorkers == 0; });
+    mTask = nullptr;
+}
+
+void ThreadPool::workerThread()
+{
+    uint64_t lastJobId = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mLock);
+            mJobStarted.wait(lock, [this, lastJobId]() { return mIsStopping || (mJobId != lastJobId); });
+            if(mIsStopping)
+                return;
+
+            lastJobId = mJobId;
+        }
+
+        processItems();
+
+        bool isLastWorker;
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            --mNbBusyWorkers;
+            isLastWorker = (mNbBusyWorkers == 0);
+        }
+        if(isLastWorker)
+            mJobDone.notify_one();
+    }
+}
+
+void ThreadPool::processItems()
+{
+    // mTask, mNbItems and mChunkSize are set before the job is started and are not
+    // changed until every thread is done with it
+    while(true)
+    {
+        uint32_t first = mNextItem.fetch_add(mChunkSize, std::memory_order_relaxed);
+        if(first >= mNbItems)
+            return;
+
+        uint32_t last = std::min(first + mChunkSize, mNbItems);
+        for(uint32_t i = first; i < last; ++i)
+            (*mTask)(i);
+    }
+}
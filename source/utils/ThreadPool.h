@@ -0,0 +1,79 @@
+/*
+ *  Copyright (C) 2011-2016  OpenDungeons Team
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \brief Pool of worker threads used to process independent items in parallel. The items
+//! are distributed in small chunks taken from a shared counter so that a thread done with
+//! cheap items keeps taking work while others are busy with expensive ones.
+//! parallelFor is blocking and should always be called from the same thread. That thread
+//! processes items as well, so a pool with 0 worker processes everything serially.
+class ThreadPool
+{
+public:
+    ThreadPool(uint32_t nbWorkers);
+    ~ThreadPool();
+
+    //! \brief Calls task for every index from 0 to nbItems - 1 and returns when they have all
+    //! been processed. The order in which the items are processed is not defined so task
+    //! should only write data owned by the given item
+    void parallelFor(uint32_t nbItems, const std::function<void(uint32_t)>& task);
+
+    inline uint32_t getNbWorkers() const
+    { return static_cast<uint32_t>(mWorkers.size()); }
+
+    //! \brief Number of workers to use to have one thread per core (taking into
+    //! account the thread calling parallelFor)
+    static uint32_t getDefaultNbWorkers();
+
+private:
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void workerThread();
+
+    //! \brief Processes chunks of the current job until there is no item left
+    void processItems();
+
+    std::vector<std::thread> mWorkers;
+
+    std::mutex mLock;
+    std::condition_variable mJobStarted;
+    std::condition_variable mJobDone;
+
+    //! \brief Incremented for each job so that workers know when a new one is available
+    uint64_t mJobId;
+    bool mIsStopping;
+    //! \brief Number of workers still processing the current job
+    uint32_t mNbBusyWorkers;
+
+    const std::function<void(uint32_t)>* mTask;
+    uint32_t mNbItems;
+    uint32_t mChunkSize;
+    std::atomic<uint32_t> mNextItem;
+};
+
+#endif // THREADPOOL_H